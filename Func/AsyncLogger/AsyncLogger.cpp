@@ -0,0 +1,418 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+static_assert(sizeof(LogRecord) == kLogRecordSize, "LogRecord must fill exactly one record");
+
+namespace
+{
+	/// <summary>
+	/// ストリームにAsyncLoggerを覚えさせる場所の番号
+	/// </summary>
+	int GetAsyncLoggerIndex()
+	{
+		static const int index = std::ios_base::xalloc();
+		return index;
+	}
+
+	/// <summary>
+	/// 2のべき乗に切り上げる
+	/// </summary>
+	uint64_t RoundUpToPowerOfTwo(uint64_t value)
+	{
+		uint64_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+
+		return result;
+	}
+
+	// 作られているAsyncLogger（止まる直前にまとめてflushする）
+	typedef struct LiveAsyncLoggers
+	{
+		std::mutex mutex;
+		std::vector<AsyncLogger*> loggers;
+	}LiveAsyncLoggers;
+
+	/// <summary>
+	/// 作られているAsyncLoggerを取得する
+	/// </summary>
+	LiveAsyncLoggers& GetLiveAsyncLoggers()
+	{
+		static LiveAsyncLoggers live;
+		return live;
+	}
+
+	/// <summary>
+	/// targetまでflushされるのを待つ
+	/// </summary>
+	/// <returns>flushされたか（時間切れならfalse）</returns>
+	bool WaitAsyncLoggerFlushed(AsyncLogger* logger, double timeoutMilliseconds)
+	{
+		uint64_t target = logger->enqueuePosition.load(std::memory_order_acquire);
+
+		// 他のスレッドがもっと先まで頼んでいたら、そのままにする
+		uint64_t requested = logger->flushRequestPosition.load(std::memory_order_relaxed);
+		while (requested < target && !logger->flushRequestPosition.compare_exchange_weak(requested, target, std::memory_order_release))
+		{
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		while (logger->flushedPosition.load(std::memory_order_acquire) < target)
+		{
+			if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= timeoutMilliseconds)
+			{
+				return false;
+			}
+
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		return true;
+	}
+
+	// 1回にまとめて書く量（ログが途切れなくても、この量ごとに書いてflushを見る）
+	const size_t kLogBatchBytes = 64 * 1024;
+
+	/// <summary>
+	/// 読めるログを取り出して、batchに足す
+	/// </summary>
+	/// <returns>取り出した数</returns>
+	uint64_t DrainLogRecords(AsyncLogger* logger, std::string& batch)
+	{
+		uint64_t count = 0;
+
+		while (batch.size() < kLogBatchBytes)
+		{
+			LogRecord& record = logger->records[logger->dequeuePosition & logger->mask];
+
+			// 書き込み終わっていなければ、ここで止める（順番を入れ替えない）
+			if (record.sequence.load(std::memory_order_acquire) != logger->dequeuePosition + 1)
+			{
+				return count;
+			}
+
+			const char* text = record.heapText ? record.heapText : record.inlineText;
+
+			// これまでのLogと同じく、1つのログごとに改行する
+			batch.append(text, record.length);
+			batch.push_back('\n');
+
+#ifdef _WIN32
+			if (logger->settings.isDebugOutput)
+			{
+				OutputDebugStringA(text);
+			}
+#endif
+
+			if (record.heapText)
+			{
+				delete[] record.heapText;
+				record.heapText = nullptr;
+			}
+
+			// 1周後の書き込みに渡す
+			record.sequence.store(logger->dequeuePosition + logger->mask + 1, std::memory_order_release);
+			logger->dequeuePosition++;
+			count++;
+		}
+
+		return count;
+	}
+
+	/// <summary>
+	/// ファイルに書くスレッド
+	/// </summary>
+	void RunLogWriter(AsyncLogger* logger)
+	{
+		std::string batch;
+		batch.reserve(kLogBatchBytes + kLogRecordSize);
+
+		size_t unflushedBytes = 0;
+		std::chrono::steady_clock::time_point lastFlushTime = std::chrono::steady_clock::now();
+
+		while (true)
+		{
+			// 止める指示を先に読む（読んだ後に入れられたログも、次の周で取り出す）
+			bool isRunning = logger->isRunning.load(std::memory_order_acquire);
+
+			uint64_t count = DrainLogRecords(logger, batch);
+			if (!batch.empty())
+			{
+				logger->output->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+				unflushedBytes += batch.size();
+				batch.clear();
+
+				logger->writtenCount.fetch_add(count, std::memory_order_relaxed);
+			}
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			double elapsed = std::chrono::duration<double, std::milli>(now - lastFlushTime).count();
+
+			bool isFlushRequested = logger->flushRequestPosition.load(std::memory_order_acquire) > logger->flushedPosition.load(std::memory_order_relaxed);
+			bool isFlushDue = unflushedBytes > 0 && (unflushedBytes >= logger->settings.flushBytes || elapsed >= logger->settings.flushIntervalMilliseconds);
+
+			if (isFlushRequested || isFlushDue || !isRunning)
+			{
+				if (unflushedBytes > 0)
+				{
+					logger->output->flush();
+					logger->flushCount.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				unflushedBytes = 0;
+				lastFlushTime = now;
+				logger->flushedPosition.store(logger->dequeuePosition, std::memory_order_release);
+			}
+
+			if (count == 0)
+			{
+				if (!isRunning)
+				{
+					return;
+				}
+
+				// 何もなければ少し休む（書き込むスレッドは起こさなくてよいので、ロックを使わずに済む）
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	}
+}
+
+/// <summary>
+/// 既定の設定を作る（4096個、いっぱいなら捨てる、100msか64KBごとにflush）
+/// </summary>
+/// <returns>AsyncLoggerSettings</returns>
+AsyncLoggerSettings MakeAsyncLoggerSettings()
+{
+	// AsyncLoggerSettings
+	AsyncLoggerSettings settings{};
+	settings.capacity = 4096;
+	settings.fullPolicy = LogFullPolicy::Drop;
+	settings.flushIntervalMilliseconds = 100.0;
+	settings.flushBytes = 64 * 1024;
+	settings.isDebugOutput = true;
+
+	return settings;
+}
+
+/// <summary>
+/// AsyncLoggerを作り、ファイルに書くスレッドを始める
+/// </summary>
+/// <param name="output">書き込み先（ReleaseAsyncLoggerまでは、このスレッド以外から書かない）</param>
+/// <param name="settings">設定</param>
+/// <returns>AsyncLogger</returns>
+AsyncLogger* CreateAsyncLogger(std::ostream& output, const AsyncLoggerSettings& settings)
+{
+	// AsyncLogger
+	AsyncLogger* logger = new AsyncLogger{};
+	logger->output = &output;
+	logger->settings = settings;
+
+	uint64_t capacity = RoundUpToPowerOfTwo((std::max)(settings.capacity, 2u));
+	logger->records = std::make_unique<LogRecord[]>(capacity);
+	logger->mask = capacity - 1;
+
+	// i番目の場所は、位置iの書き込みを待つ
+	for (uint64_t i = 0; i < capacity; i++)
+	{
+		logger->records[i].sequence.store(i, std::memory_order_relaxed);
+		logger->records[i].heapText = nullptr;
+	}
+
+	logger->isRunning.store(true, std::memory_order_release);
+	logger->writer = std::thread(RunLogWriter, logger);
+
+	LiveAsyncLoggers& live = GetLiveAsyncLoggers();
+	{
+		std::lock_guard<std::mutex> lock(live.mutex);
+		live.loggers.push_back(logger);
+	}
+
+	return logger;
+}
+
+/// <summary>
+/// ログをリングに入れる（待たずに戻る。Blockか、Errorのログなら、いっぱいのときだけ待つ）
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+/// <param name="message">文字列</param>
+/// <param name="severity">重さ</param>
+/// <returns>入れられたか（Dropでいっぱいなら、Infoのログはfalse）</returns>
+bool PushLog(AsyncLogger* logger, std::string_view message, LogSeverity severity)
+{
+	assert(logger != nullptr);
+
+	/*-----------------------
+	    書き込む場所を取る
+	-----------------------*/
+
+	LogRecord* record = nullptr;
+	uint64_t position = logger->enqueuePosition.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		record = &logger->records[position & logger->mask];
+		int64_t difference = static_cast<int64_t>(record->sequence.load(std::memory_order_acquire) - position);
+
+		if (difference == 0)
+		{
+			// 空いている（他のスレッドに先を越されたら、取り直す）
+			if (logger->enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (difference < 0)
+		{
+			// 1周前のログがまだ読まれていない（エラーは捨てない）
+			if (logger->settings.fullPolicy == LogFullPolicy::Drop && severity != LogSeverity::Error)
+			{
+				logger->droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			std::this_thread::yield();
+			position = logger->enqueuePosition.load(std::memory_order_relaxed);
+		}
+		else
+		{
+			position = logger->enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+
+	/*-------------------
+	    文字列を入れる
+	-------------------*/
+
+	record->length = static_cast<uint32_t>(message.size());
+
+	char* text = record->inlineText;
+	if (message.size() >= sizeof(record->inlineText))
+	{
+		// 長いログ（シェーダーのエラーなど）だけメモリを確保する
+		record->heapText = new char[message.size() + 1];
+		text = record->heapText;
+	}
+
+	std::memcpy(text, message.data(), message.size());
+	text[message.size()] = '\0';
+
+	// 読めるようにする
+	record->sequence.store(position + 1, std::memory_order_release);
+
+	return true;
+}
+
+/// <summary>
+/// ここまでに入れたログが、ファイルに書かれてflushされるまで待つ
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+void FlushAsyncLogger(AsyncLogger* logger)
+{
+	assert(logger != nullptr);
+
+	WaitAsyncLoggerFlushed(logger, std::numeric_limits<double>::infinity());
+}
+
+/// <summary>
+/// 作られている全てのAsyncLoggerを、待てるだけflushする（止まる直前に、例外のハンドラなどから呼ぶ）
+/// </summary>
+/// <param name="timeoutMilliseconds">1つのAsyncLoggerを待つ最長の時間</param>
+/// <returns>全て書けたか（書くスレッド自身から呼ばれた、時間切れならfalse）</returns>
+bool FlushAllAsyncLoggers(double timeoutMilliseconds)
+{
+	LiveAsyncLoggers& live = GetLiveAsyncLoggers();
+
+	// 作ったり解放したりしている最中に止まったなら、待たずに諦める
+	std::unique_lock<std::mutex> lock(live.mutex, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		return false;
+	}
+
+	bool isFlushed = true;
+	for (AsyncLogger* logger : live.loggers)
+	{
+		// 書くスレッドが止まったなら、待っても書かれない
+		if (logger->writer.get_id() == std::this_thread::get_id())
+		{
+			isFlushed = false;
+			continue;
+		}
+
+		isFlushed = WaitAsyncLoggerFlushed(logger, timeoutMilliseconds) && isFlushed;
+	}
+
+	return isFlushed;
+}
+
+/// <summary>
+/// ストリームにAsyncLoggerを結び付ける（Logに渡すと、そのストリームにはAsyncLoggerを通して書く）
+/// </summary>
+/// <param name="stream">ストリーム</param>
+/// <param name="logger">AsyncLogger（nullptrなら外す）</param>
+void AttachAsyncLogger(std::ostream& stream, AsyncLogger* logger)
+{
+	stream.pword(GetAsyncLoggerIndex()) = logger;
+}
+
+/// <summary>
+/// ストリームに結び付いたAsyncLoggerを取得する
+/// </summary>
+/// <param name="stream">ストリーム</param>
+/// <returns>AsyncLogger（なければnullptr）</returns>
+AsyncLogger* GetAttachedAsyncLogger(std::ostream& stream)
+{
+	return static_cast<AsyncLogger*>(stream.pword(GetAsyncLoggerIndex()));
+}
+
+/// <summary>
+/// 残ったログを全て書いてから、AsyncLoggerを解放する（ログを出すスレッドが全て終わってから呼ぶ）
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+void ReleaseAsyncLogger(AsyncLogger* logger)
+{
+	if (logger == nullptr)
+	{
+		return;
+	}
+
+	LiveAsyncLoggers& live = GetLiveAsyncLoggers();
+	{
+		std::lock_guard<std::mutex> lock(live.mutex);
+		live.loggers.erase(std::remove(live.loggers.begin(), live.loggers.end(), logger), live.loggers.end());
+	}
+
+	logger->isRunning.store(false, std::memory_order_release);
+	logger->writer.join();
+
+	// 捨てたログがあれば、最後に数を書いておく
+	uint64_t droppedCount = logger->droppedCount.load(std::memory_order_relaxed);
+	if (droppedCount > 0)
+	{
+		*logger->output << "AsyncLogger dropped " << droppedCount << " records\n";
+		logger->output->flush();
+	}
+
+	if (GetAttachedAsyncLogger(*logger->output) == logger)
+	{
+		AttachAsyncLogger(*logger->output, nullptr);
+	}
+
+	delete logger;
+}
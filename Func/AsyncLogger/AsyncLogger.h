@@ -0,0 +1,156 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <thread>
+
+// 1つのログを入れる場所の大きさ（これより長いログは、別に確保したメモリに入れる）
+const size_t kLogRecordSize = 256;
+
+// リングがいっぱいのときにどうするか
+enum class LogFullPolicy
+{
+	// 捨てて数える（呼んだスレッドを止めない）
+	Drop,
+
+	// 空くまで待つ
+	Block
+};
+
+// ログの重さ
+enum class LogSeverity
+{
+	// 普通のログ（いっぱいのときはfullPolicyに従う）
+	Info,
+
+	// エラー（止まる前の手がかりなので、Dropでも捨てずに空くまで待つ）
+	Error
+};
+
+// 1つのログ（書き込むスレッドと、ファイルに書くスレッドの受け渡しに使う）
+typedef struct alignas(64) LogRecord
+{
+	// 書き込めるか、読めるかを表す番号
+	std::atomic<uint64_t> sequence;
+
+	// inlineTextに入らなかったときの文字列（ファイルに書くスレッドが解放する）
+	char* heapText;
+
+	// 文字数
+	uint32_t length;
+
+	// 文字列（終端の0も入れる）
+	char inlineText[kLogRecordSize - sizeof(std::atomic<uint64_t>) - sizeof(char*) - sizeof(uint32_t)];
+}LogRecord;
+
+// AsyncLoggerの設定
+typedef struct AsyncLoggerSettings
+{
+	// リングに入るログの数（2のべき乗に切り上げる）
+	uint32_t capacity;
+
+	// リングがいっぱいのときにどうするか
+	LogFullPolicy fullPolicy;
+
+	// ファイルに書いてからflushするまでの最長の時間と、溜まった量
+	double flushIntervalMilliseconds;
+	size_t flushBytes;
+
+	// デバッガの出力にも出すか（Windowsのみ）
+	bool isDebugOutput;
+}AsyncLoggerSettings;
+
+/*
+	ログを呼んだスレッドではファイルに書かず、ロックのないリングに入れるだけにする
+	別のスレッドがまとめてファイルに書き、設定した間隔か量ごとにflushする
+*/
+typedef struct AsyncLogger
+{
+	// リング
+	std::unique_ptr<LogRecord[]> records;
+	uint64_t mask;
+
+	// 次に書き込む位置（書き込むスレッドが取り合う）
+	alignas(64) std::atomic<uint64_t> enqueuePosition;
+
+	// 次に読む位置（ファイルに書くスレッドだけが使う）
+	alignas(64) uint64_t dequeuePosition;
+
+	// ここまでflushした位置と、ここまでflushしてほしい位置
+	std::atomic<uint64_t> flushedPosition;
+	std::atomic<uint64_t> flushRequestPosition;
+
+	// 書き込み先
+	std::ostream* output;
+
+	// 設定
+	AsyncLoggerSettings settings;
+
+	// ファイルに書くスレッド
+	std::atomic<bool> isRunning;
+	std::thread writer;
+
+	// 捨てた数、書いた数、flushした回数
+	std::atomic<uint64_t> droppedCount;
+	std::atomic<uint64_t> writtenCount;
+	std::atomic<uint64_t> flushCount;
+}AsyncLogger;
+
+/// <summary>
+/// 既定の設定を作る（4096個、いっぱいなら捨てる、100msか64KBごとにflush）
+/// </summary>
+/// <returns>AsyncLoggerSettings</returns>
+AsyncLoggerSettings MakeAsyncLoggerSettings();
+
+/// <summary>
+/// AsyncLoggerを作り、ファイルに書くスレッドを始める
+/// </summary>
+/// <param name="output">書き込み先（ReleaseAsyncLoggerまでは、このスレッド以外から書かない）</param>
+/// <param name="settings">設定</param>
+/// <returns>AsyncLogger</returns>
+AsyncLogger* CreateAsyncLogger(std::ostream& output, const AsyncLoggerSettings& settings);
+
+/// <summary>
+/// ログをリングに入れる（待たずに戻る。Blockか、Errorのログなら、いっぱいのときだけ待つ）
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+/// <param name="message">文字列</param>
+/// <param name="severity">重さ</param>
+/// <returns>入れられたか（Dropでいっぱいなら、Infoのログはfalse）</returns>
+bool PushLog(AsyncLogger* logger, std::string_view message, LogSeverity severity);
+
+/// <summary>
+/// ここまでに入れたログが、ファイルに書かれてflushされるまで待つ
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+void FlushAsyncLogger(AsyncLogger* logger);
+
+/// <summary>
+/// 作られている全てのAsyncLoggerを、待てるだけflushする（止まる直前に、例外のハンドラなどから呼ぶ）
+/// </summary>
+/// <param name="timeoutMilliseconds">1つのAsyncLoggerを待つ最長の時間</param>
+/// <returns>全て書けたか（書くスレッド自身から呼ばれた、時間切れならfalse）</returns>
+bool FlushAllAsyncLoggers(double timeoutMilliseconds);
+
+/// <summary>
+/// ストリームにAsyncLoggerを結び付ける（Logに渡すと、そのストリームにはAsyncLoggerを通して書く）
+/// </summary>
+/// <param name="stream">ストリーム</param>
+/// <param name="logger">AsyncLogger（nullptrなら外す）</param>
+void AttachAsyncLogger(std::ostream& stream, AsyncLogger* logger);
+
+/// <summary>
+/// ストリームに結び付いたAsyncLoggerを取得する
+/// </summary>
+/// <param name="stream">ストリーム</param>
+/// <returns>AsyncLogger（なければnullptr）</returns>
+AsyncLogger* GetAttachedAsyncLogger(std::ostream& stream);
+
+/// <summary>
+/// 残ったログを全て書いてから、AsyncLoggerを解放する（ログを出すスレッドが全て終わってから呼ぶ）
+/// </summary>
+/// <param name="logger">AsyncLogger</param>
+void ReleaseAsyncLogger(AsyncLogger* logger);
@@ -0,0 +1,99 @@
+#include "BindlessBuffer.h"
+#include "../Create/Create.h"
+#include "../Barrier/Barrier.h"
+#include <cstring>
+
+/// <summary>
+/// BindlessBufferを作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="heapAllocator">SRVを置くDescriptorHeap</param>
+/// <param name="elementSize">要素1つの大きさ</param>
+/// <param name="capacity">最大の要素数</param>
+/// <returns>BindlessBuffer</returns>
+BindlessBuffer CreateBindlessBuffer(ID3D12Device* device, DescriptorHeapAllocator& heapAllocator, uint32_t elementSize, uint32_t capacity)
+{
+	// BindlessBuffer
+	BindlessBuffer buffer{};
+	buffer.table = MakeBindlessTable(elementSize, capacity);
+
+	// GPU専用のバッファ
+	buffer.resource = CreateBufferResource(device, static_cast<size_t>(elementSize) * capacity, D3D12_HEAP_TYPE_DEFAULT);
+	assert(buffer.resource != nullptr);
+
+	// SRV
+	buffer.descriptor = AllocatePersistentDescriptors(heapAllocator.allocator, 1);
+	assert(buffer.descriptor.count == 1);
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Buffer.FirstElement = 0;
+	srvDesc.Buffer.NumElements = capacity;
+	srvDesc.Buffer.StructureByteStride = elementSize;
+	srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+
+	device->CreateShaderResourceView(buffer.resource, &srvDesc, GetDescriptorCPUHandle(heapAllocator, buffer.descriptor.start));
+
+	return buffer;
+}
+
+/// <summary>
+/// 書き換えられた範囲だけをGPUにコピーするコマンドを積む（描画より前に実行されるcommandListに積む）
+/// </summary>
+/// <param name="buffer">BindlessBuffer</param>
+/// <param name="uploadRing">コピー元を切り出すリングバッファ</param>
+/// <param name="uploadResource">リングバッファのResource</param>
+/// <param name="commandList"></param>
+/// <returns>コピーしたバイト数</returns>
+size_t UploadBindlessBuffer(BindlessBuffer& buffer, UploadRingBuffer& uploadRing, ID3D12Resource* uploadResource, ID3D12GraphicsCommandList* commandList)
+{
+	// 少しの隙間なら、まとめて1回でコピーする
+	const uint32_t kMergeGap = 4;
+	CollectBindlessDirtyRanges(buffer.table, kMergeGap, buffer.dirtyRanges);
+
+	if (buffer.dirtyRanges.empty())
+	{
+		return 0;
+	}
+
+	// バッファは実行のたびにCOMMONに戻るので、COMMON -> コピー先 -> シェーダーから読む の順に変える
+	TransitionBarrier(buffer.resource, commandList, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST);
+
+	// コピーしたバイト数
+	size_t uploadedSize = 0;
+
+	for (const BindlessDirtyRange& range : buffer.dirtyRanges)
+	{
+		size_t offset = static_cast<size_t>(range.firstSlot) * buffer.table.elementSize;
+		size_t size = static_cast<size_t>(range.slotCount) * buffer.table.elementSize;
+
+		UploadAllocation allocation = AllocateUploadRingBuffer(uploadRing, size, 16);
+		assert(allocation.cpuAddress != nullptr);
+
+		std::memcpy(allocation.cpuAddress, buffer.table.data.data() + offset, size);
+		commandList->CopyBufferRegion(buffer.resource, offset, uploadResource, allocation.offset, size);
+
+		uploadedSize += size;
+	}
+
+	TransitionBarrier(buffer.resource, commandList, D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+	return uploadedSize;
+}
+
+/// <summary>
+/// BindlessBufferを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="buffer">BindlessBuffer</param>
+/// <param name="heapAllocator">SRVを置いたDescriptorHeap</param>
+void ReleaseBindlessBuffer(BindlessBuffer& buffer, DescriptorHeapAllocator& heapAllocator)
+{
+	FreePersistentDescriptors(heapAllocator.allocator, buffer.descriptor);
+	buffer.descriptor = DescriptorRange{};
+
+	buffer.resource->Release();
+	buffer.resource = nullptr;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cassert>
+#include <vector>
+#include <d3d12.h>
+#include "../BindlessTable/BindlessTable.h"
+#include "../DescriptorHeapAllocator/DescriptorHeapAllocator.h"
+#include "../UploadRingBuffer/UploadRingBuffer.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	BindlessTableの中身をdefaultHeapのStructuredBufferに置く
+	SRVはシェーダーから見えるDescriptorHeapの常駐領域に1つ作り、シェーダーはその番号で読む
+*/
+typedef struct BindlessBuffer
+{
+	// CPU側の表
+	BindlessTable table;
+
+	// GPU側のバッファ（capacity分）
+	ID3D12Resource* resource;
+
+	// SRV
+	DescriptorRange descriptor;
+
+	// 作業用の配列（確保し直さないように使い回す）
+	std::vector<BindlessDirtyRange> dirtyRanges;
+}BindlessBuffer;
+
+/// <summary>
+/// BindlessBufferを作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="heapAllocator">SRVを置くDescriptorHeap</param>
+/// <param name="elementSize">要素1つの大きさ</param>
+/// <param name="capacity">最大の要素数</param>
+/// <returns>BindlessBuffer</returns>
+BindlessBuffer CreateBindlessBuffer(ID3D12Device* device, DescriptorHeapAllocator& heapAllocator, uint32_t elementSize, uint32_t capacity);
+
+/// <summary>
+/// 書き換えられた範囲だけをGPUにコピーするコマンドを積む（描画より前に実行されるcommandListに積む）
+/// </summary>
+/// <param name="buffer">BindlessBuffer</param>
+/// <param name="uploadRing">コピー元を切り出すリングバッファ</param>
+/// <param name="uploadResource">リングバッファのResource</param>
+/// <param name="commandList"></param>
+/// <returns>コピーしたバイト数</returns>
+size_t UploadBindlessBuffer(BindlessBuffer& buffer, UploadRingBuffer& uploadRing, ID3D12Resource* uploadResource, ID3D12GraphicsCommandList* commandList);
+
+/// <summary>
+/// BindlessBufferを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="buffer">BindlessBuffer</param>
+/// <param name="heapAllocator">SRVを置いたDescriptorHeap</param>
+void ReleaseBindlessBuffer(BindlessBuffer& buffer, DescriptorHeapAllocator& heapAllocator);
@@ -0,0 +1,222 @@
+#include "BindlessTable.h"
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+	/// <summary>
+	/// スロットを書き換えたことを記録する
+	/// </summary>
+	void MarkBindlessDirty(BindlessTable& table, uint32_t slot)
+	{
+		table.dirtyBits[slot / 64] |= (1ull << (slot % 64));
+	}
+}
+
+/// <summary>
+/// BindlessTableを作る
+/// </summary>
+/// <param name="elementSize">要素1つの大きさ</param>
+/// <param name="capacity">最大の要素数</param>
+/// <returns>BindlessTable</returns>
+BindlessTable MakeBindlessTable(uint32_t elementSize, uint32_t capacity)
+{
+	assert(elementSize > 0);
+	assert(capacity > 0);
+
+	// BindlessTable
+	BindlessTable table{};
+	table.elementSize = elementSize;
+	table.capacity = capacity;
+	table.data.resize(static_cast<size_t>(elementSize) * capacity);
+	table.isUsed.resize(capacity, false);
+	table.dirtyBits.resize((capacity + 63) / 64, 0);
+
+	return table;
+}
+
+/// <summary>
+/// スロットを確保する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <returns>スロット番号（いっぱいならkBindlessInvalidSlot）</returns>
+uint32_t AllocateBindlessSlot(BindlessTable& table)
+{
+	// スロット番号
+	uint32_t slot = kBindlessInvalidSlot;
+
+	if (!table.freeSlots.empty())
+	{
+		slot = table.freeSlots.top();
+		table.freeSlots.pop();
+	}
+	else if (table.highWater < table.capacity)
+	{
+		slot = table.highWater++;
+	}
+	else
+	{
+		return kBindlessInvalidSlot;
+	}
+
+	assert(!table.isUsed[slot]);
+	table.isUsed[slot] = true;
+	table.usedCount++;
+
+	return slot;
+}
+
+/// <summary>
+/// スロットを解放する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+void FreeBindlessSlot(BindlessTable& table, uint32_t slot)
+{
+	assert(slot < table.highWater);
+	assert(table.isUsed[slot]);
+
+	table.isUsed[slot] = false;
+	table.usedCount--;
+	table.freeSlots.push(slot);
+}
+
+/// <summary>
+/// スロットに書き込み、書き換えたことを記録する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+/// <param name="element">要素（elementSizeバイト）</param>
+void WriteBindlessSlot(BindlessTable& table, uint32_t slot, const void* element)
+{
+	assert(slot < table.highWater);
+	assert(table.isUsed[slot]);
+
+	std::memcpy(table.data.data() + static_cast<size_t>(slot) * table.elementSize, element, table.elementSize);
+	MarkBindlessDirty(table, slot);
+}
+
+/// <summary>
+/// スロットのデータを取得する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+/// <returns>データの先頭</returns>
+const void* GetBindlessSlotData(const BindlessTable& table, uint32_t slot)
+{
+	assert(slot < table.capacity);
+
+	return table.data.data() + static_cast<size_t>(slot) * table.elementSize;
+}
+
+/// <summary>
+/// 書き換えられた範囲を取り出し、記録を消す
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="mergeGap">この数以下のスロットしか空いていない範囲はつなげる（送る回数を減らす）</param>
+/// <param name="ranges">範囲（小さいスロットの順）</param>
+void CollectBindlessDirtyRanges(BindlessTable& table, uint32_t mergeGap, std::vector<BindlessDirtyRange>& ranges)
+{
+	ranges.clear();
+
+	uint32_t wordCount = (table.highWater + 63) / 64;
+
+	for (uint32_t wordIndex = 0; wordIndex < wordCount; wordIndex++)
+	{
+		uint64_t word = table.dirtyBits[wordIndex];
+		table.dirtyBits[wordIndex] = 0;
+
+		// 立っているビットを下から順に取り出す
+		while (word != 0)
+		{
+			uint32_t slot = wordIndex * 64 + static_cast<uint32_t>(std::countr_zero(word));
+			word &= word - 1;
+
+			// 前の範囲に近ければつなげる
+			if (!ranges.empty())
+			{
+				BindlessDirtyRange& last = ranges.back();
+				uint32_t lastEnd = last.firstSlot + last.slotCount;
+
+				if (slot - lastEnd <= mergeGap)
+				{
+					last.slotCount = slot - last.firstSlot + 1;
+					continue;
+				}
+			}
+
+			ranges.push_back(BindlessDirtyRange{ slot , 1 });
+		}
+	}
+}
+
+/// <summary>
+/// 使っている範囲の後ろのスロットを前の空きに移し、使っているスロットを先頭に詰める
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="moves">移動したスロット（呼び出し側はこれでスロット番号を付け替える）</param>
+void CompactBindlessTable(BindlessTable& table, std::vector<BindlessSlotMove>& moves)
+{
+	moves.clear();
+
+	if (table.usedCount == table.highWater)
+	{
+		return;
+	}
+
+	// 前から空きを、後ろから使っているスロットを探して移す
+	uint32_t hole = 0;
+	uint32_t used = table.highWater;
+
+	while (true)
+	{
+		while (hole < table.highWater && table.isUsed[hole])
+		{
+			hole++;
+		}
+
+		do
+		{
+			used--;
+		} while (used > hole && !table.isUsed[used]);
+
+		if (used <= hole)
+		{
+			break;
+		}
+
+		std::memcpy(table.data.data() + static_cast<size_t>(hole) * table.elementSize,
+			table.data.data() + static_cast<size_t>(used) * table.elementSize, table.elementSize);
+
+		table.isUsed[hole] = true;
+		table.isUsed[used] = false;
+		MarkBindlessDirty(table, hole);
+
+		moves.push_back(BindlessSlotMove{ used , hole });
+	}
+
+	// 使っているスロットは先頭に並んだので、空きの記録は要らない
+	for (uint32_t slot = table.usedCount; slot < table.highWater; slot++)
+	{
+		table.dirtyBits[slot / 64] &= ~(1ull << (slot % 64));
+	}
+
+	table.highWater = table.usedCount;
+	table.freeSlots = {};
+}
+
+/// <summary>
+/// 空きの割合を求める（詰めるかどうかの判断に使う）
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <returns>使ったことのある範囲のうち、空いている割合（0 〜 1）</returns>
+float GetBindlessFragmentation(const BindlessTable& table)
+{
+	if (table.highWater == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(table.highWater - table.usedCount) / static_cast<float>(table.highWater);
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// 確保できなかったときのスロット番号
+const uint32_t kBindlessInvalidSlot = UINT32_MAX;
+
+// 書き換えられた連続したスロット
+typedef struct BindlessDirtyRange
+{
+	// 先頭のスロット
+	uint32_t firstSlot;
+
+	// スロットの数
+	uint32_t slotCount;
+}BindlessDirtyRange;
+
+// 詰めたときに移動したスロット
+typedef struct BindlessSlotMove
+{
+	uint32_t from;
+	uint32_t to;
+}BindlessSlotMove;
+
+/*
+	GPUの大きなバッファに置く、同じ大きさの要素の表をCPU側で管理する
+	シェーダーはスロット番号で要素を読むので、書き換えた範囲だけをGPUに送ればよい
+*/
+typedef struct BindlessTable
+{
+	// 要素1つの大きさ
+	uint32_t elementSize;
+
+	// 最大の要素数
+	uint32_t capacity;
+
+	// 要素のデータ（capacity * elementSize）
+	std::vector<uint8_t> data;
+
+	// 使っているか
+	std::vector<bool> isUsed;
+
+	// 解放されたスロット（小さい番号から使い、使う範囲を短く保つ）
+	std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> freeSlots;
+
+	// 使ったことのある範囲の終わり（GPUに置く要素数）
+	uint32_t highWater;
+
+	// 使っているスロットの数
+	uint32_t usedCount;
+
+	// 書き換えられたか（1bitが1スロット）
+	std::vector<uint64_t> dirtyBits;
+}BindlessTable;
+
+/// <summary>
+/// BindlessTableを作る
+/// </summary>
+/// <param name="elementSize">要素1つの大きさ</param>
+/// <param name="capacity">最大の要素数</param>
+/// <returns>BindlessTable</returns>
+BindlessTable MakeBindlessTable(uint32_t elementSize, uint32_t capacity);
+
+/// <summary>
+/// スロットを確保する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <returns>スロット番号（いっぱいならkBindlessInvalidSlot）</returns>
+uint32_t AllocateBindlessSlot(BindlessTable& table);
+
+/// <summary>
+/// スロットを解放する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+void FreeBindlessSlot(BindlessTable& table, uint32_t slot);
+
+/// <summary>
+/// スロットに書き込み、書き換えたことを記録する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+/// <param name="element">要素（elementSizeバイト）</param>
+void WriteBindlessSlot(BindlessTable& table, uint32_t slot, const void* element);
+
+/// <summary>
+/// スロットのデータを取得する
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="slot">スロット番号</param>
+/// <returns>データの先頭</returns>
+const void* GetBindlessSlotData(const BindlessTable& table, uint32_t slot);
+
+/// <summary>
+/// 書き換えられた範囲を取り出し、記録を消す
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="mergeGap">この数以下のスロットしか空いていない範囲はつなげる（送る回数を減らす）</param>
+/// <param name="ranges">範囲（小さいスロットの順）</param>
+void CollectBindlessDirtyRanges(BindlessTable& table, uint32_t mergeGap, std::vector<BindlessDirtyRange>& ranges);
+
+/// <summary>
+/// 使っている範囲の後ろのスロットを前の空きに移し、使っているスロットを先頭に詰める
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <param name="moves">移動したスロット（呼び出し側はこれでスロット番号を付け替える）</param>
+void CompactBindlessTable(BindlessTable& table, std::vector<BindlessSlotMove>& moves);
+
+/// <summary>
+/// 空きの割合を求める（詰めるかどうかの判断に使う）
+/// </summary>
+/// <param name="table">BindlessTable</param>
+/// <returns>使ったことのある範囲のうち、空いている割合（0 〜 1）</returns>
+float GetBindlessFragmentation(const BindlessTable& table);
@@ -4,11 +4,13 @@
 /// commandQueueを生成し取得する
 /// </summary>
 /// <param name="device"></param>
+/// <param name="type">コマンドの種類（コピー専用のキューならCOPY）</param>
 /// <returns></returns>
-ID3D12CommandQueue* CreateCommandQueue(ID3D12Device* device)
+ID3D12CommandQueue* CreateCommandQueue(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type)
 {
 	ID3D12CommandQueue* commandQueue = nullptr;
 	D3D12_COMMAND_QUEUE_DESC commandQueueDesc{};
+	commandQueueDesc.Type = type;
 
 	HRESULT hr = device->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(&commandQueue));
 	assert(SUCCEEDED(hr));
@@ -20,12 +22,13 @@ ID3D12CommandQueue* CreateCommandQueue(ID3D12Device* device)
 /// commandAllocatorを生成し取得する
 /// </summary>
 /// <param name="device"></param>
+/// <param name="type">コマンドの種類（使うキューと合わせる）</param>
 /// <returns></returns>
-ID3D12CommandAllocator* CreateCommandAllocator(ID3D12Device* device)
+ID3D12CommandAllocator* CreateCommandAllocator(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type)
 {
 	ID3D12CommandAllocator* commandAllocator = nullptr;
 
-	HRESULT hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
+	HRESULT hr = device->CreateCommandAllocator(type, IID_PPV_ARGS(&commandAllocator));
 
 	assert(SUCCEEDED(hr));
 
@@ -37,12 +40,13 @@ ID3D12CommandAllocator* CreateCommandAllocator(ID3D12Device* device)
 /// </summary>
 /// <param name="device"></param>
 /// <param name="commandAllocator"></param>
+/// <param name="type">コマンドの種類（使うキューと合わせる）</param>
 /// <returns></returns>
-ID3D12GraphicsCommandList* CreateCommandList(ID3D12Device* device, ID3D12CommandAllocator* commandAllocator)
+ID3D12GraphicsCommandList* CreateCommandList(ID3D12Device* device, ID3D12CommandAllocator* commandAllocator, D3D12_COMMAND_LIST_TYPE type)
 {
 	ID3D12GraphicsCommandList* commandList = nullptr;
 
-	HRESULT hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator, nullptr, IID_PPV_ARGS(&commandList));
+	HRESULT hr = device->CreateCommandList(0, type, commandAllocator, nullptr, IID_PPV_ARGS(&commandList));
 
 	assert(SUCCEEDED(hr));
 
@@ -83,13 +87,13 @@ ID3D12DescriptorHeap* CreateDescriptorHeap
 /// <param name="device"></param>
 /// <param name="sizeInBytes"></param>
 /// <returns></returns>
-ID3D12Resource* CreateBufferResource(ID3D12Device* device, size_t sizeInBytes)
+ID3D12Resource* CreateBufferResource(ID3D12Device* device, size_t sizeInBytes, D3D12_HEAP_TYPE heapType)
 {
 	// 頂点リソース用のヒープ設定
 	D3D12_HEAP_PROPERTIES uploadHeapProperties{};
 
-	// uploadHeapを使う
-	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+	// 指定されたヒープを使う（省略したときはuploadHeap）
+	uploadHeapProperties.Type = heapType;
 
 
 	// 頂点リソースの設定
@@ -108,10 +112,13 @@ ID3D12Resource* CreateBufferResource(ID3D12Device* device, size_t sizeInBytes)
 	// バッファの場合は、これにする決まり
 	vertexResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 
+	// uploadHeapはGENERIC_READで作る決まり。defaultHeapはCOMMONで作り、コピーや描画のときに暗黙に遷移させる
+	D3D12_RESOURCE_STATES initialState = (heapType == D3D12_HEAP_TYPE_UPLOAD) ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON;
+
 	// 実際に頂点リソースを作る
 	ID3D12Resource* resource = nullptr;
 	HRESULT hr = device->CreateCommittedResource(&uploadHeapProperties, D3D12_HEAP_FLAG_NONE,
-		&vertexResourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource));
+		&vertexResourceDesc, initialState, nullptr, IID_PPV_ARGS(&resource));
 
 	assert(SUCCEEDED(hr));
 
@@ -15,23 +15,26 @@
 /// commandQueueを生成し取得する
 /// </summary>
 /// <param name="device"></param>
+/// <param name="type">コマンドの種類（コピー専用のキューならCOPY）</param>
 /// <returns></returns>
-ID3D12CommandQueue* CreateCommandQueue(ID3D12Device* device);
+ID3D12CommandQueue* CreateCommandQueue(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
 
 /// <summary>
 /// commandAllocatorを生成し取得する
 /// </summary>
 /// <param name="device"></param>
+/// <param name="type">コマンドの種類（使うキューと合わせる）</param>
 /// <returns></returns>
-ID3D12CommandAllocator* CreateCommandAllocator(ID3D12Device* device);
+ID3D12CommandAllocator* CreateCommandAllocator(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
 
 /// <summary>
 /// commandListを生成し取得する
 /// </summary>
 /// <param name="device"></param>
 /// <param name="commandAllocator"></param>
+/// <param name="type">コマンドの種類（使うキューと合わせる）</param>
 /// <returns></returns>
-ID3D12GraphicsCommandList* CreateCommandList(ID3D12Device* device, ID3D12CommandAllocator* commandAllocator);
+ID3D12GraphicsCommandList* CreateCommandList(ID3D12Device* device, ID3D12CommandAllocator* commandAllocator, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
 
 
 /// <summary>
@@ -50,5 +53,6 @@ ID3D12DescriptorHeap* CreateDescriptorHeap
 /// </summary>
 /// <param name="device"></param>
 /// <param name="sizeInBytes"></param>
+/// <param name="heapType">ヒープの種類（UPLOADはCPUから書き込む用、DEFAULTはGPU専用）</param>
 /// <returns></returns>
-ID3D12Resource* CreateBufferResource(ID3D12Device* device, size_t sizeInBytes);
\ No newline at end of file
+ID3D12Resource* CreateBufferResource(ID3D12Device* device, size_t sizeInBytes, D3D12_HEAP_TYPE heapType = D3D12_HEAP_TYPE_UPLOAD);
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "Culling.h"
+#include <cassert>
+#include <cmath>
+#include "../Simd/Simd.h"
+#include "../Vector/Vector.h"
+
+namespace
+{
+	/// <summary>
+	/// 平面の式 (a, b, c, d) を法線が単位ベクトルになるように正規化して平面にする
+	/// </summary>
+	/// <returns>平面</returns>
+	Plane MakeNormalizedPlane(float a, float b, float c, float d)
+	{
+		float inverseLength = 1.0f / std::sqrt(a * a + b * b + c * c);
+		return Plane{ Vector3{ a * inverseLength , b * inverseLength , c * inverseLength } , d * inverseLength };
+	}
+
+	/// <summary>
+	/// 平面から点までの符号付き距離を求める（表側が正）
+	/// </summary>
+	float SignedDistance(const Plane& plane, const Vector3& point)
+	{
+		return Dot(plane.normal, point) + plane.distance;
+	}
+}
+
+/// <summary>
+/// ビュープロジェクション行列から視錐台の6平面を取り出す
+/// </summary>
+/// <param name="viewProjectionMatrix">ビュープロジェクション行列（MakePerspectiveFovMatrixのように深度が[0,1]のもの）</param>
+/// <returns>ワールド空間の視錐台（法線は正規化済み）</returns>
+Frustum MakeFrustum(const Matrix4x4& viewProjectionMatrix)
+{
+	const Matrix4x4& m = viewProjectionMatrix;
+
+	// 行ベクトルなので、クリップ座標の各成分は行列の列との内積になる
+	// -w <= x <= w , -w <= y <= w , 0 <= z <= w の各不等式が1つの平面になる
+	Frustum frustum{};
+	frustum.planes[0] = MakeNormalizedPlane(m.m[0][3] + m.m[0][0], m.m[1][3] + m.m[1][0], m.m[2][3] + m.m[2][0], m.m[3][3] + m.m[3][0]);
+	frustum.planes[1] = MakeNormalizedPlane(m.m[0][3] - m.m[0][0], m.m[1][3] - m.m[1][0], m.m[2][3] - m.m[2][0], m.m[3][3] - m.m[3][0]);
+	frustum.planes[2] = MakeNormalizedPlane(m.m[0][3] + m.m[0][1], m.m[1][3] + m.m[1][1], m.m[2][3] + m.m[2][1], m.m[3][3] + m.m[3][1]);
+	frustum.planes[3] = MakeNormalizedPlane(m.m[0][3] - m.m[0][1], m.m[1][3] - m.m[1][1], m.m[2][3] - m.m[2][1], m.m[3][3] - m.m[3][1]);
+	frustum.planes[4] = MakeNormalizedPlane(m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2]);
+	frustum.planes[5] = MakeNormalizedPlane(m.m[0][3] - m.m[0][2], m.m[1][3] - m.m[1][2], m.m[2][3] - m.m[2][2], m.m[3][3] - m.m[3][2]);
+
+	return frustum;
+}
+
+/// <summary>
+/// 球が視錐台の中に入っているか（一部でも入っていれば見えるとする）
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="sphere">球</param>
+/// <returns>見えるならtrue</returns>
+bool IsVisible(const Frustum& frustum, const Sphere& sphere)
+{
+	for (const Plane& plane : frustum.planes)
+	{
+		// 1枚でも完全に裏側にあれば見えない
+		if (SignedDistance(plane, sphere.center) < -sphere.radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// <summary>
+/// AABBが視錐台の中に入っているか（一部でも入っていれば見えるとする）
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="aabb">AABB</param>
+/// <returns>見えるならtrue</returns>
+bool IsVisible(const Frustum& frustum, const AABB& aabb)
+{
+	// 中心と半分の大きさ
+	Vector3 center = Multiply(0.5f, Add(aabb.min, aabb.max));
+	Vector3 extent = Multiply(0.5f, Subtract(aabb.max, aabb.min));
+
+	for (const Plane& plane : frustum.planes)
+	{
+		// 法線方向に一番出ている頂点までの距離
+		float radius = std::abs(plane.normal.x) * extent.x + std::abs(plane.normal.y) * extent.y + std::abs(plane.normal.z) * extent.z;
+
+		if (SignedDistance(plane, center) < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// <summary>
+/// 球をまとめてカリングし、見えるものの番号を詰めて書き込む
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="spheres">球</param>
+/// <param name="visibleIndices">見える球の番号の出力先（spheresと同じ数が必要）</param>
+/// <returns>見える球の数</returns>
+size_t CullSpheres(const Frustum& frustum, std::span<const Sphere> spheres, std::span<uint32_t> visibleIndices)
+{
+	assert(visibleIndices.size() >= spheres.size());
+
+	// 見える数
+	size_t visibleCount = 0;
+
+	size_t i = 0;
+
+#if defined(MATH_SIMD)
+
+	static_assert(sizeof(Sphere) == sizeof(float) * 4, "Sphere must be tightly packed");
+
+	// 4つずつSoAに並べ替え、全平面との距離 + 半径 の最小値が負なら見えない
+	for (; i + 4 <= spheres.size(); i += 4)
+	{
+		const float* source = &spheres[i].center.x;
+		SimdFloat4 s0 = SimdLoad(source + 0);
+		SimdFloat4 s1 = SimdLoad(source + 4);
+		SimdFloat4 s2 = SimdLoad(source + 8);
+		SimdFloat4 s3 = SimdLoad(source + 12);
+
+		// 4x4の転置
+		SimdFloat4 t0 = SimdShuffle<0, 1, 0, 1>(s0, s1);
+		SimdFloat4 t1 = SimdShuffle<2, 3, 2, 3>(s0, s1);
+		SimdFloat4 t2 = SimdShuffle<0, 1, 0, 1>(s2, s3);
+		SimdFloat4 t3 = SimdShuffle<2, 3, 2, 3>(s2, s3);
+		SimdFloat4 x = SimdShuffle<0, 2, 0, 2>(t0, t2);
+		SimdFloat4 y = SimdShuffle<1, 3, 1, 3>(t0, t2);
+		SimdFloat4 z = SimdShuffle<0, 2, 0, 2>(t1, t3);
+		SimdFloat4 radius = SimdShuffle<1, 3, 1, 3>(t1, t3);
+
+		SimdFloat4 minDistance = SimdSplat(INFINITY);
+
+		for (const Plane& plane : frustum.planes)
+		{
+			SimdFloat4 distance = SimdMulAdd(x, SimdSplat(plane.normal.x), SimdAdd(radius, SimdSplat(plane.distance)));
+			distance = SimdMulAdd(y, SimdSplat(plane.normal.y), distance);
+			distance = SimdMulAdd(z, SimdSplat(plane.normal.z), distance);
+			minDistance = SimdMin(minDistance, distance);
+		}
+
+		// 見えるものだけ出力が進むように、番号は毎回書き込む
+		int culledMask = SimdMaskLess(minDistance, SimdSplat(0.0f));
+
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			visibleIndices[visibleCount] = static_cast<uint32_t>(i) + lane;
+			visibleCount += ((culledMask >> lane) & 1) ^ 1;
+		}
+	}
+
+#endif
+
+	for (; i < spheres.size(); i++)
+	{
+		if (IsVisible(frustum, spheres[i]))
+		{
+			visibleIndices[visibleCount] = static_cast<uint32_t>(i);
+			visibleCount++;
+		}
+	}
+
+	return visibleCount;
+}
+
+/// <summary>
+/// AABBをまとめてカリングし、見えるものの番号を詰めて書き込む
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="aabbs">AABB</param>
+/// <param name="visibleIndices">見えるAABBの番号の出力先（aabbsと同じ数が必要）</param>
+/// <returns>見えるAABBの数</returns>
+size_t CullAABBs(const Frustum& frustum, std::span<const AABB> aabbs, std::span<uint32_t> visibleIndices)
+{
+	assert(visibleIndices.size() >= aabbs.size());
+
+	// 見える数
+	size_t visibleCount = 0;
+
+	size_t i = 0;
+
+#if defined(MATH_SIMD)
+
+	static_assert(sizeof(AABB) == sizeof(Vector3) * 2, "AABB must be tightly packed");
+
+	// 4つずつSoAに並べ替え、中心と半分の大きさで判定する
+	for (; i + 4 <= aabbs.size(); i += 4)
+	{
+		// 最小点と最大点のVector3が交互に並んでいるので、8つのVector3として読み込んでから振り分ける
+		SimdFloat4 x01, y01, z01, x23, y23, z23;
+		SimdLoadVector3x4(&aabbs[i].min.x, x01, y01, z01);
+		SimdLoadVector3x4(&aabbs[i + 2].min.x, x23, y23, z23);
+
+		SimdFloat4 minX = SimdShuffle<0, 2, 0, 2>(x01, x23), maxX = SimdShuffle<1, 3, 1, 3>(x01, x23);
+		SimdFloat4 minY = SimdShuffle<0, 2, 0, 2>(y01, y23), maxY = SimdShuffle<1, 3, 1, 3>(y01, y23);
+		SimdFloat4 minZ = SimdShuffle<0, 2, 0, 2>(z01, z23), maxZ = SimdShuffle<1, 3, 1, 3>(z01, z23);
+
+		SimdFloat4 half = SimdSplat(0.5f);
+		SimdFloat4 centerX = SimdMul(SimdAdd(minX, maxX), half);
+		SimdFloat4 centerY = SimdMul(SimdAdd(minY, maxY), half);
+		SimdFloat4 centerZ = SimdMul(SimdAdd(minZ, maxZ), half);
+		SimdFloat4 extentX = SimdMul(SimdSub(maxX, minX), half);
+		SimdFloat4 extentY = SimdMul(SimdSub(maxY, minY), half);
+		SimdFloat4 extentZ = SimdMul(SimdSub(maxZ, minZ), half);
+
+		SimdFloat4 minDistance = SimdSplat(INFINITY);
+
+		for (const Plane& plane : frustum.planes)
+		{
+			// 中心までの距離 + 法線方向に一番出ている頂点までの距離
+			SimdFloat4 distance = SimdMulAdd(centerX, SimdSplat(plane.normal.x), SimdSplat(plane.distance));
+			distance = SimdMulAdd(centerY, SimdSplat(plane.normal.y), distance);
+			distance = SimdMulAdd(centerZ, SimdSplat(plane.normal.z), distance);
+			distance = SimdMulAdd(extentX, SimdSplat(std::abs(plane.normal.x)), distance);
+			distance = SimdMulAdd(extentY, SimdSplat(std::abs(plane.normal.y)), distance);
+			distance = SimdMulAdd(extentZ, SimdSplat(std::abs(plane.normal.z)), distance);
+			minDistance = SimdMin(minDistance, distance);
+		}
+
+		// 見えるものだけ出力が進むように、番号は毎回書き込む
+		int culledMask = SimdMaskLess(minDistance, SimdSplat(0.0f));
+
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			visibleIndices[visibleCount] = static_cast<uint32_t>(i) + lane;
+			visibleCount += ((culledMask >> lane) & 1) ^ 1;
+		}
+	}
+
+#endif
+
+	for (; i < aabbs.size(); i++)
+	{
+		if (IsVisible(frustum, aabbs[i]))
+		{
+			visibleIndices[visibleCount] = static_cast<uint32_t>(i);
+			visibleCount++;
+		}
+	}
+
+	return visibleCount;
+}
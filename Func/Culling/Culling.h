@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "../../Struct.h"
+
+/// <summary>
+/// ビュープロジェクション行列から視錐台の6平面を取り出す
+/// </summary>
+/// <param name="viewProjectionMatrix">ビュープロジェクション行列（MakePerspectiveFovMatrixのように深度が[0,1]のもの）</param>
+/// <returns>ワールド空間の視錐台（法線は正規化済み）</returns>
+Frustum MakeFrustum(const Matrix4x4& viewProjectionMatrix);
+
+/// <summary>
+/// 球が視錐台の中に入っているか（一部でも入っていれば見えるとする）
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="sphere">球</param>
+/// <returns>見えるならtrue</returns>
+bool IsVisible(const Frustum& frustum, const Sphere& sphere);
+
+/// <summary>
+/// AABBが視錐台の中に入っているか（一部でも入っていれば見えるとする）
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="aabb">AABB</param>
+/// <returns>見えるならtrue</returns>
+bool IsVisible(const Frustum& frustum, const AABB& aabb);
+
+/// <summary>
+/// 球をまとめてカリングし、見えるものの番号を詰めて書き込む
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="spheres">球</param>
+/// <param name="visibleIndices">見える球の番号の出力先（spheresと同じ数が必要）</param>
+/// <returns>見える球の数</returns>
+size_t CullSpheres(const Frustum& frustum, std::span<const Sphere> spheres, std::span<uint32_t> visibleIndices);
+
+/// <summary>
+/// AABBをまとめてカリングし、見えるものの番号を詰めて書き込む
+/// </summary>
+/// <param name="frustum">視錐台</param>
+/// <param name="aabbs">AABB</param>
+/// <param name="visibleIndices">見えるAABBの番号の出力先（aabbsと同じ数が必要）</param>
+/// <returns>見えるAABBの数</returns>
+size_t CullAABBs(const Frustum& frustum, std::span<const AABB> aabbs, std::span<uint32_t> visibleIndices);
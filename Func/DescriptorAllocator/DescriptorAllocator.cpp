@@ -0,0 +1,211 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+/// <summary>
+/// Descriptorの番号の管理を初期化する
+/// </summary>
+/// <param name="persistentCount">使い続ける領域の数</param>
+/// <param name="frameCount">フレームごとの領域の数</param>
+/// <returns>Descriptorの番号の管理</returns>
+DescriptorAllocator MakeDescriptorAllocator(uint32_t persistentCount, uint32_t frameCount)
+{
+	// Descriptorの番号の管理
+	DescriptorAllocator allocator{};
+	allocator.persistentCapacity = persistentCount;
+	allocator.frameStart = persistentCount;
+	allocator.frameCapacity = frameCount;
+	allocator.frameHead = 0;
+	allocator.frameTail = 0;
+
+	// 最初は全体が1つの空き
+	if (persistentCount > 0)
+	{
+		allocator.freeRanges.push_back(DescriptorRange{ 0 , persistentCount });
+	}
+
+	return allocator;
+}
+
+/// <summary>
+/// 解放するまで使い続けるDescriptorを連続で確保する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="count">数</param>
+/// <returns>確保した範囲（連続した空きがないときはcountが0）</returns>
+DescriptorRange AllocatePersistentDescriptors(DescriptorAllocator& allocator, uint32_t count)
+{
+	// 確保した範囲
+	DescriptorRange range{};
+
+	if (count == 0)
+	{
+		return range;
+	}
+
+	// 番号の小さい方から、入る空きを探す（後ろの大きな空きを残しておける）
+	for (size_t i = 0; i < allocator.freeRanges.size(); i++)
+	{
+		DescriptorRange& freeRange = allocator.freeRanges[i];
+
+		if (freeRange.count < count)
+		{
+			continue;
+		}
+
+		range.start = freeRange.start;
+		range.count = count;
+
+		// 空きの先頭から切り出す
+		freeRange.start += count;
+		freeRange.count -= count;
+
+		if (freeRange.count == 0)
+		{
+			allocator.freeRanges.erase(allocator.freeRanges.begin() + i);
+		}
+
+		break;
+	}
+
+	return range;
+}
+
+/// <summary>
+/// 使い続ける領域のDescriptorを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="range">AllocatePersistentDescriptorsで確保した範囲</param>
+void FreePersistentDescriptors(DescriptorAllocator& allocator, DescriptorRange range)
+{
+	if (range.count == 0)
+	{
+		return;
+	}
+
+	assert(range.start + range.count <= allocator.persistentCapacity);
+
+	// 番号順の挿入位置（rangeより後ろから始まる最初の空き）
+	auto next = std::upper_bound(allocator.freeRanges.begin(), allocator.freeRanges.end(), range.start,
+		[](uint32_t start, const DescriptorRange& freeRange) { return start < freeRange.start; });
+
+	// 空きと重なるなら二重解放
+	assert(next == allocator.freeRanges.end() || range.start + range.count <= next->start);
+	assert(next == allocator.freeRanges.begin() || std::prev(next)->start + std::prev(next)->count <= range.start);
+
+	// 前の空きとつながるなら結合する
+	if (next != allocator.freeRanges.begin() && std::prev(next)->start + std::prev(next)->count == range.start)
+	{
+		auto previous = std::prev(next);
+		previous->count += range.count;
+
+		// 後ろの空きともつながるなら、3つを1つにする
+		if (next != allocator.freeRanges.end() && previous->start + previous->count == next->start)
+		{
+			previous->count += next->count;
+			allocator.freeRanges.erase(next);
+		}
+
+		return;
+	}
+
+	// 後ろの空きとつながるなら結合する
+	if (next != allocator.freeRanges.end() && range.start + range.count == next->start)
+	{
+		next->start = range.start;
+		next->count += range.count;
+		return;
+	}
+
+	allocator.freeRanges.insert(next, range);
+}
+
+/// <summary>
+/// このフレームだけ使うDescriptorを連続で確保する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="count">数</param>
+/// <returns>確保した範囲（空きが足りないときはcountが0）</returns>
+DescriptorRange AllocateFrameDescriptors(DescriptorAllocator& allocator, uint32_t count)
+{
+	// 確保した範囲
+	DescriptorRange range{};
+
+	if (count == 0 || count > allocator.frameCapacity)
+	{
+		return range;
+	}
+
+	// GPUが使っている領域がなければ、途中で捨てる分が出ないように先頭から確保し直す
+	if (allocator.frames.empty() && allocator.frameTail == allocator.frameHead)
+	{
+		allocator.frameHead = 0;
+		allocator.frameTail = 0;
+	}
+
+	uint64_t begin = allocator.frameHead;
+
+	// DescriptorTableは連続している必要があるので、末尾をはみ出すなら残りは捨てて先頭から確保する
+	if (begin % allocator.frameCapacity + count > allocator.frameCapacity)
+	{
+		begin = (begin / allocator.frameCapacity + 1) * allocator.frameCapacity;
+	}
+
+	// GPUが使っている領域を上書きしてしまうなら確保できない
+	if (begin + count - allocator.frameTail > allocator.frameCapacity)
+	{
+		return range;
+	}
+
+	allocator.frameHead = begin + count;
+
+	range.start = allocator.frameStart + static_cast<uint32_t>(begin % allocator.frameCapacity);
+	range.count = count;
+
+	return range;
+}
+
+/// <summary>
+/// フレームの終わりに、ここまで確保したDescriptorをSignalの値と結びつける
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishDescriptorFrame(DescriptorAllocator& allocator, uint64_t fenceValue)
+{
+	// Signalの値は増え続ける
+	assert(allocator.frames.empty() || allocator.frames.back().fenceValue <= fenceValue);
+
+	allocator.frames.push_back(DescriptorFrame{ fenceValue , allocator.frameHead });
+}
+
+/// <summary>
+/// GPUが使い終わったフレームのDescriptorを回収する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+void ReclaimDescriptorFrames(DescriptorAllocator& allocator, uint64_t completedFenceValue)
+{
+	while (!allocator.frames.empty() && allocator.frames.front().fenceValue <= completedFenceValue)
+	{
+		allocator.frameTail = allocator.frames.front().head;
+		allocator.frames.pop_front();
+	}
+}
+
+/// <summary>
+/// 使い続ける領域の空きの数を求める
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <returns>空いているDescriptorの数（連続しているとは限らない）</returns>
+uint32_t GetFreePersistentDescriptorCount(const DescriptorAllocator& allocator)
+{
+	uint32_t freeCount = 0;
+
+	for (const DescriptorRange& freeRange : allocator.freeRanges)
+	{
+		freeCount += freeRange.count;
+	}
+
+	return freeCount;
+}
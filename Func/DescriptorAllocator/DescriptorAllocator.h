@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// 連続したDescriptorの範囲（確保できなかったときはcountが0）
+typedef struct DescriptorRange
+{
+	// 先頭の番号
+	uint32_t start;
+
+	// 数
+	uint32_t count;
+}DescriptorRange;
+
+// 使い終わるのを待っているフレーム
+typedef struct DescriptorFrame
+{
+	// このフレームのSignalの値
+	uint64_t fenceValue;
+
+	// このフレームの最後まで確保した位置
+	uint64_t head;
+}DescriptorFrame;
+
+/*
+	DescriptorHeapの番号を管理する
+	前半は解放されるまで使い続ける領域（空きリスト）、後半はフレームごとに使い捨てる領域（リング）
+	番号だけを扱うので、D3D12がなくても確保と回収を動かせる
+*/
+typedef struct DescriptorAllocator
+{
+	// 使い続ける領域の数（番号 0 〜 persistentCapacity - 1）
+	uint32_t persistentCapacity;
+
+	// 使い続ける領域の空き（先頭の番号順で、隣り合うものは結合しておく）
+	std::vector<DescriptorRange> freeRanges;
+
+	// フレームごとの領域の先頭の番号
+	uint32_t frameStart;
+
+	// フレームごとの領域の数
+	uint32_t frameCapacity;
+
+	// 次に確保する位置（折り返さず増え続ける通算の数）
+	uint64_t frameHead;
+
+	// GPUがまだ使っているかもしれない一番古い位置（通算の数）
+	uint64_t frameTail;
+
+	// 使い終わるのを待っているフレーム（古い順）
+	std::deque<DescriptorFrame> frames;
+}DescriptorAllocator;
+
+/// <summary>
+/// Descriptorの番号の管理を初期化する
+/// </summary>
+/// <param name="persistentCount">使い続ける領域の数</param>
+/// <param name="frameCount">フレームごとの領域の数</param>
+/// <returns>Descriptorの番号の管理</returns>
+DescriptorAllocator MakeDescriptorAllocator(uint32_t persistentCount, uint32_t frameCount);
+
+/// <summary>
+/// 解放するまで使い続けるDescriptorを連続で確保する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="count">数</param>
+/// <returns>確保した範囲（連続した空きがないときはcountが0）</returns>
+DescriptorRange AllocatePersistentDescriptors(DescriptorAllocator& allocator, uint32_t count);
+
+/// <summary>
+/// 使い続ける領域のDescriptorを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="range">AllocatePersistentDescriptorsで確保した範囲</param>
+void FreePersistentDescriptors(DescriptorAllocator& allocator, DescriptorRange range);
+
+/// <summary>
+/// このフレームだけ使うDescriptorを連続で確保する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="count">数</param>
+/// <returns>確保した範囲（空きが足りないときはcountが0）</returns>
+DescriptorRange AllocateFrameDescriptors(DescriptorAllocator& allocator, uint32_t count);
+
+/// <summary>
+/// フレームの終わりに、ここまで確保したDescriptorをSignalの値と結びつける
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishDescriptorFrame(DescriptorAllocator& allocator, uint64_t fenceValue);
+
+/// <summary>
+/// GPUが使い終わったフレームのDescriptorを回収する
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+void ReclaimDescriptorFrames(DescriptorAllocator& allocator, uint64_t completedFenceValue);
+
+/// <summary>
+/// 使い続ける領域の空きの数を求める
+/// </summary>
+/// <param name="allocator">Descriptorの番号の管理</param>
+/// <returns>空いているDescriptorの数（連続しているとは限らない）</returns>
+uint32_t GetFreePersistentDescriptorCount(const DescriptorAllocator& allocator);
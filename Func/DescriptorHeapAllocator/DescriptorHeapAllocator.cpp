@@ -0,0 +1,74 @@
+#include "DescriptorHeapAllocator.h"
+#include "../Create/Create.h"
+
+/// <summary>
+/// DescriptorHeapと番号の管理を作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="heapType">Heapの種類</param>
+/// <param name="persistentCount">解放するまで使い続ける領域の数</param>
+/// <param name="frameCount">フレームごとに使い捨てる領域の数</param>
+/// <param name="shaderVisible">シェーダーから見えるか</param>
+/// <returns>DescriptorHeapAllocator</returns>
+DescriptorHeapAllocator CreateDescriptorHeapAllocator
+(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType, uint32_t persistentCount, uint32_t frameCount, bool shaderVisible)
+{
+	// DescriptorHeapAllocator
+	DescriptorHeapAllocator heapAllocator{};
+
+	heapAllocator.heap = CreateDescriptorHeap(device, heapType, persistentCount + frameCount, shaderVisible);
+	heapAllocator.descriptorSize = device->GetDescriptorHandleIncrementSize(heapType);
+	heapAllocator.cpuStart = heapAllocator.heap->GetCPUDescriptorHandleForHeapStart();
+
+	if (shaderVisible)
+	{
+		heapAllocator.gpuStart = heapAllocator.heap->GetGPUDescriptorHandleForHeapStart();
+	}
+
+	heapAllocator.allocator = MakeDescriptorAllocator(persistentCount, frameCount);
+
+	return heapAllocator;
+}
+
+/// <summary>
+/// 番号からCPUのハンドルを求める
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+/// <param name="index">Descriptorの番号</param>
+/// <returns>CPUのハンドル</returns>
+D3D12_CPU_DESCRIPTOR_HANDLE GetDescriptorCPUHandle(const DescriptorHeapAllocator& heapAllocator, uint32_t index)
+{
+	assert(index < heapAllocator.allocator.persistentCapacity + heapAllocator.allocator.frameCapacity);
+
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = heapAllocator.cpuStart;
+	handle.ptr += static_cast<SIZE_T>(heapAllocator.descriptorSize) * index;
+
+	return handle;
+}
+
+/// <summary>
+/// 番号からGPUのハンドルを求める（シェーダーから見えるHeapのみ）
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+/// <param name="index">Descriptorの番号</param>
+/// <returns>GPUのハンドル</returns>
+D3D12_GPU_DESCRIPTOR_HANDLE GetDescriptorGPUHandle(const DescriptorHeapAllocator& heapAllocator, uint32_t index)
+{
+	assert(heapAllocator.gpuStart.ptr != 0);
+	assert(index < heapAllocator.allocator.persistentCapacity + heapAllocator.allocator.frameCapacity);
+
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = heapAllocator.gpuStart;
+	handle.ptr += static_cast<UINT64>(heapAllocator.descriptorSize) * index;
+
+	return handle;
+}
+
+/// <summary>
+/// DescriptorHeapを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+void ReleaseDescriptorHeapAllocator(DescriptorHeapAllocator& heapAllocator)
+{
+	heapAllocator.heap->Release();
+	heapAllocator.heap = nullptr;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cassert>
+#include <d3d12.h>
+#include "../DescriptorAllocator/DescriptorAllocator.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	DescriptorHeapと、その番号の管理をまとめたもの
+	番号からハンドルを求めるので、呼び出し側でオフセットを計算しなくてよい
+*/
+typedef struct DescriptorHeapAllocator
+{
+	// DescriptorHeap
+	ID3D12DescriptorHeap* heap;
+
+	// Descriptor1つの大きさ
+	uint32_t descriptorSize;
+
+	// 先頭のハンドル
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuStart;
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuStart;
+
+	// 番号の管理
+	DescriptorAllocator allocator;
+}DescriptorHeapAllocator;
+
+/// <summary>
+/// DescriptorHeapと番号の管理を作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="heapType">Heapの種類</param>
+/// <param name="persistentCount">解放するまで使い続ける領域の数</param>
+/// <param name="frameCount">フレームごとに使い捨てる領域の数</param>
+/// <param name="shaderVisible">シェーダーから見えるか</param>
+/// <returns>DescriptorHeapAllocator</returns>
+DescriptorHeapAllocator CreateDescriptorHeapAllocator
+(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE heapType, uint32_t persistentCount, uint32_t frameCount, bool shaderVisible);
+
+/// <summary>
+/// 番号からCPUのハンドルを求める
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+/// <param name="index">Descriptorの番号</param>
+/// <returns>CPUのハンドル</returns>
+D3D12_CPU_DESCRIPTOR_HANDLE GetDescriptorCPUHandle(const DescriptorHeapAllocator& heapAllocator, uint32_t index);
+
+/// <summary>
+/// 番号からGPUのハンドルを求める（シェーダーから見えるHeapのみ）
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+/// <param name="index">Descriptorの番号</param>
+/// <returns>GPUのハンドル</returns>
+D3D12_GPU_DESCRIPTOR_HANDLE GetDescriptorGPUHandle(const DescriptorHeapAllocator& heapAllocator, uint32_t index);
+
+/// <summary>
+/// DescriptorHeapを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="heapAllocator">DescriptorHeapAllocator</param>
+void ReleaseDescriptorHeapAllocator(DescriptorHeapAllocator& heapAllocator);
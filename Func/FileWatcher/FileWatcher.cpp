@@ -0,0 +1,417 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/// <summary>
+	/// 更新時刻を読む（ないときはisExistsをfalseにする）
+	/// </summary>
+	void ReadWriteTime(const std::filesystem::path& path, std::filesystem::file_time_type& lastWriteTime, bool& isExists)
+	{
+		std::error_code error;
+		lastWriteTime = std::filesystem::last_write_time(path, error);
+		isExists = !error;
+
+		if (error)
+		{
+			lastWriteTime = std::filesystem::file_time_type::min();
+		}
+	}
+
+	/// <summary>
+	/// 変更を記録する（同じパスは1つにまとめる）
+	/// </summary>
+	void AddChangedPath(std::vector<std::filesystem::path>& changedPaths, const std::filesystem::path& path)
+	{
+		if (std::find(changedPaths.begin(), changedPaths.end(), path) == changedPaths.end())
+		{
+			changedPaths.push_back(path);
+		}
+	}
+
+#ifdef __linux__
+	/// <summary>
+	/// たまったinotifyのイベントを全て読み、見張っているファイルのものを記録する
+	/// </summary>
+	void ReadNotifyEvents(FileWatcher& watcher, std::vector<std::filesystem::path>& changedPaths)
+	{
+		alignas(inotify_event) char buffer[4096];
+
+		while (true)
+		{
+			ssize_t length = read(watcher.notifyHandle, buffer, sizeof(buffer));
+			if (length <= 0)
+			{
+				// EAGAIN : もうない
+				return;
+			}
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+				offset += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// 知らせが多すぎて受け取れなかったので、inotifyで見ているファイルは全て書き換えられたものとする
+					for (WatchedFile& file : watcher.files)
+					{
+						if (file.watchHandle >= 0)
+						{
+							ReadWriteTime(file.path, file.lastWriteTime, file.isExists);
+							AddChangedPath(changedPaths, file.path);
+						}
+					}
+					continue;
+				}
+
+				if (event->len == 0)
+				{
+					continue;
+				}
+
+				std::filesystem::path name = event->name;
+				for (WatchedFile& file : watcher.files)
+				{
+					if (file.watchHandle == event->wd && file.path.filename() == name)
+					{
+						ReadWriteTime(file.path, file.lastWriteTime, file.isExists);
+						AddChangedPath(changedPaths, file.path);
+					}
+				}
+			}
+		}
+	}
+#endif
+
+#ifdef _WIN32
+	// 知らせてもらう変更（名前の付け替え、作成、削除と書き込み）
+	const DWORD kDirectoryNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+
+	/// <summary>
+	/// フォルダの次の変更の知らせを頼む（待たずに戻る）
+	/// </summary>
+	bool RequestDirectoryChanges(WatchedDirectory& directory)
+	{
+		directory.isReading = ReadDirectoryChangesW(directory.handle, directory.buffer, sizeof(directory.buffer), FALSE,
+			kDirectoryNotifyFilter, nullptr, &directory.overlapped, nullptr) != FALSE;
+
+		return directory.isReading;
+	}
+
+	/// <summary>
+	/// フォルダを開いて見張り始める（同じフォルダは同じ番号を返す）
+	/// </summary>
+	/// <returns>directoriesの番号（見張れなければ-1）</returns>
+	int OpenWatchedDirectory(FileWatcher& watcher, const std::filesystem::path& path)
+	{
+		std::error_code error;
+		std::filesystem::path directoryPath = std::filesystem::absolute(path, error).lexically_normal();
+		if (error)
+		{
+			return -1;
+		}
+
+		for (size_t i = 0; i < watcher.directories.size(); i++)
+		{
+			if (watcher.directories[i]->isReading && watcher.directories[i]->path == directoryPath)
+			{
+				return static_cast<int>(i);
+			}
+		}
+
+		// 見張っている間も、エディタがファイルを書き換えたり消したりできるように開く
+		HANDLE handle = CreateFileW(directoryPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (handle == INVALID_HANDLE_VALUE)
+		{
+			return -1;
+		}
+
+		// WatchedDirectory
+		std::unique_ptr<WatchedDirectory> directory = std::make_unique<WatchedDirectory>();
+		directory->path = directoryPath;
+		directory->handle = handle;
+		directory->overlapped = OVERLAPPED{};
+		directory->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+		if (directory->overlapped.hEvent == nullptr || !RequestDirectoryChanges(*directory))
+		{
+			if (directory->overlapped.hEvent)
+			{
+				CloseHandle(directory->overlapped.hEvent);
+			}
+			CloseHandle(handle);
+			return -1;
+		}
+
+		watcher.directories.push_back(std::move(directory));
+		return static_cast<int>(watcher.directories.size() - 1);
+	}
+
+	/// <summary>
+	/// フォルダを見張れなくなったので、そこのファイルは更新時刻を見比べる
+	/// </summary>
+	void FallBackToPolling(FileWatcher& watcher, int directoryIndex)
+	{
+		for (WatchedFile& file : watcher.files)
+		{
+			if (file.watchHandle == directoryIndex)
+			{
+				file.watchHandle = -1;
+			}
+		}
+	}
+
+	/// <summary>
+	/// 届いた変更の知らせを全て読み、見張っているファイルのものを記録する
+	/// </summary>
+	void ReadDirectoryEvents(FileWatcher& watcher, std::vector<std::filesystem::path>& changedPaths)
+	{
+		for (size_t i = 0; i < watcher.directories.size(); i++)
+		{
+			WatchedDirectory& directory = *watcher.directories[i];
+			int directoryIndex = static_cast<int>(i);
+
+			if (!directory.isReading)
+			{
+				continue;
+			}
+
+			DWORD bytes = 0;
+			if (!GetOverlappedResult(directory.handle, &directory.overlapped, &bytes, FALSE))
+			{
+				// ERROR_IO_INCOMPLETE : まだ変更がない
+				if (GetLastError() != ERROR_IO_INCOMPLETE)
+				{
+					directory.isReading = false;
+					FallBackToPolling(watcher, directoryIndex);
+				}
+				continue;
+			}
+
+			if (bytes == 0)
+			{
+				// 知らせが多すぎて受け取れなかったので、このフォルダのファイルは全て書き換えられたものとする
+				for (WatchedFile& file : watcher.files)
+				{
+					if (file.watchHandle == directoryIndex)
+					{
+						ReadWriteTime(file.path, file.lastWriteTime, file.isExists);
+						AddChangedPath(changedPaths, file.path);
+					}
+				}
+			}
+			else
+			{
+				const uint8_t* entry = reinterpret_cast<const uint8_t*>(directory.buffer);
+
+				while (true)
+				{
+					const FILE_NOTIFY_INFORMATION* information = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(entry);
+					int nameLength = static_cast<int>(information->FileNameLength / sizeof(WCHAR));
+
+					// Windowsのファイル名は大文字と小文字を区別しない
+					for (WatchedFile& file : watcher.files)
+					{
+						std::wstring name = file.path.filename().wstring();
+
+						if (file.watchHandle == directoryIndex &&
+							CompareStringOrdinal(information->FileName, nameLength, name.c_str(), static_cast<int>(name.size()), TRUE) == CSTR_EQUAL)
+						{
+							ReadWriteTime(file.path, file.lastWriteTime, file.isExists);
+							AddChangedPath(changedPaths, file.path);
+						}
+					}
+
+					if (information->NextEntryOffset == 0)
+					{
+						break;
+					}
+					entry += information->NextEntryOffset;
+				}
+			}
+
+			// 次の知らせを頼む
+			if (!RequestDirectoryChanges(directory))
+			{
+				FallBackToPolling(watcher, directoryIndex);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 読み込みを取り消して、フォルダを閉じる
+	/// </summary>
+	void CloseWatchedDirectory(WatchedDirectory& directory)
+	{
+		if (directory.isReading)
+		{
+			// 取り消しが終わるまで待つ（それまではbufferに書かれるかもしれない）
+			DWORD bytes = 0;
+			CancelIoEx(directory.handle, &directory.overlapped);
+			GetOverlappedResult(directory.handle, &directory.overlapped, &bytes, TRUE);
+			directory.isReading = false;
+		}
+
+		CloseHandle(directory.overlapped.hEvent);
+		CloseHandle(directory.handle);
+	}
+#endif
+}
+
+/// <summary>
+/// FileWatcherを作る
+/// </summary>
+/// <param name="pollIntervalMilliseconds">更新時刻を見比べる間隔（inotifyやReadDirectoryChangesWで見ているファイルには使わない）</param>
+/// <returns>FileWatcher</returns>
+FileWatcher CreateFileWatcher(double pollIntervalMilliseconds)
+{
+	// FileWatcher
+	FileWatcher watcher{};
+	watcher.notifyHandle = -1;
+	watcher.pollIntervalMilliseconds = pollIntervalMilliseconds;
+	watcher.lastPollTime = std::chrono::steady_clock::now();
+
+#ifdef __linux__
+	watcher.notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+
+	return watcher;
+}
+
+/// <summary>
+/// ファイルを見張る（登録済みなら何もしない。まだないファイルも、できたら知らせる）
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+/// <param name="path">ファイルへのパス</param>
+void WatchFile(FileWatcher& watcher, const std::filesystem::path& path)
+{
+	for (const WatchedFile& file : watcher.files)
+	{
+		if (file.path == path)
+		{
+			return;
+		}
+	}
+
+	// 見張るファイル
+	WatchedFile file{};
+	file.path = path;
+	file.watchHandle = -1;
+	ReadWriteTime(path, file.lastWriteTime, file.isExists);
+
+#ifdef __linux__
+	if (watcher.notifyHandle >= 0)
+	{
+		// ファイルではなくフォルダを見る（名前を付け替えて保存されても見失わない。同じフォルダは同じ番号が返る）
+		std::filesystem::path directory = path.parent_path();
+		if (directory.empty())
+		{
+			directory = ".";
+		}
+
+		const uint32_t kMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+		file.watchHandle = inotify_add_watch(watcher.notifyHandle, directory.c_str(), kMask);
+	}
+#endif
+
+#ifdef _WIN32
+	{
+		// ファイルではなくフォルダを見る（名前を付け替えて保存されても見失わない）
+		std::filesystem::path directory = path.parent_path();
+		if (directory.empty())
+		{
+			directory = ".";
+		}
+
+		file.watchHandle = OpenWatchedDirectory(watcher, directory);
+	}
+#endif
+
+	watcher.files.push_back(file);
+}
+
+/// <summary>
+/// 前回から書き換えられたファイルを取得する（待たずに戻る）
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+/// <returns>書き換えられたファイル（登録されたパス。同じものは1つにまとめる）</returns>
+std::vector<std::filesystem::path> PollFileWatcher(FileWatcher& watcher)
+{
+	// 書き換えられたファイル
+	std::vector<std::filesystem::path> changedPaths;
+
+#ifdef __linux__
+	if (watcher.notifyHandle >= 0)
+	{
+		ReadNotifyEvents(watcher, changedPaths);
+	}
+#endif
+
+#ifdef _WIN32
+	ReadDirectoryEvents(watcher, changedPaths);
+#endif
+
+	// inotifyやReadDirectoryChangesWで見ていないファイルは、間隔をあけて更新時刻を見比べる
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (std::chrono::duration<double, std::milli>(now - watcher.lastPollTime).count() < watcher.pollIntervalMilliseconds)
+	{
+		return changedPaths;
+	}
+	watcher.lastPollTime = now;
+
+	for (WatchedFile& file : watcher.files)
+	{
+		if (file.watchHandle >= 0)
+		{
+			continue;
+		}
+
+		std::filesystem::file_time_type lastWriteTime;
+		bool isExists = false;
+		ReadWriteTime(file.path, lastWriteTime, isExists);
+
+		if (lastWriteTime != file.lastWriteTime || isExists != file.isExists)
+		{
+			file.lastWriteTime = lastWriteTime;
+			file.isExists = isExists;
+			AddChangedPath(changedPaths, file.path);
+		}
+	}
+
+	return changedPaths;
+}
+
+/// <summary>
+/// FileWatcherを解放する
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+void ReleaseFileWatcher(FileWatcher& watcher)
+{
+#ifdef __linux__
+	if (watcher.notifyHandle >= 0)
+	{
+		// フォルダの見張りもまとめて外れる
+		close(watcher.notifyHandle);
+	}
+#endif
+
+#ifdef _WIN32
+	for (std::unique_ptr<WatchedDirectory>& directory : watcher.directories)
+	{
+		CloseWatchedDirectory(*directory);
+	}
+	watcher.directories.clear();
+#endif
+
+	watcher.notifyHandle = -1;
+	watcher.files.clear();
+}
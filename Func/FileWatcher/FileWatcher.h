@@ -0,0 +1,95 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+// 見張っているファイル
+typedef struct WatchedFile
+{
+	// 登録されたパス（変更を知らせるときはこのまま返す）
+	std::filesystem::path path;
+
+	// inotifyで見ているフォルダの番号、WindowsではdirectoriesのReadDirectoryChangesWで見ているフォルダの番号（-1なら時刻を見比べる）
+	int watchHandle;
+
+	// 最後に見た更新時刻と、あったか
+	std::filesystem::file_time_type lastWriteTime;
+	bool isExists;
+}WatchedFile;
+
+#ifdef _WIN32
+// ReadDirectoryChangesWで見張っているフォルダ
+typedef struct WatchedDirectory
+{
+	// フォルダへのパス
+	std::filesystem::path path;
+
+	// フォルダのハンドル（FILE_FLAG_OVERLAPPEDで開く）
+	HANDLE handle;
+
+	// 読み込み中の変更の知らせ（終わるまで、この場所とbufferを動かさない）
+	OVERLAPPED overlapped;
+
+	// 読み込みを頼んでいるか（頼めなくなったフォルダのファイルは、時刻を見比べる）
+	bool isReading;
+
+	// 変更の知らせを受け取る場所（FILE_NOTIFY_INFORMATIONはDWORDの境界に並ぶ）
+	DWORD buffer[4096];
+}WatchedDirectory;
+#endif
+
+/*
+	ファイルが書き換えられたことを知らせる
+	Linuxではinotify、WindowsではReadDirectoryChangesWでフォルダを見張り（保存時に名前を付け替えるエディタにも対応する）、
+	それ以外や使えないときは、一定の間隔で更新時刻を見比べる
+*/
+typedef struct FileWatcher
+{
+	// 見張っているファイル
+	std::vector<WatchedFile> files;
+
+	// inotify（使えなければ-1）
+	int notifyHandle;
+
+#ifdef _WIN32
+	// 見張っているフォルダ（読み込み中はOVERLAPPEDの場所を変えられないので、1つずつ確保する）
+	std::vector<std::unique_ptr<WatchedDirectory>> directories;
+#endif
+
+	// 更新時刻を見比べる間隔と、最後に見比べた時刻
+	double pollIntervalMilliseconds;
+	std::chrono::steady_clock::time_point lastPollTime;
+}FileWatcher;
+
+/// <summary>
+/// FileWatcherを作る
+/// </summary>
+/// <param name="pollIntervalMilliseconds">更新時刻を見比べる間隔（inotifyやReadDirectoryChangesWで見ているファイルには使わない）</param>
+/// <returns>FileWatcher</returns>
+FileWatcher CreateFileWatcher(double pollIntervalMilliseconds);
+
+/// <summary>
+/// ファイルを見張る（登録済みなら何もしない。まだないファイルも、できたら知らせる）
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+/// <param name="path">ファイルへのパス</param>
+void WatchFile(FileWatcher& watcher, const std::filesystem::path& path);
+
+/// <summary>
+/// 前回から書き換えられたファイルを取得する（待たずに戻る）
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+/// <returns>書き換えられたファイル（登録されたパス。同じものは1つにまとめる）</returns>
+std::vector<std::filesystem::path> PollFileWatcher(FileWatcher& watcher);
+
+/// <summary>
+/// FileWatcherを解放する
+/// </summary>
+/// <param name="watcher">FileWatcher</param>
+void ReleaseFileWatcher(FileWatcher& watcher);
@@ -0,0 +1,52 @@
+#include "FramePacer.h"
+#include <cassert>
+
+/// <summary>
+/// フレームの管理を初期化する
+/// </summary>
+/// <param name="frameLatency">同時に処理中にできるフレーム数（1 〜 kMaxFrameLatency、1なら毎フレーム待つ）</param>
+/// <param name="initialFenceValue">Fenceの初期値</param>
+/// <returns>フレームの管理</returns>
+FramePacer MakeFramePacer(uint32_t frameLatency, uint64_t initialFenceValue)
+{
+	assert(frameLatency >= 1 && frameLatency <= kMaxFrameLatency);
+
+	// フレームの管理
+	FramePacer pacer{};
+	pacer.frameLatency = frameLatency;
+	pacer.slotIndex = 0;
+	pacer.lastSignaledValue = initialFenceValue;
+
+	// まだ使っていないスロットは待たなくてよい
+	for (uint32_t i = 0; i < kMaxFrameLatency; i++)
+	{
+		pacer.slotFenceValues[i] = initialFenceValue;
+	}
+
+	return pacer;
+}
+
+/// <summary>
+/// 今のスロットを使い始める前に、GPUが進んでいる必要のあるFenceの値を求める
+/// </summary>
+/// <param name="pacer">フレームの管理</param>
+/// <returns>待つ値（Fenceの値がこれ以上なら待たなくてよい）</returns>
+uint64_t GetFramePacerWaitValue(const FramePacer& pacer)
+{
+	return pacer.slotFenceValues[pacer.slotIndex];
+}
+
+/// <summary>
+/// 今のフレームのコマンドを送った後に呼び、Signalする値を決めて次のスロットに進める
+/// </summary>
+/// <param name="pacer">フレームの管理</param>
+/// <returns>Signalする値</returns>
+uint64_t AdvanceFramePacer(FramePacer& pacer)
+{
+	pacer.lastSignaledValue++;
+	pacer.slotFenceValues[pacer.slotIndex] = pacer.lastSignaledValue;
+
+	pacer.slotIndex = (pacer.slotIndex + 1) % pacer.frameLatency;
+
+	return pacer.lastSignaledValue;
+}
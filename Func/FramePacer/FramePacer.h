@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+// 同時に処理中にできるフレーム数の上限
+const uint32_t kMaxFrameLatency = 4;
+
+/*
+	CPUが何フレーム先までGPUを追い越してよいかを管理する
+	フレームごとのリソース（commandAllocatorなど）はスロット番号で持ち分け、
+	スロットを使い回す前に、そのスロットで前回Signalした値までGPUが進むのを待つ
+	Fenceの値しか扱わないので、D3D12なしでも動かせる
+*/
+typedef struct FramePacer
+{
+	// 同時に処理中にできるフレーム数
+	uint32_t frameLatency;
+
+	// 今記録しているフレームのスロット番号
+	uint32_t slotIndex;
+
+	// 最後にSignalした値
+	uint64_t lastSignaledValue;
+
+	// 各スロットで最後にSignalした値（まだ使っていなければ0）
+	uint64_t slotFenceValues[kMaxFrameLatency];
+}FramePacer;
+
+/// <summary>
+/// フレームの管理を初期化する
+/// </summary>
+/// <param name="frameLatency">同時に処理中にできるフレーム数（1 〜 kMaxFrameLatency、1なら毎フレーム待つ）</param>
+/// <param name="initialFenceValue">Fenceの初期値</param>
+/// <returns>フレームの管理</returns>
+FramePacer MakeFramePacer(uint32_t frameLatency, uint64_t initialFenceValue);
+
+/// <summary>
+/// 今のスロットを使い始める前に、GPUが進んでいる必要のあるFenceの値を求める
+/// </summary>
+/// <param name="pacer">フレームの管理</param>
+/// <returns>待つ値（Fenceの値がこれ以上なら待たなくてよい）</returns>
+uint64_t GetFramePacerWaitValue(const FramePacer& pacer);
+
+/// <summary>
+/// 今のフレームのコマンドを送った後に呼び、Signalする値を決めて次のスロットに進める
+/// </summary>
+/// <param name="pacer">フレームの管理</param>
+/// <returns>Signalする値</returns>
+uint64_t AdvanceFramePacer(FramePacer& pacer);
@@ -0,0 +1,239 @@
+#include "GeometryManager.h"
+#include "../Create/Create.h"
+
+namespace
+{
+	/// <summary>
+	/// コピー用Fenceが指定した値に届くまで待つ
+	/// </summary>
+	void WaitCopyFence(GeometryManager& geometryManager, uint64_t fenceValue)
+	{
+		if (geometryManager.copyFence->GetCompletedValue() < fenceValue)
+		{
+			HANDLE fenceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+			assert(fenceEvent != nullptr);
+
+			geometryManager.copyFence->SetEventOnCompletion(fenceValue, fenceEvent);
+			WaitForSingleObject(fenceEvent, INFINITE);
+			CloseHandle(fenceEvent);
+		}
+	}
+}
+
+/// <summary>
+/// GeometryManagerを作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="stagingSize">ステージングバッファの大きさ（1回のバッチで送れる最大量）</param>
+/// <returns>GeometryManager</returns>
+GeometryManager CreateGeometryManager(ID3D12Device* device, size_t stagingSize)
+{
+	// GeometryManager
+	GeometryManager geometryManager{};
+
+	// コピー専用のキューとコマンド
+	geometryManager.copyQueue = CreateCommandQueue(device, D3D12_COMMAND_LIST_TYPE_COPY);
+	geometryManager.copyCommandAllocator = CreateCommandAllocator(device, D3D12_COMMAND_LIST_TYPE_COPY);
+	geometryManager.copyCommandList = CreateCommandList(device, geometryManager.copyCommandAllocator, D3D12_COMMAND_LIST_TYPE_COPY);
+
+	// 記録は送るときに始めるので、一度閉じておく
+	HRESULT hr = geometryManager.copyCommandList->Close();
+	assert(SUCCEEDED(hr));
+
+	geometryManager.copyFenceValue = 0;
+	hr = device->CreateFence(geometryManager.copyFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&geometryManager.copyFence));
+	assert(SUCCEEDED(hr));
+
+	// ステージングバッファはマップしたままにする
+	geometryManager.stagingResource = CreateBufferResource(device, stagingSize);
+
+	void* stagingData = nullptr;
+	hr = geometryManager.stagingResource->Map(0, nullptr, &stagingData);
+	assert(SUCCEEDED(hr));
+
+	geometryManager.staging = MakeUploadRingBuffer(stagingData, geometryManager.stagingResource->GetGPUVirtualAddress(), stagingSize);
+
+	return geometryManager;
+}
+
+/// <summary>
+/// メッシュを作り、転送待ちにする（FlushGeometryUploadsで送られる）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="device"></param>
+/// <param name="vertexData">頂点データ</param>
+/// <param name="vertexStride">頂点1つの大きさ</param>
+/// <param name="indices">インデックス（空なら使わない）</param>
+/// <returns>メッシュの番号</returns>
+MeshHandle CreateMesh(GeometryManager& geometryManager, ID3D12Device* device, std::span<const uint8_t> vertexData, uint32_t vertexStride, std::span<const uint32_t> indices)
+{
+	MeshHandle handle = RegisterMesh(geometryManager.scheduler, vertexData, vertexStride, indices);
+
+	if (geometryManager.vertexBuffers.size() <= handle.index)
+	{
+		geometryManager.vertexBuffers.resize(handle.index + 1, nullptr);
+		geometryManager.indexBuffers.resize(handle.index + 1, nullptr);
+	}
+
+	// 転送先はGPU専用のdefaultHeapに作る
+	geometryManager.vertexBuffers[handle.index] = CreateBufferResource(device, vertexData.size(), D3D12_HEAP_TYPE_DEFAULT);
+
+	if (!indices.empty())
+	{
+		geometryManager.indexBuffers[handle.index] = CreateBufferResource(device, indices.size_bytes(), D3D12_HEAP_TYPE_DEFAULT);
+	}
+
+	return handle;
+}
+
+/// <summary>
+/// メッシュを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="handle">メッシュの番号</param>
+void ReleaseMesh(GeometryManager& geometryManager, MeshHandle handle)
+{
+	UnregisterMesh(geometryManager.scheduler, handle);
+
+	if (geometryManager.vertexBuffers[handle.index])
+	{
+		geometryManager.vertexBuffers[handle.index]->Release();
+		geometryManager.vertexBuffers[handle.index] = nullptr;
+	}
+
+	if (geometryManager.indexBuffers[handle.index])
+	{
+		geometryManager.indexBuffers[handle.index]->Release();
+		geometryManager.indexBuffers[handle.index] = nullptr;
+	}
+}
+
+/// <summary>
+/// 転送待ちのメッシュをまとめてコピーキューに送る（完了は待たない）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void FlushGeometryUploads(GeometryManager& geometryManager)
+{
+	while (!geometryManager.scheduler.pendingMeshes.empty())
+	{
+		// 前のバッチの記録に使ったcommandAllocatorは、コピーが終わるまでResetできない
+		WaitCopyFence(geometryManager, geometryManager.copyFenceValue);
+		UpdateMeshUploads(geometryManager.scheduler, geometryManager.staging, geometryManager.copyFence->GetCompletedValue());
+
+		// ステージングバッファに入るだけまとめる
+		MeshUploadBatch batch = BuildMeshUploadBatch(geometryManager.scheduler, geometryManager.staging);
+		assert(!batch.copies.empty());
+
+		HRESULT hr = geometryManager.copyCommandAllocator->Reset();
+		assert(SUCCEEDED(hr));
+		hr = geometryManager.copyCommandList->Reset(geometryManager.copyCommandAllocator, nullptr);
+		assert(SUCCEEDED(hr));
+
+		// defaultHeapのバッファはCOMMONから暗黙にCOPY_DESTになり、完了後にCOMMONに戻る
+		for (const MeshCopyCommand& copy : batch.copies)
+		{
+			ID3D12Resource* destination = (copy.bufferType == MeshBufferType::Vertex) ?
+				geometryManager.vertexBuffers[copy.meshIndex] : geometryManager.indexBuffers[copy.meshIndex];
+
+			geometryManager.copyCommandList->CopyBufferRegion(destination, 0, geometryManager.stagingResource, copy.stagingOffset, copy.size);
+		}
+
+		hr = geometryManager.copyCommandList->Close();
+		assert(SUCCEEDED(hr));
+
+		ID3D12CommandList* commandLists[] = { geometryManager.copyCommandList };
+		geometryManager.copyQueue->ExecuteCommandLists(1, commandLists);
+
+		geometryManager.copyFenceValue++;
+		geometryManager.copyQueue->Signal(geometryManager.copyFence, geometryManager.copyFenceValue);
+
+		SubmitMeshUploadBatch(geometryManager.scheduler, batch, geometryManager.staging, geometryManager.copyFenceValue);
+	}
+}
+
+/// <summary>
+/// 転送が終わったメッシュを描画に使える状態にする（毎フレーム呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void UpdateGeometryManager(GeometryManager& geometryManager)
+{
+	UpdateMeshUploads(geometryManager.scheduler, geometryManager.staging, geometryManager.copyFence->GetCompletedValue());
+}
+
+/// <summary>
+/// 送った転送が全て終わるまで待つ
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void WaitGeometryUploads(GeometryManager& geometryManager)
+{
+	WaitCopyFence(geometryManager, geometryManager.copyFenceValue);
+	UpdateGeometryManager(geometryManager);
+}
+
+/// <summary>
+/// 描画に使うビューを取得する
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="handle">メッシュの番号</param>
+/// <param name="vertexBufferView">頂点バッファビューの出力先</param>
+/// <param name="indexBufferView">インデックスバッファビューの出力先（インデックスがないときはSizeInBytesが0）</param>
+/// <returns>まだ転送が終わっていない、または解放済みならfalse</returns>
+bool GetMeshViews(const GeometryManager& geometryManager, MeshHandle handle, D3D12_VERTEX_BUFFER_VIEW& vertexBufferView, D3D12_INDEX_BUFFER_VIEW& indexBufferView)
+{
+	const MeshRecord* mesh = GetMeshRecord(geometryManager.scheduler, handle);
+
+	if (mesh == nullptr || mesh->state != MeshUploadState::Ready)
+	{
+		return false;
+	}
+
+	vertexBufferView.BufferLocation = geometryManager.vertexBuffers[handle.index]->GetGPUVirtualAddress();
+	vertexBufferView.SizeInBytes = mesh->vertexBufferSize;
+	vertexBufferView.StrideInBytes = mesh->vertexStride;
+
+	indexBufferView = D3D12_INDEX_BUFFER_VIEW{};
+
+	if (geometryManager.indexBuffers[handle.index])
+	{
+		indexBufferView.BufferLocation = geometryManager.indexBuffers[handle.index]->GetGPUVirtualAddress();
+		indexBufferView.SizeInBytes = mesh->indexCount * sizeof(uint32_t);
+		indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// GeometryManagerを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void ReleaseGeometryManager(GeometryManager& geometryManager)
+{
+	WaitCopyFence(geometryManager, geometryManager.copyFenceValue);
+
+	for (ID3D12Resource* resource : geometryManager.vertexBuffers)
+	{
+		if (resource)
+		{
+			resource->Release();
+		}
+	}
+
+	for (ID3D12Resource* resource : geometryManager.indexBuffers)
+	{
+		if (resource)
+		{
+			resource->Release();
+		}
+	}
+
+	geometryManager.vertexBuffers.clear();
+	geometryManager.indexBuffers.clear();
+
+	geometryManager.stagingResource->Unmap(0, nullptr);
+	geometryManager.stagingResource->Release();
+	geometryManager.copyFence->Release();
+	geometryManager.copyCommandList->Release();
+	geometryManager.copyCommandAllocator->Release();
+	geometryManager.copyQueue->Release();
+}
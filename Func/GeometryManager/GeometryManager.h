@@ -0,0 +1,102 @@
+#pragma once
+#include <cassert>
+#include <span>
+#include <vector>
+#include <d3d12.h>
+#include "../MeshUpload/MeshUpload.h"
+#include "../UploadRingBuffer/UploadRingBuffer.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	変わらない頂点・インデックスをdefaultHeapに一度だけ転送して持つ
+	転送はステージングバッファ（uploadHeap）からコピーキューで行い、描画用のキューは止めない
+*/
+typedef struct GeometryManager
+{
+	// 転送の順番とメッシュの状態
+	MeshUploadScheduler scheduler;
+
+	// コピー専用のキュー
+	ID3D12CommandQueue* copyQueue;
+
+	// コピー用のcommandAllocator
+	ID3D12CommandAllocator* copyCommandAllocator;
+
+	// コピー用のcommandList
+	ID3D12GraphicsCommandList* copyCommandList;
+
+	// コピーの完了を知るFence
+	ID3D12Fence* copyFence;
+
+	// 最後にSignalした値
+	uint64_t copyFenceValue;
+
+	// ステージングバッファ
+	ID3D12Resource* stagingResource;
+	UploadRingBuffer staging;
+
+	// 各メッシュのバッファ（MeshHandle::indexで引く）
+	std::vector<ID3D12Resource*> vertexBuffers;
+	std::vector<ID3D12Resource*> indexBuffers;
+}GeometryManager;
+
+/// <summary>
+/// GeometryManagerを作る
+/// </summary>
+/// <param name="device"></param>
+/// <param name="stagingSize">ステージングバッファの大きさ（1回のバッチで送れる最大量）</param>
+/// <returns>GeometryManager</returns>
+GeometryManager CreateGeometryManager(ID3D12Device* device, size_t stagingSize);
+
+/// <summary>
+/// メッシュを作り、転送待ちにする（FlushGeometryUploadsで送られる）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="device"></param>
+/// <param name="vertexData">頂点データ</param>
+/// <param name="vertexStride">頂点1つの大きさ</param>
+/// <param name="indices">インデックス（空なら使わない）</param>
+/// <returns>メッシュの番号</returns>
+MeshHandle CreateMesh(GeometryManager& geometryManager, ID3D12Device* device, std::span<const uint8_t> vertexData, uint32_t vertexStride, std::span<const uint32_t> indices);
+
+/// <summary>
+/// メッシュを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="handle">メッシュの番号</param>
+void ReleaseMesh(GeometryManager& geometryManager, MeshHandle handle);
+
+/// <summary>
+/// 転送待ちのメッシュをまとめてコピーキューに送る（完了は待たない）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void FlushGeometryUploads(GeometryManager& geometryManager);
+
+/// <summary>
+/// 転送が終わったメッシュを描画に使える状態にする（毎フレーム呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void UpdateGeometryManager(GeometryManager& geometryManager);
+
+/// <summary>
+/// 送った転送が全て終わるまで待つ
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void WaitGeometryUploads(GeometryManager& geometryManager);
+
+/// <summary>
+/// 描画に使うビューを取得する
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+/// <param name="handle">メッシュの番号</param>
+/// <param name="vertexBufferView">頂点バッファビューの出力先</param>
+/// <param name="indexBufferView">インデックスバッファビューの出力先（インデックスがないときはSizeInBytesが0）</param>
+/// <returns>まだ転送が終わっていない、または解放済みならfalse</returns>
+bool GetMeshViews(const GeometryManager& geometryManager, MeshHandle handle, D3D12_VERTEX_BUFFER_VIEW& vertexBufferView, D3D12_INDEX_BUFFER_VIEW& indexBufferView);
+
+/// <summary>
+/// GeometryManagerを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="geometryManager">GeometryManager</param>
+void ReleaseGeometryManager(GeometryManager& geometryManager);
@@ -0,0 +1,51 @@
+#include "Hash.h"
+
+namespace
+{
+	// FNV-1aの素数
+	const uint64_t kHashPrime = 1099511628211ull;
+}
+
+/// <summary>
+/// バイト列のハッシュを求める（FNV-1a 64bit）
+/// </summary>
+/// <param name="data">先頭</param>
+/// <param name="size">バイト数</param>
+/// <param name="seed">初期値（続けて求めるときは前の結果を渡す）</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = seed;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= kHashPrime;
+	}
+
+	return hash;
+}
+
+/// <summary>
+/// 文字列のハッシュを続けて求める（長さも含めるので、区切りの違う連結が同じにならない）
+/// </summary>
+/// <param name="seed">前の結果</param>
+/// <param name="text">文字列</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashString(uint64_t seed, std::string_view text)
+{
+	uint64_t hash = HashValue(seed, static_cast<uint64_t>(text.size()));
+	return HashBytes(text.data(), text.size(), hash);
+}
+
+/// <summary>
+/// 2つのハッシュを混ぜる
+/// </summary>
+/// <param name="seed">前の結果</param>
+/// <param name="hash">混ぜるハッシュ</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashCombine(uint64_t seed, uint64_t hash)
+{
+	return HashValue(seed, hash);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ハッシュの初期値（FNV-1aのoffset basis）
+const uint64_t kHashSeed = 14695981039346656037ull;
+
+/// <summary>
+/// バイト列のハッシュを求める（FNV-1a 64bit）
+/// </summary>
+/// <param name="data">先頭</param>
+/// <param name="size">バイト数</param>
+/// <param name="seed">初期値（続けて求めるときは前の結果を渡す）</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = kHashSeed);
+
+/// <summary>
+/// 値のハッシュを続けて求める（パディングのない型に使う）
+/// </summary>
+/// <param name="seed">前の結果</param>
+/// <param name="value">値</param>
+/// <returns>ハッシュ</returns>
+template<typename T>
+uint64_t HashValue(uint64_t seed, const T& value)
+{
+	return HashBytes(&value, sizeof(T), seed);
+}
+
+/// <summary>
+/// 文字列のハッシュを続けて求める（長さも含めるので、区切りの違う連結が同じにならない）
+/// </summary>
+/// <param name="seed">前の結果</param>
+/// <param name="text">文字列</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashString(uint64_t seed, std::string_view text);
+
+/// <summary>
+/// 2つのハッシュを混ぜる
+/// </summary>
+/// <param name="seed">前の結果</param>
+/// <param name="hash">混ぜるハッシュ</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashCombine(uint64_t seed, uint64_t hash);
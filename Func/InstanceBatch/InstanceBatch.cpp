@@ -0,0 +1,53 @@
+#include "InstanceBatch.h"
+#include "../RadixSort/RadixSort.h"
+#include <cassert>
+
+/// <summary>
+/// 同じメッシュとマテリアルのオブジェクトを1回の描画にまとめる
+/// </summary>
+/// <param name="items">描画したいオブジェクト</param>
+/// <param name="maxInstancesPerBatch">1回の描画でまとめる最大数（1ならまとめない）</param>
+/// <param name="instanceObjectIndices">インスタンスの並び（バッチごとに連続したオブジェクトの番号）の出力先</param>
+/// <param name="batches">バッチの出力先（メッシュ、マテリアルの順に並ぶ）</param>
+void BuildInstanceBatches
+(std::span<const InstanceDrawItem> items, uint32_t maxInstancesPerBatch, std::vector<uint32_t>& instanceObjectIndices, std::vector<InstanceBatch>& batches)
+{
+	assert(maxInstancesPerBatch > 0);
+
+	instanceObjectIndices.clear();
+	batches.clear();
+
+	if (items.empty())
+	{
+		return;
+	}
+
+	// メッシュとマテリアルを1つのキーにして並べ替える（同じキーの中は渡された順番を保つ）
+	std::vector<RadixSortEntry> order(items.size());
+	std::vector<RadixSortEntry> sortBuffer;
+
+	for (uint32_t i = 0; i < order.size(); i++)
+	{
+		order[i] = RadixSortEntry{ (static_cast<uint64_t>(items[i].meshIndex) << 32) | items[i].materialIndex , i };
+	}
+
+	RadixSort(order, sortBuffer);
+
+	// キーが変わるところか、最大数に達したところでバッチを区切る
+	instanceObjectIndices.reserve(items.size());
+
+	for (uint32_t i = 0; i < order.size(); i++)
+	{
+		const InstanceDrawItem& item = items[order[i].index];
+
+		if (batches.empty() ||
+			batches.back().meshIndex != item.meshIndex || batches.back().materialIndex != item.materialIndex ||
+			batches.back().instanceCount >= maxInstancesPerBatch)
+		{
+			batches.push_back(InstanceBatch{ item.meshIndex , item.materialIndex , i , 0 });
+		}
+
+		batches.back().instanceCount++;
+		instanceObjectIndices.push_back(item.objectIndex);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// 描画したいオブジェクト1つ分
+typedef struct InstanceDrawItem
+{
+	// メッシュの番号
+	uint32_t meshIndex;
+
+	// マテリアルの番号
+	uint32_t materialIndex;
+
+	// オブジェクトの番号（座標変換などを引くのに使う）
+	uint32_t objectIndex;
+}InstanceDrawItem;
+
+// 1回の描画でまとめて描くインスタンス
+typedef struct InstanceBatch
+{
+	// メッシュの番号
+	uint32_t meshIndex;
+
+	// マテリアルの番号
+	uint32_t materialIndex;
+
+	// インスタンスの並びの中の先頭
+	uint32_t firstInstance;
+
+	// インスタンスの数
+	uint32_t instanceCount;
+}InstanceBatch;
+
+/// <summary>
+/// 同じメッシュとマテリアルのオブジェクトを1回の描画にまとめる
+/// </summary>
+/// <param name="items">描画したいオブジェクト</param>
+/// <param name="maxInstancesPerBatch">1回の描画でまとめる最大数（1ならまとめない）</param>
+/// <param name="instanceObjectIndices">インスタンスの並び（バッチごとに連続したオブジェクトの番号）の出力先</param>
+/// <param name="batches">バッチの出力先（メッシュ、マテリアルの順に並ぶ）</param>
+void BuildInstanceBatches
+(std::span<const InstanceDrawItem> items, uint32_t maxInstancesPerBatch, std::vector<uint32_t>& instanceObjectIndices, std::vector<InstanceBatch>& batches);
@@ -0,0 +1,175 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	// このスレッドが仕事をしている最中か（仕事の中から配り直すと待ち合って止まるので、そのときはその場で処理する）
+	thread_local bool tIsRunningJob = false;
+
+	/// <summary>
+	/// 仕事を取っては処理する（取れなくなったら戻る）
+	/// </summary>
+	void RunJobBatch(JobSystem* system, JobBatch& batch)
+	{
+		while (true)
+		{
+			size_t jobIndex = batch.nextJob.fetch_add(1, std::memory_order_relaxed);
+			if (jobIndex >= batch.jobCount)
+			{
+				return;
+			}
+
+			tIsRunningJob = true;
+			(*batch.job)(jobIndex);
+			tIsRunningJob = false;
+
+			// 最後の仕事を終えたら、待っているスレッドを起こす
+			if (batch.finishedCount.fetch_add(1, std::memory_order_acq_rel) + 1 == batch.jobCount)
+			{
+				std::lock_guard<std::mutex> lock(system->mutex);
+				system->doneCondition.notify_all();
+			}
+		}
+	}
+
+	/// <summary>
+	/// 仕事を待つスレッド
+	/// </summary>
+	void RunJobWorker(JobSystem* system)
+	{
+		uint64_t generation = 0;
+
+		while (true)
+		{
+			std::shared_ptr<JobBatch> batch;
+
+			{
+				std::unique_lock<std::mutex> lock(system->mutex);
+				system->wakeCondition.wait(lock, [&]() { return !system->isRunning || system->generation != generation; });
+
+				if (!system->isRunning)
+				{
+					return;
+				}
+
+				generation = system->generation;
+				batch = system->batch;
+			}
+
+			RunJobBatch(system, *batch);
+		}
+	}
+}
+
+/// <summary>
+/// スレッドを作って、仕事を待たせる
+/// </summary>
+/// <param name="workerCount">スレッドの数（呼び出したスレッドは含まない、0でもよい）</param>
+/// <returns>JobSystem</returns>
+JobSystem* CreateJobSystem(uint32_t workerCount)
+{
+	// JobSystem
+	JobSystem* system = new JobSystem{};
+	system->generation = 0;
+	system->isRunning = true;
+
+	system->workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		system->workers.emplace_back(RunJobWorker, system);
+	}
+
+	return system;
+}
+
+/// <summary>
+/// 全てのスレッドで共有するJobSystemを取得する（初めて呼ばれたときに、コア数 - 1本のスレッドで作る）
+/// </summary>
+/// <returns>JobSystem</returns>
+JobSystem* GetSharedJobSystem()
+{
+	// プログラムの終わりにスレッドを止める
+	typedef struct SharedJobSystem
+	{
+		JobSystem* system;
+		~SharedJobSystem() { ReleaseJobSystem(system); }
+	}SharedJobSystem;
+
+	static SharedJobSystem shared{ CreateJobSystem((std::max)(std::thread::hardware_concurrency(), 1u) - 1) };
+	return shared.system;
+}
+
+/// <summary>
+/// 仕事を番号ごとにスレッドへ配り、全て終わるまで待つ（呼び出したスレッドも仕事をする）
+/// </summary>
+/// <param name="system">JobSystem</param>
+/// <param name="jobCount">仕事の数</param>
+/// <param name="job">番号を受け取って仕事をする関数（別々のスレッドから同時に呼ばれる）</param>
+void RunJobs(JobSystem* system, size_t jobCount, const std::function<void(size_t jobIndex)>& job)
+{
+	assert(system != nullptr);
+
+	if (jobCount == 0)
+	{
+		return;
+	}
+
+	// 1つだけ、スレッドがない、仕事の中から呼ばれた、他が配っている最中なら、このスレッドで順に処理する
+	std::unique_lock<std::mutex> submitLock(system->submitMutex, std::defer_lock);
+	if (jobCount == 1 || system->workers.empty() || tIsRunningJob || !submitLock.try_lock())
+	{
+		for (size_t i = 0; i < jobCount; i++)
+		{
+			job(i);
+		}
+		return;
+	}
+
+	std::shared_ptr<JobBatch> batch = std::make_shared<JobBatch>();
+	batch->job = &job;
+	batch->jobCount = jobCount;
+	batch->nextJob.store(0, std::memory_order_relaxed);
+	batch->finishedCount.store(0, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(system->mutex);
+		system->batch = batch;
+		system->generation++;
+	}
+	system->wakeCondition.notify_all();
+
+	// 呼び出したスレッドも仕事を取る
+	RunJobBatch(system, *batch);
+
+	// 他のスレッドの仕事が終わるのを待つ（jobはここまで生きている必要がある）
+	{
+		std::unique_lock<std::mutex> lock(system->mutex);
+		system->doneCondition.wait(lock, [&]() { return batch->finishedCount.load(std::memory_order_acquire) == jobCount; });
+	}
+}
+
+/// <summary>
+/// スレッドを止めて、JobSystemを解放する
+/// </summary>
+/// <param name="system">JobSystem</param>
+void ReleaseJobSystem(JobSystem* system)
+{
+	if (system == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(system->mutex);
+		system->isRunning = false;
+	}
+	system->wakeCondition.notify_all();
+
+	for (std::thread& worker : system->workers)
+	{
+		worker.join();
+	}
+
+	delete system;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 1回のRunJobsで配る仕事
+typedef struct JobBatch
+{
+	// 仕事（番号を受け取る、RunJobsが戻るまで生きている）
+	const std::function<void(size_t jobIndex)>* job;
+
+	// 仕事の数
+	size_t jobCount;
+
+	// 次に取る番号と、終わった数
+	std::atomic<size_t> nextJob;
+	std::atomic<size_t> finishedCount;
+}JobBatch;
+
+/*
+	一度作ったスレッドを使い回して、番号で分けた仕事を配る
+	呼び出したスレッドも仕事を取るので、スレッドが0本でも動く
+	仕事の中からRunJobsを呼んだときと、別のスレッドが配っている最中は、呼び出したスレッドだけで処理する
+*/
+typedef struct JobSystem
+{
+	// 仕事を待つスレッド
+	std::vector<std::thread> workers;
+
+	// batchとgenerationを守る
+	std::mutex mutex;
+
+	// 新しい仕事と、全て終わったことを知らせる
+	std::condition_variable wakeCondition;
+	std::condition_variable doneCondition;
+
+	// 今配っている仕事（終わった後も、遅れて起きたスレッドが読むのでshared_ptrで持つ）
+	std::shared_ptr<JobBatch> batch;
+
+	// 配った回数（スレッドは変わったときだけ仕事を取りに行く）
+	uint64_t generation;
+
+	// 止める指示
+	bool isRunning;
+
+	// 一度に配れるのは1つだけ
+	std::mutex submitMutex;
+}JobSystem;
+
+/// <summary>
+/// スレッドを作って、仕事を待たせる
+/// </summary>
+/// <param name="workerCount">スレッドの数（呼び出したスレッドは含まない、0でもよい）</param>
+/// <returns>JobSystem</returns>
+JobSystem* CreateJobSystem(uint32_t workerCount);
+
+/// <summary>
+/// 全てのスレッドで共有するJobSystemを取得する（初めて呼ばれたときに、コア数 - 1本のスレッドで作る）
+/// </summary>
+/// <returns>JobSystem</returns>
+JobSystem* GetSharedJobSystem();
+
+/// <summary>
+/// 仕事を番号ごとにスレッドへ配り、全て終わるまで待つ（呼び出したスレッドも仕事をする）
+/// </summary>
+/// <param name="system">JobSystem</param>
+/// <param name="jobCount">仕事の数</param>
+/// <param name="job">番号を受け取って仕事をする関数（別々のスレッドから同時に呼ばれる）</param>
+void RunJobs(JobSystem* system, size_t jobCount, const std::function<void(size_t jobIndex)>& job);
+
+/// <summary>
+/// スレッドを止めて、JobSystemを解放する
+/// </summary>
+/// <param name="system">JobSystem</param>
+void ReleaseJobSystem(JobSystem* system);
@@ -1,121 +1,45 @@
 #include "Matrix.h"
+#include "../JobSystem/JobSystem.h"
+#include "../Vector/Vector.h"
+#include <algorithm>
 
-/// <summary>
-/// 座標変換を行う
-/// </summary>
-/// <param name="v">ベクトル</param>
-/// <param name="m">行列</param>
-/// <returns>変換した座標</returns>
-Vector3 Transform(const Vector3& v, const Matrix4x4& m)
-{
-	// 変換した座標
-	Vector3 transform;
-	transform.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + 1.0f * m.m[3][0];
-	transform.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + 1.0f * m.m[3][1];
-	transform.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + 1.0f * m.m[3][2];
-	float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + 1.0f * m.m[3][3];
-
-	assert(w != 0.0f);
-
-	transform.x /= w;
-	transform.y /= w;
-	transform.z /= w;
-
-	return transform;
-}
-
-/// <summary>
-/// 積を求める
-/// </summary>
-/// <param name="m1">行列1</param>
-/// <param name="m2">行列2</param>
-/// <returns>積</returns>
-Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
+namespace
 {
-	// 積
-	Matrix4x4 multiply;
-
-	multiply.m[0][0] = m1.m[0][0] * m2.m[0][0] + m1.m[0][1] * m2.m[1][0] + m1.m[0][2] * m2.m[2][0] + m1.m[0][3] * m2.m[3][0];
-	multiply.m[0][1] = m1.m[0][0] * m2.m[0][1] + m1.m[0][1] * m2.m[1][1] + m1.m[0][2] * m2.m[2][1] + m1.m[0][3] * m2.m[3][1];
-	multiply.m[0][2] = m1.m[0][0] * m2.m[0][2] + m1.m[0][1] * m2.m[1][2] + m1.m[0][2] * m2.m[2][2] + m1.m[0][3] * m2.m[3][2];
-	multiply.m[0][3] = m1.m[0][0] * m2.m[0][3] + m1.m[0][1] * m2.m[1][3] + m1.m[0][2] * m2.m[2][3] + m1.m[0][3] * m2.m[3][3];
-
-	multiply.m[1][0] = m1.m[1][0] * m2.m[0][0] + m1.m[1][1] * m2.m[1][0] + m1.m[1][2] * m2.m[2][0] + m1.m[1][3] * m2.m[3][0];
-	multiply.m[1][1] = m1.m[1][0] * m2.m[0][1] + m1.m[1][1] * m2.m[1][1] + m1.m[1][2] * m2.m[2][1] + m1.m[1][3] * m2.m[3][1];
-	multiply.m[1][2] = m1.m[1][0] * m2.m[0][2] + m1.m[1][1] * m2.m[1][2] + m1.m[1][2] * m2.m[2][2] + m1.m[1][3] * m2.m[3][2];
-	multiply.m[1][3] = m1.m[1][0] * m2.m[0][3] + m1.m[1][1] * m2.m[1][3] + m1.m[1][2] * m2.m[2][3] + m1.m[1][3] * m2.m[3][3];
-
-	multiply.m[2][0] = m1.m[2][0] * m2.m[0][0] + m1.m[2][1] * m2.m[1][0] + m1.m[2][2] * m2.m[2][0] + m1.m[2][3] * m2.m[3][0];
-	multiply.m[2][1] = m1.m[2][0] * m2.m[0][1] + m1.m[2][1] * m2.m[1][1] + m1.m[2][2] * m2.m[2][1] + m1.m[2][3] * m2.m[3][1];
-	multiply.m[2][2] = m1.m[2][0] * m2.m[0][2] + m1.m[2][1] * m2.m[1][2] + m1.m[2][2] * m2.m[2][2] + m1.m[2][3] * m2.m[3][2];
-	multiply.m[2][3] = m1.m[2][0] * m2.m[0][3] + m1.m[2][1] * m2.m[1][3] + m1.m[2][2] * m2.m[2][3] + m1.m[2][3] * m2.m[3][3];
-
-	multiply.m[3][0] = m1.m[3][0] * m2.m[0][0] + m1.m[3][1] * m2.m[1][0] + m1.m[3][2] * m2.m[2][0] + m1.m[3][3] * m2.m[3][0];
-	multiply.m[3][1] = m1.m[3][0] * m2.m[0][1] + m1.m[3][1] * m2.m[1][1] + m1.m[3][2] * m2.m[2][1] + m1.m[3][3] * m2.m[3][1];
-	multiply.m[3][2] = m1.m[3][0] * m2.m[0][2] + m1.m[3][1] * m2.m[1][2] + m1.m[3][2] * m2.m[2][2] + m1.m[3][3] * m2.m[3][2];
-	multiply.m[3][3] = m1.m[3][0] * m2.m[0][3] + m1.m[3][1] * m2.m[1][3] + m1.m[3][2] * m2.m[2][3] + m1.m[3][3] * m2.m[3][3];
-
-	return multiply;
-}
-
-/// <summary>
-/// 単位行列を作る
-/// </summary>
-/// <returns>単位行列</returns>
-Matrix4x4 MakeIdenityMatrix()
-{
-	// 単位行列
-	Matrix4x4 idenityMatrix;
-
-	for (uint32_t i = 0; i < 4; i++)
+	/// <summary>
+	/// 各軸のsin, cosからアフィン変換行列を作る（拡縮 * X回転 * Y回転 * Z回転 * 移動 を展開したもの）
+	/// </summary>
+	/// <param name="scale">拡縮</param>
+	/// <param name="sinValue">各軸の回転角のsin</param>
+	/// <param name="cosValue">各軸の回転角のcos</param>
+	/// <param name="translate">移動</param>
+	/// <returns>アフィン変換行列</returns>
+	Matrix4x4 MakeAffineMatrixFromSinCos(const Vector3& scale, const Vector3& sinValue, const Vector3& cosValue, const Vector3& translate)
 	{
-		for (uint32_t j = 0; j < 4; j++)
-		{
-			if (i == j)
-			{
-				idenityMatrix.m[i][j] = 1.0f;
-			} 
-			else
-			{
-				idenityMatrix.m[i][j] = 0.0f;
-			}
-		}
+		// アフィン変換行列
+		Matrix4x4 affineMatrix;
+
+		affineMatrix.m[0][0] = scale.x * (cosValue.y * cosValue.z);
+		affineMatrix.m[0][1] = scale.x * (cosValue.y * sinValue.z);
+		affineMatrix.m[0][2] = scale.x * (-sinValue.y);
+		affineMatrix.m[0][3] = 0.0f;
+
+		affineMatrix.m[1][0] = scale.y * (sinValue.x * sinValue.y * cosValue.z - cosValue.x * sinValue.z);
+		affineMatrix.m[1][1] = scale.y * (sinValue.x * sinValue.y * sinValue.z + cosValue.x * cosValue.z);
+		affineMatrix.m[1][2] = scale.y * (sinValue.x * cosValue.y);
+		affineMatrix.m[1][3] = 0.0f;
+
+		affineMatrix.m[2][0] = scale.z * (cosValue.x * sinValue.y * cosValue.z + sinValue.x * sinValue.z);
+		affineMatrix.m[2][1] = scale.z * (cosValue.x * sinValue.y * sinValue.z - sinValue.x * cosValue.z);
+		affineMatrix.m[2][2] = scale.z * (cosValue.x * cosValue.y);
+		affineMatrix.m[2][3] = 0.0f;
+
+		affineMatrix.m[3][0] = translate.x;
+		affineMatrix.m[3][1] = translate.y;
+		affineMatrix.m[3][2] = translate.z;
+		affineMatrix.m[3][3] = 1.0f;
+
+		return affineMatrix;
 	}
-
-	return idenityMatrix;
-}
-
-/// <summary>
-/// 拡大縮小行列を作る
-/// </summary>
-/// <param name="scale">拡縮</param>
-/// <returns>拡大縮小行列</returns>
-Matrix4x4 MakeScaleMatrix(const Vector3& scale)
-{
-	// 拡大縮小行列
-	Matrix4x4 scaleMatrix;
-
-	scaleMatrix.m[0][0] = scale.x;
-	scaleMatrix.m[0][1] = 0.0f;
-	scaleMatrix.m[0][2] = 0.0f;
-	scaleMatrix.m[0][3] = 0.0f;
-
-	scaleMatrix.m[1][0] = 0.0f;
-	scaleMatrix.m[1][1] = scale.y;
-	scaleMatrix.m[1][2] = 0.0f;
-	scaleMatrix.m[1][3] = 0.0f;
-
-	scaleMatrix.m[2][0] = 0.0f;
-	scaleMatrix.m[2][1] = 0.0f;
-	scaleMatrix.m[2][2] = scale.z;
-	scaleMatrix.m[2][3] = 0.0f;
-
-	scaleMatrix.m[3][0] = 0.0f;
-	scaleMatrix.m[3][1] = 0.0f;
-	scaleMatrix.m[3][2] = 0.0f;
-	scaleMatrix.m[3][3] = 1.0f;
-
-	return scaleMatrix;
 }
 
 /// <summary>
@@ -224,55 +148,52 @@ Matrix4x4 MakeRotateZMatrix(float radian)
 /// <returns>回転行列</returns>
 Matrix4x4 MakeRotateMatrix(const Vector3& rotate)
 {
-	// 回転行列
-	Matrix4x4 rotateMatrix = Multiply(Multiply(MakeRotateXMatrix(rotate.x), MakeRotateYMatrix(rotate.y)), MakeRotateZMatrix(rotate.z));
+	// 各軸のsin, cosは1回ずつだけ求める
+	Vector3 sinValue = { std::sin(rotate.x) , std::sin(rotate.y) , std::sin(rotate.z) };
+	Vector3 cosValue = { std::cos(rotate.x) , std::cos(rotate.y) , std::cos(rotate.z) };
+
+	// 回転行列（X回転 * Y回転 * Z回転 を展開したもの）
+	Matrix4x4 rotateMatrix = MakeAffineMatrixFromSinCos({ 1.0f , 1.0f , 1.0f }, sinValue, cosValue, { 0.0f , 0.0f , 0.0f });
 	return rotateMatrix;
 }
 
 /// <summary>
-/// 平行移動行列を作る
+/// アフィン変換行列を作る
 /// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転</param>
 /// <param name="translate">移動</param>
-/// <returns>平行移動行列</returns>
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate)
+/// <returns>アフィン変換行列</returns>
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
 {
-	// 平行移動行列
-	Matrix4x4 translateMatrix;
-
-	translateMatrix.m[0][0] = 1.0f;
-	translateMatrix.m[0][1] = 0.0f;
-	translateMatrix.m[0][2] = 0.0f;
-	translateMatrix.m[0][3] = 0.0f;
-
-	translateMatrix.m[1][0] = 0.0f;
-	translateMatrix.m[1][1] = 1.0f;
-	translateMatrix.m[1][2] = 0.0f;
-	translateMatrix.m[1][3] = 0.0f;
-
-	translateMatrix.m[2][0] = 0.0f;
-	translateMatrix.m[2][1] = 0.0f;
-	translateMatrix.m[2][2] = 1.0f;
-	translateMatrix.m[2][3] = 0.0f;
-
-	translateMatrix.m[3][0] = translate.x;
-	translateMatrix.m[3][1] = translate.y;
-	translateMatrix.m[3][2] = translate.z;
-	translateMatrix.m[3][3] = 1.0f;
-
-	return translateMatrix;
+	// 各軸のsin, cosは1回ずつだけ求める
+	Vector3 sinValue = { std::sin(rotate.x) , std::sin(rotate.y) , std::sin(rotate.z) };
+	Vector3 cosValue = { std::cos(rotate.x) , std::cos(rotate.y) , std::cos(rotate.z) };
+
+	// アフィン変換行列（行列の積をせずに12要素を直接書き込む）
+	Matrix4x4 worldMatrix = MakeAffineMatrixFromSinCos(scale, sinValue, cosValue, translate);
+
+	return worldMatrix;
 }
 
 /// <summary>
-/// アフィン変換行列を作る
+/// アフィン変換行列を作る（sin, cosに多項式近似を使う）
 /// </summary>
 /// <param name="scale">拡縮</param>
 /// <param name="rotate">回転</param>
 /// <param name="translate">移動</param>
 /// <returns>アフィン変換行列</returns>
-Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
+Matrix4x4 MakeAffineMatrixFast(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
 {
+	// 各軸のsin, cos
+	Vector3 sinValue;
+	Vector3 cosValue;
+	SinCosFast(rotate.x, sinValue.x, cosValue.x);
+	SinCosFast(rotate.y, sinValue.y, cosValue.y);
+	SinCosFast(rotate.z, sinValue.z, cosValue.z);
+
 	// アフィン変換行列
-	Matrix4x4 worldMatrix = Multiply(Multiply(MakeScaleMatrix(scale), MakeRotateMatrix(rotate)), MakeTranslateMatrix(translate));
+	Matrix4x4 worldMatrix = MakeAffineMatrixFromSinCos(scale, sinValue, cosValue, translate);
 
 	return worldMatrix;
 }
@@ -284,6 +205,71 @@ Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Ve
 /// <returns>逆行列</returns>
 Matrix4x4 MakeInverseMatrix(const Matrix4x4& m)
 {
+#if defined(MATH_SIMD)
+
+	/*-------------------------------------------
+	    2x2のブロック行列に分けて逆行列を求める
+	    | A B |
+	    | C D |
+	-------------------------------------------*/
+
+	SimdFloat4 row0 = SimdLoad(m.m[0]);
+	SimdFloat4 row1 = SimdLoad(m.m[1]);
+	SimdFloat4 row2 = SimdLoad(m.m[2]);
+	SimdFloat4 row3 = SimdLoad(m.m[3]);
+
+	// 各ブロック（行優先の2x2行列）
+	SimdFloat4 a = SimdShuffle<0, 1, 0, 1>(row0, row1);
+	SimdFloat4 b = SimdShuffle<2, 3, 2, 3>(row0, row1);
+	SimdFloat4 c = SimdShuffle<0, 1, 0, 1>(row2, row3);
+	SimdFloat4 d = SimdShuffle<2, 3, 2, 3>(row2, row3);
+
+	// 各ブロックの行列式 (|A| , |B| , |C| , |D|)
+	SimdFloat4 detSub = SimdSub
+	(
+		SimdMul(SimdShuffle<0, 2, 0, 2>(row0, row2), SimdShuffle<1, 3, 1, 3>(row1, row3)),
+		SimdMul(SimdShuffle<1, 3, 1, 3>(row0, row2), SimdShuffle<0, 2, 0, 2>(row1, row3))
+	);
+	SimdFloat4 detA = SimdSplat<0>(detSub);
+	SimdFloat4 detB = SimdSplat<1>(detSub);
+	SimdFloat4 detC = SimdSplat<2>(detSub);
+	SimdFloat4 detD = SimdSplat<3>(detSub);
+
+	// 余因子(D) * C と 余因子(A) * B
+	SimdFloat4 adjDC = SimdMat2AdjMul(d, c);
+	SimdFloat4 adjAB = SimdMat2AdjMul(a, b);
+
+	// 逆行列の各ブロックの余因子
+	SimdFloat4 x = SimdSub(SimdMul(detD, a), SimdMat2Mul(b, adjDC));
+	SimdFloat4 w = SimdSub(SimdMul(detA, d), SimdMat2Mul(c, adjAB));
+	SimdFloat4 y = SimdSub(SimdMul(detB, c), SimdMat2MulAdj(d, adjAB));
+	SimdFloat4 z = SimdSub(SimdMul(detC, b), SimdMat2MulAdj(a, adjDC));
+
+	// 行列式 |M| = |A||D| + |B||C| - tr(余因子(A)B 余因子(D)C)
+	SimdFloat4 trace = SimdMul(adjAB, SimdSwizzle<0, 2, 1, 3>(adjDC));
+	trace = SimdAdd(trace, SimdSwizzle<2, 3, 0, 1>(trace));
+	trace = SimdAdd(trace, SimdSwizzle<1, 0, 3, 2>(trace));
+	SimdFloat4 determinant = SimdSub(SimdAdd(SimdMul(detA, detD), SimdMul(detB, detC)), trace);
+
+	// 余因子の符号を含めた行列式の逆数（割り算は1回だけ）
+	SimdFloat4 inverseDeterminant = SimdDiv(SimdSet(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+	x = SimdMul(x, inverseDeterminant);
+	y = SimdMul(y, inverseDeterminant);
+	z = SimdMul(z, inverseDeterminant);
+	w = SimdMul(w, inverseDeterminant);
+
+	// 余因子の並べ替えと格納をまとめて行う
+	Matrix4x4 inverseMatrix;
+	SimdStore(inverseMatrix.m[0], SimdShuffle<3, 1, 3, 1>(x, y));
+	SimdStore(inverseMatrix.m[1], SimdShuffle<2, 0, 2, 0>(x, y));
+	SimdStore(inverseMatrix.m[2], SimdShuffle<3, 1, 3, 1>(z, w));
+	SimdStore(inverseMatrix.m[3], SimdShuffle<2, 0, 2, 0>(z, w));
+
+	return inverseMatrix;
+
+#else
+
 	// 行列式
 	float determinant =
 		m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2] -
@@ -370,15 +356,95 @@ Matrix4x4 MakeInverseMatrix(const Matrix4x4& m)
 		m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1];
 
 
+	// 行列式の逆数（割り算は1回だけ）
+	float inverseDeterminant = 1.0f / determinant;
+
 	for (uint32_t i = 0; i < 4; i++)
 	{
 		for (uint32_t j = 0; j < 4; j++)
 		{
-			adjugateMatrix.m[i][j] *= 1.0f / determinant;
+			adjugateMatrix.m[i][j] *= inverseDeterminant;
 		}
 	}
 
 	return adjugateMatrix;
+
+#endif
+}
+
+/// <summary>
+/// カメラの姿勢情報からビュー行列を作る
+/// </summary>
+/// <param name="cameraTransform">カメラの姿勢情報</param>
+/// <returns>ビュー行列</returns>
+Matrix4x4 MakeViewMatrix(const Transform3D& cameraTransform)
+{
+	// カメラのワールド行列は S * R * T なので、ビュー行列は T^-1 * R^T * S^-1
+	Matrix4x4 rotateMatrix = MakeRotateMatrix(cameraTransform.rotate);
+	float inverseScale[3] = { 1.0f / cameraTransform.scale.x , 1.0f / cameraTransform.scale.y , 1.0f / cameraTransform.scale.z };
+	const Vector3& translate = cameraTransform.translate;
+
+	// ビュー行列
+	Matrix4x4 viewMatrix;
+
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		for (uint32_t j = 0; j < 3; j++)
+		{
+			viewMatrix.m[i][j] = rotateMatrix.m[j][i] * inverseScale[j];
+		}
+
+		viewMatrix.m[i][3] = 0.0f;
+	}
+
+	for (uint32_t j = 0; j < 3; j++)
+	{
+		viewMatrix.m[3][j] = -(translate.x * rotateMatrix.m[j][0] + translate.y * rotateMatrix.m[j][1] + translate.z * rotateMatrix.m[j][2]) * inverseScale[j];
+	}
+
+	viewMatrix.m[3][3] = 1.0f;
+
+	return viewMatrix;
+}
+
+/// <summary>
+/// 注視点を向くビュー行列を作る
+/// </summary>
+/// <param name="eye">カメラの位置</param>
+/// <param name="target">注視点</param>
+/// <param name="up">上方向</param>
+/// <returns>ビュー行列</returns>
+Matrix4x4 MakeLookAtMatrix(const Vector3& eye, const Vector3& target, const Vector3& up)
+{
+	// カメラの各軸
+	Vector3 axisZ = Normalize(Subtract(target, eye));
+	Vector3 axisX = Normalize(Cross(up, axisZ));
+	Vector3 axisY = Cross(axisZ, axisX);
+
+	// ビュー行列
+	Matrix4x4 viewMatrix;
+
+	viewMatrix.m[0][0] = axisX.x;
+	viewMatrix.m[0][1] = axisY.x;
+	viewMatrix.m[0][2] = axisZ.x;
+	viewMatrix.m[0][3] = 0.0f;
+
+	viewMatrix.m[1][0] = axisX.y;
+	viewMatrix.m[1][1] = axisY.y;
+	viewMatrix.m[1][2] = axisZ.y;
+	viewMatrix.m[1][3] = 0.0f;
+
+	viewMatrix.m[2][0] = axisX.z;
+	viewMatrix.m[2][1] = axisY.z;
+	viewMatrix.m[2][2] = axisZ.z;
+	viewMatrix.m[2][3] = 0.0f;
+
+	viewMatrix.m[3][0] = -Dot(axisX, eye);
+	viewMatrix.m[3][1] = -Dot(axisY, eye);
+	viewMatrix.m[3][2] = -Dot(axisZ, eye);
+	viewMatrix.m[3][3] = 1.0f;
+
+	return viewMatrix;
 }
 
 /// <summary>
@@ -417,78 +483,653 @@ Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip
 	return perspectiveFovMatrix;
 }
 
+namespace
+{
+	// SoAでまとめて計算するオブジェクトの数
+	const size_t kBatchWidth = 8;
+
+	// 1スレッドが受け持つオブジェクトの数
+	const size_t kObjectsPerJob = 2048;
+
+	/// <summary>
+	/// [0 , count) を一定数ごとに分けて、共有のJobSystemのスレッドで処理する（少ないときは呼び出したスレッドだけで処理する）
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="countPerJob">1つの仕事が受け持つ要素数</param>
+	/// <param name="function">範囲の先頭と要素数を受け取って処理する関数</param>
+	template<typename Function>
+	void ParallelFor(size_t count, size_t countPerJob, const Function& function)
+	{
+		if (count <= countPerJob)
+		{
+			function(size_t(0), count);
+			return;
+		}
+
+		// スレッドは毎回作らず、一度作ったものを使い回す
+		size_t jobCount = (count + countPerJob - 1) / countPerJob;
+		RunJobs(GetSharedJobSystem(), jobCount, [&](size_t jobIndex)
+			{
+				size_t begin = jobIndex * countPerJob;
+				function(begin, std::min(countPerJob, count - begin));
+			});
+	}
+
+#if defined(MATH_SIMD)
+
+	/// <summary>
+	/// 4要素分のsinとcosを多項式近似でまとめて求める（SinCosFastのSIMD版）
+	/// </summary>
+	/// <param name="radian">ラジアン4要素</param>
+	/// <param name="sinValue">sinの出力先4要素</param>
+	/// <param name="cosValue">cosの出力先4要素</param>
+	void SimdSinCosFast(const float* radian, float* sinValue, float* cosValue)
+	{
+		SimdFloat4 x = SimdLoad(radian);
+
+		// [-π , π] に収める
+		SimdFloat4 quotient = SimdTruncate(SimdAdd(SimdMul(x, SimdSplat(0.159154943f)), SimdCopySign(SimdSplat(0.5f), x)));
+		SimdFloat4 y = SimdSub(x, SimdMul(quotient, SimdSplat(6.28125f)));
+		y = SimdSub(y, SimdMul(quotient, SimdSplat(0.00193500519f)));
+		y = SimdSub(y, SimdMul(quotient, SimdSplat(3.01991605e-07f)));
+
+		// [-π/2 , π/2] に折り返す
+		SimdFloat4 absY = SimdAbs(y);
+		SimdFloat4 sign = SimdCopySign(SimdSplat(1.0f), SimdSub(SimdSplat(1.57079633f), absY));
+		y = SimdMul(SimdCopySign(SimdSplat(1.0f), y), SimdMin(absY, SimdSub(SimdSplat(3.14159265f), absY)));
+
+		SimdFloat4 y2 = SimdMul(y, y);
+
+		// 11次のミニマックス近似
+		SimdFloat4 s = SimdMulAdd(SimdSplat(-2.3889859e-08f), y2, SimdSplat(2.7525562e-06f));
+		s = SimdMulAdd(s, y2, SimdSplat(-0.00019840874f));
+		s = SimdMulAdd(s, y2, SimdSplat(0.0083333310f));
+		s = SimdMulAdd(s, y2, SimdSplat(-0.16666667f));
+		s = SimdMulAdd(s, y2, SimdSplat(1.0f));
+		SimdStore(sinValue, SimdMul(s, y));
+
+		// 10次のミニマックス近似
+		SimdFloat4 c = SimdMulAdd(SimdSplat(-2.6051615e-07f), y2, SimdSplat(2.4760495e-05f));
+		c = SimdMulAdd(c, y2, SimdSplat(-0.0013888378f));
+		c = SimdMulAdd(c, y2, SimdSplat(0.041666638f));
+		c = SimdMulAdd(c, y2, SimdSplat(-0.5f));
+		c = SimdMulAdd(c, y2, SimdSplat(1.0f));
+		SimdStore(cosValue, SimdMul(c, sign));
+	}
+
+#endif
+
+	/// <summary>
+	/// 最大kBatchWidth個のオブジェクトのワールドビュープロジェクション行列をSoAで作る
+	/// </summary>
+	/// <param name="transforms">姿勢情報</param>
+	/// <param name="vp">ビュープロジェクション行列</param>
+	/// <param name="out">出力先</param>
+	/// <param name="count">オブジェクトの数</param>
+	void MakeWorldViewProjectionBatch(const Transform3D* transforms, const Matrix4x4& vp, Matrix4x4* out, size_t count)
+	{
+		// 姿勢情報をSoAに並べ替える（余った要素は0のまま計算して捨てる）
+		alignas(32) float scaleX[kBatchWidth] = {}, scaleY[kBatchWidth] = {}, scaleZ[kBatchWidth] = {};
+		alignas(32) float rotateX[kBatchWidth] = {}, rotateY[kBatchWidth] = {}, rotateZ[kBatchWidth] = {};
+		alignas(32) float translateX[kBatchWidth] = {}, translateY[kBatchWidth] = {}, translateZ[kBatchWidth] = {};
+
+		for (size_t i = 0; i < count; i++)
+		{
+			scaleX[i] = transforms[i].scale.x;
+			scaleY[i] = transforms[i].scale.y;
+			scaleZ[i] = transforms[i].scale.z;
+			rotateX[i] = transforms[i].rotate.x;
+			rotateY[i] = transforms[i].rotate.y;
+			rotateZ[i] = transforms[i].rotate.z;
+			translateX[i] = transforms[i].translate.x;
+			translateY[i] = transforms[i].translate.y;
+			translateZ[i] = transforms[i].translate.z;
+		}
+
+		// 各軸のsin, cos（多項式近似を4要素ずつまとめて求める）
+		alignas(32) float sinX[kBatchWidth], cosX[kBatchWidth];
+		alignas(32) float sinY[kBatchWidth], cosY[kBatchWidth];
+		alignas(32) float sinZ[kBatchWidth], cosZ[kBatchWidth];
+
+#if defined(MATH_SIMD)
+
+		for (size_t i = 0; i < kBatchWidth; i += 4)
+		{
+			SimdSinCosFast(rotateX + i, sinX + i, cosX + i);
+			SimdSinCosFast(rotateY + i, sinY + i, cosY + i);
+			SimdSinCosFast(rotateZ + i, sinZ + i, cosZ + i);
+		}
+
+#else
+
+		for (size_t i = 0; i < kBatchWidth; i++)
+		{
+			SinCosFast(rotateX[i], sinX[i], cosX[i]);
+			SinCosFast(rotateY[i], sinY[i], cosY[i]);
+			SinCosFast(rotateZ[i], sinZ[i], cosZ[i]);
+		}
+
+#endif
+
+		// ワールド行列の3x3部分（拡縮 * X回転 * Y回転 * Z回転）
+		alignas(32) float w[3][3][kBatchWidth];
+
+		for (size_t i = 0; i < kBatchWidth; i++)
+		{
+			w[0][0][i] = scaleX[i] * (cosY[i] * cosZ[i]);
+			w[0][1][i] = scaleX[i] * (cosY[i] * sinZ[i]);
+			w[0][2][i] = scaleX[i] * (-sinY[i]);
+
+			w[1][0][i] = scaleY[i] * (sinX[i] * sinY[i] * cosZ[i] - cosX[i] * sinZ[i]);
+			w[1][1][i] = scaleY[i] * (sinX[i] * sinY[i] * sinZ[i] + cosX[i] * cosZ[i]);
+			w[1][2][i] = scaleY[i] * (sinX[i] * cosY[i]);
+
+			w[2][0][i] = scaleZ[i] * (cosX[i] * sinY[i] * cosZ[i] + sinX[i] * sinZ[i]);
+			w[2][1][i] = scaleZ[i] * (cosX[i] * sinY[i] * sinZ[i] - sinX[i] * cosZ[i]);
+			w[2][2][i] = scaleZ[i] * (cosX[i] * cosY[i]);
+		}
+
+		// ワールド行列 * ビュープロジェクション行列（ワールド行列の4列目は(0,0,0,1)）
+		alignas(32) float wvp[4][4][kBatchWidth];
+
+		for (size_t row = 0; row < 3; row++)
+		{
+			for (size_t column = 0; column < 4; column++)
+			{
+				for (size_t i = 0; i < kBatchWidth; i++)
+				{
+					wvp[row][column][i] = w[row][0][i] * vp.m[0][column] + w[row][1][i] * vp.m[1][column] + w[row][2][i] * vp.m[2][column];
+				}
+			}
+		}
+
+		for (size_t column = 0; column < 4; column++)
+		{
+			for (size_t i = 0; i < kBatchWidth; i++)
+			{
+				wvp[3][column][i] = translateX[i] * vp.m[0][column] + translateY[i] * vp.m[1][column] + translateZ[i] * vp.m[2][column] + vp.m[3][column];
+			}
+		}
+
+		// AoSに戻して書き込む
+		for (size_t i = 0; i < count; i++)
+		{
+			for (size_t row = 0; row < 4; row++)
+			{
+				for (size_t column = 0; column < 4; column++)
+				{
+					out[i].m[row][column] = wvp[row][column][i];
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// 最大kBatchWidth個のオブジェクトのワールドビュープロジェクション行列をSoAで作る（回転がクォータニオンのもの）
+	/// </summary>
+	/// <param name="transforms">姿勢情報</param>
+	/// <param name="vp">ビュープロジェクション行列</param>
+	/// <param name="out">出力先</param>
+	/// <param name="count">オブジェクトの数</param>
+	void MakeWorldViewProjectionBatch(const QuaternionTransform3D* transforms, const Matrix4x4& vp, Matrix4x4* out, size_t count)
+	{
+		// 姿勢情報をSoAに並べ替える（余った要素は0のまま計算して捨てる）
+		alignas(32) float scaleX[kBatchWidth] = {}, scaleY[kBatchWidth] = {}, scaleZ[kBatchWidth] = {};
+		alignas(32) float rotateX[kBatchWidth] = {}, rotateY[kBatchWidth] = {}, rotateZ[kBatchWidth] = {}, rotateW[kBatchWidth] = {};
+		alignas(32) float translateX[kBatchWidth] = {}, translateY[kBatchWidth] = {}, translateZ[kBatchWidth] = {};
+
+		for (size_t i = 0; i < count; i++)
+		{
+			scaleX[i] = transforms[i].scale.x;
+			scaleY[i] = transforms[i].scale.y;
+			scaleZ[i] = transforms[i].scale.z;
+			rotateX[i] = transforms[i].rotate.x;
+			rotateY[i] = transforms[i].rotate.y;
+			rotateZ[i] = transforms[i].rotate.z;
+			rotateW[i] = transforms[i].rotate.w;
+			translateX[i] = transforms[i].translate.x;
+			translateY[i] = transforms[i].translate.y;
+			translateZ[i] = transforms[i].translate.z;
+		}
+
+		// ワールド行列の3x3部分（拡縮 * クォータニオンの回転行列、三角関数はいらない）
+		alignas(32) float w[3][3][kBatchWidth];
+
+		for (size_t i = 0; i < kBatchWidth; i++)
+		{
+			float xx = rotateX[i] * rotateX[i], yy = rotateY[i] * rotateY[i], zz = rotateZ[i] * rotateZ[i];
+			float xy = rotateX[i] * rotateY[i], xz = rotateX[i] * rotateZ[i], yz = rotateY[i] * rotateZ[i];
+			float wx = rotateW[i] * rotateX[i], wy = rotateW[i] * rotateY[i], wz = rotateW[i] * rotateZ[i];
+
+			w[0][0][i] = scaleX[i] * (1.0f - 2.0f * (yy + zz));
+			w[0][1][i] = scaleX[i] * (2.0f * (xy + wz));
+			w[0][2][i] = scaleX[i] * (2.0f * (xz - wy));
+
+			w[1][0][i] = scaleY[i] * (2.0f * (xy - wz));
+			w[1][1][i] = scaleY[i] * (1.0f - 2.0f * (xx + zz));
+			w[1][2][i] = scaleY[i] * (2.0f * (yz + wx));
+
+			w[2][0][i] = scaleZ[i] * (2.0f * (xz + wy));
+			w[2][1][i] = scaleZ[i] * (2.0f * (yz - wx));
+			w[2][2][i] = scaleZ[i] * (1.0f - 2.0f * (xx + yy));
+		}
+
+		// ワールド行列 * ビュープロジェクション行列（ワールド行列の4列目は(0,0,0,1)）
+		alignas(32) float wvp[4][4][kBatchWidth];
+
+		for (size_t row = 0; row < 3; row++)
+		{
+			for (size_t column = 0; column < 4; column++)
+			{
+				for (size_t i = 0; i < kBatchWidth; i++)
+				{
+					wvp[row][column][i] = w[row][0][i] * vp.m[0][column] + w[row][1][i] * vp.m[1][column] + w[row][2][i] * vp.m[2][column];
+				}
+			}
+		}
+
+		for (size_t column = 0; column < 4; column++)
+		{
+			for (size_t i = 0; i < kBatchWidth; i++)
+			{
+				wvp[3][column][i] = translateX[i] * vp.m[0][column] + translateY[i] * vp.m[1][column] + translateZ[i] * vp.m[2][column] + vp.m[3][column];
+			}
+		}
+
+		// AoSに戻して書き込む
+		for (size_t i = 0; i < count; i++)
+		{
+			for (size_t row = 0; row < 4; row++)
+			{
+				for (size_t column = 0; column < 4; column++)
+				{
+					out[i].m[row][column] = wvp[row][column][i];
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// 範囲内のオブジェクトのワールドビュープロジェクション行列を作る
+	/// </summary>
+	/// <param name="transforms">姿勢情報</param>
+	/// <param name="vp">ビュープロジェクション行列</param>
+	/// <param name="out">出力先</param>
+	/// <param name="count">オブジェクトの数</param>
+	template<typename TransformType>
+	void MakeWorldViewProjectionRange(const TransformType* transforms, const Matrix4x4& vp, Matrix4x4* out, size_t count)
+	{
+		for (size_t begin = 0; begin < count; begin += kBatchWidth)
+		{
+			MakeWorldViewProjectionBatch(transforms + begin, vp, out + begin, std::min(kBatchWidth, count - begin));
+		}
+	}
+
+	/// <summary>
+	/// オブジェクトが多いときはスレッドに分けて、ワールドビュープロジェクション行列を作る
+	/// </summary>
+	/// <param name="transforms">各オブジェクトの姿勢情報</param>
+	/// <param name="viewProjectionMatrix">共通のビュープロジェクション行列</param>
+	/// <param name="worldViewProjectionMatrices">ワールドビュープロジェクション行列の出力先</param>
+	template<typename TransformType>
+	void MakeWorldViewProjectionParallel(std::span<const TransformType> transforms, const Matrix4x4& viewProjectionMatrix, std::span<Matrix4x4> worldViewProjectionMatrices)
+	{
+		assert(worldViewProjectionMatrices.size() >= transforms.size());
+
+		ParallelFor(transforms.size(), kObjectsPerJob, [&](size_t begin, size_t count)
+			{
+				MakeWorldViewProjectionRange(transforms.data() + begin, viewProjectionMatrix, worldViewProjectionMatrices.data() + begin, count);
+			});
+	}
+}
+
 /// <summary>
-/// 正射影行列を作る
+/// 複数のオブジェクトのワールドビュープロジェクション行列をまとめて作る
 /// </summary>
-/// <param name="left">左</param>
-/// <param name="top">上</param>
-/// <param name="right">右</param>
-/// <param name="bottom">下</param>
-/// <param name="nearClip">近平面との距離</param>
-/// <param name="farClip">遠平面との距離</param>
-/// <returns>正射影行列</returns>
-Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip)
+/// <param name="transforms">各オブジェクトの姿勢情報</param>
+/// <param name="viewProjectionMatrix">共通のビュープロジェクション行列</param>
+/// <param name="worldViewProjectionMatrices">ワールドビュープロジェクション行列の出力先（transformsと同じ数）</param>
+void MakeWorldViewProjectionMatrices(std::span<const Transform3D> transforms, const Matrix4x4& viewProjectionMatrix, std::span<Matrix4x4> worldViewProjectionMatrices)
+{
+	MakeWorldViewProjectionParallel(transforms, viewProjectionMatrix, worldViewProjectionMatrices);
+}
+
+/// <summary>
+/// 複数のオブジェクトのワールドビュープロジェクション行列をまとめて作る（回転がクォータニオンのもの）
+/// </summary>
+/// <param name="transforms">各オブジェクトの姿勢情報</param>
+/// <param name="viewProjectionMatrix">共通のビュープロジェクション行列</param>
+/// <param name="worldViewProjectionMatrices">ワールドビュープロジェクション行列の出力先（transformsと同じ数）</param>
+void MakeWorldViewProjectionMatrices(std::span<const QuaternionTransform3D> transforms, const Matrix4x4& viewProjectionMatrix, std::span<Matrix4x4> worldViewProjectionMatrices)
+{
+	MakeWorldViewProjectionParallel(transforms, viewProjectionMatrix, worldViewProjectionMatrices);
+}
+
+namespace
+{
+	// 1スレッドが受け持つ座標の数
+	const size_t kPointsPerJob = 16384;
+
+	// 座標変換の種類
+	enum class TransformMode
+	{
+		// 方向ベクトル（移動成分を使わない）
+		Direction,
+
+		// アフィン変換する座標（wで割らない）
+		AffinePoint,
+
+		// 射影変換する座標（wで割る）
+		ProjectivePoint
+	};
+
+	/// <summary>
+	/// 1つのベクトルを座標変換する
+	/// </summary>
+	/// <param name="v">ベクトル</param>
+	/// <param name="m">行列</param>
+	/// <returns>変換したベクトル</returns>
+	template<TransformMode mode>
+	Vector3 TransformOne(const Vector3& v, const Matrix4x4& m)
+	{
+		// 変換したベクトル
+		Vector3 transform{};
+		transform.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0];
+		transform.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1];
+		transform.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2];
+
+		if constexpr (mode != TransformMode::Direction)
+		{
+			transform.x += m.m[3][0];
+			transform.y += m.m[3][1];
+			transform.z += m.m[3][2];
+		}
+
+		if constexpr (mode == TransformMode::ProjectivePoint)
+		{
+			float inverseW = 1.0f / (v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3]);
+			transform.x *= inverseW;
+			transform.y *= inverseW;
+			transform.z *= inverseW;
+		}
+
+		return transform;
+	}
+
+#if defined(MATH_SIMD)
+
+	/// <summary>
+	/// SoAに並んだ4つのベクトルを座標変換する
+	/// </summary>
+	/// <param name="m">行列</param>
+	/// <param name="x">x成分4要素（変換した値で上書きする）</param>
+	/// <param name="y">y成分4要素（変換した値で上書きする）</param>
+	/// <param name="z">z成分4要素（変換した値で上書きする）</param>
+	template<TransformMode mode>
+	void SimdTransform4(const Matrix4x4& m, SimdFloat4& x, SimdFloat4& y, SimdFloat4& z)
+	{
+		SimdFloat4 transformX = SimdMul(x, SimdSplat(m.m[0][0]));
+		SimdFloat4 transformY = SimdMul(x, SimdSplat(m.m[0][1]));
+		SimdFloat4 transformZ = SimdMul(x, SimdSplat(m.m[0][2]));
+
+		transformX = SimdMulAdd(y, SimdSplat(m.m[1][0]), transformX);
+		transformY = SimdMulAdd(y, SimdSplat(m.m[1][1]), transformY);
+		transformZ = SimdMulAdd(y, SimdSplat(m.m[1][2]), transformZ);
+
+		transformX = SimdMulAdd(z, SimdSplat(m.m[2][0]), transformX);
+		transformY = SimdMulAdd(z, SimdSplat(m.m[2][1]), transformY);
+		transformZ = SimdMulAdd(z, SimdSplat(m.m[2][2]), transformZ);
+
+		if constexpr (mode != TransformMode::Direction)
+		{
+			transformX = SimdAdd(transformX, SimdSplat(m.m[3][0]));
+			transformY = SimdAdd(transformY, SimdSplat(m.m[3][1]));
+			transformZ = SimdAdd(transformZ, SimdSplat(m.m[3][2]));
+		}
+
+		if constexpr (mode == TransformMode::ProjectivePoint)
+		{
+			SimdFloat4 w = SimdMul(x, SimdSplat(m.m[0][3]));
+			w = SimdMulAdd(y, SimdSplat(m.m[1][3]), w);
+			w = SimdMulAdd(z, SimdSplat(m.m[2][3]), w);
+			w = SimdAdd(w, SimdSplat(m.m[3][3]));
+
+			SimdFloat4 inverseW = SimdDiv(SimdSplat(1.0f), w);
+			transformX = SimdMul(transformX, inverseW);
+			transformY = SimdMul(transformY, inverseW);
+			transformZ = SimdMul(transformZ, inverseW);
+		}
+
+		x = transformX;
+		y = transformY;
+		z = transformZ;
+	}
+
+#endif
+
+	/// <summary>
+	/// AoSに並んだベクトルをまとめて座標変換する
+	/// </summary>
+	/// <param name="vectors">ベクトル</param>
+	/// <param name="m">行列</param>
+	/// <param name="out">出力先（vectorsと同じでもよい）</param>
+	/// <param name="count">ベクトルの数</param>
+	template<TransformMode mode>
+	void TransformRange(const Vector3* vectors, const Matrix4x4& m, Vector3* out, size_t count)
+	{
+		static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed");
+
+		size_t i = 0;
+
+#if defined(MATH_SIMD)
+
+		// 4つ(12要素)ずつ読み込み、SoAに並べ替えてから計算する
+		for (; i + 4 <= count; i += 4)
+		{
+			SimdFloat4 x, y, z;
+			SimdLoadVector3x4(&vectors[i].x, x, y, z);
+
+			SimdTransform4<mode>(m, x, y, z);
+
+			SimdStoreVector3x4(&out[i].x, x, y, z);
+		}
+
+#endif
+
+		for (; i < count; i++)
+		{
+			out[i] = TransformOne<mode>(vectors[i], m);
+		}
+	}
+
+	/// <summary>
+	/// SoAに並んだベクトルをまとめて座標変換する
+	/// </summary>
+	/// <param name="x">x成分</param>
+	/// <param name="y">y成分</param>
+	/// <param name="z">z成分</param>
+	/// <param name="m">行列</param>
+	/// <param name="outX">x成分の出力先</param>
+	/// <param name="outY">y成分の出力先</param>
+	/// <param name="outZ">z成分の出力先</param>
+	/// <param name="count">ベクトルの数</param>
+	template<TransformMode mode>
+	void TransformRange(const float* x, const float* y, const float* z, const Matrix4x4& m, float* outX, float* outY, float* outZ, size_t count)
+	{
+		size_t i = 0;
+
+#if defined(MATH_SIMD)
+
+		for (; i + 4 <= count; i += 4)
+		{
+			SimdFloat4 vx = SimdLoad(x + i);
+			SimdFloat4 vy = SimdLoad(y + i);
+			SimdFloat4 vz = SimdLoad(z + i);
+
+			SimdTransform4<mode>(m, vx, vy, vz);
+
+			SimdStore(outX + i, vx);
+			SimdStore(outY + i, vy);
+			SimdStore(outZ + i, vz);
+		}
+
+#endif
+
+		for (; i < count; i++)
+		{
+			Vector3 transform = TransformOne<mode>(Vector3{ x[i] , y[i] , z[i] }, m);
+			outX[i] = transform.x;
+			outY[i] = transform.y;
+			outZ[i] = transform.z;
+		}
+	}
+
+	/// <summary>
+	/// 座標をAoSでまとめて変換する（アフィン変換ならwで割らない）
+	/// </summary>
+	void TransformPointsRange(const Vector3* points, const Matrix4x4& m, Vector3* out, size_t count)
+	{
+		if (IsAffineMatrix(m))
+		{
+			TransformRange<TransformMode::AffinePoint>(points, m, out, count);
+		}
+		else
+		{
+			TransformRange<TransformMode::ProjectivePoint>(points, m, out, count);
+		}
+	}
+
+	/// <summary>
+	/// 座標をSoAでまとめて変換する（アフィン変換ならwで割らない）
+	/// </summary>
+	void TransformPointsRange(const float* x, const float* y, const float* z, const Matrix4x4& m, float* outX, float* outY, float* outZ, size_t count)
+	{
+		if (IsAffineMatrix(m))
+		{
+			TransformRange<TransformMode::AffinePoint>(x, y, z, m, outX, outY, outZ, count);
+		}
+		else
+		{
+			TransformRange<TransformMode::ProjectivePoint>(x, y, z, m, outX, outY, outZ, count);
+		}
+	}
+}
+
+/// <summary>
+/// 座標をまとめて変換する（AoS）
+/// </summary>
+/// <param name="points">座標</param>
+/// <param name="m">行列</param>
+/// <param name="transformedPoints">変換した座標の出力先（pointsと同じ数、pointsと同じでもよい）</param>
+void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> transformedPoints)
+{
+	assert(transformedPoints.size() >= points.size());
+
+	TransformPointsRange(points.data(), m, transformedPoints.data(), points.size());
+}
+
+/// <summary>
+/// 座標をまとめて変換する（SoA）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformPoints(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ)
 {
-	// 正射影行列
-	Matrix4x4 orthographicMatrix;
-
-	orthographicMatrix.m[0][0] = 2.0f / (right - left);
-	orthographicMatrix.m[0][1] = 0.0f;
-	orthographicMatrix.m[0][2] = 0.0f;
-	orthographicMatrix.m[0][3] = 0.0f;
-
-	orthographicMatrix.m[1][0] = 0.0f;
-	orthographicMatrix.m[1][1] = 2.0f / (top - bottom);
-	orthographicMatrix.m[1][2] = 0.0f;
-	orthographicMatrix.m[1][3] = 0.0f;
-
-	orthographicMatrix.m[2][0] = 0.0f;
-	orthographicMatrix.m[2][1] = 0.0f;
-	orthographicMatrix.m[2][2] = 1.0f / (farClip - nearClip);
-	orthographicMatrix.m[2][3] = 0.0f;
-
-	orthographicMatrix.m[3][0] = (left + right) / (left - right);
-	orthographicMatrix.m[3][1] = (top + bottom) / (bottom - top);
-	orthographicMatrix.m[3][2] = nearClip / (nearClip - farClip);
-	orthographicMatrix.m[3][3] = 1.0f;
-
-	return orthographicMatrix;
+	assert(y.size() == x.size() && z.size() == x.size());
+	assert(transformedX.size() >= x.size() && transformedY.size() >= x.size() && transformedZ.size() >= x.size());
+
+	TransformPointsRange(x.data(), y.data(), z.data(), m, transformedX.data(), transformedY.data(), transformedZ.data(), x.size());
+}
+
+/// <summary>
+/// 方向ベクトルをまとめて変換する（AoS）
+/// </summary>
+/// <param name="directions">方向ベクトル</param>
+/// <param name="m">行列</param>
+/// <param name="transformedDirections">変換した方向ベクトルの出力先（directionsと同じ数、directionsと同じでもよい）</param>
+void TransformDirections(std::span<const Vector3> directions, const Matrix4x4& m, std::span<Vector3> transformedDirections)
+{
+	assert(transformedDirections.size() >= directions.size());
+
+	TransformRange<TransformMode::Direction>(directions.data(), m, transformedDirections.data(), directions.size());
+}
+
+/// <summary>
+/// 方向ベクトルをまとめて変換する（SoA）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformDirections(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ)
+{
+	assert(y.size() == x.size() && z.size() == x.size());
+	assert(transformedX.size() >= x.size() && transformedY.size() >= x.size() && transformedZ.size() >= x.size());
+
+	TransformRange<TransformMode::Direction>(x.data(), y.data(), z.data(), m, transformedX.data(), transformedY.data(), transformedZ.data(), x.size());
 }
 
 /// <summary>
-/// ビューポート変換行列を作る
+/// 座標をスレッドに分けてまとめて変換する（AoS）
 /// </summary>
-/// <param name="left">左</param>
-/// <param name="top">上</param>
-/// <param name="width">幅</param>
-/// <param name="height">高さ</param>
-/// <param name="minDepth">最小深度値</param>
-/// <param name="maxDepth">最大深度値</param>
-/// <returns>ビューポート変換行列</returns>
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth)
+/// <param name="points">座標</param>
+/// <param name="m">行列</param>
+/// <param name="transformedPoints">変換した座標の出力先（pointsと同じ数、pointsと同じでもよい）</param>
+void TransformPointsParallel(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> transformedPoints)
 {
-	// ビューポート変換行列
-	Matrix4x4 viewportMatrix;
-
-	viewportMatrix.m[0][0] = width / 2.0f;
-	viewportMatrix.m[0][1] = 0.0f;
-	viewportMatrix.m[0][2] = 0.0f;
-	viewportMatrix.m[0][3] = 0.0f;
-
-	viewportMatrix.m[1][0] = 0.0f;
-	viewportMatrix.m[1][1] = -(height / 2.0f);
-	viewportMatrix.m[1][2] = 0.0f;
-	viewportMatrix.m[1][3] = 0.0f;
-
-	viewportMatrix.m[2][0] = 0.0f;
-	viewportMatrix.m[2][1] = 0.0f;
-	viewportMatrix.m[2][2] = maxDepth - minDepth;
-	viewportMatrix.m[2][3] = 0.0f;
-
-	viewportMatrix.m[3][0] = left + width / 2.0f;
-	viewportMatrix.m[3][1] = top + height / 2.0f;
-	viewportMatrix.m[3][2] = minDepth;
-	viewportMatrix.m[3][3] = 1.0f;
-
-	return viewportMatrix;
-}
\ No newline at end of file
+	assert(transformedPoints.size() >= points.size());
+
+	ParallelFor(points.size(), kPointsPerJob, [&](size_t begin, size_t count)
+		{
+			TransformPointsRange(points.data() + begin, m, transformedPoints.data() + begin, count);
+		});
+}
+
+/// <summary>
+/// 座標をスレッドに分けてまとめて変換する（SoA）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformPointsParallel(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ)
+{
+	assert(y.size() == x.size() && z.size() == x.size());
+	assert(transformedX.size() >= x.size() && transformedY.size() >= x.size() && transformedZ.size() >= x.size());
+
+	ParallelFor(x.size(), kPointsPerJob, [&](size_t begin, size_t count)
+		{
+			TransformPointsRange(x.data() + begin, y.data() + begin, z.data() + begin, m,
+				transformedX.data() + begin, transformedY.data() + begin, transformedZ.data() + begin, count);
+		});
+}
+
+/// <summary>
+/// 方向ベクトルをスレッドに分けてまとめて変換する（AoS）
+/// </summary>
+/// <param name="directions">方向ベクトル</param>
+/// <param name="m">行列</param>
+/// <param name="transformedDirections">変換した方向ベクトルの出力先（directionsと同じ数、directionsと同じでもよい）</param>
+void TransformDirectionsParallel(std::span<const Vector3> directions, const Matrix4x4& m, std::span<Vector3> transformedDirections)
+{
+	assert(transformedDirections.size() >= directions.size());
+
+	ParallelFor(directions.size(), kPointsPerJob, [&](size_t begin, size_t count)
+		{
+			TransformRange<TransformMode::Direction>(directions.data() + begin, m, transformedDirections.data() + begin, count);
+		});
+}
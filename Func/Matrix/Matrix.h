@@ -1,8 +1,13 @@
 #pragma once
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include "../../Struct.h"
+#include "../Simd/Simd.h"
 
 /// <summary>
 /// 座標変換を行う
@@ -10,7 +15,33 @@
 /// <param name="v">ベクトル</param>
 /// <param name="m">行列</param>
 /// <returns>変換した座標</returns>
-Vector3 Transform(const Vector3& v, const Matrix4x4& m);
+constexpr Vector3 Transform(const Vector3& v, const Matrix4x4& m)
+{
+	// 変換した座標
+	Vector3 transform{};
+	transform.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + 1.0f * m.m[3][0];
+	transform.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + 1.0f * m.m[3][1];
+	transform.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + 1.0f * m.m[3][2];
+	float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + 1.0f * m.m[3][3];
+
+	assert(w != 0.0f);
+
+	transform.x /= w;
+	transform.y /= w;
+	transform.z /= w;
+
+	return transform;
+}
+
+/// <summary>
+/// アフィン変換行列かどうか（4列目が(0,0,0,1)で、wで割る必要がないか）
+/// </summary>
+/// <param name="m">行列</param>
+/// <returns>アフィン変換行列ならtrue</returns>
+constexpr bool IsAffineMatrix(const Matrix4x4& m)
+{
+	return m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f;
+}
 
 /// <summary>
 /// 積を求める
@@ -18,20 +49,151 @@ Vector3 Transform(const Vector3& v, const Matrix4x4& m);
 /// <param name="m1">行列1</param>
 /// <param name="m2">行列2</param>
 /// <returns>積</returns>
-Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
+{
+	// 積
+	Matrix4x4 multiply{};
+
+#if defined(MATH_SIMD)
+
+	// コンパイル時に計算するときはスカラー版を使う
+	if (!std::is_constant_evaluated())
+	{
+		// m2の各行
+		SimdFloat4 row0 = SimdLoad(m2.m[0]);
+		SimdFloat4 row1 = SimdLoad(m2.m[1]);
+		SimdFloat4 row2 = SimdLoad(m2.m[2]);
+		SimdFloat4 row3 = SimdLoad(m2.m[3]);
+
+		// 結果のi行目は、m1のi行目の各要素でm2の行を重み付けした和になる
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			SimdFloat4 a = SimdLoad(m1.m[i]);
+			SimdFloat4 result = SimdMul(SimdSplat<0>(a), row0);
+			result = SimdMulAdd(SimdSplat<1>(a), row1, result);
+			result = SimdMulAdd(SimdSplat<2>(a), row2, result);
+			result = SimdMulAdd(SimdSplat<3>(a), row3, result);
+			SimdStore(multiply.m[i], result);
+		}
+
+		return multiply;
+	}
+
+#endif
+
+	multiply.m[0][0] = m1.m[0][0] * m2.m[0][0] + m1.m[0][1] * m2.m[1][0] + m1.m[0][2] * m2.m[2][0] + m1.m[0][3] * m2.m[3][0];
+	multiply.m[0][1] = m1.m[0][0] * m2.m[0][1] + m1.m[0][1] * m2.m[1][1] + m1.m[0][2] * m2.m[2][1] + m1.m[0][3] * m2.m[3][1];
+	multiply.m[0][2] = m1.m[0][0] * m2.m[0][2] + m1.m[0][1] * m2.m[1][2] + m1.m[0][2] * m2.m[2][2] + m1.m[0][3] * m2.m[3][2];
+	multiply.m[0][3] = m1.m[0][0] * m2.m[0][3] + m1.m[0][1] * m2.m[1][3] + m1.m[0][2] * m2.m[2][3] + m1.m[0][3] * m2.m[3][3];
+
+	multiply.m[1][0] = m1.m[1][0] * m2.m[0][0] + m1.m[1][1] * m2.m[1][0] + m1.m[1][2] * m2.m[2][0] + m1.m[1][3] * m2.m[3][0];
+	multiply.m[1][1] = m1.m[1][0] * m2.m[0][1] + m1.m[1][1] * m2.m[1][1] + m1.m[1][2] * m2.m[2][1] + m1.m[1][3] * m2.m[3][1];
+	multiply.m[1][2] = m1.m[1][0] * m2.m[0][2] + m1.m[1][1] * m2.m[1][2] + m1.m[1][2] * m2.m[2][2] + m1.m[1][3] * m2.m[3][2];
+	multiply.m[1][3] = m1.m[1][0] * m2.m[0][3] + m1.m[1][1] * m2.m[1][3] + m1.m[1][2] * m2.m[2][3] + m1.m[1][3] * m2.m[3][3];
+
+	multiply.m[2][0] = m1.m[2][0] * m2.m[0][0] + m1.m[2][1] * m2.m[1][0] + m1.m[2][2] * m2.m[2][0] + m1.m[2][3] * m2.m[3][0];
+	multiply.m[2][1] = m1.m[2][0] * m2.m[0][1] + m1.m[2][1] * m2.m[1][1] + m1.m[2][2] * m2.m[2][1] + m1.m[2][3] * m2.m[3][1];
+	multiply.m[2][2] = m1.m[2][0] * m2.m[0][2] + m1.m[2][1] * m2.m[1][2] + m1.m[2][2] * m2.m[2][2] + m1.m[2][3] * m2.m[3][2];
+	multiply.m[2][3] = m1.m[2][0] * m2.m[0][3] + m1.m[2][1] * m2.m[1][3] + m1.m[2][2] * m2.m[2][3] + m1.m[2][3] * m2.m[3][3];
+
+	multiply.m[3][0] = m1.m[3][0] * m2.m[0][0] + m1.m[3][1] * m2.m[1][0] + m1.m[3][2] * m2.m[2][0] + m1.m[3][3] * m2.m[3][0];
+	multiply.m[3][1] = m1.m[3][0] * m2.m[0][1] + m1.m[3][1] * m2.m[1][1] + m1.m[3][2] * m2.m[2][1] + m1.m[3][3] * m2.m[3][1];
+	multiply.m[3][2] = m1.m[3][0] * m2.m[0][2] + m1.m[3][1] * m2.m[1][2] + m1.m[3][2] * m2.m[2][2] + m1.m[3][3] * m2.m[3][2];
+	multiply.m[3][3] = m1.m[3][0] * m2.m[0][3] + m1.m[3][1] * m2.m[1][3] + m1.m[3][2] * m2.m[2][3] + m1.m[3][3] * m2.m[3][3];
+
+	return multiply;
+}
 
 /// <summary>
 /// 単位行列を作る
 /// </summary>
 /// <returns>単位行列</returns>
-Matrix4x4 MakeIdenityMatrix();
+constexpr Matrix4x4 MakeIdenityMatrix()
+{
+	// 単位行列
+	Matrix4x4 idenityMatrix{};
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		for (uint32_t j = 0; j < 4; j++)
+		{
+			if (i == j)
+			{
+				idenityMatrix.m[i][j] = 1.0f;
+			} 
+			else
+			{
+				idenityMatrix.m[i][j] = 0.0f;
+			}
+		}
+	}
+
+	return idenityMatrix;
+}
 
 /// <summary>
 /// 拡大縮小行列を作る
 /// </summary>
 /// <param name="scale">拡縮</param>
 /// <returns>拡大縮小行列</returns>
-Matrix4x4 MakeScaleMatrix(const Vector3& scale);
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale)
+{
+	// 拡大縮小行列
+	Matrix4x4 scaleMatrix{};
+
+	scaleMatrix.m[0][0] = scale.x;
+	scaleMatrix.m[0][1] = 0.0f;
+	scaleMatrix.m[0][2] = 0.0f;
+	scaleMatrix.m[0][3] = 0.0f;
+
+	scaleMatrix.m[1][0] = 0.0f;
+	scaleMatrix.m[1][1] = scale.y;
+	scaleMatrix.m[1][2] = 0.0f;
+	scaleMatrix.m[1][3] = 0.0f;
+
+	scaleMatrix.m[2][0] = 0.0f;
+	scaleMatrix.m[2][1] = 0.0f;
+	scaleMatrix.m[2][2] = scale.z;
+	scaleMatrix.m[2][3] = 0.0f;
+
+	scaleMatrix.m[3][0] = 0.0f;
+	scaleMatrix.m[3][1] = 0.0f;
+	scaleMatrix.m[3][2] = 0.0f;
+	scaleMatrix.m[3][3] = 1.0f;
+
+	return scaleMatrix;
+}
+
+/// <summary>
+/// sinとcosを多項式近似でまとめて求める
+/// |radian| <= 25000 の範囲で絶対誤差は 3e-7 以下（sinは11次、cosは10次のミニマックス近似）
+/// </summary>
+/// <param name="radian">ラジアン</param>
+/// <param name="sinValue">sinの出力先</param>
+/// <param name="cosValue">cosの出力先</param>
+inline void SinCosFast(float radian, float& sinValue, float& cosValue)
+{
+	const float kPi = 3.14159265f;
+	const float kHalfPi = 1.57079633f;
+	const float kInverseTwoPi = 0.159154943f;
+
+	// [-π , π] に収める（2πを3つに分けて引くことで桁落ちを抑える）
+	float quotient = static_cast<float>(static_cast<int32_t>(radian * kInverseTwoPi + std::copysign(0.5f, radian)));
+	float y = ((radian - quotient * 6.28125f) - quotient * 0.00193500519f) - quotient * 3.01991605e-07f;
+
+	// [-π/2 , π/2] に折り返す（cosは符号が反転する）
+	float absY = std::fabs(y);
+	float sign = std::copysign(1.0f, kHalfPi - absY);
+	y = std::copysign(1.0f, y) * (std::min)(absY, kPi - absY);
+
+	float y2 = y * y;
+
+	// 11次のミニマックス近似
+	sinValue = (((((-2.3889859e-08f * y2 + 2.7525562e-06f) * y2 - 0.00019840874f) * y2 + 0.0083333310f) * y2 - 0.16666667f) * y2 + 1.0f) * y;
+
+	// 10次のミニマックス近似
+	cosValue = sign * (((((-2.6051615e-07f * y2 + 2.4760495e-05f) * y2 - 0.0013888378f) * y2 + 0.041666638f) * y2 - 0.5f) * y2 + 1.0f);
+}
 
 /// <summary>
 /// X軸の回転行列を作る
@@ -66,7 +228,33 @@ Matrix4x4 MakeRotateMatrix(const Vector3& rotate);
 /// </summary>
 /// <param name="translate">移動</param>
 /// <returns>平行移動行列</returns>
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate)
+{
+	// 平行移動行列
+	Matrix4x4 translateMatrix{};
+
+	translateMatrix.m[0][0] = 1.0f;
+	translateMatrix.m[0][1] = 0.0f;
+	translateMatrix.m[0][2] = 0.0f;
+	translateMatrix.m[0][3] = 0.0f;
+
+	translateMatrix.m[1][0] = 0.0f;
+	translateMatrix.m[1][1] = 1.0f;
+	translateMatrix.m[1][2] = 0.0f;
+	translateMatrix.m[1][3] = 0.0f;
+
+	translateMatrix.m[2][0] = 0.0f;
+	translateMatrix.m[2][1] = 0.0f;
+	translateMatrix.m[2][2] = 1.0f;
+	translateMatrix.m[2][3] = 0.0f;
+
+	translateMatrix.m[3][0] = translate.x;
+	translateMatrix.m[3][1] = translate.y;
+	translateMatrix.m[3][2] = translate.z;
+	translateMatrix.m[3][3] = 1.0f;
+
+	return translateMatrix;
+}
 
 /// <summary>
 /// アフィン変換行列を作る
@@ -77,6 +265,15 @@ Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
 /// <returns>アフィン変換行列</returns>
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
 
+/// <summary>
+/// アフィン変換行列を作る（sin, cosに多項式近似を使う）
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転</param>
+/// <param name="translate">移動</param>
+/// <returns>アフィン変換行列</returns>
+Matrix4x4 MakeAffineMatrixFast(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
 /// <summary>
 /// 逆行列を作る
 /// </summary>
@@ -84,6 +281,103 @@ Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Ve
 /// <returns>逆行列</returns>
 Matrix4x4 MakeInverseMatrix(const Matrix4x4& m);
 
+/// <summary>
+/// アフィン変換行列の逆行列を作る（4列目が(0,0,0,1)の行列のみ）
+/// </summary>
+/// <param name="m">アフィン変換行列</param>
+/// <returns>逆行列</returns>
+constexpr Matrix4x4 MakeInverseAffineMatrix(const Matrix4x4& m)
+{
+	assert(m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f);
+
+	// 3x3部分の余因子
+	float cofactor00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	float cofactor01 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	float cofactor02 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+
+	// 3x3部分の行列式
+	float determinant = m.m[0][0] * cofactor00 + m.m[0][1] * cofactor01 + m.m[0][2] * cofactor02;
+	float inverseDeterminant = 1.0f / determinant;
+
+	// 逆行列
+	Matrix4x4 inverseMatrix{};
+
+	inverseMatrix.m[0][0] = cofactor00 * inverseDeterminant;
+	inverseMatrix.m[0][1] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * inverseDeterminant;
+	inverseMatrix.m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * inverseDeterminant;
+	inverseMatrix.m[0][3] = 0.0f;
+
+	inverseMatrix.m[1][0] = cofactor01 * inverseDeterminant;
+	inverseMatrix.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * inverseDeterminant;
+	inverseMatrix.m[1][2] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * inverseDeterminant;
+	inverseMatrix.m[1][3] = 0.0f;
+
+	inverseMatrix.m[2][0] = cofactor02 * inverseDeterminant;
+	inverseMatrix.m[2][1] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * inverseDeterminant;
+	inverseMatrix.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * inverseDeterminant;
+	inverseMatrix.m[2][3] = 0.0f;
+
+	// 移動は -t * (3x3部分の逆行列)
+	for (uint32_t j = 0; j < 3; j++)
+	{
+		inverseMatrix.m[3][j] = -(m.m[3][0] * inverseMatrix.m[0][j] + m.m[3][1] * inverseMatrix.m[1][j] + m.m[3][2] * inverseMatrix.m[2][j]);
+	}
+
+	inverseMatrix.m[3][3] = 1.0f;
+
+	return inverseMatrix;
+}
+
+/// <summary>
+/// 回転と移動だけの行列の逆行列を作る（拡縮を含まない行列のみ）
+/// </summary>
+/// <param name="m">回転と移動だけの行列</param>
+/// <returns>逆行列</returns>
+constexpr Matrix4x4 MakeInverseRigidMatrix(const Matrix4x4& m)
+{
+	assert(m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f);
+
+	// 逆行列
+	Matrix4x4 inverseMatrix{};
+
+	// 回転の逆は転置
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		for (uint32_t j = 0; j < 3; j++)
+		{
+			inverseMatrix.m[i][j] = m.m[j][i];
+		}
+
+		inverseMatrix.m[i][3] = 0.0f;
+	}
+
+	// 移動は回転の逆で戻して符号を反転する
+	for (uint32_t j = 0; j < 3; j++)
+	{
+		inverseMatrix.m[3][j] = -(m.m[3][0] * m.m[j][0] + m.m[3][1] * m.m[j][1] + m.m[3][2] * m.m[j][2]);
+	}
+
+	inverseMatrix.m[3][3] = 1.0f;
+
+	return inverseMatrix;
+}
+
+/// <summary>
+/// カメラの姿勢情報からビュー行列を作る
+/// </summary>
+/// <param name="cameraTransform">カメラの姿勢情報</param>
+/// <returns>ビュー行列</returns>
+Matrix4x4 MakeViewMatrix(const Transform3D& cameraTransform);
+
+/// <summary>
+/// 注視点を向くビュー行列を作る
+/// </summary>
+/// <param name="eye">カメラの位置</param>
+/// <param name="target">注視点</param>
+/// <param name="up">上方向</param>
+/// <returns>ビュー行列</returns>
+Matrix4x4 MakeLookAtMatrix(const Vector3& eye, const Vector3& target, const Vector3& up);
+
 /// <summary>
 /// 透視投影行列を作る
 /// </summary>
@@ -104,7 +398,33 @@ Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip
 /// <param name="nearClip">近平面との距離</param>
 /// <param name="farClip">遠平面との距離</param>
 /// <returns>正射影行列</returns>
-Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip);
+constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip)
+{
+	// 正射影行列
+	Matrix4x4 orthographicMatrix{};
+
+	orthographicMatrix.m[0][0] = 2.0f / (right - left);
+	orthographicMatrix.m[0][1] = 0.0f;
+	orthographicMatrix.m[0][2] = 0.0f;
+	orthographicMatrix.m[0][3] = 0.0f;
+
+	orthographicMatrix.m[1][0] = 0.0f;
+	orthographicMatrix.m[1][1] = 2.0f / (top - bottom);
+	orthographicMatrix.m[1][2] = 0.0f;
+	orthographicMatrix.m[1][3] = 0.0f;
+
+	orthographicMatrix.m[2][0] = 0.0f;
+	orthographicMatrix.m[2][1] = 0.0f;
+	orthographicMatrix.m[2][2] = 1.0f / (farClip - nearClip);
+	orthographicMatrix.m[2][3] = 0.0f;
+
+	orthographicMatrix.m[3][0] = (left + right) / (left - right);
+	orthographicMatrix.m[3][1] = (top + bottom) / (bottom - top);
+	orthographicMatrix.m[3][2] = nearClip / (nearClip - farClip);
+	orthographicMatrix.m[3][3] = 1.0f;
+
+	return orthographicMatrix;
+}
 
 /// <summary>
 /// ビューポート変換行列を作る
@@ -116,4 +436,131 @@ Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float botto
 /// <param name="minDepth">最小深度値</param>
 /// <param name="maxDepth">最大深度値</param>
 /// <returns>ビューポート変換行列</returns>
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
\ No newline at end of file
+constexpr Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth)
+{
+	// ビューポート変換行列
+	Matrix4x4 viewportMatrix{};
+
+	viewportMatrix.m[0][0] = width / 2.0f;
+	viewportMatrix.m[0][1] = 0.0f;
+	viewportMatrix.m[0][2] = 0.0f;
+	viewportMatrix.m[0][3] = 0.0f;
+
+	viewportMatrix.m[1][0] = 0.0f;
+	viewportMatrix.m[1][1] = -(height / 2.0f);
+	viewportMatrix.m[1][2] = 0.0f;
+	viewportMatrix.m[1][3] = 0.0f;
+
+	viewportMatrix.m[2][0] = 0.0f;
+	viewportMatrix.m[2][1] = 0.0f;
+	viewportMatrix.m[2][2] = maxDepth - minDepth;
+	viewportMatrix.m[2][3] = 0.0f;
+
+	viewportMatrix.m[3][0] = left + width / 2.0f;
+	viewportMatrix.m[3][1] = top + height / 2.0f;
+	viewportMatrix.m[3][2] = minDepth;
+	viewportMatrix.m[3][3] = 1.0f;
+
+	return viewportMatrix;
+}
+
+/// <summary>
+/// 複数のオブジェクトのワールドビュープロジェクション行列をまとめて作る
+/// </summary>
+/// <param name="transforms">各オブジェクトの姿勢情報</param>
+/// <param name="viewProjectionMatrix">共通のビュープロジェクション行列</param>
+/// <param name="worldViewProjectionMatrices">ワールドビュープロジェクション行列の出力先（transformsと同じ数）</param>
+void MakeWorldViewProjectionMatrices(std::span<const Transform3D> transforms, const Matrix4x4& viewProjectionMatrix, std::span<Matrix4x4> worldViewProjectionMatrices);
+
+/// <summary>
+/// 複数のオブジェクトのワールドビュープロジェクション行列をまとめて作る（回転がクォータニオンのもの）
+/// </summary>
+/// <param name="transforms">各オブジェクトの姿勢情報</param>
+/// <param name="viewProjectionMatrix">共通のビュープロジェクション行列</param>
+/// <param name="worldViewProjectionMatrices">ワールドビュープロジェクション行列の出力先（transformsと同じ数）</param>
+void MakeWorldViewProjectionMatrices(std::span<const QuaternionTransform3D> transforms, const Matrix4x4& viewProjectionMatrix, std::span<Matrix4x4> worldViewProjectionMatrices);
+
+/// <summary>
+/// 座標をまとめて変換する（AoS、アフィン変換のときはwで割らない）
+/// </summary>
+/// <param name="points">座標</param>
+/// <param name="m">行列</param>
+/// <param name="transformedPoints">変換した座標の出力先（pointsと同じ数、pointsと同じでもよい）</param>
+void TransformPoints(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> transformedPoints);
+
+/// <summary>
+/// 座標をまとめて変換する（SoA、アフィン変換のときはwで割らない）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformPoints(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ);
+
+/// <summary>
+/// 方向ベクトルをまとめて変換する（AoS、移動成分は使わない）
+/// </summary>
+/// <param name="directions">方向ベクトル</param>
+/// <param name="m">行列</param>
+/// <param name="transformedDirections">変換した方向ベクトルの出力先（directionsと同じ数、directionsと同じでもよい）</param>
+void TransformDirections(std::span<const Vector3> directions, const Matrix4x4& m, std::span<Vector3> transformedDirections);
+
+/// <summary>
+/// 方向ベクトルをまとめて変換する（SoA、移動成分は使わない）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformDirections(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ);
+
+/// <summary>
+/// 座標をスレッドに分けてまとめて変換する（AoS、大量の座標向け）
+/// </summary>
+/// <param name="points">座標</param>
+/// <param name="m">行列</param>
+/// <param name="transformedPoints">変換した座標の出力先（pointsと同じ数、pointsと同じでもよい）</param>
+void TransformPointsParallel(std::span<const Vector3> points, const Matrix4x4& m, std::span<Vector3> transformedPoints);
+
+/// <summary>
+/// 座標をスレッドに分けてまとめて変換する（SoA、大量の座標向け）
+/// </summary>
+/// <param name="x">x成分</param>
+/// <param name="y">y成分</param>
+/// <param name="z">z成分</param>
+/// <param name="m">行列</param>
+/// <param name="transformedX">変換したx成分の出力先</param>
+/// <param name="transformedY">変換したy成分の出力先</param>
+/// <param name="transformedZ">変換したz成分の出力先</param>
+void TransformPointsParallel(std::span<const float> x, std::span<const float> y, std::span<const float> z, const Matrix4x4& m,
+	std::span<float> transformedX, std::span<float> transformedY, std::span<float> transformedZ);
+
+/// <summary>
+/// 方向ベクトルをスレッドに分けてまとめて変換する（AoS、大量の方向ベクトル向け）
+/// </summary>
+/// <param name="directions">方向ベクトル</param>
+/// <param name="m">行列</param>
+/// <param name="transformedDirections">変換した方向ベクトルの出力先（directionsと同じ数、directionsと同じでもよい）</param>
+void TransformDirectionsParallel(std::span<const Vector3> directions, const Matrix4x4& m, std::span<Vector3> transformedDirections);
+
+/*--------------------
+    演算子オーバーロード
+--------------------*/
+
+/// <summary>
+/// 積を求める
+/// </summary>
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) { return Multiply(m1, m2); }
+
+/// <summary>
+/// 積を代入する
+/// </summary>
+constexpr Matrix4x4& operator*=(Matrix4x4& m1, const Matrix4x4& m2) { m1 = Multiply(m1, m2); return m1; }
@@ -0,0 +1,203 @@
+#include "MeshUpload.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+	// 頂点バッファとインデックスバッファのステージング内の配置
+	const size_t kStagingAlignment = 16;
+}
+
+/// <summary>
+/// メッシュを登録し、転送待ちにする（データはコピーして持つ）
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="vertexData">頂点データ</param>
+/// <param name="vertexStride">頂点1つの大きさ</param>
+/// <param name="indices">インデックス（空なら使わない）</param>
+/// <returns>メッシュの番号</returns>
+MeshHandle RegisterMesh(MeshUploadScheduler& scheduler, std::span<const uint8_t> vertexData, uint32_t vertexStride, std::span<const uint32_t> indices)
+{
+	assert(!vertexData.empty() && vertexStride > 0);
+	assert(vertexData.size() % vertexStride == 0);
+
+	// 空いている番号があれば使い回す
+	uint32_t index = 0;
+
+	if (!scheduler.freeIndices.empty())
+	{
+		index = scheduler.freeIndices.back();
+		scheduler.freeIndices.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(scheduler.meshes.size());
+		scheduler.meshes.emplace_back();
+	}
+
+	MeshRecord& mesh = scheduler.meshes[index];
+	mesh.isAlive = true;
+	mesh.state = MeshUploadState::Pending;
+	mesh.vertexStride = vertexStride;
+	mesh.vertexBufferSize = static_cast<uint32_t>(vertexData.size());
+	mesh.indexCount = static_cast<uint32_t>(indices.size());
+	mesh.fenceValue = 0;
+	mesh.vertexData.assign(vertexData.begin(), vertexData.end());
+	mesh.indexData.assign(indices.begin(), indices.end());
+
+	scheduler.pendingMeshes.push_back(index);
+
+	return MeshHandle{ index , mesh.generation };
+}
+
+/// <summary>
+/// メッシュの登録を解除する（転送中のものは解除できない）
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="handle">メッシュの番号</param>
+void UnregisterMesh(MeshUploadScheduler& scheduler, MeshHandle handle)
+{
+	assert(GetMeshRecord(scheduler, handle) != nullptr);
+
+	MeshRecord& mesh = scheduler.meshes[handle.index];
+	assert(mesh.state != MeshUploadState::Uploading);
+
+	if (mesh.state == MeshUploadState::Pending)
+	{
+		std::erase(scheduler.pendingMeshes, handle.index);
+	}
+
+	mesh.isAlive = false;
+	mesh.generation++;
+	mesh.vertexData.clear();
+	mesh.vertexData.shrink_to_fit();
+	mesh.indexData.clear();
+	mesh.indexData.shrink_to_fit();
+
+	scheduler.freeIndices.push_back(handle.index);
+}
+
+/// <summary>
+/// メッシュの情報を取得する
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="handle">メッシュの番号</param>
+/// <returns>メッシュの情報（解放済みならnullptr）</returns>
+const MeshRecord* GetMeshRecord(const MeshUploadScheduler& scheduler, MeshHandle handle)
+{
+	if (handle.index >= scheduler.meshes.size())
+	{
+		return nullptr;
+	}
+
+	const MeshRecord& mesh = scheduler.meshes[handle.index];
+
+	if (!mesh.isAlive || mesh.generation != handle.generation)
+	{
+		return nullptr;
+	}
+
+	return &mesh;
+}
+
+/// <summary>
+/// 転送待ちのメッシュを登録順にステージングバッファへ書き込み、1回で送るコピーの一覧を作る
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="staging">ステージングバッファ（空きが足りなくなったところで止める）</param>
+/// <returns>コピーの一覧（送るものがなければ空）</returns>
+MeshUploadBatch BuildMeshUploadBatch(MeshUploadScheduler& scheduler, UploadRingBuffer& staging)
+{
+	// コピーの一覧
+	MeshUploadBatch batch{};
+
+	while (!scheduler.pendingMeshes.empty())
+	{
+		uint32_t index = scheduler.pendingMeshes.front();
+		MeshRecord& mesh = scheduler.meshes[index];
+
+		size_t vertexSize = mesh.vertexData.size();
+		size_t indexSize = mesh.indexData.size() * sizeof(uint32_t);
+
+		// 頂点とインデックスの両方が入らなければ、次のバッチに回す（登録順を守るため、後ろのメッシュも待たせる）
+		uint64_t head = staging.head;
+		UploadAllocation vertexAllocation = AllocateUploadRingBuffer(staging, vertexSize, kStagingAlignment);
+		UploadAllocation indexAllocation{};
+
+		if (vertexAllocation.cpuAddress != nullptr && indexSize > 0)
+		{
+			indexAllocation = AllocateUploadRingBuffer(staging, indexSize, kStagingAlignment);
+		}
+
+		if (vertexAllocation.cpuAddress == nullptr || (indexSize > 0 && indexAllocation.cpuAddress == nullptr))
+		{
+			// 切り出しかけた分は戻す
+			staging.head = head;
+
+			// 空のステージングバッファにも入らないメッシュは転送できない
+			assert(!(GetUploadRingBufferUsedSize(staging) == 0 && batch.copies.empty()));
+			break;
+		}
+
+		std::memcpy(vertexAllocation.cpuAddress, mesh.vertexData.data(), vertexSize);
+		batch.copies.push_back(MeshCopyCommand{ index , MeshBufferType::Vertex , vertexAllocation.offset , vertexSize });
+
+		if (indexSize > 0)
+		{
+			std::memcpy(indexAllocation.cpuAddress, mesh.indexData.data(), indexSize);
+			batch.copies.push_back(MeshCopyCommand{ index , MeshBufferType::Index , indexAllocation.offset , indexSize });
+		}
+
+		// ステージングバッファに書き込んだので、手元のデータはいらない
+		mesh.vertexData.clear();
+		mesh.vertexData.shrink_to_fit();
+		mesh.indexData.clear();
+		mesh.indexData.shrink_to_fit();
+
+		mesh.state = MeshUploadState::Uploading;
+		batch.meshIndices.push_back(index);
+		scheduler.pendingMeshes.pop_front();
+	}
+
+	return batch;
+}
+
+/// <summary>
+/// コピーを実行してSignalした後に呼び、転送中にする
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="batch">送ったコピーの一覧</param>
+/// <param name="staging">ステージングバッファ</param>
+/// <param name="fenceValue">コピーの後にSignalした値</param>
+void SubmitMeshUploadBatch(MeshUploadScheduler& scheduler, const MeshUploadBatch& batch, UploadRingBuffer& staging, uint64_t fenceValue)
+{
+	for (uint32_t index : batch.meshIndices)
+	{
+		scheduler.meshes[index].fenceValue = fenceValue;
+	}
+
+	scheduler.inFlightBatches.push_back(MeshUploadInFlight{ fenceValue , batch.meshIndices });
+	FinishUploadRingBufferFrame(staging, fenceValue);
+}
+
+/// <summary>
+/// 転送が終わったメッシュを使える状態にし、ステージングバッファを回収する
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="staging">ステージングバッファ</param>
+/// <param name="completedFenceValue">コピー用Fenceの現在の値</param>
+void UpdateMeshUploads(MeshUploadScheduler& scheduler, UploadRingBuffer& staging, uint64_t completedFenceValue)
+{
+	while (!scheduler.inFlightBatches.empty() && scheduler.inFlightBatches.front().fenceValue <= completedFenceValue)
+	{
+		for (uint32_t index : scheduler.inFlightBatches.front().meshIndices)
+		{
+			scheduler.meshes[index].state = MeshUploadState::Ready;
+		}
+
+		scheduler.inFlightBatches.pop_front();
+	}
+
+	ReclaimUploadRingBuffer(staging, completedFenceValue);
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+#include "../UploadRingBuffer/UploadRingBuffer.h"
+
+// メッシュを指す番号（generationが違えば解放済みのメッシュ）
+typedef struct MeshHandle
+{
+	// 番号
+	uint32_t index;
+
+	// 何回目に使われた番号か
+	uint32_t generation;
+}MeshHandle;
+
+// アップロードの状態
+enum class MeshUploadState
+{
+	// ステージングバッファへの書き込み待ち
+	Pending,
+
+	// コピーキューで転送中
+	Uploading,
+
+	// 描画に使える
+	Ready,
+};
+
+// コピー先のバッファ
+enum class MeshBufferType
+{
+	Vertex,
+	Index,
+};
+
+// メッシュの情報
+typedef struct MeshRecord
+{
+	// 何回目に使われた番号か
+	uint32_t generation;
+
+	// 使われているか
+	bool isAlive;
+
+	// アップロードの状態
+	MeshUploadState state;
+
+	// 頂点1つの大きさ
+	uint32_t vertexStride;
+
+	// 頂点バッファの大きさ
+	uint32_t vertexBufferSize;
+
+	// インデックスの数
+	uint32_t indexCount;
+
+	// 転送が終わるSignalの値
+	uint64_t fenceValue;
+
+	// ステージングバッファに書き込むまで持っておくデータ
+	std::vector<uint8_t> vertexData;
+	std::vector<uint32_t> indexData;
+}MeshRecord;
+
+// 1回のバッファコピー
+typedef struct MeshCopyCommand
+{
+	// コピー先のメッシュの番号
+	uint32_t meshIndex;
+
+	// コピー先のバッファ
+	MeshBufferType bufferType;
+
+	// ステージングバッファ内の位置
+	size_t stagingOffset;
+
+	// 大きさ
+	size_t size;
+}MeshCopyCommand;
+
+// まとめて送るコピー
+typedef struct MeshUploadBatch
+{
+	// コピーの一覧（登録した順）
+	std::vector<MeshCopyCommand> copies;
+
+	// このバッチで転送するメッシュの番号
+	std::vector<uint32_t> meshIndices;
+}MeshUploadBatch;
+
+// 転送中のバッチ
+typedef struct MeshUploadInFlight
+{
+	// 転送が終わるSignalの値
+	uint64_t fenceValue;
+
+	// 転送しているメッシュの番号
+	std::vector<uint32_t> meshIndices;
+}MeshUploadInFlight;
+
+/*
+	メッシュの登録と、ステージングバッファ経由の転送の順番を管理する
+	コピーの記録と実行は呼び出し側が行うので、D3D12に依存しない
+*/
+typedef struct MeshUploadScheduler
+{
+	// メッシュの情報（MeshHandle::indexで引く）
+	std::vector<MeshRecord> meshes;
+
+	// 空いている番号
+	std::vector<uint32_t> freeIndices;
+
+	// 書き込み待ちのメッシュ（登録した順）
+	std::deque<uint32_t> pendingMeshes;
+
+	// 転送中のバッチ（Signalした順）
+	std::deque<MeshUploadInFlight> inFlightBatches;
+}MeshUploadScheduler;
+
+/// <summary>
+/// メッシュを登録し、転送待ちにする（データはコピーして持つ）
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="vertexData">頂点データ</param>
+/// <param name="vertexStride">頂点1つの大きさ</param>
+/// <param name="indices">インデックス（空なら使わない）</param>
+/// <returns>メッシュの番号</returns>
+MeshHandle RegisterMesh(MeshUploadScheduler& scheduler, std::span<const uint8_t> vertexData, uint32_t vertexStride, std::span<const uint32_t> indices);
+
+/// <summary>
+/// メッシュの登録を解除する（転送中のものは解除できない）
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="handle">メッシュの番号</param>
+void UnregisterMesh(MeshUploadScheduler& scheduler, MeshHandle handle);
+
+/// <summary>
+/// メッシュの情報を取得する
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="handle">メッシュの番号</param>
+/// <returns>メッシュの情報（解放済みならnullptr）</returns>
+const MeshRecord* GetMeshRecord(const MeshUploadScheduler& scheduler, MeshHandle handle);
+
+/// <summary>
+/// 転送待ちのメッシュを登録順にステージングバッファへ書き込み、1回で送るコピーの一覧を作る
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="staging">ステージングバッファ（空きが足りなくなったところで止める）</param>
+/// <returns>コピーの一覧（送るものがなければ空）</returns>
+MeshUploadBatch BuildMeshUploadBatch(MeshUploadScheduler& scheduler, UploadRingBuffer& staging);
+
+/// <summary>
+/// コピーを実行してSignalした後に呼び、転送中にする
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="batch">送ったコピーの一覧</param>
+/// <param name="staging">ステージングバッファ</param>
+/// <param name="fenceValue">コピーの後にSignalした値</param>
+void SubmitMeshUploadBatch(MeshUploadScheduler& scheduler, const MeshUploadBatch& batch, UploadRingBuffer& staging, uint64_t fenceValue);
+
+/// <summary>
+/// 転送が終わったメッシュを使える状態にし、ステージングバッファを回収する
+/// </summary>
+/// <param name="scheduler">スケジューラー</param>
+/// <param name="staging">ステージングバッファ</param>
+/// <param name="completedFenceValue">コピー用Fenceの現在の値</param>
+void UpdateMeshUploads(MeshUploadScheduler& scheduler, UploadRingBuffer& staging, uint64_t completedFenceValue);
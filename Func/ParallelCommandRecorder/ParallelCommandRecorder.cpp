@@ -0,0 +1,100 @@
+#include "ParallelCommandRecorder.h"
+#include "../Create/Create.h"
+
+/// <summary>
+/// 記録を始められる状態のcommandListを1つ取得する（このフレームで実行するものとして登録される）
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="device"></param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <returns>Reset済みのcommandList</returns>
+ID3D12GraphicsCommandList* AcquireRecorderCommandList(ParallelCommandRecorder& recorder, ID3D12Device* device, uint64_t completedFenceValue)
+{
+	uint32_t contextIndex = AcquireRecordContext(recorder.pool, completedFenceValue);
+
+	// 初めて使う番号なら作る（作った直後のcommandListは記録できる状態になっている）
+	if (contextIndex == recorder.commandLists.size())
+	{
+		ID3D12CommandAllocator* commandAllocator = CreateCommandAllocator(device);
+		recorder.commandAllocators.push_back(commandAllocator);
+		recorder.commandLists.push_back(CreateCommandList(device, commandAllocator));
+
+		return recorder.commandLists[contextIndex];
+	}
+
+	// GPUが使い終わっているので、中身を捨てて記録し直す
+	HRESULT hr = recorder.commandAllocators[contextIndex]->Reset();
+	assert(SUCCEEDED(hr));
+	hr = recorder.commandLists[contextIndex]->Reset(recorder.commandAllocators[contextIndex], nullptr);
+	assert(SUCCEEDED(hr));
+
+	return recorder.commandLists[contextIndex];
+}
+
+/// <summary>
+/// 描画を範囲に分けて、範囲ごとに別のスレッドで記録する
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="device"></param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <param name="drawCount">描画の数</param>
+/// <param name="workerCount">使うスレッドの数</param>
+/// <param name="minDrawsPerList">1つのcommandListに最低限入れる描画の数</param>
+/// <param name="record">commandListと範囲を受け取って記録する関数（描画先やrootSignatureなどの設定もここで行う）</param>
+/// <returns>Close済みのcommandList（描画の順。この順で実行する）</returns>
+std::vector<ID3D12CommandList*> RecordCommandListsParallel
+(ParallelCommandRecorder& recorder, ID3D12Device* device, uint64_t completedFenceValue, uint32_t drawCount, uint32_t workerCount, uint32_t minDrawsPerList,
+	const std::function<void(ID3D12GraphicsCommandList* commandList, const RecordRange& range)>& record)
+{
+	std::vector<RecordRange> ranges = PartitionRecordRanges(drawCount, workerCount, minDrawsPerList);
+
+	// 記録先の取得と作成は、スレッドを分ける前に範囲の順で行う（実行の順が毎フレーム同じになる）
+	std::vector<ID3D12GraphicsCommandList*> commandLists(ranges.size());
+
+	for (size_t i = 0; i < ranges.size(); i++)
+	{
+		commandLists[i] = AcquireRecorderCommandList(recorder, device, completedFenceValue);
+	}
+
+	// 各スレッドは自分の範囲のcommandListだけに記録する
+	RecordRangesParallel(ranges,
+		[&](uint32_t rangeIndex, const RecordRange& range)
+		{
+			record(commandLists[rangeIndex], range);
+
+			HRESULT hr = commandLists[rangeIndex]->Close();
+			assert(SUCCEEDED(hr));
+		});
+
+	return std::vector<ID3D12CommandList*>(commandLists.begin(), commandLists.end());
+}
+
+/// <summary>
+/// このフレームで使ったcommandListを、Signalの値と結びつける
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishParallelCommandRecorderFrame(ParallelCommandRecorder& recorder, uint64_t fenceValue)
+{
+	FinishRecordContextFrame(recorder.pool, fenceValue);
+}
+
+/// <summary>
+/// ParallelCommandRecorderを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+void ReleaseParallelCommandRecorder(ParallelCommandRecorder& recorder)
+{
+	for (ID3D12GraphicsCommandList* commandList : recorder.commandLists)
+	{
+		commandList->Release();
+	}
+
+	for (ID3D12CommandAllocator* commandAllocator : recorder.commandAllocators)
+	{
+		commandAllocator->Release();
+	}
+
+	recorder.commandLists.clear();
+	recorder.commandAllocators.clear();
+}
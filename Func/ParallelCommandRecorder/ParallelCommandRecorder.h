@@ -0,0 +1,59 @@
+#pragma once
+#include <cassert>
+#include <functional>
+#include <vector>
+#include <d3d12.h>
+#include "../RecordScheduler/RecordScheduler.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	描画を複数のスレッドで別々のcommandListに記録する
+	記録先はスレッドごとにcommandAllocatorとcommandListの組を持ち、GPUが使い終わったら使い回す
+*/
+typedef struct ParallelCommandRecorder
+{
+	// 記録先の使い回しの管理
+	RecordContextPool pool;
+
+	// 記録先（RecordContextPoolの番号で引く）
+	std::vector<ID3D12CommandAllocator*> commandAllocators;
+	std::vector<ID3D12GraphicsCommandList*> commandLists;
+}ParallelCommandRecorder;
+
+/// <summary>
+/// 記録を始められる状態のcommandListを1つ取得する（このフレームで実行するものとして登録される）
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="device"></param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <returns>Reset済みのcommandList</returns>
+ID3D12GraphicsCommandList* AcquireRecorderCommandList(ParallelCommandRecorder& recorder, ID3D12Device* device, uint64_t completedFenceValue);
+
+/// <summary>
+/// 描画を範囲に分けて、範囲ごとに別のスレッドで記録する
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="device"></param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <param name="drawCount">描画の数</param>
+/// <param name="workerCount">使うスレッドの数</param>
+/// <param name="minDrawsPerList">1つのcommandListに最低限入れる描画の数</param>
+/// <param name="record">commandListと範囲を受け取って記録する関数（描画先やrootSignatureなどの設定もここで行う）</param>
+/// <returns>Close済みのcommandList（描画の順。この順で実行する）</returns>
+std::vector<ID3D12CommandList*> RecordCommandListsParallel
+(ParallelCommandRecorder& recorder, ID3D12Device* device, uint64_t completedFenceValue, uint32_t drawCount, uint32_t workerCount, uint32_t minDrawsPerList,
+	const std::function<void(ID3D12GraphicsCommandList* commandList, const RecordRange& range)>& record);
+
+/// <summary>
+/// このフレームで使ったcommandListを、Signalの値と結びつける
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishParallelCommandRecorderFrame(ParallelCommandRecorder& recorder, uint64_t fenceValue);
+
+/// <summary>
+/// ParallelCommandRecorderを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="recorder">ParallelCommandRecorder</param>
+void ReleaseParallelCommandRecorder(ParallelCommandRecorder& recorder);
@@ -0,0 +1,339 @@
+#include "PipelineDescription.h"
+#include "../Hash/Hash.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+
+namespace
+{
+	/// <summary>
+	/// ブレンドの設定のハッシュを続けて求める
+	/// </summary>
+	uint64_t HashBlendDescription(uint64_t hash, const PipelineBlendDescription& blend)
+	{
+		hash = HashValue(hash, blend.blendEnable);
+		hash = HashValue(hash, blend.srcBlend);
+		hash = HashValue(hash, blend.destBlend);
+		hash = HashValue(hash, blend.blendOp);
+		hash = HashValue(hash, blend.srcBlendAlpha);
+		hash = HashValue(hash, blend.destBlendAlpha);
+		hash = HashValue(hash, blend.blendOpAlpha);
+		hash = HashValue(hash, blend.logicOpEnable);
+		hash = HashValue(hash, blend.logicOp);
+		hash = HashValue(hash, blend.renderTargetWriteMask);
+		return hash;
+	}
+
+	/// <summary>
+	/// ステンシルの面の設定のハッシュを続けて求める
+	/// </summary>
+	uint64_t HashStencilOpDescription(uint64_t hash, const PipelineStencilOpDescription& stencilOp)
+	{
+		hash = HashValue(hash, stencilOp.stencilFailOp);
+		hash = HashValue(hash, stencilOp.stencilDepthFailOp);
+		hash = HashValue(hash, stencilOp.stencilPassOp);
+		hash = HashValue(hash, stencilOp.stencilFunc);
+		return hash;
+	}
+
+	/// <summary>
+	/// セマンティクス名を大文字にする（大文字小文字を区別しない）
+	/// </summary>
+	void NormalizeSemanticName(std::string& semanticName)
+	{
+		std::transform(semanticName.begin(), semanticName.end(), semanticName.begin(),
+			[](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+	}
+}
+
+/// <summary>
+/// 結果に影響しない値を揃える（ブレンドしないときの係数、カリングしないときの表裏の向きなど）
+/// </summary>
+/// <param name="description">パイプラインの設定</param>
+/// <returns>揃えた設定</returns>
+PipelineDescription NormalizePipelineDescription(const PipelineDescription& description)
+{
+	// 揃えた設定
+	PipelineDescription normalized = description;
+
+	assert(normalized.numRenderTargets <= kPipelineMaxRenderTargets);
+
+	// IndependentBlendEnableがfalseなら、RenderTarget[0]の設定が全てに使われる
+	uint32_t blendCount = normalized.independentBlendEnable ? normalized.numRenderTargets : 1;
+
+	for (uint32_t i = 0; i < kPipelineMaxRenderTargets; i++)
+	{
+		PipelineBlendDescription& blend = normalized.blend[i];
+
+		if (i >= blendCount)
+		{
+			blend = PipelineBlendDescription{};
+			continue;
+		}
+
+		// ブレンドしないなら係数は使われない
+		if (!blend.blendEnable)
+		{
+			PipelineBlendDescription used{};
+			used.logicOpEnable = blend.logicOpEnable;
+			used.logicOp = blend.logicOp;
+			used.renderTargetWriteMask = blend.renderTargetWriteMask;
+			blend = used;
+		}
+
+		// 論理演算しないなら演算の種類は使われない
+		if (!blend.logicOpEnable)
+		{
+			blend.logicOp = 0;
+		}
+	}
+
+	// 使わないRenderTargetの形式は見ない
+	for (uint32_t i = normalized.numRenderTargets; i < kPipelineMaxRenderTargets; i++)
+	{
+		normalized.rtvFormats[i] = 0;
+	}
+
+	// カリングしないなら、どちらが表かは結果に影響しない
+	const uint32_t kCullModeNone = 1;
+	if (normalized.rasterizer.cullMode == kCullModeNone)
+	{
+		normalized.rasterizer.frontCounterClockwise = false;
+	}
+
+	// 深度を使わないなら、書き込みと比較の設定は使われない
+	if (!normalized.depthEnable)
+	{
+		normalized.depthWriteMask = 0;
+		normalized.depthFunc = 0;
+	}
+
+	// ステンシルを使わないなら、マスクと面ごとの設定は使われない
+	if (!normalized.stencilEnable)
+	{
+		normalized.stencilReadMask = 0;
+		normalized.stencilWriteMask = 0;
+		normalized.frontFace = PipelineStencilOpDescription{};
+		normalized.backFace = PipelineStencilOpDescription{};
+	}
+
+	// セマンティクス名は大文字小文字を区別しない、頂点ごとのデータならインスタンスの進め方は使われない
+	const uint32_t kInputClassificationPerVertexData = 0;
+	for (PipelineInputElementDescription& element : normalized.inputLayout)
+	{
+		NormalizeSemanticName(element.semanticName);
+
+		if (element.inputSlotClass == kInputClassificationPerVertexData)
+		{
+			element.instanceDataStepRate = 0;
+		}
+	}
+
+	// ストリーム出力がなければ、バッファの間隔とラスタライズするストリームは使われない
+	for (PipelineStreamOutputElementDescription& element : normalized.streamOutput)
+	{
+		NormalizeSemanticName(element.semanticName);
+	}
+
+	if (normalized.streamOutput.empty())
+	{
+		normalized.streamOutputStrides.clear();
+		normalized.rasterizedStream = 0;
+	}
+
+	return normalized;
+}
+
+/// <summary>
+/// パイプラインの設定のハッシュを求める（揃えてから求める）
+/// </summary>
+/// <param name="description">パイプラインの設定</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashPipelineDescription(const PipelineDescription& description)
+{
+	PipelineDescription normalized = NormalizePipelineDescription(description);
+
+	// 構造体のパディングを含めないように、1項目ずつ混ぜる
+	uint64_t hash = kHashSeed;
+	hash = HashValue(hash, normalized.rootSignatureHash);
+	hash = HashValue(hash, normalized.vertexShaderHash);
+	hash = HashValue(hash, normalized.pixelShaderHash);
+	hash = HashValue(hash, normalized.geometryShaderHash);
+	hash = HashValue(hash, normalized.hullShaderHash);
+	hash = HashValue(hash, normalized.domainShaderHash);
+
+	hash = HashValue(hash, static_cast<uint64_t>(normalized.streamOutput.size()));
+	for (const PipelineStreamOutputElementDescription& element : normalized.streamOutput)
+	{
+		hash = HashValue(hash, element.stream);
+		hash = HashString(hash, element.semanticName);
+		hash = HashValue(hash, element.semanticIndex);
+		hash = HashValue(hash, element.startComponent);
+		hash = HashValue(hash, element.componentCount);
+		hash = HashValue(hash, element.outputSlot);
+	}
+	hash = HashValue(hash, static_cast<uint64_t>(normalized.streamOutputStrides.size()));
+	for (uint32_t stride : normalized.streamOutputStrides)
+	{
+		hash = HashValue(hash, stride);
+	}
+	hash = HashValue(hash, normalized.rasterizedStream);
+
+	hash = HashValue(hash, normalized.alphaToCoverageEnable);
+	hash = HashValue(hash, normalized.independentBlendEnable);
+	for (const PipelineBlendDescription& blend : normalized.blend)
+	{
+		hash = HashBlendDescription(hash, blend);
+	}
+	hash = HashValue(hash, normalized.sampleMask);
+
+	hash = HashValue(hash, normalized.rasterizer.fillMode);
+	hash = HashValue(hash, normalized.rasterizer.cullMode);
+	hash = HashValue(hash, normalized.rasterizer.frontCounterClockwise);
+	hash = HashValue(hash, normalized.rasterizer.depthBias);
+	hash = HashValue(hash, normalized.rasterizer.depthBiasClamp);
+	hash = HashValue(hash, normalized.rasterizer.slopeScaledDepthBias);
+	hash = HashValue(hash, normalized.rasterizer.depthClipEnable);
+	hash = HashValue(hash, normalized.rasterizer.multisampleEnable);
+	hash = HashValue(hash, normalized.rasterizer.antialiasedLineEnable);
+	hash = HashValue(hash, normalized.rasterizer.forcedSampleCount);
+	hash = HashValue(hash, normalized.rasterizer.conservativeRaster);
+
+	hash = HashValue(hash, normalized.depthEnable);
+	hash = HashValue(hash, normalized.depthWriteMask);
+	hash = HashValue(hash, normalized.depthFunc);
+
+	hash = HashValue(hash, normalized.stencilEnable);
+	hash = HashValue(hash, normalized.stencilReadMask);
+	hash = HashValue(hash, normalized.stencilWriteMask);
+	hash = HashStencilOpDescription(hash, normalized.frontFace);
+	hash = HashStencilOpDescription(hash, normalized.backFace);
+
+	hash = HashValue(hash, static_cast<uint64_t>(normalized.inputLayout.size()));
+	for (const PipelineInputElementDescription& element : normalized.inputLayout)
+	{
+		hash = HashString(hash, element.semanticName);
+		hash = HashValue(hash, element.semanticIndex);
+		hash = HashValue(hash, element.format);
+		hash = HashValue(hash, element.inputSlot);
+		hash = HashValue(hash, element.alignedByteOffset);
+		hash = HashValue(hash, element.inputSlotClass);
+		hash = HashValue(hash, element.instanceDataStepRate);
+	}
+	hash = HashValue(hash, normalized.ibStripCutValue);
+	hash = HashValue(hash, normalized.primitiveTopologyType);
+
+	hash = HashValue(hash, normalized.numRenderTargets);
+	for (uint32_t format : normalized.rtvFormats)
+	{
+		hash = HashValue(hash, format);
+	}
+	hash = HashValue(hash, normalized.dsvFormat);
+	hash = HashValue(hash, normalized.sampleCount);
+	hash = HashValue(hash, normalized.sampleQuality);
+
+	hash = HashValue(hash, normalized.nodeMask);
+	hash = HashValue(hash, normalized.flags);
+
+	return hash;
+}
+
+/// <summary>
+/// 同じハッシュのパイプラインがあればそれを使い、なければ作る
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="hash">設定のハッシュ</param>
+/// <param name="create">パイプラインを作る関数（新しく作るときだけ呼ばれる。失敗したらnullptrを返す）</param>
+/// <param name="isAsync">別のスレッドで作るか</param>
+/// <returns>slotsの番号</returns>
+uint32_t FindOrCreatePipeline(PipelineCacheTable& table, uint64_t hash, const std::function<void* ()>& create, bool isAsync)
+{
+	auto found = table.slotIndices.find(hash);
+
+	if (found != table.slotIndices.end())
+	{
+		table.hitCount++;
+		return found->second;
+	}
+
+	table.missCount++;
+
+	// パイプライン
+	PipelineCacheSlot slot{};
+	slot.hash = hash;
+
+	if (isAsync)
+	{
+		slot.pipeline = std::async(std::launch::async, create).share();
+	}
+	else
+	{
+		std::promise<void*> promise;
+		promise.set_value(create());
+		slot.pipeline = promise.get_future().share();
+	}
+
+	uint32_t slotIndex = static_cast<uint32_t>(table.slots.size());
+	table.slots.push_back(slot);
+	table.slotIndices.emplace(hash, slotIndex);
+
+	return slotIndex;
+}
+
+/// <summary>
+/// パイプラインを作った結果を取得する（待たない）
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+/// <returns>作った結果</returns>
+PipelineCreateStatus GetPipelineStatus(const PipelineCacheTable& table, uint32_t slotIndex)
+{
+	assert(slotIndex < table.slots.size());
+
+	const std::shared_future<void*>& pipeline = table.slots[slotIndex].pipeline;
+
+	if (pipeline.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return PipelineCreateStatus::Pending;
+	}
+
+	return pipeline.get() != nullptr ? PipelineCreateStatus::Ready : PipelineCreateStatus::Failed;
+}
+
+/// <summary>
+/// 作れなかったパイプラインを表から外す（次に同じハッシュで求められたら作り直す。slotsの番号は変わらない）
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+void ErasePipeline(PipelineCacheTable& table, uint32_t slotIndex)
+{
+	assert(slotIndex < table.slots.size());
+
+	// 同じハッシュで作り直した後なら、新しい方は残す
+	auto found = table.slotIndices.find(table.slots[slotIndex].hash);
+	if (found != table.slotIndices.end() && found->second == slotIndex)
+	{
+		table.slotIndices.erase(found);
+	}
+}
+
+/// <summary>
+/// パイプラインを取得する
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+/// <param name="wait">作り終わるまで待つか</param>
+/// <returns>パイプライン（待たないときに作り終わっていないか、作れなかったならnullptr）</returns>
+void* GetPipeline(const PipelineCacheTable& table, uint32_t slotIndex, bool wait)
+{
+	assert(slotIndex < table.slots.size());
+
+	const std::shared_future<void*>& pipeline = table.slots[slotIndex].pipeline;
+
+	if (!wait && pipeline.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return nullptr;
+	}
+
+	return pipeline.get();
+}
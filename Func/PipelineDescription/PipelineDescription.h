@@ -0,0 +1,220 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// RenderTargetの最大数（D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT）
+const uint32_t kPipelineMaxRenderTargets = 8;
+
+// RenderTarget1つ分のブレンド
+typedef struct PipelineBlendDescription
+{
+	bool blendEnable;
+	uint32_t srcBlend;
+	uint32_t destBlend;
+	uint32_t blendOp;
+	uint32_t srcBlendAlpha;
+	uint32_t destBlendAlpha;
+	uint32_t blendOpAlpha;
+	bool logicOpEnable;
+	uint32_t logicOp;
+	uint32_t renderTargetWriteMask;
+}PipelineBlendDescription;
+
+// ラスタライザ
+typedef struct PipelineRasterizerDescription
+{
+	uint32_t fillMode;
+	uint32_t cullMode;
+	bool frontCounterClockwise;
+	int32_t depthBias;
+	float depthBiasClamp;
+	float slopeScaledDepthBias;
+	bool depthClipEnable;
+	bool multisampleEnable;
+	bool antialiasedLineEnable;
+	uint32_t forcedSampleCount;
+	uint32_t conservativeRaster;
+}PipelineRasterizerDescription;
+
+// ステンシルの面1つ分
+typedef struct PipelineStencilOpDescription
+{
+	uint32_t stencilFailOp;
+	uint32_t stencilDepthFailOp;
+	uint32_t stencilPassOp;
+	uint32_t stencilFunc;
+}PipelineStencilOpDescription;
+
+// 頂点の要素1つ分
+typedef struct PipelineInputElementDescription
+{
+	std::string semanticName;
+	uint32_t semanticIndex;
+	uint32_t format;
+	uint32_t inputSlot;
+	uint32_t alignedByteOffset;
+	uint32_t inputSlotClass;
+	uint32_t instanceDataStepRate;
+}PipelineInputElementDescription;
+
+// ストリーム出力の要素1つ分
+typedef struct PipelineStreamOutputElementDescription
+{
+	uint32_t stream;
+	std::string semanticName;
+	uint32_t semanticIndex;
+	uint32_t startComponent;
+	uint32_t componentCount;
+	uint32_t outputSlot;
+}PipelineStreamOutputElementDescription;
+
+/*
+	パイプラインの設定から、結果に影響するものだけを取り出したもの
+	シェーダーやrootSignatureはバイナリのハッシュで持つので、ポインタが違っても中身が同じなら同じになる
+*/
+typedef struct PipelineDescription
+{
+	// rootSignatureの中身のハッシュ
+	uint64_t rootSignatureHash;
+
+	// シェーダーのバイトコードのハッシュ（使わないものは0）
+	uint64_t vertexShaderHash;
+	uint64_t pixelShaderHash;
+	uint64_t geometryShaderHash;
+	uint64_t hullShaderHash;
+	uint64_t domainShaderHash;
+
+	// ストリーム出力
+	std::vector<PipelineStreamOutputElementDescription> streamOutput;
+	std::vector<uint32_t> streamOutputStrides;
+	uint32_t rasterizedStream;
+
+	// ブレンド
+	bool alphaToCoverageEnable;
+	bool independentBlendEnable;
+	PipelineBlendDescription blend[kPipelineMaxRenderTargets];
+	uint32_t sampleMask;
+
+	// ラスタライザ
+	PipelineRasterizerDescription rasterizer;
+
+	// 深度
+	bool depthEnable;
+	uint32_t depthWriteMask;
+	uint32_t depthFunc;
+
+	// ステンシル
+	bool stencilEnable;
+	uint32_t stencilReadMask;
+	uint32_t stencilWriteMask;
+	PipelineStencilOpDescription frontFace;
+	PipelineStencilOpDescription backFace;
+
+	// 頂点
+	std::vector<PipelineInputElementDescription> inputLayout;
+	uint32_t ibStripCutValue;
+	uint32_t primitiveTopologyType;
+
+	// 書き込み先
+	uint32_t numRenderTargets;
+	uint32_t rtvFormats[kPipelineMaxRenderTargets];
+	uint32_t dsvFormat;
+	uint32_t sampleCount;
+	uint32_t sampleQuality;
+
+	// 使うGPUとフラグ
+	uint32_t nodeMask;
+	uint32_t flags;
+}PipelineDescription;
+
+// パイプラインを作った結果
+enum class PipelineCreateStatus
+{
+	// 別のスレッドで作っている
+	Pending,
+
+	// 作り終わった
+	Ready,
+
+	// 作れなかった
+	Failed
+};
+
+// 作ったパイプライン1つ分
+typedef struct PipelineCacheSlot
+{
+	// 設定のハッシュ
+	uint64_t hash;
+
+	// 作った結果（非同期なら作り終わるまで待てる）
+	std::shared_future<void*> pipeline;
+}PipelineCacheSlot;
+
+/*
+	設定のハッシュで、同じパイプラインを二度作らないようにする
+	パイプラインは void* で持つので、描画APIに依存しない
+*/
+typedef struct PipelineCacheTable
+{
+	// ハッシュ -> slotsの番号
+	std::unordered_map<uint64_t, uint32_t> slotIndices;
+
+	// 作ったパイプライン（作った順）
+	std::vector<PipelineCacheSlot> slots;
+
+	// 既にあったものを返した回数と、新しく作った回数
+	uint32_t hitCount;
+	uint32_t missCount;
+}PipelineCacheTable;
+
+/// <summary>
+/// 結果に影響しない値を揃える（ブレンドしないときの係数、カリングしないときの表裏の向きなど）
+/// </summary>
+/// <param name="description">パイプラインの設定</param>
+/// <returns>揃えた設定</returns>
+PipelineDescription NormalizePipelineDescription(const PipelineDescription& description);
+
+/// <summary>
+/// パイプラインの設定のハッシュを求める（揃えてから求める）
+/// </summary>
+/// <param name="description">パイプラインの設定</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashPipelineDescription(const PipelineDescription& description);
+
+/// <summary>
+/// 同じハッシュのパイプラインがあればそれを使い、なければ作る
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="hash">設定のハッシュ</param>
+/// <param name="create">パイプラインを作る関数（新しく作るときだけ呼ばれる。失敗したらnullptrを返す）</param>
+/// <param name="isAsync">別のスレッドで作るか</param>
+/// <returns>slotsの番号</returns>
+uint32_t FindOrCreatePipeline(PipelineCacheTable& table, uint64_t hash, const std::function<void* ()>& create, bool isAsync);
+
+/// <summary>
+/// パイプラインを作った結果を取得する（待たない）
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+/// <returns>作った結果</returns>
+PipelineCreateStatus GetPipelineStatus(const PipelineCacheTable& table, uint32_t slotIndex);
+
+/// <summary>
+/// 作れなかったパイプラインを表から外す（次に同じハッシュで求められたら作り直す。slotsの番号は変わらない）
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+void ErasePipeline(PipelineCacheTable& table, uint32_t slotIndex);
+
+/// <summary>
+/// パイプラインを取得する
+/// </summary>
+/// <param name="table">PipelineCacheTable</param>
+/// <param name="slotIndex">slotsの番号</param>
+/// <param name="wait">作り終わるまで待つか</param>
+/// <returns>パイプライン（待たないときに作り終わっていないか、作れなかったならnullptr）</returns>
+void* GetPipeline(const PipelineCacheTable& table, uint32_t slotIndex, bool wait);
@@ -0,0 +1,355 @@
+#include "PipelineStateCache.h"
+#include "../Hash/Hash.h"
+#include <format>
+#include <fstream>
+
+namespace
+{
+	/// <summary>
+	/// libraryに登録する名前（設定のハッシュの16進数）
+	/// </summary>
+	std::wstring MakePipelineName(uint64_t hash)
+	{
+		return std::format(L"{:016x}", hash);
+	}
+
+	/// <summary>
+	/// シェーダーのバイトコードのハッシュ（使わないなら0）
+	/// </summary>
+	uint64_t HashShaderBytecode(const D3D12_SHADER_BYTECODE& shader)
+	{
+		if (shader.pShaderBytecode == nullptr || shader.BytecodeLength == 0)
+		{
+			return 0;
+		}
+
+		return HashBytes(shader.pShaderBytecode, shader.BytecodeLength);
+	}
+
+	/// <summary>
+	/// ステンシルの面の設定を写す
+	/// </summary>
+	PipelineStencilOpDescription MakeStencilOpDescription(const D3D12_DEPTH_STENCILOP_DESC& stencilOp)
+	{
+		return PipelineStencilOpDescription{
+			static_cast<uint32_t>(stencilOp.StencilFailOp) , static_cast<uint32_t>(stencilOp.StencilDepthFailOp) ,
+			static_cast<uint32_t>(stencilOp.StencilPassOp) , static_cast<uint32_t>(stencilOp.StencilFunc) };
+	}
+}
+
+/// <summary>
+/// PipelineStateCacheを作る（保存されたファイルがあれば読む）
+/// </summary>
+/// <param name="device"></param>
+/// <param name="libraryPath">保存先</param>
+/// <returns>PipelineStateCache</returns>
+PipelineStateCache CreatePipelineStateCache(ID3D12Device* device, const std::filesystem::path& libraryPath)
+{
+	// PipelineStateCache
+	PipelineStateCache cache{};
+	cache.libraryPath = libraryPath;
+
+	HRESULT hr = device->QueryInterface(IID_PPV_ARGS(&cache.device));
+	assert(SUCCEEDED(hr));
+
+	// 保存されたファイルを読む
+	std::ifstream file(libraryPath, std::ios::binary);
+
+	if (file)
+	{
+		cache.libraryData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	if (!cache.libraryData.empty())
+	{
+		hr = cache.device->CreatePipelineLibrary(cache.libraryData.data(), cache.libraryData.size(), IID_PPV_ARGS(&cache.library));
+
+		// ドライバやGPUが変わっていると読めないので、空から作り直す
+		if (FAILED(hr))
+		{
+			cache.library = nullptr;
+			cache.libraryData.clear();
+		}
+	}
+
+	if (cache.library == nullptr)
+	{
+		hr = cache.device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&cache.library));
+		assert(SUCCEEDED(hr));
+	}
+
+	return cache;
+}
+
+/// <summary>
+/// 設定から、比較とハッシュに使う形を作る
+/// </summary>
+/// <param name="desc">PSOの設定</param>
+/// <param name="rootSignatureHash">rootSignatureの中身のハッシュ</param>
+/// <returns>比較とハッシュに使う形</returns>
+PipelineDescription MakePipelineDescription(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash)
+{
+	// 比較とハッシュに使う形
+	PipelineDescription description{};
+
+	description.rootSignatureHash = rootSignatureHash;
+	description.vertexShaderHash = HashShaderBytecode(desc.VS);
+	description.pixelShaderHash = HashShaderBytecode(desc.PS);
+	description.geometryShaderHash = HashShaderBytecode(desc.GS);
+	description.hullShaderHash = HashShaderBytecode(desc.HS);
+	description.domainShaderHash = HashShaderBytecode(desc.DS);
+
+	// ストリーム出力
+	for (UINT i = 0; i < desc.StreamOutput.NumEntries; i++)
+	{
+		const D3D12_SO_DECLARATION_ENTRY& entry = desc.StreamOutput.pSODeclaration[i];
+		description.streamOutput.push_back(PipelineStreamOutputElementDescription{
+			entry.Stream , entry.SemanticName ? entry.SemanticName : "" , entry.SemanticIndex ,
+			entry.StartComponent , entry.ComponentCount , entry.OutputSlot });
+	}
+	description.streamOutputStrides.assign(desc.StreamOutput.pBufferStrides, desc.StreamOutput.pBufferStrides + desc.StreamOutput.NumStrides);
+	description.rasterizedStream = desc.StreamOutput.RasterizedStream;
+
+	// ブレンド
+	description.alphaToCoverageEnable = desc.BlendState.AlphaToCoverageEnable;
+	description.independentBlendEnable = desc.BlendState.IndependentBlendEnable;
+	for (uint32_t i = 0; i < kPipelineMaxRenderTargets; i++)
+	{
+		const D3D12_RENDER_TARGET_BLEND_DESC& renderTarget = desc.BlendState.RenderTarget[i];
+		PipelineBlendDescription& blend = description.blend[i];
+
+		blend.blendEnable = renderTarget.BlendEnable;
+		blend.srcBlend = renderTarget.SrcBlend;
+		blend.destBlend = renderTarget.DestBlend;
+		blend.blendOp = renderTarget.BlendOp;
+		blend.srcBlendAlpha = renderTarget.SrcBlendAlpha;
+		blend.destBlendAlpha = renderTarget.DestBlendAlpha;
+		blend.blendOpAlpha = renderTarget.BlendOpAlpha;
+		blend.logicOpEnable = renderTarget.LogicOpEnable;
+		blend.logicOp = renderTarget.LogicOp;
+		blend.renderTargetWriteMask = renderTarget.RenderTargetWriteMask;
+	}
+	description.sampleMask = desc.SampleMask;
+
+	// ラスタライザ
+	description.rasterizer.fillMode = desc.RasterizerState.FillMode;
+	description.rasterizer.cullMode = desc.RasterizerState.CullMode;
+	description.rasterizer.frontCounterClockwise = desc.RasterizerState.FrontCounterClockwise;
+	description.rasterizer.depthBias = desc.RasterizerState.DepthBias;
+	description.rasterizer.depthBiasClamp = desc.RasterizerState.DepthBiasClamp;
+	description.rasterizer.slopeScaledDepthBias = desc.RasterizerState.SlopeScaledDepthBias;
+	description.rasterizer.depthClipEnable = desc.RasterizerState.DepthClipEnable;
+	description.rasterizer.multisampleEnable = desc.RasterizerState.MultisampleEnable;
+	description.rasterizer.antialiasedLineEnable = desc.RasterizerState.AntialiasedLineEnable;
+	description.rasterizer.forcedSampleCount = desc.RasterizerState.ForcedSampleCount;
+	description.rasterizer.conservativeRaster = desc.RasterizerState.ConservativeRaster;
+
+	// 深度
+	description.depthEnable = desc.DepthStencilState.DepthEnable;
+	description.depthWriteMask = desc.DepthStencilState.DepthWriteMask;
+	description.depthFunc = desc.DepthStencilState.DepthFunc;
+
+	// ステンシル
+	description.stencilEnable = desc.DepthStencilState.StencilEnable;
+	description.stencilReadMask = desc.DepthStencilState.StencilReadMask;
+	description.stencilWriteMask = desc.DepthStencilState.StencilWriteMask;
+	description.frontFace = MakeStencilOpDescription(desc.DepthStencilState.FrontFace);
+	description.backFace = MakeStencilOpDescription(desc.DepthStencilState.BackFace);
+
+	// 頂点
+	for (UINT i = 0; i < desc.InputLayout.NumElements; i++)
+	{
+		const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+		description.inputLayout.push_back(PipelineInputElementDescription{
+			element.SemanticName , element.SemanticIndex , static_cast<uint32_t>(element.Format) , element.InputSlot , element.AlignedByteOffset ,
+			static_cast<uint32_t>(element.InputSlotClass) , element.InstanceDataStepRate });
+	}
+	description.ibStripCutValue = desc.IBStripCutValue;
+	description.primitiveTopologyType = desc.PrimitiveTopologyType;
+
+	// 書き込み先
+	description.numRenderTargets = desc.NumRenderTargets;
+	for (uint32_t i = 0; i < kPipelineMaxRenderTargets; i++)
+	{
+		description.rtvFormats[i] = desc.RTVFormats[i];
+	}
+	description.dsvFormat = desc.DSVFormat;
+	description.sampleCount = desc.SampleDesc.Count;
+	description.sampleQuality = desc.SampleDesc.Quality;
+
+	// 使うGPUとフラグ（CachedPSOは作った結果に影響しないので見ない）
+	description.nodeMask = desc.NodeMask;
+	description.flags = desc.Flags;
+
+	return description;
+}
+
+/// <summary>
+/// PSOを取得する（同じ設定なら使い回し、保存されていれば読み、なければ作る）
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+/// <param name="desc">PSOの設定</param>
+/// <param name="rootSignatureHash">rootSignatureの中身のハッシュ（ポインタは起動ごとに変わるので中身で区別する）</param>
+/// <param name="isAsync">作るときに別のスレッドで作るか（作り終わるまではnullptrを返す。シェーダーとrootSignatureは作り終わるまで解放しない）</param>
+/// <param name="status">作った結果の出力先（作り終わっていない、作れなかったを区別するときに渡す。nullptrでもよい）</param>
+/// <returns>PSO（作り終わっていないか、作れなかったならnullptr）</returns>
+ID3D12PipelineState* GetGraphicsPipelineState(PipelineStateCache& cache, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash, bool isAsync,
+	PipelineCreateStatus* status)
+{
+	uint64_t hash = HashPipelineDescription(MakePipelineDescription(desc, rootSignatureHash));
+	size_t slotCount = cache.table.slots.size();
+
+	// libraryから読むのはすぐ終わるので、このスレッドで行う
+	ID3D12PipelineState* loadedPipelineState = nullptr;
+	if (cache.table.slotIndices.find(hash) == cache.table.slotIndices.end())
+	{
+		HRESULT hr = cache.library->LoadGraphicsPipeline(MakePipelineName(hash).c_str(), &desc, IID_PPV_ARGS(&loadedPipelineState));
+		if (FAILED(hr))
+		{
+			loadedPipelineState = nullptr;
+		}
+	}
+
+	// 読めなければ作る（descの中身は作り終わるまで使うので、別のスレッドにはコピーを渡す）
+	ID3D12Device1* device = cache.device;
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC descCopy = desc;
+	std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements(desc.InputLayout.pInputElementDescs, desc.InputLayout.pInputElementDescs + desc.InputLayout.NumElements);
+	std::vector<D3D12_SO_DECLARATION_ENTRY> streamOutputEntries(desc.StreamOutput.pSODeclaration, desc.StreamOutput.pSODeclaration + desc.StreamOutput.NumEntries);
+	std::vector<UINT> streamOutputStrides(desc.StreamOutput.pBufferStrides, desc.StreamOutput.pBufferStrides + desc.StreamOutput.NumStrides);
+
+	uint32_t slotIndex = FindOrCreatePipeline(cache.table, hash,
+		[=]() mutable -> void*
+		{
+			if (loadedPipelineState)
+			{
+				return loadedPipelineState;
+			}
+
+			descCopy.InputLayout.pInputElementDescs = inputElements.data();
+			descCopy.StreamOutput.pSODeclaration = streamOutputEntries.data();
+			descCopy.StreamOutput.pBufferStrides = streamOutputStrides.data();
+
+			// シェーダーとrootSignatureが合わないときなどは作れないので、nullptrを返して呼び出し側に任せる
+			ID3D12PipelineState* pipelineState = nullptr;
+			HRESULT hr = device->CreateGraphicsPipelineState(&descCopy, IID_PPV_ARGS(&pipelineState));
+			if (FAILED(hr))
+			{
+				return nullptr;
+			}
+
+			return pipelineState;
+		}, isAsync && loadedPipelineState == nullptr);
+
+	// 新しく作ったものは、保存のときにlibraryへ追加する
+	if (cache.table.slots.size() != slotCount)
+	{
+		if (loadedPipelineState)
+		{
+			cache.loadedCount++;
+		}
+		else
+		{
+			cache.unstoredSlots.push_back(slotIndex);
+		}
+	}
+
+	ID3D12PipelineState* pipelineState = static_cast<ID3D12PipelineState*>(GetPipeline(cache.table, slotIndex, !isAsync));
+	PipelineCreateStatus createStatus = GetPipelineStatus(cache.table, slotIndex);
+
+	// 作れなかったものは覚えない（次に求められたら作り直す）
+	if (createStatus == PipelineCreateStatus::Failed)
+	{
+		ErasePipeline(cache.table, slotIndex);
+	}
+
+	if (status)
+	{
+		*status = createStatus;
+	}
+
+	return pipelineState;
+}
+
+/// <summary>
+/// 新しく作ったPSOをlibraryに追加し、ファイルに保存する
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+void SavePipelineStateCache(PipelineStateCache& cache)
+{
+	if (cache.unstoredSlots.empty())
+	{
+		return;
+	}
+
+	for (uint32_t slotIndex : cache.unstoredSlots)
+	{
+		const PipelineCacheSlot& slot = cache.table.slots[slotIndex];
+		ID3D12PipelineState* pipelineState = static_cast<ID3D12PipelineState*>(GetPipeline(cache.table, slotIndex, true));
+
+		// 作れなかったものは保存しない
+		if (pipelineState == nullptr)
+		{
+			continue;
+		}
+
+		HRESULT hr = cache.library->StorePipeline(MakePipelineName(slot.hash).c_str(), pipelineState);
+		assert(SUCCEEDED(hr) || hr == E_INVALIDARG);
+	}
+
+	cache.unstoredSlots.clear();
+
+	// 書き出す
+	std::vector<uint8_t> serialized(cache.library->GetSerializedSize());
+	HRESULT hr = cache.library->Serialize(serialized.data(), serialized.size());
+	if (FAILED(hr))
+	{
+		return;
+	}
+
+	std::error_code error;
+	if (cache.libraryPath.has_parent_path())
+	{
+		std::filesystem::create_directories(cache.libraryPath.parent_path(), error);
+	}
+
+	// 書ききれなかったファイルを次の起動で読まないように、別名で書いてから置き換える
+	std::filesystem::path temporaryPath = cache.libraryPath;
+	temporaryPath += ".tmp";
+
+	std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(serialized.data()), static_cast<std::streamsize>(serialized.size()));
+	file.close();
+
+	if (file)
+	{
+		std::filesystem::rename(temporaryPath, cache.libraryPath, error);
+	}
+
+	if (!file || error)
+	{
+		std::filesystem::remove(temporaryPath, error);
+	}
+}
+
+/// <summary>
+/// PipelineStateCacheと、作った全てのPSOを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+void ReleasePipelineStateCache(PipelineStateCache& cache)
+{
+	for (uint32_t i = 0; i < cache.table.slots.size(); i++)
+	{
+		ID3D12PipelineState* pipelineState = static_cast<ID3D12PipelineState*>(GetPipeline(cache.table, i, true));
+
+		if (pipelineState)
+		{
+			pipelineState->Release();
+		}
+	}
+
+	cache.table = PipelineCacheTable{};
+	cache.unstoredSlots.clear();
+
+	cache.library->Release();
+	cache.device->Release();
+}
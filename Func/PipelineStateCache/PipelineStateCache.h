@@ -0,0 +1,76 @@
+#pragma once
+#include <cassert>
+#include <filesystem>
+#include <vector>
+#include <d3d12.h>
+#include "../PipelineDescription/PipelineDescription.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	PSOを設定のハッシュで使い回し、PipelineLibraryでファイルに保存する
+	2回目以降の起動では、保存したものを読むだけで作り直さずに済む
+*/
+typedef struct PipelineStateCache
+{
+	// 同じ設定のPSOを二度作らないための表
+	PipelineCacheTable table;
+
+	// PipelineLibraryを作るためのデバイス
+	ID3D12Device1* device;
+
+	// 保存されたPSOの集まり
+	ID3D12PipelineLibrary* library;
+
+	// ファイルから読んだデータ（libraryが使っている間は残しておく）
+	std::vector<uint8_t> libraryData;
+
+	// 保存先
+	std::filesystem::path libraryPath;
+
+	// libraryに入っていないPSOのslotsの番号（保存のときに追加する）
+	std::vector<uint32_t> unstoredSlots;
+
+	// ファイルから読めた数
+	uint32_t loadedCount;
+}PipelineStateCache;
+
+/// <summary>
+/// PipelineStateCacheを作る（保存されたファイルがあれば読む）
+/// </summary>
+/// <param name="device"></param>
+/// <param name="libraryPath">保存先</param>
+/// <returns>PipelineStateCache</returns>
+PipelineStateCache CreatePipelineStateCache(ID3D12Device* device, const std::filesystem::path& libraryPath);
+
+/// <summary>
+/// 設定から、比較とハッシュに使う形を作る
+/// </summary>
+/// <param name="desc">PSOの設定</param>
+/// <param name="rootSignatureHash">rootSignatureの中身のハッシュ</param>
+/// <returns>比較とハッシュに使う形</returns>
+PipelineDescription MakePipelineDescription(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+
+/// <summary>
+/// PSOを取得する（同じ設定なら使い回し、保存されていれば読み、なければ作る）
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+/// <param name="desc">PSOの設定</param>
+/// <param name="rootSignatureHash">rootSignatureの中身のハッシュ（ポインタは起動ごとに変わるので中身で区別する）</param>
+/// <param name="isAsync">作るときに別のスレッドで作るか（作り終わるまではnullptrを返す。シェーダーとrootSignatureは作り終わるまで解放しない）</param>
+/// <param name="status">作った結果の出力先（作り終わっていない、作れなかったを区別するときに渡す。nullptrでもよい）</param>
+/// <returns>PSO（作り終わっていないか、作れなかったならnullptr）</returns>
+ID3D12PipelineState* GetGraphicsPipelineState(PipelineStateCache& cache, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash, bool isAsync,
+	PipelineCreateStatus* status = nullptr);
+
+/// <summary>
+/// 新しく作ったPSOをlibraryに追加し、ファイルに保存する
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+void SavePipelineStateCache(PipelineStateCache& cache);
+
+/// <summary>
+/// PipelineStateCacheと、作った全てのPSOを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="cache">PipelineStateCache</param>
+void ReleasePipelineStateCache(PipelineStateCache& cache);
@@ -0,0 +1,249 @@
+#include "Quaternion.h"
+#include "../Vector/Vector.h"
+
+/// <summary>
+/// 正規化する
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>正規化したクォータニオン（ノルムが0のときは単位クォータニオン）</returns>
+Quaternion NormalizeQuaternion(const Quaternion& q)
+{
+	// ノルム
+	float norm = Norm(q);
+
+	if (norm == 0.0f)
+	{
+		return MakeIdentityQuaternion();
+	}
+
+	float inverseNorm = 1.0f / norm;
+	return Quaternion{ q.x * inverseNorm , q.y * inverseNorm , q.z * inverseNorm , q.w * inverseNorm };
+}
+
+/// <summary>
+/// 逆クォータニオンを求める
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>逆クォータニオン</returns>
+Quaternion Inverse(const Quaternion& q)
+{
+	// ノルムの2乗
+	float normSquared = DotQuaternion(q, q);
+
+	if (normSquared == 0.0f)
+	{
+		return MakeIdentityQuaternion();
+	}
+
+	// 共役クォータニオン
+	Quaternion conjugate = Conjugate(q);
+
+	float inverseNormSquared = 1.0f / normSquared;
+	return Quaternion{ conjugate.x * inverseNormSquared , conjugate.y * inverseNormSquared , conjugate.z * inverseNormSquared , conjugate.w * inverseNormSquared };
+}
+
+/// <summary>
+/// 任意軸回転のクォータニオンを作る
+/// </summary>
+/// <param name="axis">回転軸（正規化済み）</param>
+/// <param name="radian">ラジアン</param>
+/// <returns>任意軸回転のクォータニオン</returns>
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float radian)
+{
+	float halfSin = std::sin(radian * 0.5f);
+	float halfCos = std::cos(radian * 0.5f);
+
+	return Quaternion{ axis.x * halfSin , axis.y * halfSin , axis.z * halfSin , halfCos };
+}
+
+/// <summary>
+/// オイラー角からクォータニオンを作る（MakeRotateMatrix(const Vector3&)と同じ X → Y → Z の順）
+/// </summary>
+/// <param name="rotate">回転角</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateQuaternion(const Vector3& rotate)
+{
+	// 各軸の半角のsin, cos
+	float sx = std::sin(rotate.x * 0.5f), cx = std::cos(rotate.x * 0.5f);
+	float sy = std::sin(rotate.y * 0.5f), cy = std::cos(rotate.y * 0.5f);
+	float sz = std::sin(rotate.z * 0.5f), cz = std::cos(rotate.z * 0.5f);
+
+	// Z回転 * Y回転 * X回転 を展開したもの
+	Quaternion quaternion{};
+	quaternion.x = sx * cy * cz - cx * sy * sz;
+	quaternion.y = cx * sy * cz + sx * cy * sz;
+	quaternion.z = cx * cy * sz - sx * sy * cz;
+	quaternion.w = cx * cy * cz + sx * sy * sz;
+
+	return quaternion;
+}
+
+/// <summary>
+/// 回転行列からクォータニオンを作る
+/// </summary>
+/// <param name="m">回転行列（拡縮を含まないもの）</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateQuaternionFromMatrix(const Matrix4x4& m)
+{
+	// クォータニオン
+	Quaternion quaternion{};
+
+	// 桁落ちしないよう、一番大きい成分から求める
+	float trace = m.m[0][0] + m.m[1][1] + m.m[2][2];
+
+	if (trace > 0.0f)
+	{
+		float s = std::sqrt(trace + 1.0f) * 2.0f;
+		float inverseS = 1.0f / s;
+		quaternion.w = 0.25f * s;
+		quaternion.x = (m.m[1][2] - m.m[2][1]) * inverseS;
+		quaternion.y = (m.m[2][0] - m.m[0][2]) * inverseS;
+		quaternion.z = (m.m[0][1] - m.m[1][0]) * inverseS;
+	}
+	else if (m.m[0][0] > m.m[1][1] && m.m[0][0] > m.m[2][2])
+	{
+		float s = std::sqrt(1.0f + m.m[0][0] - m.m[1][1] - m.m[2][2]) * 2.0f;
+		float inverseS = 1.0f / s;
+		quaternion.x = 0.25f * s;
+		quaternion.w = (m.m[1][2] - m.m[2][1]) * inverseS;
+		quaternion.y = (m.m[0][1] + m.m[1][0]) * inverseS;
+		quaternion.z = (m.m[0][2] + m.m[2][0]) * inverseS;
+	}
+	else if (m.m[1][1] > m.m[2][2])
+	{
+		float s = std::sqrt(1.0f + m.m[1][1] - m.m[0][0] - m.m[2][2]) * 2.0f;
+		float inverseS = 1.0f / s;
+		quaternion.y = 0.25f * s;
+		quaternion.w = (m.m[2][0] - m.m[0][2]) * inverseS;
+		quaternion.x = (m.m[0][1] + m.m[1][0]) * inverseS;
+		quaternion.z = (m.m[1][2] + m.m[2][1]) * inverseS;
+	}
+	else
+	{
+		float s = std::sqrt(1.0f + m.m[2][2] - m.m[0][0] - m.m[1][1]) * 2.0f;
+		float inverseS = 1.0f / s;
+		quaternion.z = 0.25f * s;
+		quaternion.w = (m.m[0][1] - m.m[1][0]) * inverseS;
+		quaternion.x = (m.m[0][2] + m.m[2][0]) * inverseS;
+		quaternion.y = (m.m[1][2] + m.m[2][1]) * inverseS;
+	}
+
+	return quaternion;
+}
+
+/// <summary>
+/// ベクトルを回転させる
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <param name="q">クォータニオン（正規化済み）</param>
+/// <returns>回転させたベクトル</returns>
+Vector3 RotateVector(const Vector3& v, const Quaternion& q)
+{
+	// q * v * q^-1 を展開したもの（t = 2 * (q.xyz × v)）
+	Vector3 axis = { q.x , q.y , q.z };
+	Vector3 t = Multiply(2.0f, Cross(axis, v));
+
+	return v + q.w * t + Cross(axis, t);
+}
+
+/// <summary>
+/// クォータニオンから回転行列を作る
+/// </summary>
+/// <param name="q">クォータニオン（正規化済み）</param>
+/// <returns>回転行列</returns>
+Matrix4x4 MakeRotateMatrixFromQuaternion(const Quaternion& q)
+{
+	return MakeAffineMatrixQuaternion(Vector3{ 1.0f , 1.0f , 1.0f }, q, Vector3{ 0.0f , 0.0f , 0.0f });
+}
+
+/// <summary>
+/// クォータニオンでアフィン変換行列を作る（三角関数を使わない）
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転（正規化済み）</param>
+/// <param name="translate">移動</param>
+/// <returns>アフィン変換行列</returns>
+Matrix4x4 MakeAffineMatrixQuaternion(const Vector3& scale, const Quaternion& rotate, const Vector3& translate)
+{
+	float xx = rotate.x * rotate.x, yy = rotate.y * rotate.y, zz = rotate.z * rotate.z;
+	float xy = rotate.x * rotate.y, xz = rotate.x * rotate.z, yz = rotate.y * rotate.z;
+	float wx = rotate.w * rotate.x, wy = rotate.w * rotate.y, wz = rotate.w * rotate.z;
+
+	// アフィン変換行列
+	Matrix4x4 affineMatrix;
+
+	affineMatrix.m[0][0] = scale.x * (1.0f - 2.0f * (yy + zz));
+	affineMatrix.m[0][1] = scale.x * (2.0f * (xy + wz));
+	affineMatrix.m[0][2] = scale.x * (2.0f * (xz - wy));
+	affineMatrix.m[0][3] = 0.0f;
+
+	affineMatrix.m[1][0] = scale.y * (2.0f * (xy - wz));
+	affineMatrix.m[1][1] = scale.y * (1.0f - 2.0f * (xx + zz));
+	affineMatrix.m[1][2] = scale.y * (2.0f * (yz + wx));
+	affineMatrix.m[1][3] = 0.0f;
+
+	affineMatrix.m[2][0] = scale.z * (2.0f * (xz + wy));
+	affineMatrix.m[2][1] = scale.z * (2.0f * (yz - wx));
+	affineMatrix.m[2][2] = scale.z * (1.0f - 2.0f * (xx + yy));
+	affineMatrix.m[2][3] = 0.0f;
+
+	affineMatrix.m[3][0] = translate.x;
+	affineMatrix.m[3][1] = translate.y;
+	affineMatrix.m[3][2] = translate.z;
+	affineMatrix.m[3][3] = 1.0f;
+
+	return affineMatrix;
+}
+
+/// <summary>
+/// 正規化線形補間する（最短経路を通る）
+/// </summary>
+/// <param name="q0">始点</param>
+/// <param name="q1">終点</param>
+/// <param name="t">媒介変数</param>
+/// <returns>補間したクォータニオン</returns>
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t)
+{
+	// 反対向きなら終点を反転して近い方を通る
+	float sign = DotQuaternion(q0, q1) < 0.0f ? -1.0f : 1.0f;
+
+	float t0 = 1.0f - t;
+	float t1 = sign * t;
+
+	return NormalizeQuaternion(Quaternion{ t0 * q0.x + t1 * q1.x , t0 * q0.y + t1 * q1.y , t0 * q0.z + t1 * q1.z , t0 * q0.w + t1 * q1.w });
+}
+
+/// <summary>
+/// 球面線形補間する（最短経路を通る）
+/// </summary>
+/// <param name="q0">始点</param>
+/// <param name="q1">終点</param>
+/// <param name="t">媒介変数</param>
+/// <returns>補間したクォータニオン</returns>
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t)
+{
+	float dot = DotQuaternion(q0, q1);
+
+	// 反対向きなら終点を反転して近い方を通る
+	float sign = 1.0f;
+
+	if (dot < 0.0f)
+	{
+		dot = -dot;
+		sign = -1.0f;
+	}
+
+	// ほぼ同じ向きのときはsinθが0に近く不安定なので、正規化線形補間にする
+	if (dot >= 0.9995f)
+	{
+		return Nlerp(q0, q1, t);
+	}
+
+	float theta = std::acos(dot);
+	float inverseSinTheta = 1.0f / std::sin(theta);
+
+	float t0 = std::sin((1.0f - t) * theta) * inverseSinTheta;
+	float t1 = sign * std::sin(t * theta) * inverseSinTheta;
+
+	return Quaternion{ t0 * q0.x + t1 * q1.x , t0 * q0.y + t1 * q1.y , t0 * q0.z + t1 * q1.z , t0 * q0.w + t1 * q1.w };
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <cmath>
+#include "../../Struct.h"
+#include "../Matrix/Matrix.h"
+
+/*
+	回転の合成順について
+	行列は行ベクトル（v * M）なので、MakeRotateMatrixFromQuaternion(q1) * MakeRotateMatrixFromQuaternion(q2) は「q1で回してからq2で回す」になる。
+	クォータニオンでこれと同じ回転は Multiply(q2, q1) になる（右から順に適用される）。
+*/
+
+/// <summary>
+/// 単位クォータニオンを作る
+/// </summary>
+/// <returns>単位クォータニオン</returns>
+constexpr Quaternion MakeIdentityQuaternion()
+{
+	return Quaternion{ 0.0f , 0.0f , 0.0f , 1.0f };
+}
+
+/// <summary>
+/// 積を求める（q2で回してからq1で回す回転になる）
+/// </summary>
+/// <param name="q1">クォータニオン1</param>
+/// <param name="q2">クォータニオン2</param>
+/// <returns>積</returns>
+constexpr Quaternion Multiply(const Quaternion& q1, const Quaternion& q2)
+{
+	// 積
+	Quaternion multiply{};
+
+	multiply.x = q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y;
+	multiply.y = q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x;
+	multiply.z = q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w;
+	multiply.w = q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z;
+
+	return multiply;
+}
+
+/// <summary>
+/// 共役クォータニオンを求める
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>共役クォータニオン</returns>
+constexpr Quaternion Conjugate(const Quaternion& q)
+{
+	return Quaternion{ -q.x , -q.y , -q.z , q.w };
+}
+
+/// <summary>
+/// 内積を求める
+/// </summary>
+/// <param name="q1">クォータニオン1</param>
+/// <param name="q2">クォータニオン2</param>
+/// <returns>内積</returns>
+constexpr float DotQuaternion(const Quaternion& q1, const Quaternion& q2)
+{
+	return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+/// <summary>
+/// ノルムを求める
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>ノルム</returns>
+inline float Norm(const Quaternion& q)
+{
+	return std::sqrt(DotQuaternion(q, q));
+}
+
+/// <summary>
+/// 正規化する
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>正規化したクォータニオン（ノルムが0のときは単位クォータニオン）</returns>
+Quaternion NormalizeQuaternion(const Quaternion& q);
+
+/// <summary>
+/// 逆クォータニオンを求める
+/// </summary>
+/// <param name="q">クォータニオン</param>
+/// <returns>逆クォータニオン</returns>
+Quaternion Inverse(const Quaternion& q);
+
+/// <summary>
+/// 任意軸回転のクォータニオンを作る
+/// </summary>
+/// <param name="axis">回転軸（正規化済み）</param>
+/// <param name="radian">ラジアン</param>
+/// <returns>任意軸回転のクォータニオン</returns>
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float radian);
+
+/// <summary>
+/// オイラー角からクォータニオンを作る（MakeRotateMatrix(const Vector3&)と同じ X → Y → Z の順）
+/// </summary>
+/// <param name="rotate">回転角</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateQuaternion(const Vector3& rotate);
+
+/// <summary>
+/// 回転行列からクォータニオンを作る
+/// </summary>
+/// <param name="m">回転行列（拡縮を含まないもの）</param>
+/// <returns>クォータニオン</returns>
+Quaternion MakeRotateQuaternionFromMatrix(const Matrix4x4& m);
+
+/// <summary>
+/// ベクトルを回転させる
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <param name="q">クォータニオン（正規化済み）</param>
+/// <returns>回転させたベクトル</returns>
+Vector3 RotateVector(const Vector3& v, const Quaternion& q);
+
+/// <summary>
+/// クォータニオンから回転行列を作る
+/// </summary>
+/// <param name="q">クォータニオン（正規化済み）</param>
+/// <returns>回転行列</returns>
+Matrix4x4 MakeRotateMatrixFromQuaternion(const Quaternion& q);
+
+/// <summary>
+/// クォータニオンでアフィン変換行列を作る（三角関数を使わない）
+/// </summary>
+/// <param name="scale">拡縮</param>
+/// <param name="rotate">回転（正規化済み）</param>
+/// <param name="translate">移動</param>
+/// <returns>アフィン変換行列</returns>
+Matrix4x4 MakeAffineMatrixQuaternion(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+/// <summary>
+/// 正規化線形補間する（最短経路を通る）
+/// </summary>
+/// <param name="q0">始点</param>
+/// <param name="q1">終点</param>
+/// <param name="t">媒介変数</param>
+/// <returns>補間したクォータニオン</returns>
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+/// <summary>
+/// 球面線形補間する（最短経路を通る）
+/// </summary>
+/// <param name="q0">始点</param>
+/// <param name="q1">終点</param>
+/// <param name="t">媒介変数</param>
+/// <returns>補間したクォータニオン</returns>
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
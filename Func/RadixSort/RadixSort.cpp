@@ -0,0 +1,58 @@
+#include "RadixSort.h"
+
+/// <summary>
+/// キーの小さい順に安定な並べ替えを行う（同じキーの中は元の並びを保つ）
+/// </summary>
+/// <param name="entries">並べ替える配列</param>
+/// <param name="buffer">作業用の配列（毎フレーム使い回すと確保し直さなくてよい）</param>
+void RadixSort(std::vector<RadixSortEntry>& entries, std::vector<RadixSortEntry>& buffer)
+{
+	if (entries.size() <= 1)
+	{
+		return;
+	}
+
+	// 下位バイトから1バイトずつ、分布数え上げで並べる
+	const size_t kBytes = sizeof(uint64_t);
+	const size_t kBuckets = 256;
+
+	// 全てのバイトの分布を1回で数える
+	size_t counts[kBytes][kBuckets] = {};
+
+	for (const RadixSortEntry& entry : entries)
+	{
+		for (size_t byte = 0; byte < kBytes; byte++)
+		{
+			counts[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+		}
+	}
+
+	buffer.resize(entries.size());
+
+	for (size_t byte = 0; byte < kBytes; byte++)
+	{
+		size_t* count = counts[byte];
+
+		// 全てのキーでこのバイトが同じなら並びは変わらない
+		if (count[(entries.front().key >> (byte * 8)) & 0xFF] == entries.size())
+		{
+			continue;
+		}
+
+		// 各値の書き込み開始位置
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < kBuckets; bucket++)
+		{
+			size_t bucketCount = count[bucket];
+			count[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (const RadixSortEntry& entry : entries)
+		{
+			buffer[count[(entry.key >> (byte * 8)) & 0xFF]++] = entry;
+		}
+
+		entries.swap(buffer);
+	}
+}
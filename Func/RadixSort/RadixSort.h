@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 並べ替えるキーと、元の番号
+typedef struct RadixSortEntry
+{
+	// キー
+	uint64_t key;
+
+	// 元の番号
+	uint32_t index;
+}RadixSortEntry;
+
+/// <summary>
+/// キーの小さい順に安定な並べ替えを行う（同じキーの中は元の並びを保つ）
+/// </summary>
+/// <param name="entries">並べ替える配列</param>
+/// <param name="buffer">作業用の配列（毎フレーム使い回すと確保し直さなくてよい）</param>
+void RadixSort(std::vector<RadixSortEntry>& entries, std::vector<RadixSortEntry>& buffer);
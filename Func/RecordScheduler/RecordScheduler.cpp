@@ -0,0 +1,113 @@
+#include "RecordScheduler.h"
+#include "../JobSystem/JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+/// <summary>
+/// 描画をスレッドごとの連続した範囲に分ける（同じ引数なら必ず同じ分け方になる）
+/// </summary>
+/// <param name="itemCount">描画の数</param>
+/// <param name="workerCount">使うスレッドの数</param>
+/// <param name="minItemsPerRange">1つの範囲に最低限入れる描画の数（少ない描画でcommandListを増やさない）</param>
+/// <returns>描画の順に並んだ範囲（描画がなければ空）</returns>
+std::vector<RecordRange> PartitionRecordRanges(uint32_t itemCount, uint32_t workerCount, uint32_t minItemsPerRange)
+{
+	// 範囲
+	std::vector<RecordRange> ranges;
+
+	if (itemCount == 0)
+	{
+		return ranges;
+	}
+
+	// 範囲の数は、スレッドの数と最低限の描画の数の両方で抑える
+	uint32_t rangeCount = std::max(1u, std::min(workerCount, itemCount / std::max(1u, minItemsPerRange)));
+
+	// 割り切れない分は前の範囲から1つずつ多く持たせる
+	uint32_t itemsPerRange = itemCount / rangeCount;
+	uint32_t remainder = itemCount % rangeCount;
+
+	ranges.reserve(rangeCount);
+
+	uint32_t begin = 0;
+
+	for (uint32_t i = 0; i < rangeCount; i++)
+	{
+		uint32_t count = itemsPerRange + (i < remainder ? 1 : 0);
+		ranges.push_back(RecordRange{ begin , count });
+		begin += count;
+	}
+
+	return ranges;
+}
+
+/// <summary>
+/// 記録先を1つ取得する（GPUが使い終わったものを優先して使い回す）
+/// </summary>
+/// <param name="pool">記録先の管理</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <returns>記録先の番号（contextCount - 1と同じなら新しく作る必要がある）</returns>
+uint32_t AcquireRecordContext(RecordContextPool& pool, uint64_t completedFenceValue)
+{
+	// GPUが使い終わったものを使える状態に戻す
+	while (!pool.retiredContexts.empty() && pool.retiredContexts.front().fenceValue <= completedFenceValue)
+	{
+		pool.freeContexts.push_back(pool.retiredContexts.front().contextIndex);
+		pool.retiredContexts.pop_front();
+	}
+
+	// 記録先の番号
+	uint32_t contextIndex = 0;
+
+	if (!pool.freeContexts.empty())
+	{
+		contextIndex = pool.freeContexts.back();
+		pool.freeContexts.pop_back();
+	}
+	else
+	{
+		contextIndex = pool.contextCount;
+		pool.contextCount++;
+	}
+
+	pool.frameContexts.push_back(contextIndex);
+
+	return contextIndex;
+}
+
+/// <summary>
+/// このフレームで使った記録先を、Signalの値と結びつけて使い終わり待ちにする
+/// </summary>
+/// <param name="pool">記録先の管理</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishRecordContextFrame(RecordContextPool& pool, uint64_t fenceValue)
+{
+	// Signalの値は増え続ける
+	assert(pool.retiredContexts.empty() || pool.retiredContexts.back().fenceValue <= fenceValue);
+
+	for (uint32_t contextIndex : pool.frameContexts)
+	{
+		pool.retiredContexts.push_back(RecordRetiredContext{ contextIndex , fenceValue });
+	}
+
+	pool.frameContexts.clear();
+}
+
+/// <summary>
+/// 範囲ごとに共有のJobSystemのスレッドへ分けて記録する（呼び出したスレッドも記録し、全て終わるまで待つ）
+/// </summary>
+/// <param name="ranges">範囲</param>
+/// <param name="record">範囲の番号と範囲を受け取って記録する関数（範囲ごとに別のスレッドから呼ばれる）</param>
+void RecordRangesParallel(std::span<const RecordRange> ranges, const std::function<void(uint32_t rangeIndex, const RecordRange& range)>& record)
+{
+	if (ranges.empty())
+	{
+		return;
+	}
+
+	// スレッドは毎フレーム作らず、共有のJobSystemのものを使い回す（呼び出したスレッドも記録する）
+	RunJobs(GetSharedJobSystem(), ranges.size(), [&](size_t rangeIndex)
+		{
+			record(static_cast<uint32_t>(rangeIndex), ranges[rangeIndex]);
+		});
+}
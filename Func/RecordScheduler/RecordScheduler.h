@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <vector>
+
+// 1つのcommandListに記録する描画の範囲
+typedef struct RecordRange
+{
+	// 先頭の描画の番号
+	uint32_t begin;
+
+	// 描画の数
+	uint32_t count;
+}RecordRange;
+
+// GPUが使い終わるのを待っている記録先
+typedef struct RecordRetiredContext
+{
+	// 記録先の番号
+	uint32_t contextIndex;
+
+	// 使ったフレームのSignalの値
+	uint64_t fenceValue;
+}RecordRetiredContext;
+
+/*
+	記録先（commandAllocatorとcommandListの組）の使い回しを番号で管理する
+	実際のcommandListは呼び出し側が番号で引くので、D3D12がなくても動かせる
+*/
+typedef struct RecordContextPool
+{
+	// 作った記録先の数
+	uint32_t contextCount;
+
+	// すぐ使える記録先
+	std::vector<uint32_t> freeContexts;
+
+	// GPUが使い終わるのを待っている記録先（古い順）
+	std::deque<RecordRetiredContext> retiredContexts;
+
+	// このフレームで使っている記録先（取得した順 = 実行する順）
+	std::vector<uint32_t> frameContexts;
+}RecordContextPool;
+
+/// <summary>
+/// 描画をスレッドごとの連続した範囲に分ける（同じ引数なら必ず同じ分け方になる）
+/// </summary>
+/// <param name="itemCount">描画の数</param>
+/// <param name="workerCount">使うスレッドの数</param>
+/// <param name="minItemsPerRange">1つの範囲に最低限入れる描画の数（少ない描画でcommandListを増やさない）</param>
+/// <returns>描画の順に並んだ範囲（描画がなければ空）</returns>
+std::vector<RecordRange> PartitionRecordRanges(uint32_t itemCount, uint32_t workerCount, uint32_t minItemsPerRange);
+
+/// <summary>
+/// 記録先を1つ取得する（GPUが使い終わったものを優先して使い回す）
+/// </summary>
+/// <param name="pool">記録先の管理</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+/// <returns>記録先の番号（contextCount - 1と同じなら新しく作る必要がある）</returns>
+uint32_t AcquireRecordContext(RecordContextPool& pool, uint64_t completedFenceValue);
+
+/// <summary>
+/// このフレームで使った記録先を、Signalの値と結びつけて使い終わり待ちにする
+/// </summary>
+/// <param name="pool">記録先の管理</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishRecordContextFrame(RecordContextPool& pool, uint64_t fenceValue);
+
+/// <summary>
+/// 範囲ごとに共有のJobSystemのスレッドへ分けて記録する（呼び出したスレッドも記録し、全て終わるまで待つ）
+/// </summary>
+/// <param name="ranges">範囲</param>
+/// <param name="record">範囲の番号と範囲を受け取って記録する関数（範囲ごとに別のスレッドから呼ばれる）</param>
+void RecordRangesParallel(std::span<const RecordRange> ranges, const std::function<void(uint32_t rangeIndex, const RecordRange& range)>& record);
@@ -0,0 +1,112 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cassert>
+
+/// <summary>
+/// ソートキーを作る（パス、パイプライン、マテリアル、深度の順に優先して並ぶ）
+/// </summary>
+/// <param name="pass">パスの番号</param>
+/// <param name="pipelineIndex">パイプラインの番号</param>
+/// <param name="materialIndex">マテリアルの番号</param>
+/// <param name="depth">深度（0 〜 1、小さいほど先に描画する）</param>
+/// <returns>ソートキー</returns>
+uint64_t MakeRenderSortKey(uint32_t pass, uint32_t pipelineIndex, uint32_t materialIndex, float depth)
+{
+	assert(pass < (1u << kRenderSortKeyPassBits));
+	assert(pipelineIndex < (1u << kRenderSortKeyPipelineBits));
+	assert(materialIndex < (1u << kRenderSortKeyMaterialBits));
+
+	// 深度は範囲外を丸めてから整数にする（NaNは奥に送る）
+	const uint32_t kDepthMax = (1u << kRenderSortKeyDepthBits) - 1;
+	float clampedDepth = (depth >= 0.0f) ? (std::min)(depth, 1.0f) : (depth < 0.0f ? 0.0f : 1.0f);
+	uint64_t quantizedDepth = static_cast<uint64_t>(clampedDepth * kDepthMax);
+
+	uint64_t key = pass;
+	key = (key << kRenderSortKeyPipelineBits) | pipelineIndex;
+	key = (key << kRenderSortKeyMaterialBits) | materialIndex;
+	key = (key << kRenderSortKeyDepthBits) | quantizedDepth;
+
+	return key;
+}
+
+/// <summary>
+/// 積まれたパケットを全て捨てる（毎フレームの最初に呼ぶ）
+/// </summary>
+/// <param name="queue">RenderQueue</param>
+void ClearRenderQueue(RenderQueue& queue)
+{
+	queue.packets.clear();
+	queue.commands.clear();
+	queue.stats = RenderQueueStats{};
+}
+
+/// <summary>
+/// パケットを積む
+/// </summary>
+/// <param name="queue">RenderQueue</param>
+/// <param name="packet">パケット</param>
+void PushRenderPacket(RenderQueue& queue, const RenderPacket& packet)
+{
+	queue.packets.push_back(packet);
+}
+
+/// <summary>
+/// パケットをキーで並べ替え、描画ごとに切り替える必要のある状態を求める
+/// </summary>
+/// <param name="queue">RenderQueue（commandsとstatsに結果が入る）</param>
+void SortRenderQueue(RenderQueue& queue)
+{
+	// 並べ替え（同じキーの中は積まれた順を保つ）
+	queue.sortEntries.resize(queue.packets.size());
+
+	for (uint32_t i = 0; i < queue.packets.size(); i++)
+	{
+		queue.sortEntries[i] = RadixSortEntry{ queue.packets[i].sortKey , i };
+	}
+
+	RadixSort(queue.sortEntries, queue.sortBuffer);
+
+	// 直前の描画と違う状態だけ切り替える
+	queue.commands.resize(queue.sortEntries.size());
+	queue.stats = RenderQueueStats{};
+
+	for (size_t i = 0; i < queue.sortEntries.size(); i++)
+	{
+		const RenderPacket& packet = queue.packets[queue.sortEntries[i].index];
+
+		// 最初の描画は全て設定する
+		uint32_t stateChanges = kRenderStateChangeAll;
+
+		if (i > 0)
+		{
+			const RenderPacket& previous = queue.packets[queue.sortEntries[i - 1].index];
+			stateChanges = kRenderStateChangeNone;
+
+			if (packet.pipelineIndex != previous.pipelineIndex)
+			{
+				stateChanges |= kRenderStateChangePipeline;
+			}
+
+			if (packet.materialIndex != previous.materialIndex)
+			{
+				stateChanges |= kRenderStateChangeMaterial;
+			}
+
+			if (packet.meshIndex != previous.meshIndex)
+			{
+				stateChanges |= kRenderStateChangeMesh;
+			}
+		}
+
+		queue.commands[i] = RenderCommand{ queue.sortEntries[i].index , stateChanges };
+
+		queue.stats.pipelineChanges += (stateChanges & kRenderStateChangePipeline) ? 1 : 0;
+		queue.stats.materialChanges += (stateChanges & kRenderStateChangeMaterial) ? 1 : 0;
+		queue.stats.meshChanges += (stateChanges & kRenderStateChangeMesh) ? 1 : 0;
+	}
+
+	queue.stats.drawCount = static_cast<uint32_t>(queue.commands.size());
+
+	// 毎回パイプライン、マテリアル、メッシュを全て設定した場合との差
+	queue.stats.removedStateChanges = queue.stats.drawCount * 3 - (queue.stats.pipelineChanges + queue.stats.materialChanges + queue.stats.meshChanges);
+}
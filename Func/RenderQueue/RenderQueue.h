@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../RadixSort/RadixSort.h"
+
+// ソートキーの各項目のビット数（上位から パス / パイプライン / マテリアル / 深度）
+const uint32_t kRenderSortKeyPassBits = 8;
+const uint32_t kRenderSortKeyPipelineBits = 12;
+const uint32_t kRenderSortKeyMaterialBits = 20;
+const uint32_t kRenderSortKeyDepthBits = 24;
+
+// 描画の前に切り替える必要のある状態
+enum RenderStateChange : uint32_t
+{
+	kRenderStateChangeNone = 0,
+	kRenderStateChangePipeline = 1 << 0,
+	kRenderStateChangeMaterial = 1 << 1,
+	kRenderStateChangeMesh = 1 << 2,
+	kRenderStateChangeAll = kRenderStateChangePipeline | kRenderStateChangeMaterial | kRenderStateChangeMesh,
+};
+
+// 描画1回分の情報
+typedef struct RenderPacket
+{
+	// 並べ替えに使うキー（MakeRenderSortKeyで作る）
+	uint64_t sortKey;
+
+	// パイプラインの番号
+	uint32_t pipelineIndex;
+
+	// マテリアルの番号
+	uint32_t materialIndex;
+
+	// メッシュの番号
+	uint32_t meshIndex;
+
+	// 描画ごとのデータの番号（座標変換やインスタンスの範囲を引くのに使う）
+	uint32_t drawIndex;
+}RenderPacket;
+
+// 並べ替えた後の描画1回分
+typedef struct RenderCommand
+{
+	// パケットの番号
+	uint32_t packetIndex;
+
+	// この描画の前に切り替える状態（RenderStateChangeの組み合わせ）
+	uint32_t stateChanges;
+}RenderCommand;
+
+// 状態の切り替えの数
+typedef struct RenderQueueStats
+{
+	// 描画の数
+	uint32_t drawCount;
+
+	// 実際に行う切り替えの数
+	uint32_t pipelineChanges;
+	uint32_t materialChanges;
+	uint32_t meshChanges;
+
+	// 毎回全て設定した場合と比べて省いた切り替えの数
+	uint32_t removedStateChanges;
+}RenderQueueStats;
+
+/*
+	描画をキーで並べ替え、同じ状態の設定を省いて出す
+	番号だけを扱うので、描画APIに依存しない
+*/
+typedef struct RenderQueue
+{
+	// 積まれた順のパケット
+	std::vector<RenderPacket> packets;
+
+	// 並べ替えた後の描画
+	std::vector<RenderCommand> commands;
+
+	// 並べ替え用の作業配列
+	std::vector<RadixSortEntry> sortEntries;
+	std::vector<RadixSortEntry> sortBuffer;
+
+	// 状態の切り替えの数
+	RenderQueueStats stats;
+}RenderQueue;
+
+/// <summary>
+/// ソートキーを作る（パス、パイプライン、マテリアル、深度の順に優先して並ぶ）
+/// </summary>
+/// <param name="pass">パスの番号</param>
+/// <param name="pipelineIndex">パイプラインの番号</param>
+/// <param name="materialIndex">マテリアルの番号</param>
+/// <param name="depth">深度（0 〜 1、小さいほど先に描画する）</param>
+/// <returns>ソートキー</returns>
+uint64_t MakeRenderSortKey(uint32_t pass, uint32_t pipelineIndex, uint32_t materialIndex, float depth);
+
+/// <summary>
+/// 積まれたパケットを全て捨てる（毎フレームの最初に呼ぶ）
+/// </summary>
+/// <param name="queue">RenderQueue</param>
+void ClearRenderQueue(RenderQueue& queue);
+
+/// <summary>
+/// パケットを積む
+/// </summary>
+/// <param name="queue">RenderQueue</param>
+/// <param name="packet">パケット</param>
+void PushRenderPacket(RenderQueue& queue, const RenderPacket& packet);
+
+/// <summary>
+/// パケットをキーで並べ替え、描画ごとに切り替える必要のある状態を求める
+/// </summary>
+/// <param name="queue">RenderQueue（commandsとstatsに結果が入る）</param>
+void SortRenderQueue(RenderQueue& queue);
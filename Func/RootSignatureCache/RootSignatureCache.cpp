@@ -0,0 +1,200 @@
+#include "RootSignatureCache.h"
+#include "../String/String.h"
+#include <vector>
+
+namespace
+{
+	/// <summary>
+	/// 設定をD3D12の形にしてシリアライズする
+	/// </summary>
+	std::vector<uint8_t> SerializeRootSignature(const RootSignatureDescription& description, std::ostream& logStream)
+	{
+		// 範囲はパラメータから指されるので、先に全て並べてから指す
+		std::vector<D3D12_DESCRIPTOR_RANGE> ranges;
+		for (const RootParameterDescription& parameter : description.parameters)
+		{
+			for (const RootDescriptorRangeDescription& range : parameter.ranges)
+			{
+				D3D12_DESCRIPTOR_RANGE descriptorRange{};
+				descriptorRange.RangeType = static_cast<D3D12_DESCRIPTOR_RANGE_TYPE>(range.rangeType);
+				descriptorRange.NumDescriptors = range.numDescriptors;
+				descriptorRange.BaseShaderRegister = range.baseShaderRegister;
+				descriptorRange.RegisterSpace = range.registerSpace;
+				descriptorRange.OffsetInDescriptorsFromTableStart = range.offsetInDescriptorsFromTableStart;
+				ranges.push_back(descriptorRange);
+			}
+		}
+
+		std::vector<D3D12_ROOT_PARAMETER> rootParameters(description.parameters.size());
+		size_t rangeIndex = 0;
+
+		for (size_t i = 0; i < description.parameters.size(); i++)
+		{
+			const RootParameterDescription& parameter = description.parameters[i];
+			D3D12_ROOT_PARAMETER& rootParameter = rootParameters[i];
+
+			rootParameter.ParameterType = static_cast<D3D12_ROOT_PARAMETER_TYPE>(parameter.parameterType);
+			rootParameter.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(parameter.shaderVisibility);
+
+			switch (parameter.parameterType)
+			{
+			case kRootParameterTypeDescriptorTable:
+				rootParameter.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(parameter.ranges.size());
+				rootParameter.DescriptorTable.pDescriptorRanges = ranges.data() + rangeIndex;
+				rangeIndex += parameter.ranges.size();
+				break;
+
+			case kRootParameterTypeConstants:
+				rootParameter.Constants.ShaderRegister = parameter.shaderRegister;
+				rootParameter.Constants.RegisterSpace = parameter.registerSpace;
+				rootParameter.Constants.Num32BitValues = parameter.num32BitValues;
+				break;
+
+			default:
+				rootParameter.Descriptor.ShaderRegister = parameter.shaderRegister;
+				rootParameter.Descriptor.RegisterSpace = parameter.registerSpace;
+				break;
+			}
+		}
+
+		std::vector<D3D12_STATIC_SAMPLER_DESC> staticSamplers(description.staticSamplers.size());
+		for (size_t i = 0; i < description.staticSamplers.size(); i++)
+		{
+			const RootStaticSamplerDescription& sampler = description.staticSamplers[i];
+			D3D12_STATIC_SAMPLER_DESC& staticSampler = staticSamplers[i];
+
+			staticSampler.Filter = static_cast<D3D12_FILTER>(sampler.filter);
+			staticSampler.AddressU = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.addressU);
+			staticSampler.AddressV = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.addressV);
+			staticSampler.AddressW = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.addressW);
+			staticSampler.MipLODBias = sampler.mipLODBias;
+			staticSampler.MaxAnisotropy = sampler.maxAnisotropy;
+			staticSampler.ComparisonFunc = static_cast<D3D12_COMPARISON_FUNC>(sampler.comparisonFunc);
+			staticSampler.BorderColor = static_cast<D3D12_STATIC_BORDER_COLOR>(sampler.borderColor);
+			staticSampler.MinLOD = sampler.minLOD;
+			staticSampler.MaxLOD = sampler.maxLOD;
+			staticSampler.ShaderRegister = sampler.shaderRegister;
+			staticSampler.RegisterSpace = sampler.registerSpace;
+			staticSampler.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(sampler.shaderVisibility);
+		}
+
+		D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
+		descriptionRootSignature.Flags = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(description.flags);
+		descriptionRootSignature.pParameters = rootParameters.data();
+		descriptionRootSignature.NumParameters = static_cast<UINT>(rootParameters.size());
+		descriptionRootSignature.pStaticSamplers = staticSamplers.data();
+		descriptionRootSignature.NumStaticSamplers = static_cast<UINT>(staticSamplers.size());
+
+		// シリアライズにしてバイナリにする
+		ID3DBlob* signatureBlob = nullptr;
+		ID3DBlob* errorBlob = nullptr;
+		HRESULT hr = D3D12SerializeRootSignature(&descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+
+		if (FAILED(hr))
+		{
+			if (errorBlob)
+			{
+				LogError(logStream, reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
+				errorBlob->Release();
+			}
+
+			return {};
+		}
+
+		const uint8_t* data = static_cast<const uint8_t*>(signatureBlob->GetBufferPointer());
+		std::vector<uint8_t> blob(data, data + signatureBlob->GetBufferSize());
+
+		signatureBlob->Release();
+		if (errorBlob)
+		{
+			errorBlob->Release();
+		}
+
+		return blob;
+	}
+}
+
+/// <summary>
+/// RootSignatureCacheを作る
+/// </summary>
+/// <param name="directory">バイナリの保存先のフォルダ</param>
+/// <returns>RootSignatureCache</returns>
+RootSignatureCache CreateRootSignatureCache(const std::filesystem::path& directory)
+{
+	// RootSignatureCache
+	RootSignatureCache cache{};
+	cache.blobCache.directory = directory;
+
+	return cache;
+}
+
+/// <summary>
+/// rootSignatureを取得する（同じ設定なら同じものを返す）
+/// </summary>
+/// <param name="cache">RootSignatureCache</param>
+/// <param name="device"></param>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="logStream"></param>
+/// <returns>rootSignature（解放はReleaseRootSignatureCacheで行う）</returns>
+ID3D12RootSignature* GetRootSignature(RootSignatureCache& cache, ID3D12Device* device, const RootSignatureDescription& description, std::ostream& logStream)
+{
+	uint64_t hash = HashRootSignatureDescription(description);
+
+	// 既に作ってある
+	auto found = cache.rootSignatures.find(hash);
+	if (found != cache.rootSignatures.end())
+	{
+		cache.blobCache.hitCount++;
+		return found->second;
+	}
+
+	auto serialize = [&logStream](const RootSignatureDescription& target)
+		{
+			return SerializeRootSignature(target, logStream);
+		};
+
+	// バイナリを元に生成する
+	ID3D12RootSignature* rootSignature = nullptr;
+	const std::vector<uint8_t>& blob = FindOrSerializeRootSignature(cache.blobCache, description, serialize);
+	if (blob.empty())
+	{
+		assert(false);
+		return nullptr;
+	}
+
+	HRESULT hr = device->CreateRootSignature(0, blob.data(), blob.size(), IID_PPV_ARGS(&rootSignature));
+
+	// 保存されたファイルが壊れていたら、シリアライズし直す
+	if (FAILED(hr))
+	{
+		EraseRootSignatureBlob(cache.blobCache, hash);
+
+		const std::vector<uint8_t>& serializedBlob = FindOrSerializeRootSignature(cache.blobCache, description, serialize);
+		assert(!serializedBlob.empty());
+
+		hr = device->CreateRootSignature(0, serializedBlob.data(), serializedBlob.size(), IID_PPV_ARGS(&rootSignature));
+		assert(SUCCEEDED(hr));
+	}
+
+	cache.rootSignatures.emplace(hash, rootSignature);
+
+	return rootSignature;
+}
+
+/// <summary>
+/// 作った全てのrootSignatureを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="cache">RootSignatureCache</param>
+void ReleaseRootSignatureCache(RootSignatureCache& cache)
+{
+	for (auto& [hash, rootSignature] : cache.rootSignatures)
+	{
+		if (rootSignature)
+		{
+			rootSignature->Release();
+		}
+	}
+
+	cache.rootSignatures.clear();
+	cache.blobCache.blobs.clear();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cassert>
+#include <filesystem>
+#include <ostream>
+#include <unordered_map>
+#include <d3d12.h>
+#include "../RootSignatureDescription/RootSignatureDescription.h"
+
+#pragma comment(lib,"d3d12.lib")
+
+/*
+	rootSignatureを設定のハッシュで使い回す
+	シリアライズしたバイナリはファイルに保存し、2回目以降の起動ではシリアライズしない
+*/
+typedef struct RootSignatureCache
+{
+	// シリアライズしたバイナリ
+	RootSignatureBlobCache blobCache;
+
+	// ハッシュ -> 作ったrootSignature
+	std::unordered_map<uint64_t, ID3D12RootSignature*> rootSignatures;
+}RootSignatureCache;
+
+/// <summary>
+/// RootSignatureCacheを作る
+/// </summary>
+/// <param name="directory">バイナリの保存先のフォルダ</param>
+/// <returns>RootSignatureCache</returns>
+RootSignatureCache CreateRootSignatureCache(const std::filesystem::path& directory);
+
+/// <summary>
+/// rootSignatureを取得する（同じ設定なら同じものを返す）
+/// </summary>
+/// <param name="cache">RootSignatureCache</param>
+/// <param name="device"></param>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="logStream"></param>
+/// <returns>rootSignature（解放はReleaseRootSignatureCacheで行う）</returns>
+ID3D12RootSignature* GetRootSignature(RootSignatureCache& cache, ID3D12Device* device, const RootSignatureDescription& description, std::ostream& logStream);
+
+/// <summary>
+/// 作った全てのrootSignatureを解放する（GPUが使い終わってから呼ぶ）
+/// </summary>
+/// <param name="cache">RootSignatureCache</param>
+void ReleaseRootSignatureCache(RootSignatureCache& cache);
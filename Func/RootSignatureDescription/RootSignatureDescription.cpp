@@ -0,0 +1,294 @@
+#include "RootSignatureDescription.h"
+#include "../Hash/Hash.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+	// 保存するバイナリの形式が変わったら増やす（古いファイルを読まないようにする）
+	const uint64_t kRootSignatureBlobVersion = 1;
+
+	/// <summary>
+	/// 保存するファイルのパス（設定のハッシュの16進数）
+	/// </summary>
+	std::filesystem::path MakeRootSignatureBlobPath(const RootSignatureBlobCache& cache, uint64_t hash)
+	{
+		char name[32]{};
+		std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+		return cache.directory / name;
+	}
+}
+
+/// <summary>
+/// CBV、SRV、UAVを直接置くパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="parameterType">kRootParameterTypeCBV、SRV、UAV</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="shaderRegister">レジスタ番号</param>
+/// <param name="registerSpace">レジスタ空間</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootDescriptor(RootSignatureDescription& description, uint32_t parameterType, uint32_t shaderVisibility, uint32_t shaderRegister, uint32_t registerSpace)
+{
+	assert(parameterType == kRootParameterTypeCBV || parameterType == kRootParameterTypeSRV || parameterType == kRootParameterTypeUAV);
+
+	RootParameterDescription parameter{};
+	parameter.parameterType = parameterType;
+	parameter.shaderVisibility = shaderVisibility;
+	parameter.shaderRegister = shaderRegister;
+	parameter.registerSpace = registerSpace;
+
+	description.parameters.push_back(parameter);
+	assert(GetRootSignatureSize(description) <= kRootSignatureMaxSize);
+
+	return static_cast<uint32_t>(description.parameters.size() - 1);
+}
+
+/// <summary>
+/// 定数を直接置くパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="shaderRegister">レジスタ番号</param>
+/// <param name="num32BitValues">32bit値の数</param>
+/// <param name="registerSpace">レジスタ空間</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootConstants(RootSignatureDescription& description, uint32_t shaderVisibility, uint32_t shaderRegister, uint32_t num32BitValues, uint32_t registerSpace)
+{
+	assert(num32BitValues > 0);
+
+	RootParameterDescription parameter{};
+	parameter.parameterType = kRootParameterTypeConstants;
+	parameter.shaderVisibility = shaderVisibility;
+	parameter.shaderRegister = shaderRegister;
+	parameter.registerSpace = registerSpace;
+	parameter.num32BitValues = num32BitValues;
+
+	description.parameters.push_back(parameter);
+	assert(GetRootSignatureSize(description) <= kRootSignatureMaxSize);
+
+	return static_cast<uint32_t>(description.parameters.size() - 1);
+}
+
+/// <summary>
+/// DescriptorTableのパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="ranges">範囲</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootDescriptorTable(RootSignatureDescription& description, uint32_t shaderVisibility, const std::vector<RootDescriptorRangeDescription>& ranges)
+{
+	assert(!ranges.empty());
+
+	RootParameterDescription parameter{};
+	parameter.parameterType = kRootParameterTypeDescriptorTable;
+	parameter.shaderVisibility = shaderVisibility;
+	parameter.ranges = ranges;
+
+	description.parameters.push_back(parameter);
+	assert(GetRootSignatureSize(description) <= kRootSignatureMaxSize);
+
+	return static_cast<uint32_t>(description.parameters.size() - 1);
+}
+
+/// <summary>
+/// StaticSamplerを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="sampler">StaticSampler</param>
+void AddRootStaticSampler(RootSignatureDescription& description, const RootStaticSamplerDescription& sampler)
+{
+	description.staticSamplers.push_back(sampler);
+}
+
+/// <summary>
+/// rootSignatureの大きさを求める（DWORD単位。kRootSignatureMaxSize以下でなければならない）
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <returns>大きさ</returns>
+uint32_t GetRootSignatureSize(const RootSignatureDescription& description)
+{
+	// 大きさ
+	uint32_t size = 0;
+
+	for (const RootParameterDescription& parameter : description.parameters)
+	{
+		switch (parameter.parameterType)
+		{
+		case kRootParameterTypeDescriptorTable:
+			size += 1;
+			break;
+
+		case kRootParameterTypeConstants:
+			size += parameter.num32BitValues;
+			break;
+
+		default:
+			// CBV、SRV、UAVはGPUのアドレス（64bit）
+			size += 2;
+			break;
+		}
+	}
+
+	return size;
+}
+
+/// <summary>
+/// rootSignatureの設定のハッシュを求める
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashRootSignatureDescription(const RootSignatureDescription& description)
+{
+	// 構造体のパディングを含めないように、1項目ずつ混ぜる
+	uint64_t hash = HashValue(kHashSeed, kRootSignatureBlobVersion);
+	hash = HashValue(hash, description.flags);
+
+	hash = HashValue(hash, static_cast<uint64_t>(description.parameters.size()));
+	for (const RootParameterDescription& parameter : description.parameters)
+	{
+		hash = HashValue(hash, parameter.parameterType);
+		hash = HashValue(hash, parameter.shaderVisibility);
+
+		// 種類ごとに使う項目だけ混ぜる
+		if (parameter.parameterType == kRootParameterTypeDescriptorTable)
+		{
+			hash = HashValue(hash, static_cast<uint64_t>(parameter.ranges.size()));
+			for (const RootDescriptorRangeDescription& range : parameter.ranges)
+			{
+				hash = HashValue(hash, range.rangeType);
+				hash = HashValue(hash, range.numDescriptors);
+				hash = HashValue(hash, range.baseShaderRegister);
+				hash = HashValue(hash, range.registerSpace);
+				hash = HashValue(hash, range.offsetInDescriptorsFromTableStart);
+			}
+			continue;
+		}
+
+		hash = HashValue(hash, parameter.shaderRegister);
+		hash = HashValue(hash, parameter.registerSpace);
+
+		if (parameter.parameterType == kRootParameterTypeConstants)
+		{
+			hash = HashValue(hash, parameter.num32BitValues);
+		}
+	}
+
+	hash = HashValue(hash, static_cast<uint64_t>(description.staticSamplers.size()));
+	for (const RootStaticSamplerDescription& sampler : description.staticSamplers)
+	{
+		hash = HashValue(hash, sampler.filter);
+		hash = HashValue(hash, sampler.addressU);
+		hash = HashValue(hash, sampler.addressV);
+		hash = HashValue(hash, sampler.addressW);
+		hash = HashValue(hash, sampler.mipLODBias);
+		hash = HashValue(hash, sampler.maxAnisotropy);
+		hash = HashValue(hash, sampler.comparisonFunc);
+		hash = HashValue(hash, sampler.borderColor);
+		hash = HashValue(hash, sampler.minLOD);
+		hash = HashValue(hash, sampler.maxLOD);
+		hash = HashValue(hash, sampler.shaderRegister);
+		hash = HashValue(hash, sampler.registerSpace);
+		hash = HashValue(hash, sampler.shaderVisibility);
+	}
+
+	return hash;
+}
+
+/// <summary>
+/// シリアライズしたバイナリを取得する（メモリ、ファイルの順に探し、なければシリアライズして保存する）
+/// </summary>
+/// <param name="cache">RootSignatureBlobCache</param>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="serialize">シリアライズする関数（失敗したら空を返す）</param>
+/// <returns>バイナリ（失敗したら空。EraseRootSignatureBlobで消すまで有効）</returns>
+const std::vector<uint8_t>& FindOrSerializeRootSignature(RootSignatureBlobCache& cache, const RootSignatureDescription& description,
+	const std::function<std::vector<uint8_t>(const RootSignatureDescription&)>& serialize)
+{
+	static const std::vector<uint8_t> kEmptyBlob;
+
+	uint64_t hash = HashRootSignatureDescription(description);
+
+	// メモリにある
+	auto found = cache.blobs.find(hash);
+	if (found != cache.blobs.end())
+	{
+		cache.hitCount++;
+		return found->second;
+	}
+
+	// ファイルにある
+	std::vector<uint8_t> blob;
+	std::filesystem::path path;
+
+	if (!cache.directory.empty())
+	{
+		path = MakeRootSignatureBlobPath(cache, hash);
+
+		std::ifstream file(path, std::ios::binary);
+		if (file)
+		{
+			blob.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+	}
+
+	if (!blob.empty())
+	{
+		cache.loadCount++;
+		return cache.blobs.emplace(hash, std::move(blob)).first->second;
+	}
+
+	// シリアライズする
+	blob = serialize(description);
+	if (blob.empty())
+	{
+		return kEmptyBlob;
+	}
+
+	cache.serializeCount++;
+
+	// 保存する
+	if (!path.empty())
+	{
+		std::error_code error;
+		std::filesystem::create_directories(cache.directory, error);
+
+		// 書ききれなかったファイルを次の起動で読まないように、別名で書いてから置き換える
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+		file.close();
+
+		if (file)
+		{
+			std::filesystem::rename(temporaryPath, path, error);
+		}
+
+		if (!file || error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	return cache.blobs.emplace(hash, std::move(blob)).first->second;
+}
+
+/// <summary>
+/// 使えなかったバイナリを、メモリとファイルから消す
+/// </summary>
+/// <param name="cache">RootSignatureBlobCache</param>
+/// <param name="hash">設定のハッシュ</param>
+void EraseRootSignatureBlob(RootSignatureBlobCache& cache, uint64_t hash)
+{
+	cache.blobs.erase(hash);
+
+	if (!cache.directory.empty())
+	{
+		std::error_code error;
+		std::filesystem::remove(MakeRootSignatureBlobPath(cache, hash), error);
+	}
+}
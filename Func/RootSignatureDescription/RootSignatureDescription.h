@@ -0,0 +1,179 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// パラメータの種類（D3D12_ROOT_PARAMETER_TYPEと同じ値）
+const uint32_t kRootParameterTypeDescriptorTable = 0;
+const uint32_t kRootParameterTypeConstants = 1;
+const uint32_t kRootParameterTypeCBV = 2;
+const uint32_t kRootParameterTypeSRV = 3;
+const uint32_t kRootParameterTypeUAV = 4;
+
+// 見えるシェーダー（D3D12_SHADER_VISIBILITYと同じ値）
+const uint32_t kRootShaderVisibilityAll = 0;
+const uint32_t kRootShaderVisibilityVertex = 1;
+const uint32_t kRootShaderVisibilityPixel = 5;
+
+// DescriptorRangeの種類（D3D12_DESCRIPTOR_RANGE_TYPEと同じ値）
+const uint32_t kRootDescriptorRangeTypeSRV = 0;
+const uint32_t kRootDescriptorRangeTypeUAV = 1;
+const uint32_t kRootDescriptorRangeTypeCBV = 2;
+const uint32_t kRootDescriptorRangeTypeSampler = 3;
+
+// Tableの前の範囲の続きに置く（D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND）
+const uint32_t kRootDescriptorRangeOffsetAppend = 0xffffffff;
+
+// 数を決めずにDescriptorHeapの終わりまで見る（UINT_MAX）
+const uint32_t kRootDescriptorRangeUnbounded = 0xffffffff;
+
+// rootSignatureのフラグ（D3D12_ROOT_SIGNATURE_FLAGSと同じ値）
+const uint32_t kRootSignatureFlagAllowInputLayout = 0x1;
+
+// rootSignatureに置ける大きさ（DWORD単位）
+const uint32_t kRootSignatureMaxSize = 64;
+
+// DescriptorTableの範囲1つ分
+typedef struct RootDescriptorRangeDescription
+{
+	uint32_t rangeType;
+	uint32_t numDescriptors;
+	uint32_t baseShaderRegister;
+	uint32_t registerSpace;
+	uint32_t offsetInDescriptorsFromTableStart;
+}RootDescriptorRangeDescription;
+
+// パラメータ1つ分
+typedef struct RootParameterDescription
+{
+	uint32_t parameterType;
+	uint32_t shaderVisibility;
+
+	// CBV、SRV、UAV、定数で使う
+	uint32_t shaderRegister;
+	uint32_t registerSpace;
+
+	// 定数で使う
+	uint32_t num32BitValues;
+
+	// DescriptorTableで使う
+	std::vector<RootDescriptorRangeDescription> ranges;
+}RootParameterDescription;
+
+// StaticSampler1つ分（値はD3D12_STATIC_SAMPLER_DESCと同じ）
+typedef struct RootStaticSamplerDescription
+{
+	uint32_t filter;
+	uint32_t addressU;
+	uint32_t addressV;
+	uint32_t addressW;
+	float mipLODBias;
+	uint32_t maxAnisotropy;
+	uint32_t comparisonFunc;
+	uint32_t borderColor;
+	float minLOD;
+	float maxLOD;
+	uint32_t shaderRegister;
+	uint32_t registerSpace;
+	uint32_t shaderVisibility;
+}RootStaticSamplerDescription;
+
+/*
+	rootSignatureの設定を、描画APIに依存しない形で持つ
+	Add〜で1つずつ積んで作る
+*/
+typedef struct RootSignatureDescription
+{
+	uint32_t flags;
+	std::vector<RootParameterDescription> parameters;
+	std::vector<RootStaticSamplerDescription> staticSamplers;
+}RootSignatureDescription;
+
+/*
+	設定のハッシュ -> シリアライズしたバイナリ
+	バイナリはファイルにも保存し、次の起動ではシリアライズせずに読む
+*/
+typedef struct RootSignatureBlobCache
+{
+	// 保存先のフォルダ（空ならファイルに保存しない）
+	std::filesystem::path directory;
+
+	// ハッシュ -> バイナリ
+	std::unordered_map<uint64_t, std::vector<uint8_t>> blobs;
+
+	// メモリにあった回数、ファイルから読んだ回数、シリアライズした回数
+	uint32_t hitCount;
+	uint32_t loadCount;
+	uint32_t serializeCount;
+}RootSignatureBlobCache;
+
+/// <summary>
+/// CBV、SRV、UAVを直接置くパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="parameterType">kRootParameterTypeCBV、SRV、UAV</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="shaderRegister">レジスタ番号</param>
+/// <param name="registerSpace">レジスタ空間</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootDescriptor(RootSignatureDescription& description, uint32_t parameterType, uint32_t shaderVisibility, uint32_t shaderRegister, uint32_t registerSpace = 0);
+
+/// <summary>
+/// 定数を直接置くパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="shaderRegister">レジスタ番号</param>
+/// <param name="num32BitValues">32bit値の数</param>
+/// <param name="registerSpace">レジスタ空間</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootConstants(RootSignatureDescription& description, uint32_t shaderVisibility, uint32_t shaderRegister, uint32_t num32BitValues, uint32_t registerSpace = 0);
+
+/// <summary>
+/// DescriptorTableのパラメータを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="shaderVisibility">見えるシェーダー</param>
+/// <param name="ranges">範囲</param>
+/// <returns>パラメータの番号</returns>
+uint32_t AddRootDescriptorTable(RootSignatureDescription& description, uint32_t shaderVisibility, const std::vector<RootDescriptorRangeDescription>& ranges);
+
+/// <summary>
+/// StaticSamplerを積む
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="sampler">StaticSampler</param>
+void AddRootStaticSampler(RootSignatureDescription& description, const RootStaticSamplerDescription& sampler);
+
+/// <summary>
+/// rootSignatureの大きさを求める（DWORD単位。kRootSignatureMaxSize以下でなければならない）
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <returns>大きさ</returns>
+uint32_t GetRootSignatureSize(const RootSignatureDescription& description);
+
+/// <summary>
+/// rootSignatureの設定のハッシュを求める
+/// </summary>
+/// <param name="description">RootSignatureDescription</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashRootSignatureDescription(const RootSignatureDescription& description);
+
+/// <summary>
+/// シリアライズしたバイナリを取得する（メモリ、ファイルの順に探し、なければシリアライズして保存する）
+/// </summary>
+/// <param name="cache">RootSignatureBlobCache</param>
+/// <param name="description">RootSignatureDescription</param>
+/// <param name="serialize">シリアライズする関数（失敗したら空を返す）</param>
+/// <returns>バイナリ（失敗したら空。EraseRootSignatureBlobで消すまで有効）</returns>
+const std::vector<uint8_t>& FindOrSerializeRootSignature(RootSignatureBlobCache& cache, const RootSignatureDescription& description,
+	const std::function<std::vector<uint8_t>(const RootSignatureDescription&)>& serialize);
+
+/// <summary>
+/// 使えなかったバイナリを、メモリとファイルから消す
+/// </summary>
+/// <param name="cache">RootSignatureBlobCache</param>
+/// <param name="hash">設定のハッシュ</param>
+void EraseRootSignatureBlob(RootSignatureBlobCache& cache, uint64_t hash);
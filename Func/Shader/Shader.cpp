@@ -1,4 +1,291 @@
 #include "Shader.h"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+namespace
+{
+	/// <summary>
+	/// -Fdで指定されたフォルダにPDBを書き出す（DXCのAPIはファイルを書かないので、dxc.exeと同じことをする）
+	/// </summary>
+	void WriteShaderPdb(IDxcResult* shaderResult, const ShaderCompileRequest& request)
+	{
+		auto it = std::find(request.arguments.begin(), request.arguments.end(), "-Fd");
+		if (it == request.arguments.end() || std::next(it) == request.arguments.end())
+		{
+			return;
+		}
+
+		IDxcBlob* pdb = nullptr;
+		IDxcBlobUtf16* pdbName = nullptr;
+		HRESULT hr = shaderResult->GetOutput(DXC_OUT_PDB, IID_PPV_ARGS(&pdb), &pdbName);
+		if (SUCCEEDED(hr) && pdb && pdbName)
+		{
+			// 名前はバイナリのハッシュ
+			std::filesystem::path directory = *std::next(it);
+			std::filesystem::path path = directory / std::filesystem::path(pdbName->GetStringPointer()).filename();
+
+			std::error_code error;
+			std::filesystem::create_directories(directory, error);
+
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(static_cast<const char*>(pdb->GetBufferPointer()), pdb->GetBufferSize());
+		}
+
+		if (pdbName)
+		{
+			pdbName->Release();
+		}
+		if (pdb)
+		{
+			pdb->Release();
+		}
+	}
+
+	/// <summary>
+	/// DXCでコンパイルする
+	/// </summary>
+	bool CompileShaderWithDxc(IDxcUtils* dxcUtils, IDxcCompiler3* dxcCompiler, IDxcIncludeHandler* includeHandler,
+		const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+	{
+		/*-----------------------
+			HLSLファイルを読む
+		-----------------------*/
+
+		// HLSLファイルを読む
+		IDxcBlobEncoding* shaderSource = nullptr;
+		HRESULT hr = dxcUtils->LoadFile(request.sourcePath.c_str(), nullptr, &shaderSource);
+		if (FAILED(hr))
+		{
+			errors = "Failed to load " + request.sourcePath.string() + "\n";
+			return false;
+		}
+
+		// 読み込んだファイルの内容を設定する
+		DxcBuffer shaderSourceBuffer;
+		shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
+		shaderSourceBuffer.Size = shaderSource->GetBufferSize();
+
+		// UTF8の文字コードであることを通知
+		shaderSourceBuffer.Encoding = DXC_CP_UTF8;
+
+
+		/*-------------------
+			Compilerする
+		-------------------*/
+
+		// 文字列の実体（argmentsはこれを指す）
+		std::vector<std::wstring> argmentStrings =
+		{
+			// コンパイル対象のHLSLファイル名
+			request.sourcePath.wstring(),
+
+			// エントリーポイントの指定
+			L"-E" , ConvertString(request.entryPoint),
+
+			// ShaderProfileの設定
+			L"-T" , ConvertString(request.profile)
+		};
+
+		// マクロ
+		for (const std::string& define : request.defines)
+		{
+			argmentStrings.push_back(L"-D");
+			argmentStrings.push_back(ConvertString(define));
+		}
+
+		// その他のオプション
+		for (const std::string& argument : request.arguments)
+		{
+			argmentStrings.push_back(ConvertString(argument));
+		}
+
+		std::vector<LPCWSTR> argments;
+		for (const std::wstring& argment : argmentStrings)
+		{
+			argments.push_back(argment.c_str());
+		}
+
+		// 実際にShaderをCompilerする
+		IDxcResult* shaderResult = nullptr;
+		hr = dxcCompiler->Compile
+		(
+			// 読み込んだファイル
+			&shaderSourceBuffer,
+
+			// コンパイルオプション
+			argments.data(),
+
+			// コンパイルオプションの数
+			static_cast<UINT32>(argments.size()),
+
+			// includeが含まれた諸々
+			includeHandler,
+
+			// コンパイル結果
+			IID_PPV_ARGS(&shaderResult)
+		);
+
+		assert(SUCCEEDED(hr));
+
+
+		/*-----------------------------------
+			警告・エラーが出ていないか確認する
+		-----------------------------------*/
+
+		IDxcBlobUtf8* shaderError = nullptr;
+		shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
+		if (shaderError != nullptr && shaderError->GetStringLength() != 0)
+		{
+			errors = shaderError->GetStringPointer();
+
+			shaderError->Release();
+			shaderSource->Release();
+			shaderResult->Release();
+			return false;
+		}
+
+
+		/*-------------------------------
+			Compiler結果を受け取る
+		-------------------------------*/
+
+		// compile結果から実行用のバイナリ部分を取得
+		IDxcBlob* shaderBlob = nullptr;
+		hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
+		assert(SUCCEEDED(hr));
+
+		const uint8_t* data = static_cast<const uint8_t*>(shaderBlob->GetBufferPointer());
+		bytecode.assign(data, data + shaderBlob->GetBufferSize());
+
+		// 外したデバッグ情報
+		WriteShaderPdb(shaderResult, request);
+
+		// 使わないリソースを解放
+		if (shaderError)
+		{
+			shaderError->Release();
+		}
+		shaderBlob->Release();
+		shaderSource->Release();
+		shaderResult->Release();
+
+		return true;
+	}
+}
+
+/// <summary>
+/// コンパイルする内容を作る
+/// </summary>
+/// <param name="filePath">HLSLファイルへのパス</param>
+/// <param name="profile">ShaderProfile</param>
+/// <param name="settings">最適化やデバッグ情報の設定</param>
+/// <param name="entryPoint">エントリーポイント</param>
+/// <param name="defines">マクロ（"NAME" か "NAME=VALUE"）</param>
+/// <returns>コンパイルする内容</returns>
+ShaderCompileRequest MakeShaderCompileRequest(const std::filesystem::path& filePath, const std::string& profile, const ShaderCompileSettings& settings,
+	const std::string& entryPoint, const std::vector<std::string>& defines)
+{
+	// コンパイルする内容
+	ShaderCompileRequest request{};
+	request.sourcePath = filePath;
+	request.entryPoint = entryPoint;
+	request.profile = profile;
+	request.defines = defines;
+	request.arguments = MakeShaderCompileArguments(settings);
+
+	return request;
+}
+
+/// <summary>
+/// DXCの版を取得する（ShaderCacheのハッシュに混ぜる）
+/// </summary>
+/// <returns>"major.minor" と、分かればコミットの数とハッシュ</returns>
+std::string GetDxcCompilerVersion()
+{
+	IDxcCompiler3* dxcCompiler = nullptr;
+	HRESULT hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler));
+	assert(SUCCEEDED(hr));
+
+	// 版
+	std::string version = "unknown";
+
+	IDxcVersionInfo* versionInfo = nullptr;
+	if (SUCCEEDED(dxcCompiler->QueryInterface(IID_PPV_ARGS(&versionInfo))))
+	{
+		UINT32 major = 0;
+		UINT32 minor = 0;
+		if (SUCCEEDED(versionInfo->GetVersion(&major, &minor)))
+		{
+			version = std::to_string(major) + "." + std::to_string(minor);
+		}
+		versionInfo->Release();
+	}
+
+	// 同じ版でもビルドが違えば結果が変わることがあるので、コミットも混ぜる
+	IDxcVersionInfo2* versionInfo2 = nullptr;
+	if (SUCCEEDED(dxcCompiler->QueryInterface(IID_PPV_ARGS(&versionInfo2))))
+	{
+		UINT32 commitCount = 0;
+		char* commitHash = nullptr;
+		if (SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash)))
+		{
+			version += "+" + std::to_string(commitCount) + "." + (commitHash ? commitHash : "");
+			CoTaskMemFree(commitHash);
+		}
+		versionInfo2->Release();
+	}
+
+	dxcCompiler->Release();
+
+	return version;
+}
+
+/// <summary>
+/// DXCのコンパイラを作る（DXCはスレッドをまたいで使えないので、スレッドごとに作る）
+/// </summary>
+/// <returns>コンパイラ（最後のコピーが捨てられたときにDXCを解放する）</returns>
+ShaderCompileFunction CreateDxcShaderCompiler()
+{
+	// DXCの実体（コンパイラのコピーで共有し、最後に解放する）
+	typedef struct DxcInstance
+	{
+		IDxcUtils* utils;
+		IDxcCompiler3* compiler;
+		IDxcIncludeHandler* includeHandler;
+	}DxcInstance;
+
+	std::shared_ptr<DxcInstance> dxc(new DxcInstance{}, [](DxcInstance* instance)
+		{
+			if (instance->includeHandler)
+			{
+				instance->includeHandler->Release();
+			}
+			if (instance->compiler)
+			{
+				instance->compiler->Release();
+			}
+			if (instance->utils)
+			{
+				instance->utils->Release();
+			}
+			delete instance;
+		});
+
+	HRESULT hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxc->utils));
+	assert(SUCCEEDED(hr));
+
+	hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxc->compiler));
+	assert(SUCCEEDED(hr));
+
+	hr = dxc->utils->CreateDefaultIncludeHandler(&dxc->includeHandler);
+	assert(SUCCEEDED(hr));
+
+	return [dxc](const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+		{
+			return CompileShaderWithDxc(dxc->utils, dxc->compiler, dxc->includeHandler, request, bytecode, errors);
+		};
+}
 
 /// <summary>
 /// HLSLをコンパイルし、バイナリデータで返却する
@@ -8,6 +295,7 @@
 /// <param name="dxcUtils"></param>
 /// <param name="dxcCompiler"></param>
 /// <param name="includeHandler"></param>
+/// <param name="shaderCache">同じ内容ならコンパイルせずに、保存したバイナリを使う</param>
 /// <param name="logStream"></param>
 /// <returns></returns>
 IDxcBlob* CompileShader
@@ -23,107 +311,54 @@ IDxcBlob* CompileShader
 	IDxcCompiler3* dxcCompiler,
 	IDxcIncludeHandler* includeHandler,
 
+	// コンパイル結果の保存先
+	ShaderCache& shaderCache,
+
 	 std::ostream& logStream
 )
 {
-	/*-----------------------
-	    HLSLファイルを読む
-	-----------------------*/
-
 	// これからShaderをCompilerする旨をログに出す
 	Log(logStream, ConvertString(std::format(L"Begin CompileShader , path : {} , profile : {} \n", filePath, profile)));
 
-	// HLSLファイルを読む
-	IDxcBlobEncoding* shaderSource = nullptr;
-	HRESULT hr = dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
-	assert(SUCCEEDED(hr));
-
-	// 読み込んだファイルの内容を設定する
-	DxcBuffer shaderSourceBuffer;
-	shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
-	shaderSourceBuffer.Size = shaderSource->GetBufferSize();
-
-	// UTF8の文字コードであることを通知
-	shaderSourceBuffer.Encoding = DXC_CP_UTF8;
-
-
-	/*-------------------
-	    Compilerする
-	-------------------*/
-
-	LPCWSTR argments[] =
-	{
-		// コンパイル対象のHLSLファイル名
-		filePath.c_str(),
-
-		// エントリーポイントの指定
-		L"-E" , L"main",
-
-		// ShaderProfileの設定
-		L"-T" , profile,
-
-		// デバッグ用の情報を埋め込む
-		L"-Zi" , L"-Qembed_debug",
-
-		// 最適化を外しておく
-		L"-Od" ,
-
-		// メモリレイアウトは行優先
-		L"-Zpr"
-	};
-
-	// 実際にShaderをCompilerする
-	IDxcResult* shaderResult = nullptr;
-	hr = dxcCompiler->Compile
-	(
-		// 読み込んだファイル
-		&shaderSourceBuffer,
+	// 保存したバイナリを探すときに使う、コンパイルの内容（これまで通り、最適化なしでデバッグ情報を埋め込む）
+	ShaderCompileRequest request = MakeShaderCompileRequest(filePath, ConvertString(profile), MakeShaderCompileSettings(ShaderCompileMode::Debug, {}));
 
-		// コンパイルオプション
-		argments,
+	// DXCでコンパイルする（保存したバイナリがなかったときだけ呼ばれる）
+	ShaderCompileFunction compile = [&](const ShaderCompileRequest& target, std::vector<uint8_t>& bytecode, std::string& errors)
+		{
+			return CompileShaderWithDxc(dxcUtils, dxcCompiler, includeHandler, target, bytecode, errors);
+		};
 
-		// コンパイルオプションの数
-		_countof(argments),
 
-		// includeが含まれた諸々
-		includeHandler,
+	/*-------------------------------------------
+		保存したバイナリを使うか、コンパイルする
+	-------------------------------------------*/
 
-		// コンパイル結果
-		IID_PPV_ARGS(&shaderResult)
-	);
+	uint32_t hitCount = shaderCache.hitCount;
 
-	assert(SUCCEEDED(hr));
-
-
-	/*-----------------------------------
-	    警告・エラーが出ていないか確認する
-	-----------------------------------*/
-
-	IDxcBlobUtf8* shaderError = nullptr;
-	shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
-	if (shaderError != nullptr && shaderError->GetStringLength() != 0)
+	std::vector<uint8_t> bytecode;
+	std::string errors;
+	if (!CompileShaderCached(shaderCache, request, compile, bytecode, errors))
 	{
-		Log(logStream, shaderError->GetStringPointer());
+		LogError(logStream, errors);
 		assert(false);
+		return nullptr;
 	}
 
 
 	/*-------------------------------
-	    Compiler結果を受け取って返す
+		結果を返す
 	-------------------------------*/
 
-	// compile結果から実行用のバイナリ部分を取得
-	IDxcBlob* shaderBlob = nullptr;
-	hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
+	// 呼び出し側はこれまで通りReleaseするので、IDxcBlobにして返す
+	IDxcBlobEncoding* shaderBlob = nullptr;
+	HRESULT hr = dxcUtils->CreateBlob(bytecode.data(), static_cast<UINT32>(bytecode.size()), DXC_CP_ACP, &shaderBlob);
 	assert(SUCCEEDED(hr));
 
 	// 成功したログを出す
-	Log(logStream, ConvertString(std::format(L"Compile Succeeded, path : {} , profile : {} \n", filePath, profile)));
-
-	// 使わないリソースを解放
-	shaderSource->Release();
-	shaderResult->Release();
+	const wchar_t* result = (shaderCache.hitCount != hitCount) ? L"Cache Hit" : L"Compile Succeeded";
+	Log(logStream, ConvertString(std::format(L"{}, path : {} , profile : {} \n", result, filePath, profile)));
 
 	// 実行用バイナリを返却
 	return shaderBlob;
-}
\ No newline at end of file
+}
@@ -9,11 +9,37 @@
 #include "../../Func/Window/Window.h"
 #include "../../Func/Get/Get.h"
 #include "../../Func/Barrier/Barrier.h"
+#include "../../Func/ShaderCache/ShaderCache.h"
+#include "../../Func/ShaderCompileSettings/ShaderCompileSettings.h"
 
 #pragma comment(lib,"d3d12.lib")
 #pragma comment(lib,"dxgi.lib")
 #pragma comment(lib,"dxcompiler.lib")
 
+/// <summary>
+/// コンパイルする内容を作る
+/// </summary>
+/// <param name="filePath">HLSLファイルへのパス</param>
+/// <param name="profile">ShaderProfile</param>
+/// <param name="settings">最適化やデバッグ情報の設定</param>
+/// <param name="entryPoint">エントリーポイント</param>
+/// <param name="defines">マクロ（"NAME" か "NAME=VALUE"）</param>
+/// <returns>コンパイルする内容</returns>
+ShaderCompileRequest MakeShaderCompileRequest(const std::filesystem::path& filePath, const std::string& profile, const ShaderCompileSettings& settings,
+	const std::string& entryPoint = "main", const std::vector<std::string>& defines = {});
+
+/// <summary>
+/// DXCの版を取得する（ShaderCacheのハッシュに混ぜる）
+/// </summary>
+/// <returns>"major.minor" と、分かればコミットの数とハッシュ</returns>
+std::string GetDxcCompilerVersion();
+
+/// <summary>
+/// DXCのコンパイラを作る（DXCはスレッドをまたいで使えないので、スレッドごとに作る）
+/// </summary>
+/// <returns>コンパイラ（最後のコピーが捨てられたときにDXCを解放する）</returns>
+ShaderCompileFunction CreateDxcShaderCompiler();
+
 /// <summary>
 /// HLSLをコンパイルし、バイナリデータで返却する
 /// </summary>
@@ -22,6 +48,7 @@
 /// <param name="dxcUtils"></param>
 /// <param name="dxcCompiler"></param>
 /// <param name="includeHandler"></param>
+/// <param name="shaderCache">同じ内容ならコンパイルせずに、保存したバイナリを使う</param>
 /// <param name="logStream"></param>
 /// <returns></returns>
 IDxcBlob* CompileShader
@@ -37,5 +64,8 @@ IDxcBlob* CompileShader
 	IDxcCompiler3* dxcCompiler,
 	IDxcIncludeHandler* includeHandler,
 
+	// コンパイル結果の保存先
+	ShaderCache& shaderCache,
+
 	std::ostream& logStream
 );
\ No newline at end of file
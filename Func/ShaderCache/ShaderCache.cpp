@@ -0,0 +1,332 @@
+#include "ShaderCache.h"
+#include "../Hash/Hash.h"
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace
+{
+	// 保存するファイルの形式やハッシュの求め方が変わったら増やす
+	const uint64_t kShaderCacheVersion = 3;
+
+	/// <summary>
+	/// ファイルを全て読む
+	/// </summary>
+	bool ReadShaderFile(const std::filesystem::path& path, std::string& contents)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		std::ostringstream stream;
+		stream << file.rdbuf();
+		contents = stream.str();
+
+		return true;
+	}
+
+	/// <summary>
+	/// ソースの #include "〜" と #include <〜> の名前を取り出す（コメントの中は見ない）
+	/// </summary>
+	std::vector<std::string> ParseShaderIncludes(const std::string& source)
+	{
+		// includeの名前
+		std::vector<std::string> includes;
+
+		bool isInBlockComment = false;
+		size_t lineStart = 0;
+
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+			{
+				lineEnd = source.size();
+			}
+
+			// コメントを除いた行
+			std::string line;
+			for (size_t i = lineStart; i < lineEnd; i++)
+			{
+				if (isInBlockComment)
+				{
+					if (source.compare(i, 2, "*/") == 0)
+					{
+						isInBlockComment = false;
+						i++;
+					}
+					continue;
+				}
+
+				if (source.compare(i, 2, "/*") == 0)
+				{
+					isInBlockComment = true;
+					i++;
+					continue;
+				}
+
+				if (source.compare(i, 2, "//") == 0)
+				{
+					break;
+				}
+
+				line += source[i];
+			}
+
+			lineStart = lineEnd + 1;
+
+			// # include の順に並んでいるか
+			size_t position = line.find_first_not_of(" \t");
+			if (position == std::string::npos || line[position] != '#')
+			{
+				continue;
+			}
+
+			position = line.find_first_not_of(" \t", position + 1);
+			if (position == std::string::npos || line.compare(position, 7, "include") != 0)
+			{
+				continue;
+			}
+
+			position = line.find_first_not_of(" \t", position + 7);
+			if (position == std::string::npos || (line[position] != '"' && line[position] != '<'))
+			{
+				continue;
+			}
+
+			char closing = (line[position] == '"') ? '"' : '>';
+			size_t nameEnd = line.find(closing, position + 1);
+			if (nameEnd != std::string::npos)
+			{
+				includes.push_back(line.substr(position + 1, nameEnd - position - 1));
+			}
+		}
+
+		return includes;
+	}
+
+	/// <summary>
+	/// includeの名前からファイルを探す（includeしたファイルのフォルダ、includeDirectoriesの順）
+	/// </summary>
+	std::filesystem::path ResolveShaderInclude(const ShaderCache& cache, const std::filesystem::path& includingPath, const std::string& name)
+	{
+		std::filesystem::path candidate = (includingPath.parent_path() / name).lexically_normal();
+		std::error_code error;
+
+		if (std::filesystem::is_regular_file(candidate, error))
+		{
+			return candidate;
+		}
+
+		for (const std::filesystem::path& directory : cache.includeDirectories)
+		{
+			std::filesystem::path found = (directory / name).lexically_normal();
+			if (std::filesystem::is_regular_file(found, error))
+			{
+				return found;
+			}
+		}
+
+		// 見つからなくても、後でできたときに結果が変わるように記録する
+		return candidate;
+	}
+
+	/// <summary>
+	/// 保存するファイルのパス（ハッシュの16進数）
+	/// </summary>
+	std::filesystem::path MakeShaderCachePath(const ShaderCache& cache, uint64_t hash)
+	{
+		char name[32]{};
+		std::snprintf(name, sizeof(name), "%016llx.cso", static_cast<unsigned long long>(hash));
+		return cache.directory / name;
+	}
+}
+
+/// <summary>
+/// ShaderCacheを作る
+/// </summary>
+/// <param name="directory">保存先のフォルダ</param>
+/// <param name="isEnabled">使うか</param>
+/// <param name="compilerVersion">コンパイラの版</param>
+/// <returns>ShaderCache</returns>
+ShaderCache MakeShaderCache(const std::filesystem::path& directory, bool isEnabled, const std::string& compilerVersion)
+{
+	// ShaderCache
+	ShaderCache cache{};
+	cache.directory = directory;
+	cache.isEnabled = isEnabled;
+	cache.compilerVersion = compilerVersion;
+
+	return cache;
+}
+
+/// <summary>
+/// ソースが読むファイルを全て集める（includeのincludeも含む。見つからないものも含む）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="sourcePath">HLSLファイルへのパス</param>
+/// <returns>ソース自身と、includeされるファイル（見つかった順）</returns>
+std::vector<std::filesystem::path> CollectShaderDependencies(const ShaderCache& cache, const std::filesystem::path& sourcePath)
+{
+	// 読むファイル
+	std::vector<std::filesystem::path> dependencies;
+	std::unordered_set<std::string> visited;
+
+	// 深さ優先でたどる（同じファイルは一度だけ）
+	std::vector<std::filesystem::path> stack = { sourcePath.lexically_normal() };
+
+	while (!stack.empty())
+	{
+		std::filesystem::path path = stack.back();
+		stack.pop_back();
+
+		if (!visited.insert(path.generic_string()).second)
+		{
+			continue;
+		}
+
+		dependencies.push_back(path);
+
+		std::string source;
+		if (!ReadShaderFile(path, source))
+		{
+			continue;
+		}
+
+		// 書かれた順にたどるように、逆順に積む
+		std::vector<std::string> includes = ParseShaderIncludes(source);
+		for (auto it = includes.rbegin(); it != includes.rend(); ++it)
+		{
+			stack.push_back(ResolveShaderInclude(cache, path, *it));
+		}
+	}
+
+	return dependencies;
+}
+
+/// <summary>
+/// コンパイルの結果を決める全てのもののハッシュを求める（コンパイラの版、ソースと全てのincludeの中身、エントリーポイント、Profile、マクロ、オプション）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="request">コンパイルする内容</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashShaderCompileRequest(const ShaderCache& cache, const ShaderCompileRequest& request)
+{
+	uint64_t hash = HashValue(kHashSeed, kShaderCacheVersion);
+	hash = HashString(hash, cache.compilerVersion);
+	hash = HashString(hash, request.entryPoint);
+	hash = HashString(hash, request.profile);
+
+	hash = HashValue(hash, static_cast<uint64_t>(request.defines.size()));
+	for (const std::string& define : request.defines)
+	{
+		hash = HashString(hash, define);
+	}
+
+	hash = HashValue(hash, static_cast<uint64_t>(request.arguments.size()));
+	for (const std::string& argument : request.arguments)
+	{
+		hash = HashString(hash, argument);
+	}
+
+	std::vector<std::filesystem::path> dependencies = CollectShaderDependencies(cache, request.sourcePath);
+
+	hash = HashValue(hash, static_cast<uint64_t>(dependencies.size()));
+	for (const std::filesystem::path& dependency : dependencies)
+	{
+		hash = HashString(hash, dependency.generic_string());
+
+		// 見つからないファイルは、中身の代わりに印を混ぜる
+		std::string contents;
+		if (ReadShaderFile(dependency, contents))
+		{
+			hash = HashString(hash, contents);
+		}
+		else
+		{
+			hash = HashValue(hash, UINT64_MAX);
+		}
+	}
+
+	return hash;
+}
+
+/// <summary>
+/// 保存されたバイトコードがあれば読み、なければコンパイルして保存する（保存に失敗しても、コンパイルできていれば成功）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="request">コンパイルする内容</param>
+/// <param name="compile">コンパイラ</param>
+/// <param name="bytecode">バイトコード</param>
+/// <param name="errors">コンパイルに失敗した理由</param>
+/// <returns>成功したか</returns>
+bool CompileShaderCached(ShaderCache& cache, const ShaderCompileRequest& request, const ShaderCompileFunction& compile, std::vector<uint8_t>& bytecode, std::string& errors)
+{
+	bytecode.clear();
+	errors.clear();
+
+	if (!cache.isEnabled)
+	{
+		cache.missCount++;
+		return compile(request, bytecode, errors);
+	}
+
+	std::filesystem::path path = MakeShaderCachePath(cache, HashShaderCompileRequest(cache, request));
+
+	// 保存されている
+	std::ifstream file(path, std::ios::binary);
+	if (file)
+	{
+		bytecode.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		if (!bytecode.empty())
+		{
+			cache.hitCount++;
+			return true;
+		}
+	}
+
+	// コンパイルする
+	cache.missCount++;
+
+	if (!compile(request, bytecode, errors))
+	{
+		return false;
+	}
+
+	// 書きかけのファイルを読まないように、別の名前で書いてから名前を変える
+	std::error_code error;
+	std::filesystem::create_directories(cache.directory, error);
+
+	// 名前の後ろに付ける部分（"." + 文字列 はGCC 12の-O3で-Wrestrictの誤検出が出るので、appendでつなぐ）
+	std::string temporarySuffix = ".";
+	temporarySuffix.append(std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+	temporarySuffix.append(".tmp");
+
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += temporarySuffix;
+
+	std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+	output.write(reinterpret_cast<const char*>(bytecode.data()), static_cast<std::streamsize>(bytecode.size()));
+	output.close();
+
+	// 書ききれなかったファイルは残さない（次に読んだときに壊れたバイトコードを使わないように）
+	if (!output)
+	{
+		std::filesystem::remove(temporaryPath, error);
+		return true;
+	}
+
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath, error);
+	}
+
+	return true;
+}
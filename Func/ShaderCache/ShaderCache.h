@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// コンパイルする内容
+typedef struct ShaderCompileRequest
+{
+	// HLSLファイルへのパス
+	std::filesystem::path sourcePath;
+
+	// エントリーポイント
+	std::string entryPoint;
+
+	// ShaderProfile
+	std::string profile;
+
+	// マクロ（"NAME" か "NAME=VALUE"）
+	std::vector<std::string> defines;
+
+	// その他のコンパイルオプション
+	std::vector<std::string> arguments;
+}ShaderCompileRequest;
+
+/*
+	コンパイラ（成功したらbytecodeに結果を入れてtrue、失敗したらerrorsに理由を入れてfalse）
+	DXCに依存しないように、関数で受け取る
+*/
+typedef std::function<bool(const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)> ShaderCompileFunction;
+
+/*
+	シェーダーのバイトコードを、ソースと全てのinclude、オプションのハッシュでファイルに保存する
+	同じハッシュのファイルがあればコンパイラを呼ばない
+*/
+typedef struct ShaderCache
+{
+	// 保存先のフォルダ
+	std::filesystem::path directory;
+
+	// 使うか（falseなら毎回コンパイルする）
+	bool isEnabled;
+
+	// includeを探すフォルダ（includeしたファイルのフォルダの次に探す）
+	std::vector<std::filesystem::path> includeDirectories;
+
+	// コンパイラの版（ハッシュに混ぜるので、コンパイラを入れ替えると保存したものは使われない）
+	std::string compilerVersion;
+
+	// ファイルにあった回数、コンパイルした回数
+	uint32_t hitCount;
+	uint32_t missCount;
+}ShaderCache;
+
+/// <summary>
+/// ShaderCacheを作る
+/// </summary>
+/// <param name="directory">保存先のフォルダ</param>
+/// <param name="isEnabled">使うか</param>
+/// <param name="compilerVersion">コンパイラの版</param>
+/// <returns>ShaderCache</returns>
+ShaderCache MakeShaderCache(const std::filesystem::path& directory, bool isEnabled, const std::string& compilerVersion);
+
+/// <summary>
+/// ソースが読むファイルを全て集める（includeのincludeも含む。見つからないものも含む）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="sourcePath">HLSLファイルへのパス</param>
+/// <returns>ソース自身と、includeされるファイル（見つかった順）</returns>
+std::vector<std::filesystem::path> CollectShaderDependencies(const ShaderCache& cache, const std::filesystem::path& sourcePath);
+
+/// <summary>
+/// コンパイルの結果を決める全てのもののハッシュを求める（コンパイラの版、ソースと全てのincludeの中身、エントリーポイント、Profile、マクロ、オプション）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="request">コンパイルする内容</param>
+/// <returns>ハッシュ</returns>
+uint64_t HashShaderCompileRequest(const ShaderCache& cache, const ShaderCompileRequest& request);
+
+/// <summary>
+/// 保存されたバイトコードがあれば読み、なければコンパイルして保存する（保存に失敗しても、コンパイルできていれば成功）
+/// </summary>
+/// <param name="cache">ShaderCache</param>
+/// <param name="request">コンパイルする内容</param>
+/// <param name="compile">コンパイラ</param>
+/// <param name="bytecode">バイトコード</param>
+/// <param name="errors">コンパイルに失敗した理由</param>
+/// <returns>成功したか</returns>
+bool CompileShaderCached(ShaderCache& cache, const ShaderCompileRequest& request, const ShaderCompileFunction& compile, std::vector<uint8_t>& bytecode, std::string& errors);
@@ -0,0 +1,212 @@
+#include "ShaderCompileBatch.h"
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <memory>
+
+namespace
+{
+	/// <summary>
+	/// 始めた時刻からの経過時間
+	/// </summary>
+	double GetElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+/// <summary>
+/// コンパイルするスレッドを作る（各スレッドが、自分のコンパイラを作って仕事を待つ）
+/// </summary>
+/// <param name="workerCount">スレッドの数（0なら1本）</param>
+/// <param name="createCompiler">コンパイラを作る関数（スレッドごとに1回だけ、そのスレッドで呼ばれる）</param>
+/// <returns>ShaderCompilePool</returns>
+ShaderCompilePool* CreateShaderCompilePool(uint32_t workerCount, const std::function<ShaderCompileFunction()>& createCompiler)
+{
+	// ShaderCompilePool
+	ShaderCompilePool* pool = new ShaderCompilePool{};
+	pool->isRunning = true;
+
+	workerCount = (std::max)(workerCount, 1u);
+	pool->workers.reserve(workerCount);
+
+	for (uint32_t workerIndex = 0; workerIndex < workerCount; workerIndex++)
+	{
+		pool->workers.emplace_back([pool, workerIndex, createCompiler]()
+			{
+				// このスレッドだけが使うコンパイラ（止まるまで使い回す）
+				ShaderCompileFunction compile = createCompiler();
+
+				while (true)
+				{
+					ShaderCompileTask task;
+
+					{
+						std::unique_lock<std::mutex> lock(pool->mutex);
+						pool->condition.wait(lock, [&]() { return !pool->isRunning || !pool->tasks.empty(); });
+
+						// 止める指示があっても、入っている仕事は終わらせる（結果を待っている人がいる）
+						if (pool->tasks.empty())
+						{
+							return;
+						}
+
+						task = std::move(pool->tasks.front());
+						pool->tasks.pop_front();
+					}
+
+					task(compile, workerIndex);
+				}
+			});
+	}
+
+	return pool;
+}
+
+/// <summary>
+/// 残っている仕事を終わらせてからスレッドを止め、ShaderCompilePoolを解放する
+/// </summary>
+/// <param name="pool">ShaderCompilePool</param>
+void ReleaseShaderCompilePool(ShaderCompilePool* pool)
+{
+	if (pool == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pool->mutex);
+		pool->isRunning = false;
+	}
+	pool->condition.notify_all();
+
+	for (std::thread& worker : pool->workers)
+	{
+		worker.join();
+	}
+
+	delete pool;
+}
+
+/// <summary>
+/// コンパイルを始める（待たずに戻る。終わったら必ずFinishShaderCompileBatchを呼ぶ）
+/// </summary>
+/// <param name="pool">コンパイルするShaderCompilePool（FinishShaderCompileBatchまで解放しない）</param>
+/// <param name="jobs">コンパイルする内容</param>
+/// <param name="cache">保存したものを使うならShaderCache（使わないならnullptr。終わるまで書き換えない）</param>
+/// <returns>ShaderCompileBatch</returns>
+ShaderCompileBatch StartShaderCompileBatch(ShaderCompilePool* pool, const std::vector<ShaderCompileRequest>& jobs, const ShaderCache* cache)
+{
+	assert(pool != nullptr);
+
+	// ShaderCompileBatch
+	ShaderCompileBatch batch{};
+	batch.startTime = std::chrono::steady_clock::now();
+	batch.workerCount = (std::min)(static_cast<uint32_t>(pool->workers.size()), static_cast<uint32_t>(jobs.size()));
+
+	// 仕事が共有するもの（バッチが先に捨てられても残るように、仕事が持つ）
+	auto sharedJobs = std::make_shared<const std::vector<ShaderCompileRequest>>(jobs);
+	auto promises = std::make_shared<std::vector<std::promise<ShaderCompileResult>>>(jobs.size());
+
+	// 保存先の設定（仕事ごとに、同じ設定の自分用のShaderCacheを作る。数えた回数は最後に足す）
+	std::shared_ptr<const ShaderCache> sharedCache;
+	if (cache)
+	{
+		sharedCache = std::make_shared<const ShaderCache>(*cache);
+	}
+
+	for (std::promise<ShaderCompileResult>& promise : *promises)
+	{
+		batch.results.push_back(promise.get_future().share());
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pool->mutex);
+
+		for (size_t jobIndex = 0; jobIndex < jobs.size(); jobIndex++)
+		{
+			pool->tasks.push_back([=, startTime = batch.startTime](const ShaderCompileFunction& compile, uint32_t workerIndex)
+				{
+					const ShaderCompileRequest& job = (*sharedJobs)[jobIndex];
+
+					try
+					{
+						ShaderCompileResult result{};
+						result.workerIndex = workerIndex;
+
+						std::chrono::steady_clock::time_point compileStart = std::chrono::steady_clock::now();
+
+						if (sharedCache)
+						{
+							ShaderCache jobCache = MakeShaderCache(sharedCache->directory, sharedCache->isEnabled, sharedCache->compilerVersion);
+							jobCache.includeDirectories = sharedCache->includeDirectories;
+
+							result.isSucceeded = CompileShaderCached(jobCache, job, compile, result.bytecode, result.errors);
+							result.isCacheHit = jobCache.hitCount != 0;
+						}
+						else
+						{
+							result.isSucceeded = compile(job, result.bytecode, result.errors);
+						}
+
+						result.compileMilliseconds = GetElapsedMilliseconds(compileStart);
+						result.finishMilliseconds = GetElapsedMilliseconds(startTime);
+
+						(*promises)[jobIndex].set_value(std::move(result));
+					}
+					catch (...)
+					{
+						(*promises)[jobIndex].set_exception(std::current_exception());
+					}
+				});
+		}
+	}
+	pool->condition.notify_all();
+
+	return batch;
+}
+
+/// <summary>
+/// ジョブの結果を待って取得する
+/// </summary>
+/// <param name="batch">ShaderCompileBatch</param>
+/// <param name="jobIndex">ジョブの番号</param>
+/// <returns>結果（batchを捨てるまで有効）</returns>
+const ShaderCompileResult& WaitShaderCompileResult(const ShaderCompileBatch& batch, uint32_t jobIndex)
+{
+	assert(jobIndex < batch.results.size());
+
+	return batch.results[jobIndex].get();
+}
+
+/// <summary>
+/// 全てのジョブを待ち、かかった時間をまとめる
+/// </summary>
+/// <param name="batch">ShaderCompileBatch（結果はこの後も取得できる）</param>
+/// <param name="cache">使った数を足すShaderCache（nullptrでもよい）</param>
+/// <returns>かかった時間</returns>
+ShaderCompileBatchStats FinishShaderCompileBatch(ShaderCompileBatch& batch, ShaderCache* cache)
+{
+	// かかった時間
+	ShaderCompileBatchStats stats{};
+	stats.workerCount = batch.workerCount;
+
+	for (const std::shared_future<ShaderCompileResult>& future : batch.results)
+	{
+		const ShaderCompileResult& result = future.get();
+
+		stats.wallMilliseconds = (std::max)(stats.wallMilliseconds, result.finishMilliseconds);
+		stats.serialMilliseconds += result.compileMilliseconds;
+		stats.hitCount += result.isCacheHit ? 1 : 0;
+		stats.missCount += result.isCacheHit ? 0 : 1;
+		stats.failedCount += result.isSucceeded ? 0 : 1;
+	}
+
+	if (cache)
+	{
+		cache->hitCount += stats.hitCount;
+		cache->missCount += stats.missCount;
+	}
+
+	return stats;
+}
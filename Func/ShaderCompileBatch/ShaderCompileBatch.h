@@ -0,0 +1,137 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ShaderCache/ShaderCache.h"
+
+// 1つのシェーダーのコンパイル結果
+typedef struct ShaderCompileResult
+{
+	// 成功したか
+	bool isSucceeded;
+
+	// バイトコード
+	std::vector<uint8_t> bytecode;
+
+	// 失敗した理由
+	std::string errors;
+
+	// 保存したものを使ったか
+	bool isCacheHit;
+
+	// コンパイルにかかった時間
+	double compileMilliseconds;
+
+	// バッチを始めてから終わるまでの時間
+	double finishMilliseconds;
+
+	// コンパイルしたスレッドの番号
+	uint32_t workerIndex;
+}ShaderCompileResult;
+
+// コンパイルするスレッドに渡す仕事（コンパイラと、スレッドの番号を受け取る）
+typedef std::function<void(const ShaderCompileFunction& compile, uint32_t workerIndex)> ShaderCompileTask;
+
+/*
+	シェーダーをコンパイルするスレッドを、作ったまま使い回す
+	コンパイラは各スレッドが初めに1回だけ作って持ち続けるので、バッチやホットリロードのたびにDXCを作り直さない
+*/
+typedef struct ShaderCompilePool
+{
+	// コンパイルするスレッド
+	std::vector<std::thread> workers;
+
+	// tasksとisRunningを守る
+	std::mutex mutex;
+
+	// 仕事が入ったこと、止めることを知らせる
+	std::condition_variable condition;
+
+	// まだ取られていない仕事（入れた順に取る）
+	std::deque<ShaderCompileTask> tasks;
+
+	// 止める指示（残っている仕事は終わらせてから止まる）
+	bool isRunning;
+}ShaderCompilePool;
+
+/*
+	複数のシェーダーを、ShaderCompilePoolのスレッドで同時にコンパイルする
+	結果はジョブの順にfutureで受け取れるので、PSOを作るときに必要なものだけを待てばよい
+*/
+typedef struct ShaderCompileBatch
+{
+	// ジョブの順の結果
+	std::vector<std::shared_future<ShaderCompileResult>> results;
+
+	// コンパイルしたスレッドの数
+	uint32_t workerCount;
+
+	// 始めた時刻
+	std::chrono::steady_clock::time_point startTime;
+}ShaderCompileBatch;
+
+// バッチ全体の時間
+typedef struct ShaderCompileBatchStats
+{
+	// 始めてから全て終わるまでの時間
+	double wallMilliseconds;
+
+	// 1つずつコンパイルした場合の時間（全てのコンパイル時間の合計）
+	double serialMilliseconds;
+
+	// スレッドの数
+	uint32_t workerCount;
+
+	// 保存したものを使った数、コンパイルした数
+	uint32_t hitCount;
+	uint32_t missCount;
+
+	// 失敗した数
+	uint32_t failedCount;
+}ShaderCompileBatchStats;
+
+/// <summary>
+/// コンパイルするスレッドを作る（各スレッドが、自分のコンパイラを作って仕事を待つ）
+/// </summary>
+/// <param name="workerCount">スレッドの数（0なら1本）</param>
+/// <param name="createCompiler">コンパイラを作る関数（スレッドごとに1回だけ、そのスレッドで呼ばれる）</param>
+/// <returns>ShaderCompilePool</returns>
+ShaderCompilePool* CreateShaderCompilePool(uint32_t workerCount, const std::function<ShaderCompileFunction()>& createCompiler);
+
+/// <summary>
+/// 残っている仕事を終わらせてからスレッドを止め、ShaderCompilePoolを解放する
+/// </summary>
+/// <param name="pool">ShaderCompilePool</param>
+void ReleaseShaderCompilePool(ShaderCompilePool* pool);
+
+/// <summary>
+/// コンパイルを始める（待たずに戻る。終わったら必ずFinishShaderCompileBatchを呼ぶ）
+/// </summary>
+/// <param name="pool">コンパイルするShaderCompilePool（FinishShaderCompileBatchまで解放しない）</param>
+/// <param name="jobs">コンパイルする内容</param>
+/// <param name="cache">保存したものを使うならShaderCache（使わないならnullptr。終わるまで書き換えない）</param>
+/// <returns>ShaderCompileBatch</returns>
+ShaderCompileBatch StartShaderCompileBatch(ShaderCompilePool* pool, const std::vector<ShaderCompileRequest>& jobs, const ShaderCache* cache);
+
+/// <summary>
+/// ジョブの結果を待って取得する
+/// </summary>
+/// <param name="batch">ShaderCompileBatch</param>
+/// <param name="jobIndex">ジョブの番号</param>
+/// <returns>結果（batchを捨てるまで有効）</returns>
+const ShaderCompileResult& WaitShaderCompileResult(const ShaderCompileBatch& batch, uint32_t jobIndex);
+
+/// <summary>
+/// 全てのジョブを待ち、かかった時間をまとめる
+/// </summary>
+/// <param name="batch">ShaderCompileBatch（結果はこの後も取得できる）</param>
+/// <param name="cache">使った数を足すShaderCache（nullptrでもよい）</param>
+/// <returns>かかった時間</returns>
+ShaderCompileBatchStats FinishShaderCompileBatch(ShaderCompileBatch& batch, ShaderCache* cache);
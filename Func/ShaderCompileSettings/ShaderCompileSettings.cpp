@@ -0,0 +1,116 @@
+#include "ShaderCompileSettings.h"
+#include <algorithm>
+
+/// <summary>
+/// モードの既定の設定を作る
+/// </summary>
+/// <param name="mode">モード</param>
+/// <param name="pdbDirectory">PDBを書き出すフォルダ（デバッグ情報を埋め込まないときに使う）</param>
+/// <returns>ShaderCompileSettings</returns>
+ShaderCompileSettings MakeShaderCompileSettings(ShaderCompileMode mode, const std::filesystem::path& pdbDirectory)
+{
+	// ShaderCompileSettings
+	ShaderCompileSettings settings{};
+	settings.mode = mode;
+	settings.pdbDirectory = pdbDirectory;
+	settings.isDebugInfo = true;
+
+	switch (mode)
+	{
+	case ShaderCompileMode::Debug:
+
+		settings.optimizationLevel = -1;
+		settings.isEmbedDebugInfo = true;
+		settings.isStripReflection = false;
+		break;
+
+	case ShaderCompileMode::Release:
+
+		settings.optimizationLevel = 3;
+		settings.isEmbedDebugInfo = false;
+		settings.isStripReflection = true;
+		break;
+
+	case ShaderCompileMode::Profile:
+
+		settings.optimizationLevel = 3;
+		settings.isEmbedDebugInfo = true;
+		settings.isStripReflection = false;
+		break;
+	}
+
+	return settings;
+}
+
+/// <summary>
+/// 設定からDXCのコンパイルオプションを作る（エントリーポイント、Profile、マクロ以外）
+/// </summary>
+/// <param name="settings">ShaderCompileSettings</param>
+/// <returns>コンパイルオプション</returns>
+std::vector<std::string> MakeShaderCompileArguments(const ShaderCompileSettings& settings)
+{
+	// コンパイルオプション
+	std::vector<std::string> arguments;
+
+	// 最適化
+	if (settings.optimizationLevel < 0)
+	{
+		arguments.push_back("-Od");
+	}
+	else
+	{
+		arguments.push_back("-O" + std::to_string((std::min)(settings.optimizationLevel, 3)));
+	}
+
+	// デバッグ情報
+	if (settings.isDebugInfo)
+	{
+		arguments.push_back("-Zi");
+
+		if (settings.isEmbedDebugInfo)
+		{
+			arguments.push_back("-Qembed_debug");
+		}
+		else
+		{
+			// バイトコードからは外し、PDBを別に書き出す（名前はバイナリのハッシュなので、同じバイトコードは同じPDBを指す）
+			arguments.push_back("-Qstrip_debug");
+			arguments.push_back("-Zsb");
+			arguments.push_back("-Fd");
+			arguments.push_back((settings.pdbDirectory / "").generic_string());
+		}
+	}
+
+	// リフレクション
+	if (settings.isStripReflection)
+	{
+		arguments.push_back("-Qstrip_reflect");
+	}
+
+	// メモリレイアウトは行優先（モードによらず、C++側の行列の並びに合わせる）
+	arguments.push_back("-Zpr");
+
+	return arguments;
+}
+
+/// <summary>
+/// モードの名前
+/// </summary>
+/// <param name="mode">モード</param>
+/// <returns>名前</returns>
+const char* GetShaderCompileModeName(ShaderCompileMode mode)
+{
+	switch (mode)
+	{
+	case ShaderCompileMode::Debug:
+		return "Debug";
+
+	case ShaderCompileMode::Release:
+		return "Release";
+
+	case ShaderCompileMode::Profile:
+		return "Profile";
+	}
+
+	return "Unknown";
+}
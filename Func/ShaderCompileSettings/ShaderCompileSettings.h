@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// シェーダーをどう作るか
+enum class ShaderCompileMode
+{
+	// 最適化なし、デバッグ情報を埋め込む
+	Debug,
+
+	// 最適化あり、デバッグ情報とリフレクションを外し、デバッグ情報は別のPDBに書き出す
+	Release,
+
+	// 最適化あり、デバッグ情報を埋め込む（PIXなどで計測しながらソースを見る）
+	Profile
+};
+
+/*
+	シェーダーのコンパイルオプションを組み立てるための設定
+	モードごとの既定値をMakeShaderCompileSettingsで作り、必要なら項目を書き換えて使う
+*/
+typedef struct ShaderCompileSettings
+{
+	// モード
+	ShaderCompileMode mode;
+
+	// 最適化のレベル（0〜3、-1なら最適化しない）
+	int32_t optimizationLevel;
+
+	// デバッグ情報を作るか、バイトコードに埋め込むか（埋め込まないならpdbDirectoryに書き出す）
+	bool isDebugInfo;
+	bool isEmbedDebugInfo;
+
+	// 書き出すPDBのフォルダ
+	std::filesystem::path pdbDirectory;
+
+	// リフレクションを外すか（RootSignatureはコードで作るので、実行時には使わない）
+	bool isStripReflection;
+}ShaderCompileSettings;
+
+/// <summary>
+/// モードの既定の設定を作る
+/// </summary>
+/// <param name="mode">モード</param>
+/// <param name="pdbDirectory">PDBを書き出すフォルダ（デバッグ情報を埋め込まないときに使う）</param>
+/// <returns>ShaderCompileSettings</returns>
+ShaderCompileSettings MakeShaderCompileSettings(ShaderCompileMode mode, const std::filesystem::path& pdbDirectory);
+
+/// <summary>
+/// 設定からDXCのコンパイルオプションを作る（エントリーポイント、Profile、マクロ以外）
+/// </summary>
+/// <param name="settings">ShaderCompileSettings</param>
+/// <returns>コンパイルオプション</returns>
+std::vector<std::string> MakeShaderCompileArguments(const ShaderCompileSettings& settings);
+
+/// <summary>
+/// モードの名前
+/// </summary>
+/// <param name="mode">モード</param>
+/// <returns>名前</returns>
+const char* GetShaderCompileModeName(ShaderCompileMode mode);
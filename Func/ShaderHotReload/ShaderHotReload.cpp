@@ -0,0 +1,259 @@
+#include "ShaderHotReload.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	/// <summary>
+	/// 番号を小さい順に重複なく加える
+	/// </summary>
+	void InsertShaderIndex(std::vector<uint32_t>& indices, uint32_t shaderIndex)
+	{
+		auto it = std::lower_bound(indices.begin(), indices.end(), shaderIndex);
+		if (it == indices.end() || *it != shaderIndex)
+		{
+			indices.insert(it, shaderIndex);
+		}
+	}
+
+	/// <summary>
+	/// シェーダーの読むファイルを集め直し、表と見張りに登録する（includeが増えたり減ったりしても追いかける）
+	/// </summary>
+	void RefreshShaderDependencies(ShaderHotReload& reload, uint32_t shaderIndex)
+	{
+		std::vector<std::filesystem::path> dependencies = CollectShaderDependencies(reload.cache, reload.shaders[shaderIndex].sourcePath);
+
+		SetShaderDependencies(reload.graph, shaderIndex, dependencies);
+
+		for (const std::filesystem::path& dependency : dependencies)
+		{
+			WatchFile(reload.watcher, dependency);
+		}
+	}
+
+	/// <summary>
+	/// バッチの全ての結果が出たか（待たない）
+	/// </summary>
+	bool IsShaderCompileBatchReady(const ShaderCompileBatch& batch)
+	{
+		for (const std::shared_future<ShaderCompileResult>& result : batch.results)
+		{
+			if (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+/// <summary>
+/// シェーダーの読むファイルを登録し直す
+/// </summary>
+/// <param name="graph">ShaderDependencyGraph</param>
+/// <param name="shaderIndex">シェーダーの番号</param>
+/// <param name="dependencies">読むファイル</param>
+void SetShaderDependencies(ShaderDependencyGraph& graph, uint32_t shaderIndex, const std::vector<std::filesystem::path>& dependencies)
+{
+	if (graph.dependencies.size() <= shaderIndex)
+	{
+		graph.dependencies.resize(shaderIndex + 1);
+	}
+
+	// 前に登録したものを外す
+	for (const std::string& key : graph.dependencies[shaderIndex])
+	{
+		std::vector<uint32_t>& dependents = graph.dependents[key];
+		dependents.erase(std::remove(dependents.begin(), dependents.end(), shaderIndex), dependents.end());
+
+		if (dependents.empty())
+		{
+			graph.dependents.erase(key);
+		}
+	}
+
+	graph.dependencies[shaderIndex].clear();
+
+	for (const std::filesystem::path& dependency : dependencies)
+	{
+		std::string key = dependency.lexically_normal().generic_string();
+
+		graph.dependencies[shaderIndex].push_back(key);
+		InsertShaderIndex(graph.dependents[key], shaderIndex);
+	}
+}
+
+/// <summary>
+/// 書き換えられたファイルを読むシェーダーを探す
+/// </summary>
+/// <param name="graph">ShaderDependencyGraph</param>
+/// <param name="changedPaths">書き換えられたファイル</param>
+/// <returns>シェーダーの番号（小さい順、重複なし）</returns>
+std::vector<uint32_t> FindAffectedShaders(const ShaderDependencyGraph& graph, const std::vector<std::filesystem::path>& changedPaths)
+{
+	// シェーダーの番号
+	std::vector<uint32_t> affected;
+
+	for (const std::filesystem::path& path : changedPaths)
+	{
+		auto it = graph.dependents.find(path.lexically_normal().generic_string());
+		if (it == graph.dependents.end())
+		{
+			continue;
+		}
+
+		for (uint32_t shaderIndex : it->second)
+		{
+			InsertShaderIndex(affected, shaderIndex);
+		}
+	}
+
+	return affected;
+}
+
+/// <summary>
+/// ShaderHotReloadを作り、シェーダーとincludeを見張り始める
+/// </summary>
+/// <param name="shaders">見張るシェーダー</param>
+/// <param name="cache">コンパイル結果の保存先（設定を写す）</param>
+/// <param name="compilePool">コンパイルするShaderCompilePool（ReleaseShaderHotReloadまで解放しない）</param>
+/// <param name="settleMilliseconds">書き換えが止まってからコンパイルを始めるまでの時間</param>
+/// <returns>ShaderHotReload</returns>
+ShaderHotReload CreateShaderHotReload(const std::vector<ShaderCompileRequest>& shaders, const ShaderCache& cache,
+	ShaderCompilePool* compilePool, double settleMilliseconds)
+{
+	// ShaderHotReload
+	ShaderHotReload reload{};
+	reload.shaders = shaders;
+	reload.cache = MakeShaderCache(cache.directory, cache.isEnabled, cache.compilerVersion);
+	reload.cache.includeDirectories = cache.includeDirectories;
+	reload.compilePool = compilePool;
+	reload.watcher = CreateFileWatcher(250.0);
+	reload.settleMilliseconds = settleMilliseconds;
+	reload.bytecodes.resize(shaders.size(), nullptr);
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(shaders.size()); i++)
+	{
+		RefreshShaderDependencies(reload, i);
+	}
+
+	return reload;
+}
+
+/// <summary>
+/// 書き換えを調べ、コンパイルを始め、終わったものを受け取る（待たずに戻るので、毎フレームの始めに呼ぶ）
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+/// <returns>コンパイルし直せたシェーダーの番号（GetReloadedShaderBytecodeで受け取る）</returns>
+std::vector<uint32_t> UpdateShaderHotReload(ShaderHotReload& reload)
+{
+	// コンパイルし直せたシェーダーの番号
+	std::vector<uint32_t> reloadedShaders;
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+
+	/*---------------------------
+	    書き換えられたものを探す
+	---------------------------*/
+
+	std::vector<std::filesystem::path> changedPaths = PollFileWatcher(reload.watcher);
+	if (!changedPaths.empty())
+	{
+		for (uint32_t shaderIndex : FindAffectedShaders(reload.graph, changedPaths))
+		{
+			InsertShaderIndex(reload.pendingShaders, shaderIndex);
+		}
+
+		reload.lastChangeTime = now;
+	}
+
+
+	/*---------------------------
+	    終わったものを受け取る
+	---------------------------*/
+
+	if (!reload.compilingShaders.empty() && IsShaderCompileBatchReady(reload.batch))
+	{
+		for (uint32_t i = 0; i < static_cast<uint32_t>(reload.compilingShaders.size()); i++)
+		{
+			uint32_t shaderIndex = reload.compilingShaders[i];
+			const ShaderCompileResult& result = WaitShaderCompileResult(reload.batch, i);
+
+			if (result.isSucceeded)
+			{
+				reload.bytecodeStore.push_back(result.bytecode);
+				reload.bytecodes[shaderIndex] = &reload.bytecodeStore.back();
+				reload.reloadCount++;
+				reloadedShaders.push_back(shaderIndex);
+			}
+			else
+			{
+				// 失敗したら今のPSOを使い続ける（直して保存すればまたコンパイルする）
+				reload.failedCount++;
+				reload.lastErrors = result.errors;
+			}
+
+			// 失敗していても、直すためにincludeを増やすかもしれないので集め直す
+			RefreshShaderDependencies(reload, shaderIndex);
+		}
+
+		FinishShaderCompileBatch(reload.batch, &reload.cache);
+		reload.batch = ShaderCompileBatch{};
+		reload.compilingShaders.clear();
+	}
+
+
+	/*-----------------------
+	    コンパイルを始める
+	-----------------------*/
+
+	// 書き換えが止まって、前のコンパイルが終わっていれば始める（書きかけのファイルはコンパイルしない）
+	bool isSettled = std::chrono::duration<double, std::milli>(now - reload.lastChangeTime).count() >= reload.settleMilliseconds;
+
+	if (!reload.pendingShaders.empty() && reload.compilingShaders.empty() && isSettled)
+	{
+		std::vector<ShaderCompileRequest> jobs;
+		for (uint32_t shaderIndex : reload.pendingShaders)
+		{
+			jobs.push_back(reload.shaders[shaderIndex]);
+		}
+
+		reload.compilingShaders.swap(reload.pendingShaders);
+		reload.batch = StartShaderCompileBatch(reload.compilePool, jobs, &reload.cache);
+	}
+
+	return reloadedShaders;
+}
+
+/// <summary>
+/// コンパイルし直したバイトコードを取得する
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+/// <param name="shaderIndex">シェーダーの番号</param>
+/// <returns>バイトコード（ReleaseShaderHotReloadまで有効）</returns>
+const std::vector<uint8_t>& GetReloadedShaderBytecode(const ShaderHotReload& reload, uint32_t shaderIndex)
+{
+	assert(shaderIndex < reload.bytecodes.size());
+	assert(reload.bytecodes[shaderIndex] != nullptr);
+
+	return *reload.bytecodes[shaderIndex];
+}
+
+/// <summary>
+/// コンパイル中のものを待ってから、ShaderHotReloadを解放する
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+void ReleaseShaderHotReload(ShaderHotReload& reload)
+{
+	if (!reload.compilingShaders.empty())
+	{
+		FinishShaderCompileBatch(reload.batch, &reload.cache);
+		reload.compilingShaders.clear();
+	}
+
+	ReleaseFileWatcher(reload.watcher);
+	reload.bytecodes.clear();
+	reload.bytecodeStore.clear();
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../FileWatcher/FileWatcher.h"
+#include "../ShaderCompileBatch/ShaderCompileBatch.h"
+
+// ファイルから、それを読むシェーダーを引く表
+typedef struct ShaderDependencyGraph
+{
+	// シェーダーごとの、読むファイル（ソース自身とinclude）
+	std::vector<std::vector<std::string>> dependencies;
+
+	// ファイルごとの、それを読むシェーダーの番号
+	std::unordered_map<std::string, std::vector<uint32_t>> dependents;
+}ShaderDependencyGraph;
+
+/*
+	シェーダーとそのincludeを見張り、書き換えられたものを読むシェーダーだけを別のスレッドでコンパイルし直す
+	描画は止めないので、フレームの始めに更新して、コンパイルし直せたシェーダーのPSOだけを作り直す
+*/
+typedef struct ShaderHotReload
+{
+	// 見張るシェーダー（番号は起動時のジョブと同じ）
+	std::vector<ShaderCompileRequest> shaders;
+
+	// コンパイル結果の保存先
+	ShaderCache cache;
+
+	// コンパイルするスレッド（起動時のコンパイルと共有する）
+	ShaderCompilePool* compilePool;
+
+	// ファイルの見張り
+	FileWatcher watcher;
+
+	// どのファイルがどのシェーダーに読まれるか
+	ShaderDependencyGraph graph;
+
+	// 書き換えられて、まだコンパイルを始めていないシェーダー
+	std::vector<uint32_t> pendingShaders;
+
+	// 最後に書き換えを見つけた時刻と、書き終わるのを待つ時間（保存が何回かに分かれてもまとめてコンパイルする）
+	std::chrono::steady_clock::time_point lastChangeTime;
+	double settleMilliseconds;
+
+	// コンパイル中のバッチと、そのシェーダー
+	ShaderCompileBatch batch;
+	std::vector<uint32_t> compilingShaders;
+
+	// シェーダーごとの今のバイトコード（コンパイルし直すまではnullptr）
+	std::vector<const std::vector<uint8_t>*> bytecodes;
+
+	// コンパイルし直したバイトコード（作りかけのPSOが読んでいるかもしれないので、古いものも解放しない）
+	std::deque<std::vector<uint8_t>> bytecodeStore;
+
+	// コンパイルし直せた数、失敗した数と、最後に失敗した理由
+	uint32_t reloadCount;
+	uint32_t failedCount;
+	std::string lastErrors;
+}ShaderHotReload;
+
+/// <summary>
+/// シェーダーの読むファイルを登録し直す
+/// </summary>
+/// <param name="graph">ShaderDependencyGraph</param>
+/// <param name="shaderIndex">シェーダーの番号</param>
+/// <param name="dependencies">読むファイル</param>
+void SetShaderDependencies(ShaderDependencyGraph& graph, uint32_t shaderIndex, const std::vector<std::filesystem::path>& dependencies);
+
+/// <summary>
+/// 書き換えられたファイルを読むシェーダーを探す
+/// </summary>
+/// <param name="graph">ShaderDependencyGraph</param>
+/// <param name="changedPaths">書き換えられたファイル</param>
+/// <returns>シェーダーの番号（小さい順、重複なし）</returns>
+std::vector<uint32_t> FindAffectedShaders(const ShaderDependencyGraph& graph, const std::vector<std::filesystem::path>& changedPaths);
+
+/// <summary>
+/// ShaderHotReloadを作り、シェーダーとincludeを見張り始める
+/// </summary>
+/// <param name="shaders">見張るシェーダー</param>
+/// <param name="cache">コンパイル結果の保存先（設定を写す）</param>
+/// <param name="compilePool">コンパイルするShaderCompilePool（ReleaseShaderHotReloadまで解放しない）</param>
+/// <param name="settleMilliseconds">書き換えが止まってからコンパイルを始めるまでの時間</param>
+/// <returns>ShaderHotReload</returns>
+ShaderHotReload CreateShaderHotReload(const std::vector<ShaderCompileRequest>& shaders, const ShaderCache& cache,
+	ShaderCompilePool* compilePool, double settleMilliseconds);
+
+/// <summary>
+/// 書き換えを調べ、コンパイルを始め、終わったものを受け取る（待たずに戻るので、毎フレームの始めに呼ぶ）
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+/// <returns>コンパイルし直せたシェーダーの番号（GetReloadedShaderBytecodeで受け取る）</returns>
+std::vector<uint32_t> UpdateShaderHotReload(ShaderHotReload& reload);
+
+/// <summary>
+/// コンパイルし直したバイトコードを取得する
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+/// <param name="shaderIndex">シェーダーの番号</param>
+/// <returns>バイトコード（ReleaseShaderHotReloadまで有効）</returns>
+const std::vector<uint8_t>& GetReloadedShaderBytecode(const ShaderHotReload& reload, uint32_t shaderIndex);
+
+/// <summary>
+/// コンパイル中のものを待ってから、ShaderHotReloadを解放する
+/// </summary>
+/// <param name="reload">ShaderHotReload</param>
+void ReleaseShaderHotReload(ShaderHotReload& reload);
@@ -0,0 +1,209 @@
+#include "ShaderPermutation.h"
+#include "../Hash/Hash.h"
+#include <cassert>
+
+/// <summary>
+/// オンとオフだけの機能を作る（"0" と "1"）
+/// </summary>
+/// <param name="name">マクロの名前</param>
+/// <returns>ShaderFeature</returns>
+ShaderFeature MakeShaderToggle(const std::string& name)
+{
+	// ShaderFeature
+	ShaderFeature feature{};
+	feature.name = name;
+	feature.values = { "0" , "1" };
+
+	return feature;
+}
+
+/// <summary>
+/// 組み合わせの数を求める
+/// </summary>
+/// <param name="features">機能</param>
+/// <returns>組み合わせの数（機能がなければ1）</returns>
+uint64_t CountShaderPermutations(const std::vector<ShaderFeature>& features)
+{
+	uint64_t count = 1;
+
+	for (const ShaderFeature& feature : features)
+	{
+		count *= feature.values.size();
+	}
+
+	return count;
+}
+
+/// <summary>
+/// 選んだ値の番号から、組み合わせの番号を求める（先頭の機能が一番細かく変わる）
+/// </summary>
+/// <param name="features">機能</param>
+/// <param name="valueIndices">機能ごとに選んだ値の番号</param>
+/// <returns>組み合わせの番号</returns>
+uint32_t GetShaderPermutationIndex(const std::vector<ShaderFeature>& features, const std::vector<uint32_t>& valueIndices)
+{
+	assert(valueIndices.size() == features.size());
+
+	uint32_t index = 0;
+	uint32_t stride = 1;
+
+	for (size_t i = 0; i < features.size(); i++)
+	{
+		assert(valueIndices[i] < features[i].values.size());
+
+		index += valueIndices[i] * stride;
+		stride *= static_cast<uint32_t>(features[i].values.size());
+	}
+
+	return index;
+}
+
+/// <summary>
+/// 全ての組み合わせを作る（番号の順）
+/// </summary>
+/// <param name="features">機能</param>
+/// <returns>組み合わせ</returns>
+std::vector<ShaderPermutation> ExpandShaderPermutations(const std::vector<ShaderFeature>& features)
+{
+	// 組み合わせ
+	std::vector<ShaderPermutation> permutations;
+
+	uint64_t count = CountShaderPermutations(features);
+	assert(count <= UINT32_MAX);
+	permutations.reserve(static_cast<size_t>(count));
+
+	// 繰り上がりのある数え方で、選ぶ値の番号を進める
+	std::vector<uint32_t> valueIndices(features.size(), 0);
+
+	for (uint64_t n = 0; n < count; n++)
+	{
+		ShaderPermutation permutation{};
+		permutation.valueIndices = valueIndices;
+
+		for (size_t i = 0; i < features.size(); i++)
+		{
+			permutation.defines.push_back(features[i].name + "=" + features[i].values[valueIndices[i]]);
+		}
+
+		permutations.push_back(std::move(permutation));
+
+		for (size_t i = 0; i < features.size(); i++)
+		{
+			if (++valueIndices[i] < features[i].values.size())
+			{
+				break;
+			}
+
+			valueIndices[i] = 0;
+		}
+	}
+
+	return permutations;
+}
+
+/// <summary>
+/// バイトコードを組み合わせに割り当てる（同じバイトコードが既にあれば、それを指す）
+/// </summary>
+/// <param name="set">ShaderPermutationSet</param>
+/// <param name="permutationIndex">組み合わせの番号</param>
+/// <param name="bytecode">バイトコード</param>
+/// <returns>variantsの番号</returns>
+uint32_t AddShaderPermutationVariant(ShaderPermutationSet& set, uint32_t permutationIndex, const std::vector<uint8_t>& bytecode)
+{
+	if (set.variantIndices.size() <= permutationIndex)
+	{
+		set.variantIndices.resize(permutationIndex + 1, UINT32_MAX);
+	}
+
+	uint64_t hash = HashBytes(bytecode.data(), bytecode.size());
+
+	// ハッシュが同じでも、中身まで同じときだけまとめる
+	auto range = set.variantsByHash.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (set.variants[it->second] == bytecode)
+		{
+			set.variantIndices[permutationIndex] = it->second;
+			return it->second;
+		}
+	}
+
+	set.variants.push_back(bytecode);
+
+	uint32_t variantIndex = static_cast<uint32_t>(set.variants.size() - 1);
+	set.variantsByHash.emplace(hash, variantIndex);
+	set.variantIndices[permutationIndex] = variantIndex;
+
+	return variantIndex;
+}
+
+/// <summary>
+/// 全ての組み合わせをコンパイルし、同じバイトコードをまとめる（終わるまで待つ）
+/// </summary>
+/// <param name="request">マクロ以外のコンパイルする内容（request.definesは全ての組み合わせに付ける）</param>
+/// <param name="features">機能</param>
+/// <param name="compilePool">コンパイルするShaderCompilePool</param>
+/// <param name="cache">保存したものを使うならShaderCache（nullptrでもよい）</param>
+/// <returns>ShaderPermutationSet</returns>
+ShaderPermutationSet CompileShaderPermutations(const ShaderCompileRequest& request, const std::vector<ShaderFeature>& features,
+	ShaderCompilePool* compilePool, ShaderCache* cache)
+{
+	// ShaderPermutationSet
+	ShaderPermutationSet set{};
+	set.features = features;
+
+	std::vector<ShaderPermutation> permutations = ExpandShaderPermutations(features);
+	set.variantIndices.resize(permutations.size(), UINT32_MAX);
+
+	std::vector<ShaderCompileRequest> jobs;
+	jobs.reserve(permutations.size());
+
+	for (const ShaderPermutation& permutation : permutations)
+	{
+		ShaderCompileRequest job = request;
+		job.defines.insert(job.defines.end(), permutation.defines.begin(), permutation.defines.end());
+		jobs.push_back(std::move(job));
+	}
+
+	ShaderCompileBatch batch = StartShaderCompileBatch(compilePool, jobs, cache);
+
+	// 組み合わせの順に受け取るので、同じバイトコードはいつも小さい番号の組み合わせのものが残る
+	for (uint32_t i = 0; i < static_cast<uint32_t>(jobs.size()); i++)
+	{
+		const ShaderCompileResult& result = WaitShaderCompileResult(batch, i);
+
+		if (result.isSucceeded)
+		{
+			AddShaderPermutationVariant(set, i, result.bytecode);
+		}
+		else
+		{
+			set.failedCount++;
+			set.lastErrors = result.errors;
+		}
+	}
+
+	FinishShaderCompileBatch(batch, cache);
+
+	return set;
+}
+
+/// <summary>
+/// 組み合わせのバイトコードを取得する
+/// </summary>
+/// <param name="set">ShaderPermutationSet</param>
+/// <param name="valueIndices">機能ごとに選んだ値の番号</param>
+/// <returns>バイトコード（失敗した組み合わせならnullptr）</returns>
+const std::vector<uint8_t>* FindShaderPermutation(const ShaderPermutationSet& set, const std::vector<uint32_t>& valueIndices)
+{
+	uint32_t permutationIndex = GetShaderPermutationIndex(set.features, valueIndices);
+	assert(permutationIndex < set.variantIndices.size());
+
+	uint32_t variantIndex = set.variantIndices[permutationIndex];
+	if (variantIndex == UINT32_MAX)
+	{
+		return nullptr;
+	}
+
+	return &set.variants[variantIndex];
+}
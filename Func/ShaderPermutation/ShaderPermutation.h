@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../ShaderCompileBatch/ShaderCompileBatch.h"
+
+// 切り替えられる機能（#define NAME VALUE の VALUE をvaluesから1つ選ぶ）
+typedef struct ShaderFeature
+{
+	// マクロの名前
+	std::string name;
+
+	// 選べる値
+	std::vector<std::string> values;
+}ShaderFeature;
+
+// 機能の組み合わせ1つ
+typedef struct ShaderPermutation
+{
+	// 機能ごとに選んだ値の番号
+	std::vector<uint32_t> valueIndices;
+
+	// コンパイルに渡すマクロ（"NAME=VALUE"、機能の順）
+	std::vector<std::string> defines;
+}ShaderPermutation;
+
+/*
+	1つのシェーダーの全ての組み合わせをコンパイルした結果
+	マクロが違っても同じバイトコードになった組み合わせは、1つのバイトコードを指す
+*/
+typedef struct ShaderPermutationSet
+{
+	// 機能
+	std::vector<ShaderFeature> features;
+
+	// 組み合わせの番号から、variantsの番号を引く表（失敗した組み合わせはUINT32_MAX）
+	std::vector<uint32_t> variantIndices;
+
+	// 重なりのないバイトコード
+	std::vector<std::vector<uint8_t>> variants;
+
+	// バイトコードのハッシュから、variantsの番号を引く表
+	std::unordered_multimap<uint64_t, uint32_t> variantsByHash;
+
+	// 失敗した組み合わせの数と、最後に失敗した理由
+	uint32_t failedCount;
+	std::string lastErrors;
+}ShaderPermutationSet;
+
+/// <summary>
+/// オンとオフだけの機能を作る（"0" と "1"）
+/// </summary>
+/// <param name="name">マクロの名前</param>
+/// <returns>ShaderFeature</returns>
+ShaderFeature MakeShaderToggle(const std::string& name);
+
+/// <summary>
+/// 組み合わせの数を求める
+/// </summary>
+/// <param name="features">機能</param>
+/// <returns>組み合わせの数（機能がなければ1）</returns>
+uint64_t CountShaderPermutations(const std::vector<ShaderFeature>& features);
+
+/// <summary>
+/// 選んだ値の番号から、組み合わせの番号を求める（先頭の機能が一番細かく変わる）
+/// </summary>
+/// <param name="features">機能</param>
+/// <param name="valueIndices">機能ごとに選んだ値の番号</param>
+/// <returns>組み合わせの番号</returns>
+uint32_t GetShaderPermutationIndex(const std::vector<ShaderFeature>& features, const std::vector<uint32_t>& valueIndices);
+
+/// <summary>
+/// 全ての組み合わせを作る（番号の順）
+/// </summary>
+/// <param name="features">機能</param>
+/// <returns>組み合わせ</returns>
+std::vector<ShaderPermutation> ExpandShaderPermutations(const std::vector<ShaderFeature>& features);
+
+/// <summary>
+/// バイトコードを組み合わせに割り当てる（同じバイトコードが既にあれば、それを指す）
+/// </summary>
+/// <param name="set">ShaderPermutationSet</param>
+/// <param name="permutationIndex">組み合わせの番号</param>
+/// <param name="bytecode">バイトコード</param>
+/// <returns>variantsの番号</returns>
+uint32_t AddShaderPermutationVariant(ShaderPermutationSet& set, uint32_t permutationIndex, const std::vector<uint8_t>& bytecode);
+
+/// <summary>
+/// 全ての組み合わせをコンパイルし、同じバイトコードをまとめる（終わるまで待つ）
+/// </summary>
+/// <param name="request">マクロ以外のコンパイルする内容（request.definesは全ての組み合わせに付ける）</param>
+/// <param name="features">機能</param>
+/// <param name="compilePool">コンパイルするShaderCompilePool</param>
+/// <param name="cache">保存したものを使うならShaderCache（nullptrでもよい）</param>
+/// <returns>ShaderPermutationSet</returns>
+ShaderPermutationSet CompileShaderPermutations(const ShaderCompileRequest& request, const std::vector<ShaderFeature>& features,
+	ShaderCompilePool* compilePool, ShaderCache* cache);
+
+/// <summary>
+/// 組み合わせのバイトコードを取得する
+/// </summary>
+/// <param name="set">ShaderPermutationSet</param>
+/// <param name="valueIndices">機能ごとに選んだ値の番号</param>
+/// <returns>バイトコード（失敗した組み合わせならnullptr）</returns>
+const std::vector<uint8_t>* FindShaderPermutation(const ShaderPermutationSet& set, const std::vector<uint32_t>& valueIndices);
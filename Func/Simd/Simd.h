@@ -0,0 +1,187 @@
+#pragma once
+
+// 使用するSIMD命令セットをコンパイル時に選ぶ（MATH_NO_SIMDを定義するとスカラー版になる）
+#if !defined(MATH_NO_SIMD) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define MATH_SIMD
+#define MATH_SIMD_SSE
+#include <immintrin.h>
+#elif !defined(MATH_NO_SIMD) && (defined(_M_ARM64) || defined(__ARM_NEON))
+#define MATH_SIMD
+#define MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(MATH_SIMD)
+#if defined(MATH_SIMD_SSE)
+using SimdFloat4 = __m128;
+
+inline SimdFloat4 SimdLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void SimdStore(float* p, SimdFloat4 v) { _mm_storeu_ps(p, v); }
+inline SimdFloat4 SimdSet(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline SimdFloat4 SimdAdd(SimdFloat4 a, SimdFloat4 b) { return _mm_add_ps(a, b); }
+inline SimdFloat4 SimdSub(SimdFloat4 a, SimdFloat4 b) { return _mm_sub_ps(a, b); }
+inline SimdFloat4 SimdMul(SimdFloat4 a, SimdFloat4 b) { return _mm_mul_ps(a, b); }
+inline SimdFloat4 SimdDiv(SimdFloat4 a, SimdFloat4 b) { return _mm_div_ps(a, b); }
+inline SimdFloat4 SimdSplat(float f) { return _mm_set1_ps(f); }
+inline SimdFloat4 SimdMin(SimdFloat4 a, SimdFloat4 b) { return _mm_min_ps(a, b); }
+inline SimdFloat4 SimdMax(SimdFloat4 a, SimdFloat4 b) { return _mm_max_ps(a, b); }
+inline SimdFloat4 SimdAbs(SimdFloat4 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+inline float SimdGetX(SimdFloat4 v) { return _mm_cvtss_f32(v); }
+
+// a < b の要素をビットで返す（要素iがbit i）
+inline int SimdMaskLess(SimdFloat4 a, SimdFloat4 b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+
+// 0方向に丸めて整数にする
+inline SimdFloat4 SimdTruncate(SimdFloat4 v) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(v)); }
+
+// magnitudeの絶対値にsignの符号を付ける
+inline SimdFloat4 SimdCopySign(SimdFloat4 magnitude, SimdFloat4 sign)
+{
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	return _mm_or_ps(_mm_andnot_ps(signMask, magnitude), _mm_and_ps(signMask, sign));
+}
+
+// a * b + c（FMAが使えるときは1命令にまとめる）
+inline SimdFloat4 SimdMulAdd(SimdFloat4 a, SimdFloat4 b, SimdFloat4 c)
+{
+#if defined(__FMA__) || defined(__AVX2__)
+	return _mm_fmadd_ps(a, b, c);
+#else
+	return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+// 1 / sqrt(v)（近似値をニュートン法で1回補正する）
+inline SimdFloat4 SimdReciprocalSqrt(SimdFloat4 v)
+{
+	__m128 estimate = _mm_rsqrt_ps(v);
+	__m128 halfVEstimate = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), v), estimate);
+	return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfVEstimate, estimate)));
+}
+
+// (a[x] , a[y] , b[z] , b[w]) を作る
+template<int x, int y, int z, int w>
+inline SimdFloat4 SimdShuffle(SimdFloat4 a, SimdFloat4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+#else
+using SimdFloat4 = float32x4_t;
+
+inline SimdFloat4 SimdLoad(const float* p) { return vld1q_f32(p); }
+inline void SimdStore(float* p, SimdFloat4 v) { vst1q_f32(p, v); }
+inline SimdFloat4 SimdSet(float x, float y, float z, float w) { const float f[4] = { x , y , z , w }; return vld1q_f32(f); }
+inline SimdFloat4 SimdAdd(SimdFloat4 a, SimdFloat4 b) { return vaddq_f32(a, b); }
+inline SimdFloat4 SimdSub(SimdFloat4 a, SimdFloat4 b) { return vsubq_f32(a, b); }
+inline SimdFloat4 SimdMul(SimdFloat4 a, SimdFloat4 b) { return vmulq_f32(a, b); }
+inline SimdFloat4 SimdMulAdd(SimdFloat4 a, SimdFloat4 b, SimdFloat4 c) { return vmlaq_f32(c, a, b); }
+inline SimdFloat4 SimdSplat(float f) { return vdupq_n_f32(f); }
+inline SimdFloat4 SimdMin(SimdFloat4 a, SimdFloat4 b) { return vminq_f32(a, b); }
+inline SimdFloat4 SimdMax(SimdFloat4 a, SimdFloat4 b) { return vmaxq_f32(a, b); }
+inline SimdFloat4 SimdAbs(SimdFloat4 v) { return vabsq_f32(v); }
+inline float SimdGetX(SimdFloat4 v) { return vgetq_lane_f32(v, 0); }
+
+// a < b の要素をビットで返す（要素iがbit i）
+inline int SimdMaskLess(SimdFloat4 a, SimdFloat4 b)
+{
+	uint32x4_t less = vcltq_f32(a, b);
+	return int((vgetq_lane_u32(less, 0) & 1u) | (vgetq_lane_u32(less, 1) & 2u) | (vgetq_lane_u32(less, 2) & 4u) | (vgetq_lane_u32(less, 3) & 8u));
+}
+
+// 0方向に丸めて整数にする
+inline SimdFloat4 SimdTruncate(SimdFloat4 v) { return vcvtq_f32_s32(vcvtq_s32_f32(v)); }
+
+// magnitudeの絶対値にsignの符号を付ける
+inline SimdFloat4 SimdCopySign(SimdFloat4 magnitude, SimdFloat4 sign)
+{
+	const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+	return vbslq_f32(signMask, sign, magnitude);
+}
+
+inline SimdFloat4 SimdDiv(SimdFloat4 a, SimdFloat4 b)
+{
+#if defined(_M_ARM64) || defined(__aarch64__)
+	return vdivq_f32(a, b);
+#else
+	// 逆数の近似値をニュートン法で2回補正する
+	float32x4_t reciprocal = vrecpeq_f32(b);
+	reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+	reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+	return vmulq_f32(a, reciprocal);
+#endif
+}
+
+// 1 / sqrt(v)（NEONの近似値は精度が低いので、ニュートン法で2回補正する）
+inline SimdFloat4 SimdReciprocalSqrt(SimdFloat4 v)
+{
+	float32x4_t estimate = vrsqrteq_f32(v);
+	estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(v, estimate), estimate));
+	estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(v, estimate), estimate));
+	return estimate;
+}
+
+// (a[x] , a[y] , b[z] , b[w]) を作る
+template<int x, int y, int z, int w>
+inline SimdFloat4 SimdShuffle(SimdFloat4 a, SimdFloat4 b)
+{
+	SimdFloat4 result = vdupq_n_f32(vgetq_lane_f32(a, x));
+	result = vsetq_lane_f32(vgetq_lane_f32(a, y), result, 1);
+	result = vsetq_lane_f32(vgetq_lane_f32(b, z), result, 2);
+	result = vsetq_lane_f32(vgetq_lane_f32(b, w), result, 3);
+	return result;
+}
+#endif
+
+// (v[x] , v[y] , v[z] , v[w]) を作る
+template<int x, int y, int z, int w>
+inline SimdFloat4 SimdSwizzle(SimdFloat4 v) { return SimdShuffle<x, y, z, w>(v, v); }
+
+// v[i] を全要素に並べる
+template<int i>
+inline SimdFloat4 SimdSplat(SimdFloat4 v) { return SimdShuffle<i, i, i, i>(v, v); }
+
+/// <summary>
+/// AoSに並んだ4つのVector3（12要素）を読み込み、SoAに並べ替える
+/// </summary>
+inline void SimdLoadVector3x4(const float* p, SimdFloat4& x, SimdFloat4& y, SimdFloat4& z)
+{
+	SimdFloat4 a = SimdLoad(p + 0); // x0 y0 z0 x1
+	SimdFloat4 b = SimdLoad(p + 4); // y1 z1 x2 y2
+	SimdFloat4 c = SimdLoad(p + 8); // z2 x3 y3 z3
+
+	x = SimdShuffle<0, 3, 0, 2>(a, SimdShuffle<2, 2, 1, 1>(b, c));
+	y = SimdShuffle<0, 2, 0, 2>(SimdShuffle<1, 1, 0, 0>(a, b), SimdShuffle<3, 3, 2, 2>(b, c));
+	z = SimdShuffle<0, 2, 0, 2>(SimdShuffle<2, 2, 1, 1>(a, b), SimdShuffle<0, 0, 3, 3>(c, c));
+}
+
+/// <summary>
+/// SoAの4つのVector3をAoSに並べ替えて書き込む（12要素）
+/// </summary>
+inline void SimdStoreVector3x4(float* p, SimdFloat4 x, SimdFloat4 y, SimdFloat4 z)
+{
+	SimdStore(p + 0, SimdShuffle<0, 2, 0, 2>(SimdShuffle<0, 0, 0, 0>(x, y), SimdShuffle<0, 0, 1, 1>(z, x)));
+	SimdStore(p + 4, SimdShuffle<0, 2, 0, 2>(SimdShuffle<1, 1, 1, 1>(y, z), SimdShuffle<2, 2, 2, 2>(x, y)));
+	SimdStore(p + 8, SimdShuffle<0, 2, 0, 2>(SimdShuffle<2, 2, 3, 3>(z, x), SimdShuffle<3, 3, 3, 3>(y, z)));
+}
+
+/// <summary>
+/// 行優先の2x2行列の積 A * B を求める
+/// </summary>
+inline SimdFloat4 SimdMat2Mul(SimdFloat4 a, SimdFloat4 b)
+{
+	return SimdAdd(SimdMul(a, SimdSwizzle<0, 3, 0, 3>(b)), SimdMul(SimdSwizzle<1, 0, 3, 2>(a), SimdSwizzle<2, 1, 2, 1>(b)));
+}
+
+/// <summary>
+/// 行優先の2x2行列の 余因子(A) * B を求める
+/// </summary>
+inline SimdFloat4 SimdMat2AdjMul(SimdFloat4 a, SimdFloat4 b)
+{
+	return SimdSub(SimdMul(SimdSwizzle<3, 3, 0, 0>(a), b), SimdMul(SimdSwizzle<1, 1, 2, 2>(a), SimdSwizzle<2, 3, 0, 1>(b)));
+}
+
+/// <summary>
+/// 行優先の2x2行列の A * 余因子(B) を求める
+/// </summary>
+inline SimdFloat4 SimdMat2MulAdj(SimdFloat4 a, SimdFloat4 b)
+{
+	return SimdSub(SimdMul(a, SimdSwizzle<3, 0, 3, 0>(b)), SimdMul(SimdSwizzle<1, 0, 3, 2>(a), SimdSwizzle<2, 1, 2, 1>(b)));
+}
+#endif
\ No newline at end of file
@@ -1,11 +1,35 @@
 #include "String.h"
 
 /// <summary>
-/// ログを表示する
+/// ログを表示する（osにAsyncLoggerが結び付いていれば、リングに入れるだけで戻る）
 /// </summary>
 /// <param name="message">文字列</param>
 void Log(std::ostream& os , const std::string& message)
 {
+    // ファイルへの書き込みとデバッガへの出力は、AsyncLoggerのスレッドが行う
+    if (AsyncLogger* logger = GetAttachedAsyncLogger(os))
+    {
+        PushLog(logger, message, LogSeverity::Info);
+        return;
+    }
+
+    os << message << std::endl;
+	OutputDebugStringA(message.c_str());
+}
+
+/// <summary>
+/// エラーのログを表示する（AsyncLoggerでも捨てず、ファイルに書かれるまで待ってから戻る。assertで止める前に使う）
+/// </summary>
+/// <param name="message">文字列</param>
+void LogError(std::ostream& os, const std::string& message)
+{
+    if (AsyncLogger* logger = GetAttachedAsyncLogger(os))
+    {
+        PushLog(logger, message, LogSeverity::Error);
+        FlushAsyncLogger(logger);
+        return;
+    }
+
     os << message << std::endl;
 	OutputDebugStringA(message.c_str());
 }
@@ -3,13 +3,20 @@
 #include <string>
 #include <filesystem>
 #include <fstream>
+#include "../AsyncLogger/AsyncLogger.h"
 
 /// <summary>
-/// ログを表示する
+/// ログを表示する（osにAsyncLoggerが結び付いていれば、リングに入れるだけで戻る）
 /// </summary>
 /// <param name="message">文字列</param>
 void Log(std::ostream& os, const std::string& message);
 
+/// <summary>
+/// エラーのログを表示する（AsyncLoggerでも捨てず、ファイルに書かれるまで待ってから戻る。assertで止める前に使う）
+/// </summary>
+/// <param name="message">文字列</param>
+void LogError(std::ostream& os, const std::string& message);
+
 /// <summary>
 /// string -> wstring
 /// </summary>
@@ -0,0 +1,107 @@
+#include "UploadRingBuffer.h"
+#include <cassert>
+
+/// <summary>
+/// リングバッファを初期化する
+/// </summary>
+/// <param name="cpuBase">書き込み先の先頭（永続的にマップしたアドレス）</param>
+/// <param name="gpuBase">GPU仮想アドレスの先頭</param>
+/// <param name="capacity">大きさ（kUploadConstantBufferAlignmentの倍数）</param>
+/// <returns>リングバッファ</returns>
+UploadRingBuffer MakeUploadRingBuffer(void* cpuBase, uint64_t gpuBase, size_t capacity)
+{
+	assert(cpuBase != nullptr);
+	assert(capacity > 0 && capacity % kUploadConstantBufferAlignment == 0);
+
+	// リングバッファ
+	UploadRingBuffer ring{};
+	ring.cpuBase = static_cast<uint8_t*>(cpuBase);
+	ring.gpuBase = gpuBase;
+	ring.capacity = capacity;
+	ring.head = 0;
+	ring.tail = 0;
+
+	return ring;
+}
+
+/// <summary>
+/// 領域を切り出す
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="size">大きさ</param>
+/// <param name="alignment">アラインメント（2の累乗で、capacityを割り切れるもの）</param>
+/// <returns>切り出した領域（空きが足りないときはcpuAddressがnullptr）</returns>
+UploadAllocation AllocateUploadRingBuffer(UploadRingBuffer& ring, size_t size, size_t alignment)
+{
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	assert(ring.capacity % alignment == 0);
+
+	// 切り出した領域
+	UploadAllocation allocation{};
+
+	if (size == 0 || size > ring.capacity)
+	{
+		return allocation;
+	}
+
+	// アラインメントに合わせた開始位置
+	uint64_t begin = (ring.head + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+
+	// 末尾をはみ出すなら、残りは捨てて先頭から切り出す
+	if (begin % ring.capacity + size > ring.capacity)
+	{
+		begin = (begin / ring.capacity + 1) * ring.capacity;
+	}
+
+	// GPUが読んでいる領域を上書きしてしまうなら確保できない
+	if (begin + size - ring.tail > ring.capacity)
+	{
+		return allocation;
+	}
+
+	ring.head = begin + size;
+
+	allocation.offset = static_cast<size_t>(begin % ring.capacity);
+	allocation.cpuAddress = ring.cpuBase + allocation.offset;
+	allocation.gpuAddress = ring.gpuBase + allocation.offset;
+	allocation.size = size;
+
+	return allocation;
+}
+
+/// <summary>
+/// フレームの終わりに、ここまで切り出した領域をSignalの値と結びつける
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishUploadRingBufferFrame(UploadRingBuffer& ring, uint64_t fenceValue)
+{
+	// Signalの値は増え続ける
+	assert(ring.frames.empty() || ring.frames.back().fenceValue <= fenceValue);
+
+	ring.frames.push_back(UploadRingFrame{ fenceValue , ring.head });
+}
+
+/// <summary>
+/// GPUが読み終わったフレームの領域を回収する
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+void ReclaimUploadRingBuffer(UploadRingBuffer& ring, uint64_t completedFenceValue)
+{
+	while (!ring.frames.empty() && ring.frames.front().fenceValue <= completedFenceValue)
+	{
+		ring.tail = ring.frames.front().head;
+		ring.frames.pop_front();
+	}
+}
+
+/// <summary>
+/// GPUが読んでいる可能性のあるバイト数を求める
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <returns>使用中のバイト数</returns>
+size_t GetUploadRingBufferUsedSize(const UploadRingBuffer& ring)
+{
+	return static_cast<size_t>(ring.head - ring.tail);
+}
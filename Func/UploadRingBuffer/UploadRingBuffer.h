@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+
+// 定数バッファの配置に必要なアラインメント（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+const size_t kUploadConstantBufferAlignment = 256;
+
+// リングバッファから切り出した領域
+typedef struct UploadAllocation
+{
+	// CPUから書き込むアドレス（確保できなかったときはnullptr）
+	void* cpuAddress;
+
+	// GPUから読むアドレス
+	uint64_t gpuAddress;
+
+	// 先頭からのオフセット
+	size_t offset;
+
+	// 大きさ
+	size_t size;
+}UploadAllocation;
+
+// 使い終わるのを待っているフレーム
+typedef struct UploadRingFrame
+{
+	// このフレームのSignalの値
+	uint64_t fenceValue;
+
+	// このフレームの最後まで書き込んだ位置
+	uint64_t head;
+}UploadRingFrame;
+
+/*
+	毎フレームの書き込みを切り出すリングバッファ
+	D3D12の型は持たず、マップ済みのCPUアドレスとGPU仮想アドレスだけを受け取るので、
+	普通のメモリを渡せばGPUなしでも確保と回収を動かせる
+*/
+typedef struct UploadRingBuffer
+{
+	// 書き込み先の先頭（マップしたアドレス）
+	uint8_t* cpuBase;
+
+	// GPU仮想アドレスの先頭
+	uint64_t gpuBase;
+
+	// 大きさ
+	size_t capacity;
+
+	// 次に切り出す位置（折り返さず増え続ける通算のバイト数）
+	uint64_t head;
+
+	// GPUがまだ読んでいるかもしれない一番古い位置（通算のバイト数）
+	uint64_t tail;
+
+	// 使い終わるのを待っているフレーム（古い順）
+	std::deque<UploadRingFrame> frames;
+}UploadRingBuffer;
+
+/// <summary>
+/// リングバッファを初期化する
+/// </summary>
+/// <param name="cpuBase">書き込み先の先頭（永続的にマップしたアドレス）</param>
+/// <param name="gpuBase">GPU仮想アドレスの先頭</param>
+/// <param name="capacity">大きさ（kUploadConstantBufferAlignmentの倍数）</param>
+/// <returns>リングバッファ</returns>
+UploadRingBuffer MakeUploadRingBuffer(void* cpuBase, uint64_t gpuBase, size_t capacity);
+
+/// <summary>
+/// 領域を切り出す
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="size">大きさ</param>
+/// <param name="alignment">アラインメント（2の累乗で、capacityを割り切れるもの）</param>
+/// <returns>切り出した領域（空きが足りないときはcpuAddressがnullptr）</returns>
+UploadAllocation AllocateUploadRingBuffer(UploadRingBuffer& ring, size_t size, size_t alignment = kUploadConstantBufferAlignment);
+
+/// <summary>
+/// フレームの終わりに、ここまで切り出した領域をSignalの値と結びつける
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="fenceValue">このフレームのコマンドの後にSignalした値</param>
+void FinishUploadRingBufferFrame(UploadRingBuffer& ring, uint64_t fenceValue);
+
+/// <summary>
+/// GPUが読み終わったフレームの領域を回収する
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <param name="completedFenceValue">Fenceの現在の値（GetCompletedValue）</param>
+void ReclaimUploadRingBuffer(UploadRingBuffer& ring, uint64_t completedFenceValue);
+
+/// <summary>
+/// GPUが読んでいる可能性のあるバイト数を求める
+/// </summary>
+/// <param name="ring">リングバッファ</param>
+/// <returns>使用中のバイト数</returns>
+size_t GetUploadRingBufferUsedSize(const UploadRingBuffer& ring);
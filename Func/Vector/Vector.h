@@ -1,6 +1,15 @@
 #pragma once
-#include <math.h>
+#include <cmath>
+#include <algorithm>
+#include <cfloat>
+#include <cassert>
+#include <span>
 #include "../../Struct.h"
+#include "../Simd/Simd.h"
+
+/*--------------
+    Vector3
+--------------*/
 
 /// <summary>
 /// 加算する
@@ -8,7 +17,16 @@
 /// <param name="v1">ベクトル1</param>
 /// <param name="v2">ベクトル2</param>
 /// <returns>加算した値</returns>
-Vector3 Add(const Vector3& v1, const Vector3& v2);
+constexpr Vector3 Add(const Vector3& v1, const Vector3& v2)
+{
+	// 加算した値
+	Vector3 add{};
+	add.x = v1.x + v2.x;
+	add.y = v1.y + v2.y;
+	add.z = v1.z + v2.z;
+
+	return add;
+}
 
 /// <summary>
 /// 減算する
@@ -16,7 +34,27 @@ Vector3 Add(const Vector3& v1, const Vector3& v2);
 /// <param name="v1">ベクトル1</param>
 /// <param name="v2">ベクトル2</param>
 /// <returns>減算した値</returns>
-Vector3 Subtract(const Vector3& v1, const Vector3& v2);
+constexpr Vector3 Subtract(const Vector3& v1, const Vector3& v2)
+{
+	// 減算した値
+	Vector3 subtract{};
+	subtract.x = v1.x - v2.x;
+	subtract.y = v1.y - v2.y;
+	subtract.z = v1.z - v2.z;
+
+	return subtract;
+}
+
+/// <summary>
+/// スカラー倍する
+/// </summary>
+/// <param name="scalar">スカラー</param>
+/// <param name="v">ベクトル</param>
+/// <returns>スカラー倍した値</returns>
+constexpr Vector3 Multiply(float scalar, const Vector3& v)
+{
+	return Vector3{ scalar * v.x , scalar * v.y , scalar * v.z };
+}
 
 /// <summary>
 /// 内積を求める
@@ -24,21 +62,111 @@ Vector3 Subtract(const Vector3& v1, const Vector3& v2);
 /// <param name="v1">ベクトル1</param>
 /// <param name="v2">ベクトル2</param>
 /// <returns>内積</returns>
-float Dot(const Vector3& v1, const Vector3& v2);
+constexpr float Dot(const Vector3& v1, const Vector3& v2)
+{
+	float dot = v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+	return dot;
+}
+
+/// <summary>
+/// ベクトルの距離の2乗を求める（比較だけならsqrtのいらないこちらを使う）
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <returns>距離の2乗</returns>
+constexpr float LengthSquared(const Vector3& v)
+{
+	return Dot(v, v);
+}
 
 /// <summary>
 /// ベクトルの距離を求める
 /// </summary>
 /// <param name="v">ベクトル</param>
 /// <returns>距離</returns>
-float Length(const Vector3& v);
+inline float Length(const Vector3& v)
+{
+	float length = std::sqrt(LengthSquared(v));
+	return length;
+}
 
 /// <summary>
 /// 正規化する
 /// </summary>
 /// <param name="v">ベクトル</param>
 /// <returns>正規化したベクトル</returns>
-Vector3 Normalize(const Vector3& v);
+inline Vector3 Normalize(const Vector3& v)
+{
+	// 距離
+	float length = Length(v);
+
+	// 正規化したベクトル
+	Vector3 normalize = { 0.0f , 0.0f , 0.0f };
+
+	if (length != 0.0f)
+	{
+		normalize.x = v.x / length;
+		normalize.y = v.y / length;
+		normalize.z = v.z / length;
+	}
+
+	return normalize;
+}
+
+/// <summary>
+/// 逆数平方根の近似で正規化する（誤差は相対で1e-6程度、長さ0のときは0ベクトル）
+/// </summary>
+/// <param name="v">ベクトル</param>
+/// <returns>正規化したベクトル</returns>
+inline Vector3 NormalizeFast(const Vector3& v)
+{
+	// 長さ0は最小の正規化数に置き換えて、分岐せずに 0 * 有限値 = 0 にする
+	float lengthSquared = (std::max)(LengthSquared(v), FLT_MIN);
+
+#if defined(MATH_SIMD)
+	float inverseLength = SimdGetX(SimdReciprocalSqrt(SimdSplat(lengthSquared)));
+#else
+	float inverseLength = 1.0f / std::sqrt(lengthSquared);
+#endif
+
+	return Vector3{ v.x * inverseLength , v.y * inverseLength , v.z * inverseLength };
+}
+
+/// <summary>
+/// まとめて正規化する（誤差はNormalizeFastと同じ、長さ0のものは0ベクトル）
+/// </summary>
+/// <param name="vectors">ベクトル</param>
+/// <param name="normalizedVectors">正規化したベクトルの出力先（vectorsと同じ数、vectorsと同じでもよい）</param>
+inline void NormalizeArray(std::span<const Vector3> vectors, std::span<Vector3> normalizedVectors)
+{
+	assert(normalizedVectors.size() >= vectors.size());
+
+	size_t i = 0;
+
+#if defined(MATH_SIMD)
+
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed");
+
+	// 4つずつSoAに並べ替えて計算する
+	for (; i + 4 <= vectors.size(); i += 4)
+	{
+		SimdFloat4 x, y, z;
+		SimdLoadVector3x4(&vectors[i].x, x, y, z);
+
+		SimdFloat4 lengthSquared = SimdMulAdd(z, z, SimdMulAdd(y, y, SimdMul(x, x)));
+
+		// 長さ0は最小の正規化数に置き換えて、0 * 有限値 = 0 にする
+		SimdFloat4 inverseLength = SimdReciprocalSqrt(SimdMax(lengthSquared, SimdSplat(FLT_MIN)));
+
+		SimdStoreVector3x4(&normalizedVectors[i].x, SimdMul(x, inverseLength), SimdMul(y, inverseLength), SimdMul(z, inverseLength));
+	}
+
+#endif
+
+	for (; i < vectors.size(); i++)
+	{
+		normalizedVectors[i] = NormalizeFast(vectors[i]);
+	}
+}
 
 /// <summary>
 /// クロス積を求める
@@ -46,4 +174,49 @@ Vector3 Normalize(const Vector3& v);
 /// <param name="v1">ベクトル1</param>
 /// <param name="v2">ベクトル2</param>
 /// <returns>クロス積</returns>
-Vector3 Cross(const Vector3& v1, const Vector3& v2);
\ No newline at end of file
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2)
+{
+	// クロス積
+	Vector3 cross{};
+
+	cross.x = v1.y * v2.z - v1.z * v2.y;
+	cross.y = v1.z * v2.x - v1.x * v2.z;
+	cross.z = v1.x * v2.y - v1.y * v2.x;
+
+	return cross;
+}
+
+
+/*--------------------
+    演算子オーバーロード
+--------------------*/
+
+constexpr Vector2 operator+(const Vector2& v1, const Vector2& v2) { return Vector2{ v1.x + v2.x , v1.y + v2.y }; }
+constexpr Vector2 operator-(const Vector2& v1, const Vector2& v2) { return Vector2{ v1.x - v2.x , v1.y - v2.y }; }
+constexpr Vector2 operator-(const Vector2& v) { return Vector2{ -v.x , -v.y }; }
+constexpr Vector2 operator*(float scalar, const Vector2& v) { return Vector2{ scalar * v.x , scalar * v.y }; }
+constexpr Vector2 operator*(const Vector2& v, float scalar) { return scalar * v; }
+constexpr Vector2 operator/(const Vector2& v, float scalar) { return (1.0f / scalar) * v; }
+constexpr Vector2& operator+=(Vector2& v1, const Vector2& v2) { v1 = v1 + v2; return v1; }
+constexpr Vector2& operator-=(Vector2& v1, const Vector2& v2) { v1 = v1 - v2; return v1; }
+constexpr Vector2& operator*=(Vector2& v, float scalar) { v = scalar * v; return v; }
+
+constexpr Vector3 operator+(const Vector3& v1, const Vector3& v2) { return Add(v1, v2); }
+constexpr Vector3 operator-(const Vector3& v1, const Vector3& v2) { return Subtract(v1, v2); }
+constexpr Vector3 operator-(const Vector3& v) { return Multiply(-1.0f, v); }
+constexpr Vector3 operator*(float scalar, const Vector3& v) { return Multiply(scalar, v); }
+constexpr Vector3 operator*(const Vector3& v, float scalar) { return Multiply(scalar, v); }
+constexpr Vector3 operator/(const Vector3& v, float scalar) { return Multiply(1.0f / scalar, v); }
+constexpr Vector3& operator+=(Vector3& v1, const Vector3& v2) { v1 = Add(v1, v2); return v1; }
+constexpr Vector3& operator-=(Vector3& v1, const Vector3& v2) { v1 = Subtract(v1, v2); return v1; }
+constexpr Vector3& operator*=(Vector3& v, float scalar) { v = Multiply(scalar, v); return v; }
+
+constexpr Vector4 operator+(const Vector4& v1, const Vector4& v2) { return Vector4{ v1.x + v2.x , v1.y + v2.y , v1.z + v2.z , v1.w + v2.w }; }
+constexpr Vector4 operator-(const Vector4& v1, const Vector4& v2) { return Vector4{ v1.x - v2.x , v1.y - v2.y , v1.z - v2.z , v1.w - v2.w }; }
+constexpr Vector4 operator-(const Vector4& v) { return Vector4{ -v.x , -v.y , -v.z , -v.w }; }
+constexpr Vector4 operator*(float scalar, const Vector4& v) { return Vector4{ scalar * v.x , scalar * v.y , scalar * v.z , scalar * v.w }; }
+constexpr Vector4 operator*(const Vector4& v, float scalar) { return scalar * v; }
+constexpr Vector4 operator/(const Vector4& v, float scalar) { return (1.0f / scalar) * v; }
+constexpr Vector4& operator+=(Vector4& v1, const Vector4& v2) { v1 = v1 + v2; return v1; }
+constexpr Vector4& operator-=(Vector4& v1, const Vector4& v2) { v1 = v1 - v2; return v1; }
+constexpr Vector4& operator*=(Vector4& v, float scalar) { v = scalar * v; return v; }
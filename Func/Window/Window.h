@@ -3,6 +3,7 @@
 #include <strsafe.h>
 #include <string>
 #include <DbgHelp.h>
+#include "../AsyncLogger/AsyncLogger.h"
 #include "../../externals/imgui/imgui.h"
 #include "../../externals/imgui/imgui_impl_dx12.h"
 #include "../../externals/imgui/imgui_impl_win32.h"
@@ -28,6 +29,9 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 /// <returns></returns>
 static LONG WINAPI ExportDump(EXCEPTION_POINTERS* exception)
 {
+	// リングに残っているログを先にファイルへ書く（書くスレッドが止まっていても、待ち続けない）
+	FlushAllAsyncLoggers(1000.0);
+
 	// 時刻を取得して、時刻を名前に入れたファイルを作成　Dumpsディレクトリ以下に出力
 	SYSTEMTIME time;
 	GetLocalTime(&time);
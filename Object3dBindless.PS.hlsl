@@ -0,0 +1,30 @@
+struct PixelShaderOutput
+{
+    float4 color : SV_TARGET;
+};
+
+struct Material
+{
+    float4 color;
+};
+
+struct DrawConstants
+{
+    uint instanceBase;
+    uint materialSlot;
+    uint transformTable;
+    uint materialTable;
+    uint instanceSlotList;
+};
+
+ConstantBuffer<DrawConstants> gDraw : register(b1);
+
+// DescriptorHeap全体を、型ごとに別のspaceで見る
+StructuredBuffer<Material> gMaterialTables[] : register(t0, space3);
+
+PixelShaderOutput main()
+{
+    PixelShaderOutput output;
+    output.color = gMaterialTables[gDraw.materialTable][gDraw.materialSlot].color;
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+struct VertexShaderOutput
+{
+    float4 position : SV_POSITION;
+};
+
+struct VertexShaderInput
+{
+    float4 position : POSITION0;
+};
+
+struct TransformationMatrix
+{
+    float4x4 WVP;
+};
+
+struct DrawConstants
+{
+    uint instanceBase;
+    uint materialSlot;
+    uint transformTable;
+    uint materialTable;
+    uint instanceSlotList;
+};
+
+ConstantBuffer<DrawConstants> gDraw : register(b1);
+
+// DescriptorHeap全体を、型ごとに別のspaceで見る
+StructuredBuffer<TransformationMatrix> gTransformTables[] : register(t0, space1);
+StructuredBuffer<uint> gSlotLists[] : register(t0, space2);
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
+{
+    uint transformSlot = gSlotLists[gDraw.instanceSlotList][gDraw.instanceBase + instanceId];
+
+    VertexShaderOutput output;
+    output.position = mul(input.position, gTransformTables[gDraw.transformTable][transformSlot].WVP);
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+struct VertexShaderOutput
+{
+    float4 position : SV_POSITION;
+};
+
+struct VertexShaderInput
+{
+    float4 position : POSITION0;
+};
+
+struct TransformationMatrix
+{
+    float4x4 WVP;
+};
+
+StructuredBuffer<TransformationMatrix> gTransformationMatrices : register(t0);
+
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID)
+{
+    VertexShaderOutput output;
+    output.position = mul(input.position, gTransformationMatrices[instanceId].WVP);
+    return output;
+}
\ No newline at end of file
@@ -24,6 +24,15 @@ typedef struct Vector4
 	float w;
 }Vector4;
 
+// クォータニオン
+typedef struct Quaternion
+{
+	float x;
+	float y;
+	float z;
+	float w;
+}Quaternion;
+
 // 4x4行列
 typedef struct Matrix4x4
 {
@@ -41,4 +50,54 @@ typedef struct Transform3D
 
 	// 移動
 	Vector3 translate;
-}Transform3D;
\ No newline at end of file
+}Transform3D;
+
+// 姿勢情報3D（回転をクォータニオンで持つ）
+typedef struct QuaternionTransform3D
+{
+	// 拡縮
+	Vector3 scale;
+
+	// 回転
+	Quaternion rotate;
+
+	// 移動
+	Vector3 translate;
+}QuaternionTransform3D;
+
+// 球
+typedef struct Sphere
+{
+	// 中心
+	Vector3 center;
+
+	// 半径
+	float radius;
+}Sphere;
+
+// 軸平行境界箱
+typedef struct AABB
+{
+	// 最小点
+	Vector3 min;
+
+	// 最大点
+	Vector3 max;
+}AABB;
+
+// 平面（Dot(normal, p) + distance >= 0 の側が表）
+typedef struct Plane
+{
+	// 法線
+	Vector3 normal;
+
+	// 原点からの距離
+	float distance;
+}Plane;
+
+// 視錐台（各平面の表が内側）
+typedef struct Frustum
+{
+	// 左, 右, 下, 上, 近, 遠 の順
+	Plane planes[6];
+}Frustum;
\ No newline at end of file
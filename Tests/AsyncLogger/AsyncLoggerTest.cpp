@@ -0,0 +1,250 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Func/AsyncLogger/AsyncLogger.h"
+#include "TestCheck.h"
+
+/*
+	AsyncLoggerのテスト
+	書き込み先を止められるstreambufにして、リングがいっぱいのときの動きを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 開くまで書き込みを止めるstreambuf
+	/// </summary>
+	class GatedBuffer : public std::streambuf
+	{
+	public:
+
+		// 書き込みを止める、再開する
+		void SetOpen(bool isOpen)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isOpen_ = isOpen;
+			condition_.notify_all();
+		}
+
+		// 書き込みで止まっているスレッドが来るまで待つ
+		void WaitBlocked()
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [&]() { return isBlocked_; });
+		}
+
+		// 書かれた文字列と、flushの回数
+		std::string GetText()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return text_;
+		}
+		int GetSyncCount()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			return syncCount_;
+		}
+
+	protected:
+
+		std::streamsize xsputn(const char* data, std::streamsize count) override
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			isBlocked_ = !isOpen_;
+			condition_.notify_all();
+			condition_.wait(lock, [&]() { return isOpen_; });
+			isBlocked_ = false;
+
+			text_.append(data, static_cast<size_t>(count));
+			return count;
+		}
+
+		int_type overflow(int_type character) override
+		{
+			if (character != traits_type::eof())
+			{
+				char c = traits_type::to_char_type(character);
+				xsputn(&c, 1);
+			}
+			return traits_type::not_eof(character);
+		}
+
+		int sync() override
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			syncCount_++;
+			return 0;
+		}
+
+	private:
+
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool isOpen_ = true;
+		bool isBlocked_ = false;
+		std::string text_;
+		int syncCount_ = 0;
+	};
+
+	/// <summary>
+	/// 設定を作る（flushは頼まれたときだけ）
+	/// </summary>
+	AsyncLoggerSettings MakeTestSettings(uint32_t capacity, LogFullPolicy fullPolicy)
+	{
+		AsyncLoggerSettings settings = MakeAsyncLoggerSettings();
+		settings.capacity = capacity;
+		settings.fullPolicy = fullPolicy;
+		settings.flushIntervalMilliseconds = 60000.0;
+		settings.flushBytes = SIZE_MAX;
+		settings.isDebugOutput = false;
+		return settings;
+	}
+
+	/// <summary>
+	/// 複数のスレッドから入れても、スレッドごとの順番を保ち、全て1行ずつ書く
+	/// </summary>
+	void TestOrderAndFlush()
+	{
+		const int kThreadCount = 4;
+		const int kMessageCount = 2000;
+
+		std::ostringstream output;
+		AsyncLogger* logger = CreateAsyncLogger(output, MakeTestSettings(64, LogFullPolicy::Block));
+		AttachAsyncLogger(output, logger);
+		CHECK(GetAttachedAsyncLogger(output) == logger);
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < kThreadCount; t++)
+		{
+			threads.emplace_back([logger, t]()
+				{
+					for (int i = 0; i < kMessageCount; i++)
+					{
+						CHECK(PushLog(logger, std::to_string(t) + ":" + std::to_string(i), LogSeverity::Info));
+					}
+				});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		// 長いログ（リングの場所に入らないもの）
+		std::string longMessage(kLogRecordSize * 3, 'x');
+		PushLog(logger, longMessage, LogSeverity::Info);
+
+		FlushAsyncLogger(logger);
+		CHECK(logger->writtenCount == kThreadCount * kMessageCount + 1);
+		CHECK(logger->droppedCount == 0);
+
+		std::istringstream lines(output.str());
+		std::vector<int> nextIndices(kThreadCount, 0);
+		std::string line;
+		int lineCount = 0;
+		while (std::getline(lines, line))
+		{
+			lineCount++;
+			if (line == longMessage)
+			{
+				continue;
+			}
+
+			int t = std::stoi(line.substr(0, line.find(':')));
+			int i = std::stoi(line.substr(line.find(':') + 1));
+			CHECK(i == nextIndices[t]);
+			nextIndices[t] = i + 1;
+		}
+		CHECK(lineCount == kThreadCount * kMessageCount + 1);
+
+		ReleaseAsyncLogger(logger);
+		CHECK(GetAttachedAsyncLogger(output) == nullptr);
+	}
+
+	/// <summary>
+	/// いっぱいなら、Infoのログは捨てるが、Errorのログは空くまで待って必ず書く
+	/// </summary>
+	void TestDropKeepsErrors()
+	{
+		const uint32_t kCapacity = 4;
+
+		GatedBuffer buffer;
+		std::ostream output(&buffer);
+		AsyncLogger* logger = CreateAsyncLogger(output, MakeTestSettings(kCapacity, LogFullPolicy::Drop));
+
+		// 書くスレッドを、最初のログを書くところで止める
+		buffer.SetOpen(false);
+		PushLog(logger, "first", LogSeverity::Info);
+		buffer.WaitBlocked();
+
+		// リングを埋めると、次のInfoは捨てる
+		for (uint32_t i = 0; i < kCapacity; i++)
+		{
+			CHECK(PushLog(logger, "fill" + std::to_string(i), LogSeverity::Info));
+		}
+		CHECK(!PushLog(logger, "dropped", LogSeverity::Info));
+		CHECK(logger->droppedCount == 1);
+
+		// Errorは空くまで待つ
+		std::atomic<bool> isErrorPushed = false;
+		std::thread errorThread([&]()
+			{
+				CHECK(PushLog(logger, "error", LogSeverity::Error));
+				isErrorPushed = true;
+			});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		CHECK(!isErrorPushed);
+
+		buffer.SetOpen(true);
+		errorThread.join();
+		CHECK(isErrorPushed);
+
+		// 止まる直前のflush（全て書かれてから戻る）
+		CHECK(FlushAllAsyncLoggers(5000.0));
+		std::string text = buffer.GetText();
+		CHECK(text.find("error\n") != std::string::npos);
+		CHECK(text.find("fill3\n") != std::string::npos);
+		CHECK(text.find("dropped") == std::string::npos);
+		CHECK(logger->droppedCount == 1);
+		CHECK(buffer.GetSyncCount() > 0);
+
+		ReleaseAsyncLogger(logger);
+		CHECK(buffer.GetText().find("AsyncLogger dropped 1 records") != std::string::npos);
+	}
+
+	/// <summary>
+	/// 書くスレッドが止まっていれば、時間切れで諦める
+	/// </summary>
+	void TestFlushTimeout()
+	{
+		GatedBuffer buffer;
+		std::ostream output(&buffer);
+		AsyncLogger* logger = CreateAsyncLogger(output, MakeTestSettings(16, LogFullPolicy::Drop));
+
+		buffer.SetOpen(false);
+		PushLog(logger, "stuck", LogSeverity::Error);
+		buffer.WaitBlocked();
+
+		CHECK(!FlushAllAsyncLoggers(10.0));
+
+		buffer.SetOpen(true);
+		CHECK(FlushAllAsyncLoggers(5000.0));
+		ReleaseAsyncLogger(logger);
+
+		// 解放した後は待つものがない
+		CHECK(FlushAllAsyncLoggers(0.0));
+	}
+}
+
+int main()
+{
+	TestOrderAndFlush();
+	TestDropKeepsErrors();
+	TestFlushTimeout();
+
+	return FinishTest("AsyncLoggerTest");
+}
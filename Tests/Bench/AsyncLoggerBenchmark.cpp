@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Func/AsyncLogger/AsyncLogger.h"
+#include "Benchmark.h"
+
+/*
+	AsyncLoggerのベンチマーク
+	複数のスレッドから同時にPushLogを呼び、1回あたりの時間（ns）、PushLog1回の待ち時間の中央値と99%点、捨てた数を出す
+	書き込み先は何もしないstreambufにして、ファイルに書く速さには左右されないようにする
+
+	AsyncLoggerBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+
+	iterationsは全てのスレッドを合わせたPushLogの回数
+*/
+
+namespace
+{
+	// 1行のログ（1フレームに何度も出る程度の長さ）
+	const std::string_view kMessage = "frame 12345 : draw 678 , pipeline 9 , material 1011 , mesh 1213\n";
+
+	/// <summary>
+	/// 書かれたものを捨てるstreambuf
+	/// </summary>
+	class NullBuffer : public std::streambuf
+	{
+	protected:
+
+		std::streamsize xsputn(const char*, std::streamsize count) override
+		{
+			return count;
+		}
+
+		int_type overflow(int_type character) override
+		{
+			return traits_type::not_eof(character);
+		}
+	};
+
+	/// <summary>
+	/// 並べた待ち時間から割合の位置の値を取り出す
+	/// </summary>
+	double GetPercentile(const std::vector<double>& sortedLatencies, double ratio)
+	{
+		size_t index = static_cast<size_t>(ratio * static_cast<double>(sortedLatencies.size() - 1));
+		return sortedLatencies[index];
+	}
+
+	/// <summary>
+	/// producerCount個のスレッドからPushLogを呼ぶ
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="settings">設定</param>
+	/// <param name="producerCount">ログを出すスレッドの数</param>
+	/// <returns>結果</returns>
+	BenchmarkResult RunProducerBenchmark(const char* name, const BenchmarkSettings& settings, uint32_t producerCount)
+	{
+		NullBuffer buffer;
+		std::ostream output(&buffer);
+
+		// 既定の設定（4096個、いっぱいなら捨てる）
+		AsyncLoggerSettings loggerSettings = MakeAsyncLoggerSettings();
+		loggerSettings.isDebugOutput = false;
+		AsyncLogger* logger = CreateAsyncLogger(output, loggerSettings);
+
+		uint64_t pushesPerThread = (std::max)(settings.iterations / producerCount, uint64_t{ 1 });
+
+		// スレッドごとの待ち時間（時刻を取る分も含む）
+		std::vector<std::vector<double>> threadLatencies(producerCount);
+		std::vector<double> latencies;
+
+		// 最後の計測の待ち時間と、捨てた数
+		double p50 = 0.0;
+		double p99 = 0.0;
+		uint64_t droppedBefore = 0;
+		uint64_t droppedCount = 0;
+
+		BenchmarkResult result = RunBenchmark(name, settings, pushesPerThread * producerCount, [&](size_t)
+			{
+				droppedBefore = logger->droppedCount.load();
+
+				std::vector<std::thread> threads;
+				for (uint32_t t = 0; t < producerCount; t++)
+				{
+					threads.emplace_back([&, t]()
+						{
+							std::vector<double>& threadLatency = threadLatencies[t];
+							threadLatency.clear();
+							threadLatency.reserve(pushesPerThread);
+
+							for (uint64_t i = 0; i < pushesPerThread; i++)
+							{
+								std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+								PushLog(logger, kMessage, LogSeverity::Info);
+								std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+								threadLatency.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+							}
+						});
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+			}, [&]()
+				{
+					// 次の計測を空のリングから始める
+					FlushAsyncLogger(logger);
+					droppedCount = logger->droppedCount.load() - droppedBefore;
+
+					latencies.clear();
+					for (const std::vector<double>& threadLatency : threadLatencies)
+					{
+						latencies.insert(latencies.end(), threadLatency.begin(), threadLatency.end());
+					}
+					std::sort(latencies.begin(), latencies.end());
+
+					p50 = GetPercentile(latencies, 0.50);
+					p99 = GetPercentile(latencies, 0.99);
+				});
+
+		ReleaseAsyncLogger(logger);
+
+		result.metrics.push_back(BenchmarkMetric{ "producers" , static_cast<double>(producerCount) });
+		result.metrics.push_back(BenchmarkMetric{ "pushLogP50Ns" , p50 });
+		result.metrics.push_back(BenchmarkMetric{ "pushLogP99Ns" , p99 });
+		result.metrics.push_back(BenchmarkMetric{ "dropped" , static_cast<double>(droppedCount) });
+		result.metrics.push_back(BenchmarkMetric{ "pushed" , static_cast<double>(pushesPerThread * producerCount) });
+
+		return result;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunAsyncLoggerBenchmarks(const BenchmarkSettings& settings)
+	{
+		std::vector<BenchmarkResult> results;
+		results.push_back(RunProducerBenchmark("PushLog1Thread", settings, 1));
+		results.push_back(RunProducerBenchmark("PushLog4Threads", settings, 4));
+
+		// ハードウェアのスレッドを全て使う（ファイルに書くスレッドと取り合う）
+		uint32_t hardwareThreadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+		results.push_back(RunProducerBenchmark("PushLogAllThreads", settings, hardwareThreadCount));
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 1000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunAsyncLoggerBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Func/Simd/Simd.h"
+
+/*
+	ベンチマークで使う計測と出力
+	1回あたりの時間（ns）を、何度か測ったうちの最小と中央値で出す
+
+	<Benchmark> [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+// ベンチマークの設定
+typedef struct BenchmarkSettings
+{
+	// 1回の計測で行う回数
+	uint64_t iterations;
+
+	// 計測する回数
+	uint32_t repeat;
+
+	// "json" か "csv"
+	std::string format;
+
+	// 出力先（空なら標準出力）
+	std::string outputPath;
+}BenchmarkSettings;
+
+// 時間の他に出す値（描画の数や、捨てたログの数など）
+typedef struct BenchmarkMetric
+{
+	// 名前
+	std::string name;
+
+	// 値
+	double value;
+}BenchmarkMetric;
+
+// 1つのベンチマークの結果
+typedef struct BenchmarkResult
+{
+	// 名前
+	std::string name;
+
+	// 1回あたりの時間（ns）
+	double nanosecondsPerOperationMin;
+	double nanosecondsPerOperationMedian;
+
+	// 時間の他に出す値
+	std::vector<BenchmarkMetric> metrics;
+}BenchmarkResult;
+
+/// <summary>
+/// コマンドラインから設定を読む
+/// </summary>
+/// <param name="argc">引数の数</param>
+/// <param name="argv">引数</param>
+/// <param name="defaultIterations">--iterationsがないときの回数</param>
+/// <param name="settings">設定の出力先</param>
+/// <returns>読めたか（読めなければ使い方を出している）</returns>
+inline bool ParseBenchmarkSettings(int argc, char* argv[], uint64_t defaultIterations, BenchmarkSettings& settings)
+{
+	// 既定の設定
+	settings = BenchmarkSettings{};
+	settings.iterations = defaultIterations;
+	settings.repeat = 5;
+	settings.format = "json";
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+
+		if (std::strcmp(argv[i], "--iterations") == 0 && hasValue)
+		{
+			settings.iterations = (std::max)(std::strtoull(argv[++i], nullptr, 10), 1ull);
+		}
+		else if (std::strcmp(argv[i], "--repeat") == 0 && hasValue)
+		{
+			settings.repeat = (std::max)(static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)), 1u);
+		}
+		else if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+		{
+			settings.format = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+		{
+			settings.outputPath = argv[++i];
+		}
+		else
+		{
+			std::fprintf(stderr, "usage: %s [--iterations N] [--repeat R] [--format json|csv] [--output path]\n", argv[0]);
+			return false;
+		}
+	}
+
+	if (settings.format != "json" && settings.format != "csv")
+	{
+		std::fprintf(stderr, "unknown format: %s\n", settings.format.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// 計測する
+/// </summary>
+/// <param name="name">名前</param>
+/// <param name="settings">設定</param>
+/// <param name="operationsPerCall">bodyを1回呼んだときの回数（まとめて処理する関数用）</param>
+/// <param name="body">body(番号) で1回分を行う</param>
+/// <param name="consume">計測の後に結果を使う</param>
+/// <returns>結果</returns>
+template<typename Body, typename Consumer>
+BenchmarkResult RunBenchmark(const char* name, const BenchmarkSettings& settings, uint64_t operationsPerCall, Body body, Consumer consume)
+{
+	uint64_t callCount = (std::max)(settings.iterations / operationsPerCall, uint64_t{ 1 });
+	std::vector<double> samples;
+
+	// 1回目はキャッシュを温めるために捨てる
+	for (uint32_t r = 0; r <= settings.repeat; r++)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for (uint64_t i = 0; i < callCount; i++)
+		{
+			body(static_cast<size_t>(i));
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		consume();
+
+		if (r != 0)
+		{
+			double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+			samples.push_back(nanoseconds / static_cast<double>(callCount * operationsPerCall));
+		}
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	BenchmarkResult result{};
+	result.name = name;
+	result.nanosecondsPerOperationMin = samples.front();
+	result.nanosecondsPerOperationMedian = samples[samples.size() / 2];
+
+	return result;
+}
+
+/// <summary>
+/// 結果を書き出す
+/// </summary>
+/// <param name="file">書き出し先</param>
+/// <param name="settings">設定</param>
+/// <param name="backend">実装の名前（"sse"、"scalar" など）</param>
+/// <param name="results">結果</param>
+inline void WriteBenchmarkResults(std::FILE* file, const BenchmarkSettings& settings, const char* backend, const std::vector<BenchmarkResult>& results)
+{
+	if (settings.format == "csv")
+	{
+		// 時間の他の値は "名前=値" を ; でつなぐ
+		std::fprintf(file, "name,backend,iterations,repeat,ns_per_op_min,ns_per_op_median,metrics\n");
+
+		for (const BenchmarkResult& result : results)
+		{
+			std::fprintf(file, "%s,%s,%llu,%u,%.4f,%.4f,", result.name.c_str(), backend,
+				static_cast<unsigned long long>(settings.iterations), settings.repeat,
+				result.nanosecondsPerOperationMin, result.nanosecondsPerOperationMedian);
+
+			for (size_t m = 0; m < result.metrics.size(); m++)
+			{
+				std::fprintf(file, "%s%s=%.4f", (m != 0) ? ";" : "", result.metrics[m].name.c_str(), result.metrics[m].value);
+			}
+
+			std::fprintf(file, "\n");
+		}
+
+		return;
+	}
+
+	std::fprintf(file, "{\n");
+	std::fprintf(file, "  \"backend\": \"%s\",\n", backend);
+	std::fprintf(file, "  \"iterations\": %llu,\n", static_cast<unsigned long long>(settings.iterations));
+	std::fprintf(file, "  \"repeat\": %u,\n", settings.repeat);
+	std::fprintf(file, "  \"results\": [\n");
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		std::fprintf(file, "    { \"name\": \"%s\", \"nsPerOpMin\": %.4f, \"nsPerOpMedian\": %.4f", results[i].name.c_str(),
+			results[i].nanosecondsPerOperationMin, results[i].nanosecondsPerOperationMedian);
+
+		for (const BenchmarkMetric& metric : results[i].metrics)
+		{
+			std::fprintf(file, ", \"%s\": %.4f", metric.name.c_str(), metric.value);
+		}
+
+		std::fprintf(file, " }%s\n", (i + 1 < results.size()) ? "," : "");
+	}
+
+	std::fprintf(file, "  ]\n");
+	std::fprintf(file, "}\n");
+}
+
+/// <summary>
+/// 結果を設定の出力先に書き出す
+/// </summary>
+/// <param name="settings">設定</param>
+/// <param name="backend">実装の名前</param>
+/// <param name="results">結果</param>
+/// <returns>mainの戻り値（書けなければ1）</returns>
+inline int FinishBenchmark(const BenchmarkSettings& settings, const char* backend, const std::vector<BenchmarkResult>& results)
+{
+	std::FILE* file = stdout;
+	if (!settings.outputPath.empty())
+	{
+		file = std::fopen(settings.outputPath.c_str(), "w");
+		if (file == nullptr)
+		{
+			std::fprintf(stderr, "failed to open %s\n", settings.outputPath.c_str());
+			return 1;
+		}
+	}
+
+	WriteBenchmarkResults(file, settings, backend, results);
+
+	if (file != stdout && std::fclose(file) != 0)
+	{
+		std::fprintf(stderr, "failed to write %s\n", settings.outputPath.c_str());
+		return 1;
+	}
+
+	return 0;
+}
+
+/// <summary>
+/// 使っている数学のSIMD命令の名前（数学を使わないベンチマークは"none"を渡す）
+/// </summary>
+/// <returns>名前</returns>
+inline const char* GetMathBackendName()
+{
+#if defined(MATH_SIMD_SSE)
+	return "sse";
+#elif defined(MATH_SIMD_NEON)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,107 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Func/Culling/Culling.h"
+#include "Func/Matrix/Matrix.h"
+#include "Func/Vector/Vector.h"
+#include "Benchmark.h"
+
+/*
+	視錐台カリングのベンチマーク
+	100万個の球とAABBをまとめてカリングし、1個あたりの時間（ns）と見えた数を出す
+
+	CullingBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+
+	CullingBenchmarkはSIMD版、CullingBenchmarkScalarはMATH_NO_SIMDのスカラー版で、同じ表を出す
+*/
+
+namespace
+{
+	// 境界の数
+	const size_t kBoundsCount = 1000000;
+
+	// 見えた数を最後に足して、計算が消されないようにする
+	volatile size_t gSink = 0;
+
+	/// <summary>
+	/// 再現できる乱数（-range 〜 range）
+	/// </summary>
+	float RandomFloat(uint32_t& state, float range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunCullingBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		uint32_t state = 12345;
+
+		// カメラの前に散らばった境界（3割ほどが視錐台に入る）
+		std::vector<Sphere> spheres(kBoundsCount);
+		std::vector<AABB> aabbs(kBoundsCount);
+
+		for (size_t i = 0; i < kBoundsCount; i++)
+		{
+			Vector3 center = { RandomFloat(state, 40.0f) , RandomFloat(state, 20.0f) , 40.0f + RandomFloat(state, 60.0f) };
+			Vector3 extent = { 0.1f + std::abs(RandomFloat(state, 2.0f)) , 0.1f + std::abs(RandomFloat(state, 2.0f)) , 0.1f + std::abs(RandomFloat(state, 2.0f)) };
+
+			spheres[i].center = center;
+			spheres[i].radius = Length(extent);
+
+			aabbs[i].min = { center.x - extent.x , center.y - extent.y , center.z - extent.z };
+			aabbs[i].max = { center.x + extent.x , center.y + extent.y , center.z + extent.z };
+		}
+
+		Matrix4x4 viewProjectionMatrix = Multiply(MakeLookAtMatrix({ 0.0f , 5.0f , -20.0f }, { 0.0f , 0.0f , 0.0f }, { 0.0f , 1.0f , 0.0f }),
+			MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+		Frustum frustum = MakeFrustum(viewProjectionMatrix);
+
+		std::vector<uint32_t> visibleIndices(kBoundsCount);
+		size_t visibleCount = 0;
+
+		auto consumeVisibleCount = [&]() { gSink = gSink + visibleCount; };
+
+
+		/*-------------
+		    計測する
+		-------------*/
+
+		std::vector<BenchmarkResult> results;
+
+		results.push_back(RunBenchmark("CullSpheres", settings, kBoundsCount, [&](size_t)
+			{
+				visibleCount = CullSpheres(frustum, spheres, visibleIndices);
+			}, consumeVisibleCount));
+		results.back().metrics.push_back(BenchmarkMetric{ "bounds" , static_cast<double>(kBoundsCount) });
+		results.back().metrics.push_back(BenchmarkMetric{ "visible" , static_cast<double>(visibleCount) });
+
+		results.push_back(RunBenchmark("CullAABBs", settings, kBoundsCount, [&](size_t)
+			{
+				visibleCount = CullAABBs(frustum, aabbs, visibleIndices);
+			}, consumeVisibleCount));
+		results.back().metrics.push_back(BenchmarkMetric{ "bounds" , static_cast<double>(kBoundsCount) });
+		results.back().metrics.push_back(BenchmarkMetric{ "visible" , static_cast<double>(visibleCount) });
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 10000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunCullingBenchmarks(settings);
+
+	return FinishBenchmark(settings, GetMathBackendName(), results);
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <vector>
+#include "Func/DescriptorAllocator/DescriptorAllocator.h"
+#include "Benchmark.h"
+
+/*
+	DescriptorAllocatorのベンチマーク
+	使い続ける領域の確保と解放、フレームごとの領域の確保と回収を繰り返し、1回あたりの時間（ns）を出す
+
+	DescriptorAllocatorBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+namespace
+{
+	// 使い続ける領域の数と、その中で生きている範囲の数
+	const uint32_t kPersistentCapacity = 65536;
+	const uint32_t kLiveRangeCount = 4096;
+
+	// フレームごとの領域の数と、1フレームの確保の回数、GPUが遅れるフレームの数
+	const uint32_t kFrameCapacity = 16384;
+	const uint32_t kAllocationsPerFrame = 256;
+	const uint64_t kFramesInFlight = 2;
+
+	// 乱数の入力の数（2のべき乗、番号はマスクで回す）
+	const size_t kInputCount = 1024;
+	const size_t kInputMask = kInputCount - 1;
+
+	// 結果を最後に足して、計算が消されないようにする
+	volatile uint32_t gSink = 0;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunDescriptorAllocatorBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		uint32_t state = 12345;
+
+		// 確保する数（1 〜 8、テクスチャやバッファのテーブル程度）と、解放する範囲の番号
+		std::vector<uint32_t> counts(kInputCount);
+		std::vector<uint32_t> victims(kInputCount);
+
+		for (size_t i = 0; i < kInputCount; i++)
+		{
+			counts[i] = 1 + RandomUint(state, 8);
+			victims[i] = RandomUint(state, kLiveRangeCount);
+		}
+
+		std::vector<BenchmarkResult> results;
+
+
+		/*-------------------------------
+		    使い続ける領域の確保と解放
+		-------------------------------*/
+
+		{
+			// 生きている範囲をばらばらに解放して作り直すので、空きは細切れになっていく
+			DescriptorAllocator allocator = MakeDescriptorAllocator(kPersistentCapacity, 0);
+			std::vector<DescriptorRange> liveRanges(kLiveRangeCount);
+
+			for (uint32_t i = 0; i < kLiveRangeCount; i++)
+			{
+				liveRanges[i] = AllocatePersistentDescriptors(allocator, counts[i & kInputMask]);
+			}
+
+			uint64_t failedCount = 0;
+
+			results.push_back(RunBenchmark("AllocateFreePersistentDescriptors", settings, 1, [&](size_t i)
+				{
+					DescriptorRange& range = liveRanges[victims[i & kInputMask]];
+					FreePersistentDescriptors(allocator, range);
+
+					range = AllocatePersistentDescriptors(allocator, counts[(i >> 3) & kInputMask]);
+					failedCount += (range.count == 0);
+				}, [&]() { gSink = gSink + static_cast<uint32_t>(allocator.freeRanges.size()); }));
+			results.back().metrics.push_back(BenchmarkMetric{ "liveRanges" , static_cast<double>(kLiveRangeCount) });
+			results.back().metrics.push_back(BenchmarkMetric{ "freeRanges" , static_cast<double>(allocator.freeRanges.size()) });
+			results.back().metrics.push_back(BenchmarkMetric{ "failedAllocations" , static_cast<double>(failedCount) });
+		}
+
+
+		/*-------------------------------------
+		    フレームごとの領域の確保と回収
+		-------------------------------------*/
+
+		{
+			// 1フレームにkAllocationsPerFrame回確保し、kFramesInFlightフレーム前までをGPUが使い終わったとする
+			DescriptorAllocator allocator = MakeDescriptorAllocator(0, kFrameCapacity);
+			uint64_t fenceValue = 0;
+			uint64_t failedCount = 0;
+
+			results.push_back(RunBenchmark("AllocateFrameDescriptors", settings, 1, [&](size_t i)
+				{
+					DescriptorRange range = AllocateFrameDescriptors(allocator, counts[i & kInputMask]);
+					failedCount += (range.count == 0);
+
+					if ((i + 1) % kAllocationsPerFrame == 0)
+					{
+						FinishDescriptorFrame(allocator, ++fenceValue);
+						ReclaimDescriptorFrames(allocator, (fenceValue > kFramesInFlight) ? fenceValue - kFramesInFlight : 0);
+					}
+				}, [&]() { gSink = gSink + static_cast<uint32_t>(allocator.frameHead); }));
+			results.back().metrics.push_back(BenchmarkMetric{ "allocationsPerFrame" , static_cast<double>(kAllocationsPerFrame) });
+			results.back().metrics.push_back(BenchmarkMetric{ "failedAllocations" , static_cast<double>(failedCount) });
+		}
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 1000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunDescriptorAllocatorBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
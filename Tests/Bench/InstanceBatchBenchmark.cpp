@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <vector>
+#include "Func/InstanceBatch/InstanceBatch.h"
+#include "Benchmark.h"
+
+/*
+	InstanceBatchのベンチマーク
+	20万個のオブジェクトのシーンをバッチにまとめ、1オブジェクトあたりの時間（ns）と、オブジェクトとバッチの数を出す
+
+	InstanceBatchBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+namespace
+{
+	// オブジェクトの数
+	const uint32_t kItemCount = 200000;
+
+	// シーンのメッシュの数と、メッシュごとのマテリアルの数（組み合わせは2048通り）
+	const uint32_t kMeshCount = 512;
+	const uint32_t kMaterialsPerMesh = 4;
+
+	// 結果を最後に足して、計算が消されないようにする
+	volatile uint32_t gSink = 0;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// オブジェクトとバッチの数を結果に加える
+	/// </summary>
+	void AddBatchMetrics(BenchmarkResult& result, const std::vector<InstanceBatch>& batches)
+	{
+		result.metrics.push_back(BenchmarkMetric{ "items" , static_cast<double>(kItemCount) });
+		result.metrics.push_back(BenchmarkMetric{ "batches" , static_cast<double>(batches.size()) });
+		result.metrics.push_back(BenchmarkMetric{ "itemsPerBatch" , static_cast<double>(kItemCount) / static_cast<double>(batches.size()) });
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunInstanceBatchBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		uint32_t state = 12345;
+
+		// 並びはばらばら（シーンを辿った順）
+		std::vector<InstanceDrawItem> items(kItemCount);
+
+		for (uint32_t i = 0; i < kItemCount; i++)
+		{
+			items[i].meshIndex = RandomUint(state, kMeshCount);
+			items[i].materialIndex = items[i].meshIndex * kMaterialsPerMesh + RandomUint(state, kMaterialsPerMesh);
+			items[i].objectIndex = i;
+		}
+
+		std::vector<uint32_t> instanceObjectIndices;
+		std::vector<InstanceBatch> batches;
+
+		auto consumeBatches = [&]() { gSink = gSink + batches.back().instanceCount + instanceObjectIndices.back(); };
+
+
+		/*-------------
+		    計測する
+		-------------*/
+
+		std::vector<BenchmarkResult> results;
+
+		results.push_back(RunBenchmark("BuildInstanceBatches", settings, kItemCount, [&](size_t)
+			{
+				BuildInstanceBatches(items, 1024, instanceObjectIndices, batches);
+			}, consumeBatches));
+		AddBatchMetrics(results.back(), batches);
+
+		// 1回の描画でまとめる数が少ないとき（定数バッファの大きさで制限される場合など）
+		results.push_back(RunBenchmark("BuildInstanceBatchesMax16", settings, kItemCount, [&](size_t)
+			{
+				BuildInstanceBatches(items, 16, instanceObjectIndices, batches);
+			}, consumeBatches));
+		AddBatchMetrics(results.back(), batches);
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 10000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunInstanceBatchBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
@@ -0,0 +1,215 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "Func/Matrix/Matrix.h"
+#include "Func/Quaternion/Quaternion.h"
+#include "Func/Vector/Vector.h"
+#include "Benchmark.h"
+
+/*
+	数学の関数のベンチマーク
+	1回あたりの時間（ns）を、何度か測ったうちの最小と中央値で出す
+
+	MathBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+
+	MathBenchmarkはSIMD版、MathBenchmarkScalarはMATH_NO_SIMDのスカラー版で、同じ表を出す
+*/
+
+namespace
+{
+	// 入力の数（2のべき乗、番号はマスクで回す）
+	const size_t kInputCount = 1024;
+	const size_t kInputMask = kInputCount - 1;
+
+	// 計算結果を最後に足して、計算が消されないようにする
+	volatile float gSink = 0.0f;
+
+	/// <summary>
+	/// 再現できる乱数（-range 〜 range）
+	/// </summary>
+	float RandomFloat(uint32_t& state, float range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+	}
+
+	/// <summary>
+	/// 結果を足す（計測の外で呼ぶ）
+	/// </summary>
+	void Consume(const std::vector<Matrix4x4>& matrices)
+	{
+		float sum = 0.0f;
+		for (const Matrix4x4& m : matrices)
+		{
+			sum += m.m[0][0] + m.m[1][1] + m.m[2][2] + m.m[3][3] + m.m[3][0];
+		}
+		gSink = gSink + sum;
+	}
+
+	void Consume(const std::vector<Vector3>& vectors)
+	{
+		float sum = 0.0f;
+		for (const Vector3& v : vectors)
+		{
+			sum += v.x + v.y + v.z;
+		}
+		gSink = gSink + sum;
+	}
+
+	void Consume(const std::vector<float>& values)
+	{
+		float sum = 0.0f;
+		for (float value : values)
+		{
+			sum += value;
+		}
+		gSink = gSink + sum;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunMathBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		uint32_t state = 12345;
+
+		std::vector<Transform3D> transforms(kInputCount);
+		std::vector<Quaternion> rotations(kInputCount);
+		std::vector<Matrix4x4> matrices(kInputCount);
+		std::vector<Transform3D> cameraTransforms(kInputCount);
+		std::vector<Matrix4x4> rigidMatrices(kInputCount);
+		std::vector<Vector3> vectors(kInputCount);
+
+		for (size_t i = 0; i < kInputCount; i++)
+		{
+			transforms[i].scale = { 0.5f + std::abs(RandomFloat(state, 2.0f)) , 0.5f + std::abs(RandomFloat(state, 2.0f)) , 0.5f + std::abs(RandomFloat(state, 2.0f)) };
+			transforms[i].rotate = { RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) };
+			transforms[i].translate = { RandomFloat(state, 100.0f) , RandomFloat(state, 100.0f) , RandomFloat(state, 100.0f) };
+
+			matrices[i] = MakeAffineMatrix(transforms[i].scale, transforms[i].rotate, transforms[i].translate);
+			rotations[i] = MakeRotateQuaternion(transforms[i].rotate);
+
+			// 拡縮を含まない姿勢（カメラや、MakeInverseRigidMatrixの入力）
+			cameraTransforms[i] = transforms[i];
+			cameraTransforms[i].scale = { 1.0f , 1.0f , 1.0f };
+			rigidMatrices[i] = MakeAffineMatrix(cameraTransforms[i].scale, cameraTransforms[i].rotate, cameraTransforms[i].translate);
+
+			vectors[i] = { RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) };
+		}
+
+		Matrix4x4 viewProjectionMatrix = Multiply(MakeLookAtMatrix({ 0.0f , 5.0f , -20.0f }, { 0.0f , 0.0f , 0.0f }, { 0.0f , 1.0f , 0.0f }),
+			MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+		std::vector<Matrix4x4> matrixResults(kInputCount);
+		std::vector<Vector3> vectorResults(kInputCount);
+		std::vector<float> floatResults(kInputCount);
+
+		auto consumeMatrices = [&]() { Consume(matrixResults); };
+		auto consumeVectors = [&]() { Consume(vectorResults); };
+		auto consumeFloats = [&]() { Consume(floatResults); };
+
+
+		/*-------------
+		    計測する
+		-------------*/
+
+		std::vector<BenchmarkResult> results;
+
+		results.push_back(RunBenchmark("Multiply", settings, 1, [&](size_t i)
+			{
+				matrixResults[i & kInputMask] = Multiply(matrices[i & kInputMask], matrices[(i + 1) & kInputMask]);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeInverseMatrix", settings, 1, [&](size_t i)
+			{
+				matrixResults[i & kInputMask] = MakeInverseMatrix(matrices[i & kInputMask]);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeInverseRigidMatrix", settings, 1, [&](size_t i)
+			{
+				matrixResults[i & kInputMask] = MakeInverseRigidMatrix(rigidMatrices[i & kInputMask]);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeViewMatrix", settings, 1, [&](size_t i)
+			{
+				matrixResults[i & kInputMask] = MakeViewMatrix(cameraTransforms[i & kInputMask]);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeInverseAffineMatrix", settings, 1, [&](size_t i)
+			{
+				matrixResults[i & kInputMask] = MakeInverseAffineMatrix(matrices[i & kInputMask]);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeAffineMatrix", settings, 1, [&](size_t i)
+			{
+				const Transform3D& transform = transforms[i & kInputMask];
+				matrixResults[i & kInputMask] = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeAffineMatrixQuaternion", settings, 1, [&](size_t i)
+			{
+				const Transform3D& transform = transforms[i & kInputMask];
+				matrixResults[i & kInputMask] = MakeAffineMatrixQuaternion(transform.scale, rotations[i & kInputMask], transform.translate);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeAffineMatrixFast", settings, 1, [&](size_t i)
+			{
+				const Transform3D& transform = transforms[i & kInputMask];
+				matrixResults[i & kInputMask] = MakeAffineMatrixFast(transform.scale, transform.rotate, transform.translate);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("MakeWorldViewProjectionMatrices", settings, kInputCount, [&](size_t)
+			{
+				MakeWorldViewProjectionMatrices(transforms, viewProjectionMatrix, matrixResults);
+			}, consumeMatrices));
+
+		results.push_back(RunBenchmark("Transform", settings, 1, [&](size_t i)
+			{
+				vectorResults[i & kInputMask] = Transform(vectors[i & kInputMask], matrices[(i >> 10) & kInputMask]);
+			}, consumeVectors));
+
+		results.push_back(RunBenchmark("TransformPoints", settings, kInputCount, [&](size_t i)
+			{
+				TransformPoints(vectors, matrices[i & kInputMask], vectorResults);
+			}, consumeVectors));
+
+		results.push_back(RunBenchmark("Normalize", settings, 1, [&](size_t i)
+			{
+				vectorResults[i & kInputMask] = Normalize(vectors[i & kInputMask]);
+			}, consumeVectors));
+
+		results.push_back(RunBenchmark("NormalizeFast", settings, 1, [&](size_t i)
+			{
+				vectorResults[i & kInputMask] = NormalizeFast(vectors[i & kInputMask]);
+			}, consumeVectors));
+
+		results.push_back(RunBenchmark("NormalizeArray", settings, kInputCount, [&](size_t)
+			{
+				NormalizeArray(vectors, vectorResults);
+			}, consumeVectors));
+
+		results.push_back(RunBenchmark("Length", settings, 1, [&](size_t i)
+			{
+				floatResults[i & kInputMask] = Length(vectors[i & kInputMask]);
+			}, consumeFloats));
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 1000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunMathBenchmarks(settings);
+
+	return FinishBenchmark(settings, GetMathBackendName(), results);
+}
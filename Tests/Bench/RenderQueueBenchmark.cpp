@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <vector>
+#include "Func/RenderQueue/RenderQueue.h"
+#include "Benchmark.h"
+
+/*
+	RenderQueueのベンチマーク
+	10万個のパケットを並べ替え、1パケットあたりの時間（ns）と省いた状態の切り替えの数を出す
+
+	RenderQueueBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+namespace
+{
+	// パケットの数
+	const uint32_t kPacketCount = 100000;
+
+	// シーンの状態の数（マテリアルはパイプラインごと、メッシュはマテリアルごとに決まった数がある）
+	const uint32_t kPassCount = 2;
+	const uint32_t kPipelineCount = 64;
+	const uint32_t kMaterialsPerPipeline = 16;
+	const uint32_t kMeshesPerMaterial = 4;
+
+	// 結果を最後に足して、計算が消されないようにする
+	volatile uint32_t gSink = 0;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunRenderQueueBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		uint32_t state = 12345;
+
+		// 積まれる順はばらばら（シーンを辿った順）
+		RenderQueue queue{};
+		ClearRenderQueue(queue);
+
+		for (uint32_t i = 0; i < kPacketCount; i++)
+		{
+			RenderPacket packet{};
+			packet.pipelineIndex = RandomUint(state, kPipelineCount);
+			packet.materialIndex = packet.pipelineIndex * kMaterialsPerPipeline + RandomUint(state, kMaterialsPerPipeline);
+			packet.meshIndex = packet.materialIndex * kMeshesPerMaterial + RandomUint(state, kMeshesPerMaterial);
+			packet.drawIndex = i;
+			packet.sortKey = MakeRenderSortKey(RandomUint(state, kPassCount), packet.pipelineIndex, packet.materialIndex,
+				static_cast<float>(RandomUint(state, 1u << 16)) / static_cast<float>(1u << 16));
+
+			PushRenderPacket(queue, packet);
+		}
+
+		auto consumeCommands = [&]() { gSink = gSink + queue.commands.back().packetIndex + queue.stats.removedStateChanges; };
+
+
+		/*-------------
+		    計測する
+		-------------*/
+
+		std::vector<BenchmarkResult> results;
+
+		results.push_back(RunBenchmark("SortRenderQueue", settings, kPacketCount, [&](size_t)
+			{
+				SortRenderQueue(queue);
+			}, consumeCommands));
+		results.back().metrics.push_back(BenchmarkMetric{ "packets" , static_cast<double>(queue.stats.drawCount) });
+		results.back().metrics.push_back(BenchmarkMetric{ "pipelineChanges" , static_cast<double>(queue.stats.pipelineChanges) });
+		results.back().metrics.push_back(BenchmarkMetric{ "materialChanges" , static_cast<double>(queue.stats.materialChanges) });
+		results.back().metrics.push_back(BenchmarkMetric{ "meshChanges" , static_cast<double>(queue.stats.meshChanges) });
+		results.back().metrics.push_back(BenchmarkMetric{ "removedStateChanges" , static_cast<double>(queue.stats.removedStateChanges) });
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 10000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunRenderQueueBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
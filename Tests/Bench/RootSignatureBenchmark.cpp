@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <vector>
+#include "Func/RootSignatureDescription/RootSignatureDescription.h"
+#include "Benchmark.h"
+
+/*
+	RootSignatureDescriptionのベンチマーク
+	設定のハッシュと、キャッシュからバイナリを引く時間（ns）を出す
+	シリアライズは、設定のハッシュをバイト列にするだけの偽物を使い、ファイルには保存しない
+
+	RootSignatureBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+namespace
+{
+	// 設定の数（2のべき乗、番号はマスクで回す）
+	const size_t kDescriptionCount = 64;
+	const size_t kDescriptionMask = kDescriptionCount - 1;
+
+	// 結果を最後に足して、計算が消されないようにする
+	volatile uint64_t gSink = 0;
+
+	/// <summary>
+	/// 描画で使う形に近い設定（番号でレジスタと定数の数を変える）
+	/// </summary>
+	RootSignatureDescription MakeDescription(uint32_t index)
+	{
+		RootSignatureDescription description{};
+		description.flags = kRootSignatureFlagAllowInputLayout;
+
+		AddRootDescriptor(description, kRootParameterTypeCBV, kRootShaderVisibilityVertex, 0);
+		AddRootDescriptor(description, kRootParameterTypeCBV, kRootShaderVisibilityPixel, 1);
+		AddRootConstants(description, kRootShaderVisibilityPixel, 2, 1 + index % 16);
+		AddRootDescriptorTable(description, kRootShaderVisibilityPixel,
+			{ RootDescriptorRangeDescription{ kRootDescriptorRangeTypeSRV , 1 + index / 16 , 0 , 0 , kRootDescriptorRangeOffsetAppend } ,
+			  RootDescriptorRangeDescription{ kRootDescriptorRangeTypeSRV , kRootDescriptorRangeUnbounded , 0 , 1 , kRootDescriptorRangeOffsetAppend } });
+
+		RootStaticSamplerDescription sampler{};
+		sampler.filter = 0x15;
+		sampler.addressU = 1;
+		sampler.addressV = 1;
+		sampler.addressW = 1;
+		sampler.maxLOD = 3.402823466e+38f;
+		sampler.shaderVisibility = kRootShaderVisibilityPixel;
+		AddRootStaticSampler(description, sampler);
+
+		return description;
+	}
+
+	/// <summary>
+	/// 偽物のシリアライズ（ハッシュのバイト列を返す）
+	/// </summary>
+	std::vector<uint8_t> StubSerialize(const RootSignatureDescription& description)
+	{
+		uint64_t hash = HashRootSignatureDescription(description);
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&hash);
+		return std::vector<uint8_t>(bytes, bytes + sizeof(hash));
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunRootSignatureBenchmarks(const BenchmarkSettings& settings)
+	{
+		/*-------------
+		    入力を作る
+		-------------*/
+
+		std::vector<RootSignatureDescription> descriptions(kDescriptionCount);
+		for (uint32_t i = 0; i < kDescriptionCount; i++)
+		{
+			descriptions[i] = MakeDescription(i);
+		}
+
+		uint64_t hashSum = 0;
+		auto consumeHashSum = [&]() { gSink = gSink + hashSum; };
+
+
+		/*-------------
+		    計測する
+		-------------*/
+
+		std::vector<BenchmarkResult> results;
+
+		results.push_back(RunBenchmark("HashRootSignatureDescription", settings, 1, [&](size_t i)
+			{
+				hashSum += HashRootSignatureDescription(descriptions[i & kDescriptionMask]);
+			}, consumeHashSum));
+
+		// 全ての設定がメモリにある（毎フレーム引く場合）
+		{
+			RootSignatureBlobCache cache{};
+			for (const RootSignatureDescription& description : descriptions)
+			{
+				FindOrSerializeRootSignature(cache, description, StubSerialize);
+			}
+
+			results.push_back(RunBenchmark("FindOrSerializeRootSignatureHit", settings, 1, [&](size_t i)
+				{
+					hashSum += FindOrSerializeRootSignature(cache, descriptions[i & kDescriptionMask], StubSerialize).size();
+				}, consumeHashSum));
+			results.back().metrics.push_back(BenchmarkMetric{ "hitCount" , static_cast<double>(cache.hitCount) });
+			results.back().metrics.push_back(BenchmarkMetric{ "serializeCount" , static_cast<double>(cache.serializeCount) });
+		}
+
+		// 設定を一回りするごとにメモリを空にする（起動時のように、毎回シリアライズして積む場合）
+		{
+			RootSignatureBlobCache cache{};
+
+			results.push_back(RunBenchmark("FindOrSerializeRootSignatureMiss", settings, 1, [&](size_t i)
+				{
+					if ((i & kDescriptionMask) == 0)
+					{
+						cache.blobs.clear();
+					}
+
+					hashSum += FindOrSerializeRootSignature(cache, descriptions[i & kDescriptionMask], StubSerialize).size();
+				}, consumeHashSum));
+			results.back().metrics.push_back(BenchmarkMetric{ "hitCount" , static_cast<double>(cache.hitCount) });
+			results.back().metrics.push_back(BenchmarkMetric{ "serializeCount" , static_cast<double>(cache.serializeCount) });
+		}
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 1000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunRootSignatureBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
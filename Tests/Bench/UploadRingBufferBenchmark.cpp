@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Func/UploadRingBuffer/UploadRingBuffer.h"
+#include "Benchmark.h"
+
+/*
+	UploadRingBufferのベンチマーク
+	フレームごとに確保と回収を繰り返し、1回の確保あたりの時間（ns）と、一番多く使った大きさを出す
+
+	UploadRingBufferBenchmark [--iterations N] [--repeat R] [--format json|csv] [--output path]
+*/
+
+namespace
+{
+	// リングの大きさ
+	const size_t kCapacity = 16 * 1024 * 1024;
+
+	// 1フレームの確保の回数と、GPUが遅れるフレームの数
+	const uint32_t kAllocationsPerFrame = 512;
+	const uint64_t kFramesInFlight = 2;
+
+	// 乱数の入力の数（2のべき乗、番号はマスクで回す）
+	const size_t kInputCount = 1024;
+	const size_t kInputMask = kInputCount - 1;
+
+	// 結果を最後に足して、計算が消されないようにする
+	volatile size_t gSink = 0;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// フレームごとに確保と回収を繰り返す
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="settings">設定</param>
+	/// <param name="sizes">確保する大きさ（kInputCount個）</param>
+	/// <param name="alignment">アライメント</param>
+	/// <returns>結果</returns>
+	BenchmarkResult RunFrameBenchmark(const char* name, const BenchmarkSettings& settings, const std::vector<size_t>& sizes, size_t alignment)
+	{
+		// GPUの代わりのメモリ
+		std::vector<uint8_t> memory(kCapacity);
+		UploadRingBuffer ring = MakeUploadRingBuffer(memory.data(), 0x10000000ull, kCapacity);
+
+		uint64_t fenceValue = 0;
+		uint64_t failedCount = 0;
+		size_t peakUsedSize = 0;
+		size_t offsetSum = 0;
+
+		BenchmarkResult result = RunBenchmark(name, settings, 1, [&](size_t i)
+			{
+				UploadAllocation allocation = AllocateUploadRingBuffer(ring, sizes[i & kInputMask], alignment);
+				failedCount += (allocation.cpuAddress == nullptr);
+				offsetSum += allocation.offset;
+
+				// 1フレーム分を確保したら、kFramesInFlightフレーム前までをGPUが使い終わったとする
+				if ((i + 1) % kAllocationsPerFrame == 0)
+				{
+					peakUsedSize = (std::max)(peakUsedSize, GetUploadRingBufferUsedSize(ring));
+					FinishUploadRingBufferFrame(ring, ++fenceValue);
+					ReclaimUploadRingBuffer(ring, (fenceValue > kFramesInFlight) ? fenceValue - kFramesInFlight : 0);
+				}
+			}, [&]() { gSink = gSink + offsetSum; });
+
+		result.metrics.push_back(BenchmarkMetric{ "allocationsPerFrame" , static_cast<double>(kAllocationsPerFrame) });
+		result.metrics.push_back(BenchmarkMetric{ "peakUsedBytes" , static_cast<double>(peakUsedSize) });
+		result.metrics.push_back(BenchmarkMetric{ "failedAllocations" , static_cast<double>(failedCount) });
+
+		return result;
+	}
+
+	/// <summary>
+	/// 全てのベンチマークを行う
+	/// </summary>
+	std::vector<BenchmarkResult> RunUploadRingBufferBenchmarks(const BenchmarkSettings& settings)
+	{
+		uint32_t state = 12345;
+
+		// 定数バッファ（64 〜 1024バイト）と、頂点データ（1 〜 16KB）
+		std::vector<size_t> constantSizes(kInputCount);
+		std::vector<size_t> vertexSizes(kInputCount);
+
+		for (size_t i = 0; i < kInputCount; i++)
+		{
+			constantSizes[i] = 64 * (1 + RandomUint(state, 16));
+			vertexSizes[i] = 1024 * (1 + RandomUint(state, 16));
+		}
+
+		std::vector<BenchmarkResult> results;
+		results.push_back(RunFrameBenchmark("AllocateConstantBuffers", settings, constantSizes, kUploadConstantBufferAlignment));
+		results.push_back(RunFrameBenchmark("AllocateVertexData", settings, vertexSizes, 16));
+
+		return results;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings{};
+	if (!ParseBenchmarkSettings(argc, argv, 1000000, settings))
+	{
+		return 2;
+	}
+
+	std::vector<BenchmarkResult> results = RunUploadRingBufferBenchmarks(settings);
+
+	return FinishBenchmark(settings, "none", results);
+}
@@ -0,0 +1,304 @@
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "Func/BindlessTable/BindlessTable.h"
+#include "TestCheck.h"
+
+/*
+	BindlessTableのテスト
+	GPUのバッファの代わりに、書き換えられた範囲だけを写す配列を持ち、CPU側と一致し続けるかを確かめる
+*/
+
+namespace
+{
+	// テストで置く要素（持ち主の番号と、書いた回数）
+	typedef struct TestElement
+	{
+		uint32_t owner;
+		uint32_t version;
+	}TestElement;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// スロットの要素を読む
+	/// </summary>
+	TestElement ReadElement(const BindlessTable& table, uint32_t slot)
+	{
+		TestElement element{};
+		std::memcpy(&element, GetBindlessSlotData(table, slot), sizeof(element));
+		return element;
+	}
+
+	/// <summary>
+	/// 書き換えられた範囲だけをGPUの代わりの配列に写す
+	/// </summary>
+	void UploadDirtyRanges(BindlessTable& table, uint32_t mergeGap, std::vector<uint8_t>& gpuData)
+	{
+		std::vector<BindlessDirtyRange> ranges;
+		CollectBindlessDirtyRanges(table, mergeGap, ranges);
+
+		for (size_t i = 0; i < ranges.size(); i++)
+		{
+			// 範囲は小さいスロットの順に、つなげる距離より離れて並び、GPUに置く範囲に収まる
+			CHECK(ranges[i].slotCount > 0);
+			CHECK(ranges[i].firstSlot + ranges[i].slotCount <= table.highWater);
+			if (i > 0)
+			{
+				CHECK(ranges[i - 1].firstSlot + ranges[i - 1].slotCount + mergeGap < ranges[i].firstSlot);
+			}
+
+			size_t offset = static_cast<size_t>(ranges[i].firstSlot) * table.elementSize;
+			std::memcpy(gpuData.data() + offset, table.data.data() + offset, static_cast<size_t>(ranges[i].slotCount) * table.elementSize);
+		}
+	}
+
+	/// <summary>
+	/// 小さい番号から使い、解放されたスロットを使い回す
+	/// </summary>
+	void TestAllocate()
+	{
+		BindlessTable table = MakeBindlessTable(sizeof(TestElement), 4);
+		CHECK(GetBindlessFragmentation(table) == 0.0f);
+
+		CHECK(AllocateBindlessSlot(table) == 0);
+		CHECK(AllocateBindlessSlot(table) == 1);
+		CHECK(AllocateBindlessSlot(table) == 2);
+		CHECK(AllocateBindlessSlot(table) == 3);
+		CHECK(AllocateBindlessSlot(table) == kBindlessInvalidSlot);
+		CHECK(table.usedCount == 4 && table.highWater == 4);
+
+		FreeBindlessSlot(table, 2);
+		FreeBindlessSlot(table, 0);
+		CHECK(table.usedCount == 2);
+		CHECK_NEAR(GetBindlessFragmentation(table), 0.5f, 1e-6f);
+
+		CHECK(AllocateBindlessSlot(table) == 0);
+		CHECK(AllocateBindlessSlot(table) == 2);
+		CHECK(AllocateBindlessSlot(table) == kBindlessInvalidSlot);
+
+		// 書いたものが読める
+		TestElement element{ 7 , 3 };
+		WriteBindlessSlot(table, 2, &element);
+		CHECK(ReadElement(table, 2).owner == 7 && ReadElement(table, 2).version == 3);
+	}
+
+	/// <summary>
+	/// 書き換えた範囲は、近いものをつなげて取り出し、取り出した後は空になる
+	/// </summary>
+	void TestDirtyRanges()
+	{
+		BindlessTable table = MakeBindlessTable(sizeof(TestElement), 200);
+		for (uint32_t i = 0; i < 200; i++)
+		{
+			AllocateBindlessSlot(table);
+		}
+
+		// 64スロットの境目をまたぐ範囲も1つになる
+		const uint32_t kWrittenSlots[] = { 3 , 4 , 5 , 8 , 62 , 63 , 64 , 65 , 130 , 199 };
+		TestElement element{};
+		for (uint32_t slot : kWrittenSlots)
+		{
+			WriteBindlessSlot(table, slot, &element);
+		}
+
+		std::vector<BindlessDirtyRange> ranges;
+		CollectBindlessDirtyRanges(table, 0, ranges);
+		CHECK(ranges.size() == 5);
+		if (ranges.size() == 5)
+		{
+			CHECK(ranges[0].firstSlot == 3 && ranges[0].slotCount == 3);
+			CHECK(ranges[1].firstSlot == 8 && ranges[1].slotCount == 1);
+			CHECK(ranges[2].firstSlot == 62 && ranges[2].slotCount == 4);
+			CHECK(ranges[3].firstSlot == 130 && ranges[3].slotCount == 1);
+			CHECK(ranges[4].firstSlot == 199 && ranges[4].slotCount == 1);
+		}
+
+		// 取り出した後は空
+		CollectBindlessDirtyRanges(table, 0, ranges);
+		CHECK(ranges.empty());
+
+		// 間が2つまでならつなげる
+		for (uint32_t slot : kWrittenSlots)
+		{
+			WriteBindlessSlot(table, slot, &element);
+		}
+		CollectBindlessDirtyRanges(table, 2, ranges);
+		CHECK(ranges.size() == 4);
+		if (ranges.size() == 4)
+		{
+			CHECK(ranges[0].firstSlot == 3 && ranges[0].slotCount == 6);
+			CHECK(ranges[1].firstSlot == 62 && ranges[1].slotCount == 4);
+		}
+
+		// 全部つなげる
+		for (uint32_t slot : kWrittenSlots)
+		{
+			WriteBindlessSlot(table, slot, &element);
+		}
+		CollectBindlessDirtyRanges(table, UINT32_MAX, ranges);
+		CHECK(ranges.size() == 1 && ranges[0].firstSlot == 3 && ranges[0].slotCount == 197);
+	}
+
+	/// <summary>
+	/// 詰めると、使っているスロットが先頭に並び、移動を付け替えれば同じ要素が読める
+	/// </summary>
+	void TestCompact()
+	{
+		BindlessTable table = MakeBindlessTable(sizeof(TestElement), 16);
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			uint32_t slot = AllocateBindlessSlot(table);
+			TestElement element{ i , 0 };
+			WriteBindlessSlot(table, slot, &element);
+		}
+
+		std::vector<BindlessDirtyRange> ranges;
+		CollectBindlessDirtyRanges(table, 0, ranges);
+
+		// 0, 2, 3, 7 を空ける（後ろの 9, 8, 6 が前に来る）
+		FreeBindlessSlot(table, 0);
+		FreeBindlessSlot(table, 2);
+		FreeBindlessSlot(table, 3);
+		FreeBindlessSlot(table, 7);
+
+		std::vector<BindlessSlotMove> moves;
+		CompactBindlessTable(table, moves);
+
+		CHECK(moves.size() == 3);
+		CHECK(table.highWater == 6 && table.usedCount == 6);
+		CHECK(GetBindlessFragmentation(table) == 0.0f);
+
+		// 移した先は空いていたスロット、移した元は詰めた後の範囲の外
+		for (const BindlessSlotMove& move : moves)
+		{
+			CHECK(move.to < 6 && move.from >= 6);
+			CHECK(ReadElement(table, move.to).owner == move.from);
+		}
+
+		// 移した先だけを送り直す
+		CollectBindlessDirtyRanges(table, 0, ranges);
+		uint32_t dirtyCount = 0;
+		for (const BindlessDirtyRange& range : ranges)
+		{
+			dirtyCount += range.slotCount;
+		}
+		CHECK(dirtyCount == moves.size());
+
+		// 詰めた後は、後ろから使う
+		CHECK(AllocateBindlessSlot(table) == 6);
+
+		// 空きがなければ何もしない
+		CompactBindlessTable(table, moves);
+		CHECK(moves.empty());
+	}
+
+	/// <summary>
+	/// ばらばらに確保、解放、書き込み、詰めるを繰り返しても、GPUの代わりの配列と一致する
+	/// </summary>
+	void TestRandom()
+	{
+		const uint32_t kCapacity = 300;
+		const uint32_t kMergeGap = 3;
+		BindlessTable table = MakeBindlessTable(sizeof(TestElement), kCapacity);
+		std::vector<uint8_t> gpuData(table.data.size(), 0);
+
+		// 持ち主の番号 -> スロットと、書いた回数
+		std::unordered_map<uint32_t, uint32_t> ownerSlots;
+		std::unordered_map<uint32_t, uint32_t> ownerVersions;
+		std::vector<uint32_t> owners;
+		uint32_t nextOwner = 0;
+
+		uint32_t state = 7;
+		for (int frame = 0; frame < 500; frame++)
+		{
+			uint32_t operationCount = RandomUint(state, 20);
+			for (uint32_t n = 0; n < operationCount; n++)
+			{
+				uint32_t operation = RandomUint(state, 4);
+
+				if (operation == 0 || owners.empty())
+				{
+					uint32_t slot = AllocateBindlessSlot(table);
+					if (slot == kBindlessInvalidSlot)
+					{
+						CHECK(table.usedCount == kCapacity);
+						continue;
+					}
+
+					uint32_t owner = nextOwner++;
+					TestElement element{ owner , 0 };
+					WriteBindlessSlot(table, slot, &element);
+					ownerSlots[owner] = slot;
+					ownerVersions[owner] = 0;
+					owners.push_back(owner);
+				}
+				else if (operation == 1)
+				{
+					size_t index = RandomUint(state, static_cast<uint32_t>(owners.size()));
+					uint32_t owner = owners[index];
+					owners[index] = owners.back();
+					owners.pop_back();
+
+					FreeBindlessSlot(table, ownerSlots[owner]);
+					ownerSlots.erase(owner);
+				}
+				else
+				{
+					uint32_t owner = owners[RandomUint(state, static_cast<uint32_t>(owners.size()))];
+					TestElement element{ owner , ++ownerVersions[owner] };
+					WriteBindlessSlot(table, ownerSlots[owner], &element);
+				}
+			}
+
+			// 空きが多ければ詰めて、スロット番号を付け替える
+			if (GetBindlessFragmentation(table) > 0.5f)
+			{
+				std::vector<BindlessSlotMove> moves;
+				CompactBindlessTable(table, moves);
+
+				std::unordered_map<uint32_t, uint32_t> slotOwners;
+				for (const auto& [owner, slot] : ownerSlots)
+				{
+					slotOwners[slot] = owner;
+				}
+				for (const BindlessSlotMove& move : moves)
+				{
+					CHECK(slotOwners.count(move.from) == 1);
+					ownerSlots[slotOwners[move.from]] = move.to;
+				}
+				CHECK(table.highWater == table.usedCount);
+			}
+
+			UploadDirtyRanges(table, kMergeGap, gpuData);
+
+			// 使っている全てのスロットで、GPUの代わりの配列に最新の要素がある
+			CHECK(table.usedCount == ownerSlots.size());
+			for (const auto& [owner, slot] : ownerSlots)
+			{
+				TestElement element{};
+				std::memcpy(&element, gpuData.data() + static_cast<size_t>(slot) * table.elementSize, sizeof(element));
+				CHECK(slot < table.highWater);
+				CHECK(element.owner == owner && element.version == ownerVersions[owner]);
+			}
+		}
+	}
+}
+
+int main()
+{
+	TestAllocate();
+	TestDirtyRanges();
+	TestCompact();
+	TestRandom();
+
+	return FinishTest("BindlessTableTest");
+}
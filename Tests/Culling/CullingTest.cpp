@@ -0,0 +1,190 @@
+#include <cstdint>
+#include <vector>
+#include "Func/Culling/Culling.h"
+#include "Func/Matrix/Matrix.h"
+#include "Func/Vector/Vector.h"
+#include "TestCheck.h"
+
+/*
+	視錐台カリングのテスト
+	CullingTestはSIMD版、CullingScalarTestはMATH_NO_SIMDのスカラー版で、同じ確認をする
+*/
+
+namespace
+{
+	/// <summary>
+	/// 再現できる乱数（-range 〜 range）
+	/// </summary>
+	float RandomFloat(uint32_t& state, float range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+	}
+
+	/// <summary>
+	/// テストに使うカメラ（(0,0,-10)から+Zを見る）のビュープロジェクション行列
+	/// </summary>
+	Matrix4x4 MakeTestViewProjection()
+	{
+		Matrix4x4 viewMatrix = MakeLookAtMatrix({ 0.0f , 0.0f , -10.0f }, { 0.0f , 0.0f , 0.0f }, { 0.0f , 1.0f , 0.0f });
+		return viewMatrix * MakePerspectiveFovMatrix(0.9f, 16.0f / 9.0f, 0.1f, 100.0f);
+	}
+
+	/// <summary>
+	/// 点がクリップ空間の範囲（-w <= x,y <= w , 0 <= z <= w）に入るか（比べる相手）
+	/// </summary>
+	/// <param name="margin">境界からこれより近い点は、どちらとも決めない（0を返す）</param>
+	/// <returns>入るなら1、出るなら-1、境界に近ければ0</returns>
+	int ClassifyPointReference(const Vector3& point, const Matrix4x4& m, float margin)
+	{
+		float clip[4];
+		for (int j = 0; j < 4; j++)
+		{
+			clip[j] = point.x * m.m[0][j] + point.y * m.m[1][j] + point.z * m.m[2][j] + m.m[3][j];
+		}
+
+		float distances[6] = { clip[3] + clip[0] , clip[3] - clip[0] , clip[3] + clip[1] , clip[3] - clip[1] , clip[2] , clip[3] - clip[2] };
+
+		float minDistance = distances[0];
+		for (float distance : distances)
+		{
+			minDistance = (std::min)(minDistance, distance);
+		}
+
+		if (std::fabs(minDistance) < margin)
+		{
+			return 0;
+		}
+
+		return minDistance > 0.0f ? 1 : -1;
+	}
+
+	/// <summary>
+	/// 取り出した平面は、法線が単位ベクトルで、内側を表にしている
+	/// </summary>
+	void TestFrustumPlanes()
+	{
+		Frustum frustum = MakeFrustum(MakeTestViewProjection());
+
+		for (const Plane& plane : frustum.planes)
+		{
+			CHECK_NEAR(Length(plane.normal), 1.0f, 1e-5f);
+			CHECK(Dot(plane.normal, { 0.0f , 0.0f , 5.0f }) + plane.distance > 0.0f);
+		}
+
+		// 近平面は z = -9.9、遠平面は z = 90 で、どちらも視線に垂直
+		CHECK_NEAR(frustum.planes[4].normal.z, 1.0f, 1e-5f);
+		CHECK_NEAR(frustum.planes[4].distance, 9.9f, 1e-3f);
+		CHECK_NEAR(frustum.planes[5].normal.z, -1.0f, 1e-5f);
+		CHECK_NEAR(frustum.planes[5].distance, 90.0f, 1e-2f);
+	}
+
+	/// <summary>
+	/// 点（半径0の球）はクリップ空間の範囲と同じ判定になる
+	/// </summary>
+	void TestPointsMatchClipSpace()
+	{
+		Matrix4x4 viewProjection = MakeTestViewProjection();
+		Frustum frustum = MakeFrustum(viewProjection);
+
+		uint32_t state = 1;
+		int insideCount = 0;
+		for (int n = 0; n < 2000; n++)
+		{
+			Vector3 point = { RandomFloat(state, 60.0f) , RandomFloat(state, 40.0f) , RandomFloat(state, 60.0f) + 30.0f };
+
+			int expected = ClassifyPointReference(point, viewProjection, 1e-2f);
+			if (expected == 0)
+			{
+				continue;
+			}
+
+			CHECK(IsVisible(frustum, Sphere{ point , 0.0f }) == (expected > 0));
+			CHECK(IsVisible(frustum, AABB{ point , point }) == (expected > 0));
+			insideCount += expected > 0 ? 1 : 0;
+		}
+
+		// 中と外の両方を確かめている
+		CHECK(insideCount > 100 && insideCount < 1900);
+	}
+
+	/// <summary>
+	/// 一部でも入っていれば見える
+	/// </summary>
+	void TestPartiallyVisible()
+	{
+		Frustum frustum = MakeFrustum(MakeTestViewProjection());
+
+		// カメラの後ろ
+		CHECK(!IsVisible(frustum, Sphere{ { 0.0f , 0.0f , -20.0f } , 5.0f }));
+		CHECK(!IsVisible(frustum, AABB{ { -1.0f , -1.0f , -30.0f } , { 1.0f , 1.0f , -20.0f } }));
+
+		// 遠平面をまたぐ
+		CHECK(IsVisible(frustum, Sphere{ { 0.0f , 0.0f , 92.0f } , 3.0f }));
+		CHECK(!IsVisible(frustum, Sphere{ { 0.0f , 0.0f , 95.0f } , 3.0f }));
+
+		// 全ての頂点が外にあっても、視錐台を貫くAABB
+		CHECK(IsVisible(frustum, AABB{ { -1000.0f , -0.5f , 10.0f } , { 1000.0f , 0.5f , 11.0f } }));
+
+		// カメラを包むAABB
+		CHECK(IsVisible(frustum, AABB{ { -50.0f , -50.0f , -50.0f } , { 50.0f , 50.0f , 50.0f } }));
+	}
+
+	/// <summary>
+	/// まとめてカリングしたものは、1つずつ判定したものと同じ番号を同じ順に返す（4つずつ処理する部分と、余りの部分の両方）
+	/// </summary>
+	void TestBatchMatchesSingle()
+	{
+		Frustum frustum = MakeFrustum(MakeTestViewProjection());
+
+		uint32_t state = 2;
+		for (size_t count : { size_t(0) , size_t(3) , size_t(4) , size_t(17) , size_t(1000) })
+		{
+			std::vector<Sphere> spheres(count);
+			std::vector<AABB> aabbs(count);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				Vector3 center = { RandomFloat(state, 80.0f) , RandomFloat(state, 50.0f) , RandomFloat(state, 80.0f) + 20.0f };
+				spheres[i] = Sphere{ center , std::fabs(RandomFloat(state, 5.0f)) };
+
+				Vector3 extent = { std::fabs(RandomFloat(state, 5.0f)) , std::fabs(RandomFloat(state, 5.0f)) , std::fabs(RandomFloat(state, 5.0f)) };
+				aabbs[i] = AABB{ Subtract(center, extent) , Add(center, extent) };
+			}
+
+			std::vector<uint32_t> expectedSpheres;
+			std::vector<uint32_t> expectedAABBs;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (IsVisible(frustum, spheres[i]))
+				{
+					expectedSpheres.push_back(i);
+				}
+				if (IsVisible(frustum, aabbs[i]))
+				{
+					expectedAABBs.push_back(i);
+				}
+			}
+
+			std::vector<uint32_t> visibleIndices(count);
+			size_t visibleCount = CullSpheres(frustum, spheres, visibleIndices);
+			visibleIndices.resize(visibleCount);
+			CHECK(visibleIndices == expectedSpheres);
+
+			visibleIndices.assign(count, 0);
+			visibleCount = CullAABBs(frustum, aabbs, visibleIndices);
+			visibleIndices.resize(visibleCount);
+			CHECK(visibleIndices == expectedAABBs);
+		}
+	}
+}
+
+int main()
+{
+	TestFrustumPlanes();
+	TestPointsMatchClipSpace();
+	TestPartiallyVisible();
+	TestBatchMatchesSingle();
+
+	return FinishTest("CullingTest");
+}
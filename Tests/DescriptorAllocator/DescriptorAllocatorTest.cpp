@@ -0,0 +1,210 @@
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "Func/DescriptorAllocator/DescriptorAllocator.h"
+#include "TestCheck.h"
+
+/*
+	DescriptorAllocatorのテスト
+	番号ごとに誰が使っているかを別に覚えておき、重ならないこと、解放すると元に戻ることを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// 空きは番号順に並び、隣り合うものは結合されている
+	/// </summary>
+	void CheckFreeRanges(const DescriptorAllocator& allocator)
+	{
+		for (size_t i = 1; i < allocator.freeRanges.size(); i++)
+		{
+			const DescriptorRange& previous = allocator.freeRanges[i - 1];
+			CHECK(previous.start + previous.count < allocator.freeRanges[i].start);
+		}
+		for (const DescriptorRange& freeRange : allocator.freeRanges)
+		{
+			CHECK(freeRange.count > 0);
+		}
+	}
+
+	/// <summary>
+	/// 使い続ける領域の確保と解放
+	/// </summary>
+	void TestPersistent()
+	{
+		DescriptorAllocator allocator = MakeDescriptorAllocator(16, 0);
+		CHECK(GetFreePersistentDescriptorCount(allocator) == 16);
+
+		DescriptorRange a = AllocatePersistentDescriptors(allocator, 4);
+		DescriptorRange b = AllocatePersistentDescriptors(allocator, 4);
+		DescriptorRange c = AllocatePersistentDescriptors(allocator, 4);
+		CHECK(a.start == 0 && b.start == 4 && c.start == 8 && c.count == 4);
+		CHECK(AllocatePersistentDescriptors(allocator, 0).count == 0);
+
+		// 間を空けると、連続していない空きには入らない
+		FreePersistentDescriptors(allocator, a);
+		FreePersistentDescriptors(allocator, c);
+		CHECK(GetFreePersistentDescriptorCount(allocator) == 12);
+		CHECK(allocator.freeRanges.size() == 2);
+		CHECK(AllocatePersistentDescriptors(allocator, 9).count == 0);
+
+		// 小さいものは、番号の小さい空きから
+		DescriptorRange d = AllocatePersistentDescriptors(allocator, 2);
+		CHECK(d.start == 0 && d.count == 2);
+		FreePersistentDescriptors(allocator, d);
+
+		// 真ん中を解放すると、3つの空きが1つになる
+		FreePersistentDescriptors(allocator, b);
+		CHECK(allocator.freeRanges.size() == 1);
+		CHECK(allocator.freeRanges[0].start == 0 && allocator.freeRanges[0].count == 16);
+		CHECK(AllocatePersistentDescriptors(allocator, 16).count == 16);
+	}
+
+	/// <summary>
+	/// ばらばらに確保と解放を繰り返しても、重ならず、数が合う
+	/// </summary>
+	void TestPersistentRandom()
+	{
+		const uint32_t kCapacity = 128;
+		DescriptorAllocator allocator = MakeDescriptorAllocator(kCapacity, 64);
+
+		// 番号ごとの持ち主（-1なら空き）
+		std::vector<int> owners(kCapacity, -1);
+		std::vector<DescriptorRange> allocated;
+
+		uint32_t state = 3;
+		for (int n = 0; n < 5000; n++)
+		{
+			if (allocated.empty() || RandomUint(state, 3) != 0)
+			{
+				DescriptorRange range = AllocatePersistentDescriptors(allocator, 1 + RandomUint(state, 8));
+				if (range.count == 0)
+				{
+					continue;
+				}
+
+				CHECK(range.start + range.count <= kCapacity);
+				for (uint32_t i = range.start; i < range.start + range.count && i < kCapacity; i++)
+				{
+					CHECK(owners[i] == -1);
+					owners[i] = n;
+				}
+				allocated.push_back(range);
+			}
+			else
+			{
+				size_t index = RandomUint(state, static_cast<uint32_t>(allocated.size()));
+				DescriptorRange range = allocated[index];
+				allocated.erase(allocated.begin() + index);
+
+				FreePersistentDescriptors(allocator, range);
+				for (uint32_t i = range.start; i < range.start + range.count; i++)
+				{
+					owners[i] = -1;
+				}
+			}
+
+			uint32_t freeCount = 0;
+			for (int owner : owners)
+			{
+				freeCount += owner == -1 ? 1 : 0;
+			}
+			CHECK(GetFreePersistentDescriptorCount(allocator) == freeCount);
+			CheckFreeRanges(allocator);
+		}
+
+		// 全て解放すれば1つの空きに戻る
+		for (const DescriptorRange& range : allocated)
+		{
+			FreePersistentDescriptors(allocator, range);
+		}
+		CHECK(allocator.freeRanges.size() == 1 && allocator.freeRanges[0].count == kCapacity);
+	}
+
+	/// <summary>
+	/// フレームごとの領域は、使い続ける領域の後ろにあり、GPUが使い終わるまで上書きしない
+	/// </summary>
+	void TestFrameDescriptors()
+	{
+		const uint32_t kPersistentCount = 32;
+		const uint32_t kFrameCount = 64;
+		const uint64_t kFrameLatency = 2;
+
+		DescriptorAllocator allocator = MakeDescriptorAllocator(kPersistentCount, kFrameCount);
+
+		// GPUが使っているかもしれない範囲と、そのSignalの値
+		typedef struct InFlightRange
+		{
+			uint64_t fenceValue;
+			DescriptorRange range;
+		}InFlightRange;
+		std::deque<InFlightRange> inFlight;
+
+		uint32_t state = 4;
+		uint32_t failedCount = 0;
+
+		for (uint64_t frame = 1; frame <= 300; frame++)
+		{
+			uint64_t completedValue = frame > kFrameLatency ? frame - kFrameLatency : 0;
+			ReclaimDescriptorFrames(allocator, completedValue);
+			while (!inFlight.empty() && inFlight.front().fenceValue <= completedValue)
+			{
+				inFlight.pop_front();
+			}
+
+			uint32_t tableCount = 1 + RandomUint(state, 4);
+			for (uint32_t t = 0; t < tableCount; t++)
+			{
+				DescriptorRange range = AllocateFrameDescriptors(allocator, 1 + RandomUint(state, 12));
+				if (range.count == 0)
+				{
+					failedCount++;
+					continue;
+				}
+
+				// フレームごとの領域の中で連続している
+				CHECK(range.start >= kPersistentCount);
+				CHECK(range.start + range.count <= kPersistentCount + kFrameCount);
+
+				// GPUが使っている範囲と重ならない
+				for (const InFlightRange& other : inFlight)
+				{
+					bool isOverlapped = range.start < other.range.start + other.range.count && other.range.start < range.start + range.count;
+					CHECK(!isOverlapped);
+				}
+
+				inFlight.push_back(InFlightRange{ frame , range });
+			}
+
+			FinishDescriptorFrame(allocator, frame);
+		}
+
+		CHECK(failedCount > 0 && failedCount < 300);
+
+		// 全体より大きいものは確保しない
+		CHECK(AllocateFrameDescriptors(allocator, kFrameCount + 1).count == 0);
+
+		// 全て使い終われば、全体を1回で確保できる
+		ReclaimDescriptorFrames(allocator, UINT64_MAX);
+		DescriptorRange whole = AllocateFrameDescriptors(allocator, kFrameCount);
+		CHECK(whole.start == kPersistentCount && whole.count == kFrameCount);
+	}
+}
+
+int main()
+{
+	TestPersistent();
+	TestPersistentRandom();
+	TestFrameDescriptors();
+
+	return FinishTest("DescriptorAllocatorTest");
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Func/FileWatcher/FileWatcher.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	FileWatcherのテスト
+	Linuxではinotifyで見るファイルと、フォルダがなくて時刻を見比べるファイルの両方を確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 変更に含まれるか
+	/// </summary>
+	bool Contains(const std::vector<std::filesystem::path>& paths, const std::filesystem::path& path)
+	{
+		return std::find(paths.begin(), paths.end(), path) != paths.end();
+	}
+
+	/// <summary>
+	/// 書き換え、名前を付け替えての保存、削除を知らせる
+	/// </summary>
+	void TestNotify(const std::filesystem::path& root)
+	{
+		std::filesystem::path shader = root / "Shader.hlsl";
+		std::filesystem::path include = root / "Common.hlsli";
+		std::filesystem::path other = root / "Other.txt";
+		WriteTestFile(shader, "a");
+		WriteTestFile(include, "a");
+		WriteTestFile(other, "a");
+
+		FileWatcher watcher = CreateFileWatcher(0.0);
+		WatchFile(watcher, shader);
+		WatchFile(watcher, include);
+		WatchFile(watcher, include);
+		CHECK(watcher.files.size() == 2);
+
+		// 何もしなければ何も返さない
+		CHECK(PollFileWatcher(watcher).empty());
+
+		// 書き換え（見張っていないファイルは返さない、同じファイルは1つにまとめる）
+		WriteTestFile(shader, "b");
+		WriteTestFile(shader, "c");
+		WriteTestFile(other, "b");
+		std::vector<std::filesystem::path> changed = PollFileWatcher(watcher);
+		CHECK(changed.size() == 1 && Contains(changed, shader));
+		CHECK(PollFileWatcher(watcher).empty());
+
+		// 別の名前で書いてから付け替える（保存するときのエディタ）
+		WriteTestFile(root / "Common.hlsli.swp", "b");
+		std::filesystem::rename(root / "Common.hlsli.swp", include);
+		changed = PollFileWatcher(watcher);
+		CHECK(changed.size() == 1 && Contains(changed, include));
+
+		// 削除と、作り直し
+		std::filesystem::remove(include);
+		CHECK(Contains(PollFileWatcher(watcher), include));
+		WriteTestFile(include, "c");
+		CHECK(Contains(PollFileWatcher(watcher), include));
+
+		ReleaseFileWatcher(watcher);
+		CHECK(watcher.files.empty());
+	}
+
+	/// <summary>
+	/// inotifyの知らせがあふれたら、そのとき失われた書き換えも含めて、見張っているファイルを全て知らせる
+	/// </summary>
+	void TestNotifyOverflow(const std::filesystem::path& root)
+	{
+#ifdef __linux__
+		// ためておける知らせの数（読めなければ確かめない）
+		std::ifstream limitFile("/proc/sys/fs/inotify/max_queued_events");
+		uint32_t maxQueuedEvents = 0;
+		if (!(limitFile >> maxQueuedEvents) || maxQueuedEvents > 1000000)
+		{
+			return;
+		}
+
+		std::filesystem::path shader = root / "Overflow/Shader.hlsl";
+		std::filesystem::path include = root / "Overflow/Common.hlsli";
+		std::filesystem::path other = root / "Overflow/Other.txt";
+		WriteTestFile(shader, "a");
+		WriteTestFile(include, "a");
+		WriteTestFile(other, "a");
+
+		FileWatcher watcher = CreateFileWatcher(60000.0);
+		WatchFile(watcher, shader);
+		WatchFile(watcher, include);
+		CHECK(watcher.files[0].watchHandle >= 0);
+
+		// 見張っていないファイルの名前の付け替えで、ためておける数より多く知らせる（1回で2つ知らせる）
+		for (uint32_t i = 0; i < maxQueuedEvents / 2 + 16; i++)
+		{
+			std::filesystem::rename(other, root / "Overflow/Other.bak");
+			std::filesystem::rename(root / "Overflow/Other.bak", other);
+		}
+
+		// あふれた後の書き換えの知らせは失われる
+		WriteTestFile(shader, "b");
+
+		std::vector<std::filesystem::path> changed = PollFileWatcher(watcher);
+		CHECK(changed.size() == 2 && Contains(changed, shader) && Contains(changed, include));
+		CHECK(watcher.files[0].lastWriteTime == std::filesystem::last_write_time(shader));
+
+		// 読み切った後は、また1つずつ知らせる
+		CHECK(PollFileWatcher(watcher).empty());
+		WriteTestFile(include, "b");
+		changed = PollFileWatcher(watcher);
+		CHECK(changed.size() == 1 && Contains(changed, include));
+
+		ReleaseFileWatcher(watcher);
+#else
+		(void)root;
+#endif
+	}
+
+	/// <summary>
+	/// 見張れないファイルは、間隔をあけて更新時刻を見比べる
+	/// </summary>
+	void TestPolling(const std::filesystem::path& root)
+	{
+		// まだフォルダがないので、フォルダは見張れない
+		std::filesystem::path path = root / "Later/Shader.hlsl";
+
+		FileWatcher watcher = CreateFileWatcher(0.0);
+		WatchFile(watcher, path);
+		CHECK(watcher.files.size() == 1 && watcher.files[0].watchHandle < 0);
+		CHECK(PollFileWatcher(watcher).empty());
+
+		// できたら知らせる
+		WriteTestFile(path, "a");
+		CHECK(Contains(PollFileWatcher(watcher), path));
+		CHECK(PollFileWatcher(watcher).empty());
+
+		// 更新時刻が変われば知らせる
+		std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+		CHECK(Contains(PollFileWatcher(watcher), path));
+
+		// 間隔があくまでは見比べない
+		FileWatcher slowWatcher = CreateFileWatcher(60000.0);
+		WatchFile(slowWatcher, path);
+		std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+		CHECK(PollFileWatcher(slowWatcher).empty());
+
+		ReleaseFileWatcher(watcher);
+		ReleaseFileWatcher(slowWatcher);
+	}
+}
+
+int main()
+{
+	std::filesystem::path root = MakeTestDirectory("FileWatcher");
+
+	TestNotify(root);
+	TestNotifyOverflow(root);
+	TestPolling(root);
+
+	std::error_code error;
+	std::filesystem::remove_all(root, error);
+
+	return FinishTest("FileWatcherTest");
+}
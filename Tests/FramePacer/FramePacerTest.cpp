@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Func/FramePacer/FramePacer.h"
+#include "TestCheck.h"
+
+/*
+	FramePacerのテスト
+	GPUの代わりに、Fenceの値を遅れて進めるだけの処理で、待つ値と処理中のフレーム数を確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 待つ値は、同じスロットを前に使ったフレームのSignalの値になる
+	/// </summary>
+	void TestWaitValues()
+	{
+		for (uint32_t frameLatency = 1; frameLatency <= kMaxFrameLatency; frameLatency++)
+		{
+			const uint64_t kInitialFenceValue = 7;
+			FramePacer pacer = MakeFramePacer(frameLatency, kInitialFenceValue);
+
+			std::vector<uint64_t> signaledValues;
+			for (uint32_t frame = 0; frame < 20; frame++)
+			{
+				uint64_t waitValue = GetFramePacerWaitValue(pacer);
+
+				// 初めのframeLatencyフレームは待たない（初期値はもう終わっている）
+				if (frame < frameLatency)
+				{
+					CHECK(waitValue == kInitialFenceValue);
+				}
+				else
+				{
+					CHECK(waitValue == signaledValues[frame - frameLatency]);
+				}
+
+				CHECK(pacer.slotIndex == frame % frameLatency);
+
+				uint64_t signalValue = AdvanceFramePacer(pacer);
+				CHECK(signalValue == kInitialFenceValue + frame + 1);
+				CHECK(pacer.lastSignaledValue == signalValue);
+				signaledValues.push_back(signalValue);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 待った後は、GPUが遅くても処理中のフレームがframeLatencyを超えない
+	/// </summary>
+	void TestFramesInFlight()
+	{
+		for (uint32_t frameLatency = 1; frameLatency <= kMaxFrameLatency; frameLatency++)
+		{
+			FramePacer pacer = MakeFramePacer(frameLatency, 0);
+
+			// GPUが終えたFenceの値と、待った回数
+			uint64_t completedValue = 0;
+			uint32_t waitCount = 0;
+			uint32_t maxInFlight = 0;
+
+			for (uint32_t frame = 0; frame < 100; frame++)
+			{
+				// GPUは3フレームに1回しか進まない
+				if (frame % 3 == 0 && completedValue < pacer.lastSignaledValue)
+				{
+					completedValue++;
+				}
+
+				// 待つ（ここではGPUを待つ値まで進めたことにする）
+				uint64_t waitValue = GetFramePacerWaitValue(pacer);
+				if (completedValue < waitValue)
+				{
+					completedValue = waitValue;
+					waitCount++;
+				}
+
+				// このスロットを前に使ったフレームは終わっている
+				CHECK(completedValue >= waitValue);
+
+				AdvanceFramePacer(pacer);
+
+				uint32_t inFlight = static_cast<uint32_t>(pacer.lastSignaledValue - completedValue);
+				maxInFlight = (std::max)(maxInFlight, inFlight);
+				CHECK(inFlight <= frameLatency);
+			}
+
+			// GPUが遅いので、先に進めるのはちょうどframeLatencyフレームまで
+			CHECK(maxInFlight == frameLatency);
+			CHECK(waitCount > 0);
+		}
+	}
+}
+
+int main()
+{
+	TestWaitValues();
+	TestFramesInFlight();
+
+	return FinishTest("FramePacerTest");
+}
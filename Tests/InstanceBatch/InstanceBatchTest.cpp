@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Func/InstanceBatch/InstanceBatch.h"
+#include "TestCheck.h"
+
+/*
+	InstanceBatchのテスト
+	std::stable_sortで並べた結果と比べて、バッチの区切りとインスタンスの並びを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// ばらばらなメッシュとマテリアルのオブジェクトを作る（オブジェクトの番号は並び順と変えておく）
+	/// </summary>
+	std::vector<InstanceDrawItem> MakeRandomItems(uint32_t count, uint32_t meshCount, uint32_t materialCount, uint32_t& state)
+	{
+		std::vector<InstanceDrawItem> items(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			items[i] = InstanceDrawItem{ RandomUint(state, meshCount) , RandomUint(state, materialCount) , count * 3 - i };
+		}
+		return items;
+	}
+
+	/// <summary>
+	/// std::stable_sortで並べた結果と、バッチの区切りが一致する
+	/// </summary>
+	void CheckBatches(const std::vector<InstanceDrawItem>& items, uint32_t maxInstancesPerBatch)
+	{
+		std::vector<uint32_t> instanceObjectIndices;
+		std::vector<InstanceBatch> batches;
+		BuildInstanceBatches(items, maxInstancesPerBatch, instanceObjectIndices, batches);
+
+		// メッシュ、マテリアルの順に並べる（同じキーの中は渡された順番）
+		std::vector<InstanceDrawItem> expected = items;
+		std::stable_sort(expected.begin(), expected.end(), [](const InstanceDrawItem& a, const InstanceDrawItem& b)
+			{
+				return a.meshIndex != b.meshIndex ? a.meshIndex < b.meshIndex : a.materialIndex < b.materialIndex;
+			});
+
+		CHECK(instanceObjectIndices.size() == items.size());
+		for (size_t i = 0; i < expected.size() && i < instanceObjectIndices.size(); i++)
+		{
+			CHECK(instanceObjectIndices[i] == expected[i].objectIndex);
+		}
+
+		// バッチは隙間なく並び、中身は全て同じメッシュとマテリアル
+		uint32_t nextInstance = 0;
+		for (size_t b = 0; b < batches.size(); b++)
+		{
+			const InstanceBatch& batch = batches[b];
+			CHECK(batch.firstInstance == nextInstance);
+			CHECK(batch.instanceCount >= 1 && batch.instanceCount <= maxInstancesPerBatch);
+
+			for (uint32_t i = batch.firstInstance; i < batch.firstInstance + batch.instanceCount && i < expected.size(); i++)
+			{
+				CHECK(expected[i].meshIndex == batch.meshIndex && expected[i].materialIndex == batch.materialIndex);
+			}
+
+			// 前のバッチと同じキーなら、前のバッチは最大数まで詰まっている
+			if (b > 0 && batches[b - 1].meshIndex == batch.meshIndex && batches[b - 1].materialIndex == batch.materialIndex)
+			{
+				CHECK(batches[b - 1].instanceCount == maxInstancesPerBatch);
+			}
+
+			nextInstance += batch.instanceCount;
+		}
+		CHECK(nextInstance == items.size());
+	}
+
+	/// <summary>
+	/// 小さな例で、まとめ方を直接確かめる
+	/// </summary>
+	void TestSmall()
+	{
+		std::vector<InstanceDrawItem> items =
+		{
+			{ 1 , 0 , 10 },
+			{ 0 , 1 , 11 },
+			{ 1 , 0 , 12 },
+			{ 0 , 0 , 13 },
+			{ 0 , 1 , 14 },
+			{ 1 , 0 , 15 },
+		};
+
+		std::vector<uint32_t> instanceObjectIndices;
+		std::vector<InstanceBatch> batches;
+		BuildInstanceBatches(items, 2, instanceObjectIndices, batches);
+
+		CHECK((instanceObjectIndices == std::vector<uint32_t>{ 13 , 11 , 14 , 10 , 12 , 15 }));
+		CHECK(batches.size() == 4);
+		if (batches.size() == 4)
+		{
+			CHECK(batches[0].meshIndex == 0 && batches[0].materialIndex == 0 && batches[0].firstInstance == 0 && batches[0].instanceCount == 1);
+			CHECK(batches[1].meshIndex == 0 && batches[1].materialIndex == 1 && batches[1].firstInstance == 1 && batches[1].instanceCount == 2);
+			CHECK(batches[2].meshIndex == 1 && batches[2].materialIndex == 0 && batches[2].firstInstance == 3 && batches[2].instanceCount == 2);
+			CHECK(batches[3].meshIndex == 1 && batches[3].materialIndex == 0 && batches[3].firstInstance == 5 && batches[3].instanceCount == 1);
+		}
+
+		// 最大数が1ならまとめない
+		BuildInstanceBatches(items, 1, instanceObjectIndices, batches);
+		CHECK(batches.size() == items.size());
+
+		// 空なら前の結果も消える
+		BuildInstanceBatches({}, 4, instanceObjectIndices, batches);
+		CHECK(batches.empty() && instanceObjectIndices.empty());
+	}
+
+	/// <summary>
+	/// キーの上位（メッシュ）と下位（マテリアル）の両方が大きい値でも正しく並ぶ
+	/// </summary>
+	void TestLargeIndices()
+	{
+		std::vector<InstanceDrawItem> items =
+		{
+			{ 0xFFFFFFFFu , 0 , 0 },
+			{ 0 , 0xFFFFFFFFu , 1 },
+			{ 0x10000u , 0x100u , 2 },
+			{ 0 , 0xFFFFFFFFu , 3 },
+			{ 0x100u , 0x10000u , 4 },
+		};
+		CheckBatches(items, 8);
+	}
+
+	/// <summary>
+	/// ばらばらなオブジェクトを、いろいろな最大数でまとめる
+	/// </summary>
+	void TestRandom()
+	{
+		uint32_t state = 5;
+		const uint32_t kMaxInstances[] = { 1 , 3 , 64 , 100000 };
+
+		for (uint32_t count : { 1u , 7u , 1000u , 20000u })
+		{
+			std::vector<InstanceDrawItem> items = MakeRandomItems(count, 16, 8, state);
+			for (uint32_t maxInstancesPerBatch : kMaxInstances)
+			{
+				CheckBatches(items, maxInstancesPerBatch);
+			}
+		}
+
+		// 最大数がなければ、バッチの数はメッシュとマテリアルの組み合わせの数になる
+		std::vector<InstanceDrawItem> items = MakeRandomItems(10000, 16, 8, state);
+		std::vector<uint32_t> instanceObjectIndices;
+		std::vector<InstanceBatch> batches;
+		BuildInstanceBatches(items, UINT32_MAX, instanceObjectIndices, batches);
+		CHECK(batches.size() == 16 * 8);
+	}
+}
+
+int main()
+{
+	TestSmall();
+	TestLargeIndices();
+	TestRandom();
+
+	return FinishTest("InstanceBatchTest");
+}
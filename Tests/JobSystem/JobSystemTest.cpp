@@ -0,0 +1,158 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "Func/JobSystem/JobSystem.h"
+#include "Func/Matrix/Matrix.h"
+#include "TestCheck.h"
+
+/*
+	JobSystemのテスト
+	全ての仕事が1回ずつ行われるか、スレッドを使い回しているか、入れ子や同時の呼び出しで止まらないかを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 全ての番号が1回ずつ処理される
+	/// </summary>
+	void TestEveryJobRunsOnce(JobSystem* system)
+	{
+		for (size_t jobCount : { size_t(0) , size_t(1) , size_t(2) , size_t(7) , size_t(1000) })
+		{
+			std::vector<std::atomic<uint32_t>> counts(jobCount);
+			RunJobs(system, jobCount, [&](size_t jobIndex) { counts[jobIndex].fetch_add(1); });
+
+			for (size_t i = 0; i < jobCount; i++)
+			{
+				CHECK(counts[i].load() == 1);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 何度呼んでも、作ったスレッドと呼び出したスレッドしか使わない
+	/// </summary>
+	void TestWorkersAreReused()
+	{
+		JobSystem* system = CreateJobSystem(3);
+
+		std::mutex mutex;
+		std::set<std::thread::id> threadIds;
+
+		for (int n = 0; n < 200; n++)
+		{
+			RunJobs(system, 16, [&](size_t)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					threadIds.insert(std::this_thread::get_id());
+				});
+		}
+
+		CHECK(threadIds.size() <= 4);
+		CHECK(threadIds.count(std::this_thread::get_id()) == 1);
+
+		ReleaseJobSystem(system);
+	}
+
+	/// <summary>
+	/// 仕事の中から配り直しても止まらない（その場で順に処理される）
+	/// </summary>
+	void TestNestedRunJobs(JobSystem* system)
+	{
+		std::atomic<uint32_t> innerCount = 0;
+
+		RunJobs(system, 8, [&](size_t)
+			{
+				RunJobs(system, 8, [&](size_t) { innerCount.fetch_add(1); });
+			});
+
+		CHECK(innerCount.load() == 64);
+	}
+
+	/// <summary>
+	/// 別々のスレッドから同時に配っても、どちらも全て処理される
+	/// </summary>
+	void TestConcurrentSubmitters(JobSystem* system)
+	{
+		std::atomic<uint32_t> counts[2] = { 0 , 0 };
+
+		auto submit = [&](int submitter)
+			{
+				for (int n = 0; n < 100; n++)
+				{
+					RunJobs(system, 32, [&](size_t) { counts[submitter].fetch_add(1); });
+				}
+			};
+
+		std::thread other(submit, 1);
+		submit(0);
+		other.join();
+
+		CHECK(counts[0].load() == 3200);
+		CHECK(counts[1].load() == 3200);
+	}
+
+	/// <summary>
+	/// スレッドに分ける行列の関数が、分けずに計算したものと同じになる
+	/// </summary>
+	void TestParallelMath()
+	{
+		const size_t kCount = 50000;
+
+		std::vector<Transform3D> transforms(kCount);
+		std::vector<Vector3> points(kCount);
+		for (size_t i = 0; i < kCount; i++)
+		{
+			float f = static_cast<float>(i);
+			transforms[i] = { { 1.0f , 1.0f + f * 1e-5f , 1.0f } , { f * 1e-3f , 0.0f , f * 2e-3f } , { f , -f , 0.5f * f } };
+			points[i] = { f , 1.0f , -f };
+		}
+
+		Matrix4x4 viewProjectionMatrix = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+		std::vector<Matrix4x4> matrices(kCount);
+		MakeWorldViewProjectionMatrices(transforms, viewProjectionMatrix, matrices);
+
+		Matrix4x4 m = MakeAffineMatrix({ 2.0f , 2.0f , 2.0f }, { 0.3f , 0.2f , 0.1f }, { 1.0f , 2.0f , 3.0f });
+		std::vector<Vector3> transformed(kCount);
+		TransformPointsParallel(points, m, transformed);
+
+		for (size_t i = 0; i < kCount; i += 997)
+		{
+			Matrix4x4 expected = Multiply(MakeAffineMatrix(transforms[i].scale, transforms[i].rotate, transforms[i].translate), viewProjectionMatrix);
+			for (int row = 0; row < 4; row++)
+			{
+				for (int column = 0; column < 4; column++)
+				{
+					CHECK_NEAR(matrices[i].m[row][column], expected.m[row][column], 1e-3 * (std::max)(1.0f, std::fabs(expected.m[row][column])));
+				}
+			}
+
+			Vector3 point = Transform(points[i], m);
+			CHECK_NEAR(transformed[i].x, point.x, 1e-3 * (std::max)(1.0f, std::fabs(point.x)));
+			CHECK_NEAR(transformed[i].z, point.z, 1e-3 * (std::max)(1.0f, std::fabs(point.z)));
+		}
+	}
+}
+
+int main()
+{
+	JobSystem* system = CreateJobSystem(3);
+	TestEveryJobRunsOnce(system);
+	TestNestedRunJobs(system);
+	TestConcurrentSubmitters(system);
+	ReleaseJobSystem(system);
+
+	// スレッドがなくても動く
+	JobSystem* serialSystem = CreateJobSystem(0);
+	TestEveryJobRunsOnce(serialSystem);
+	TestNestedRunJobs(serialSystem);
+	ReleaseJobSystem(serialSystem);
+
+	TestWorkersAreReused();
+	TestParallelMath();
+
+	return FinishTest("JobSystemTest");
+}
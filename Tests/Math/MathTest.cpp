@@ -0,0 +1,314 @@
+#include <cstdint>
+#include <vector>
+#include "Func/Matrix/Matrix.h"
+#include "Func/Vector/Vector.h"
+#include "TestCheck.h"
+
+/*
+	行列とベクトルのテスト
+	MathTestはSIMD版、MathScalarTestはMATH_NO_SIMDのスカラー版で、同じ確認をする
+*/
+
+namespace
+{
+	// 許す誤差
+	const float kTolerance = 1e-4f;
+
+	/// <summary>
+	/// 再現できる乱数（-range 〜 range）
+	/// </summary>
+	float RandomFloat(uint32_t& state, float range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+	}
+
+	/// <summary>
+	/// 乱数で姿勢情報を作る（拡縮は0.5以上）
+	/// </summary>
+	Transform3D MakeRandomTransform(uint32_t& state)
+	{
+		Transform3D transform{};
+		transform.scale = { 0.5f + std::fabs(RandomFloat(state, 2.0f)) , 0.5f + std::fabs(RandomFloat(state, 2.0f)) , 0.5f + std::fabs(RandomFloat(state, 2.0f)) };
+		transform.rotate = { RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) };
+		transform.translate = { RandomFloat(state, 50.0f) , RandomFloat(state, 50.0f) , RandomFloat(state, 50.0f) };
+		return transform;
+	}
+
+	/// <summary>
+	/// 定義どおりの積（比べる相手）
+	/// </summary>
+	Matrix4x4 MultiplyReference(const Matrix4x4& m1, const Matrix4x4& m2)
+	{
+		Matrix4x4 result{};
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				double sum = 0.0;
+				for (int k = 0; k < 4; k++)
+				{
+					sum += static_cast<double>(m1.m[row][k]) * static_cast<double>(m2.m[k][column]);
+				}
+				result.m[row][column] = static_cast<float>(sum);
+			}
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// 全ての要素が近いか確かめる（toleranceは要素の大きさに合わせて広げる）
+	/// </summary>
+	void CheckMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float tolerance)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				float scale = (std::max)(1.0f, std::fabs(expected.m[row][column]));
+				CHECK_NEAR(actual.m[row][column], expected.m[row][column], tolerance * scale);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 拡縮、回転、移動の行列の積でアフィン変換行列を作る（比べる相手、回転はX→Y→Zの順）
+	/// </summary>
+	Matrix4x4 MakeAffineMatrixReference(const Transform3D& transform)
+	{
+		Matrix4x4 rotateMatrix = MultiplyReference(MultiplyReference(MakeRotateXMatrix(transform.rotate.x), MakeRotateYMatrix(transform.rotate.y)), MakeRotateZMatrix(transform.rotate.z));
+		return MultiplyReference(MultiplyReference(MakeScaleMatrix(transform.scale), rotateMatrix), MakeTranslateMatrix(transform.translate));
+	}
+
+	/// <summary>
+	/// 積
+	/// </summary>
+	void TestMultiply()
+	{
+		Matrix4x4 identity = MakeIdenityMatrix();
+
+		uint32_t state = 1;
+		for (int n = 0; n < 100; n++)
+		{
+			Matrix4x4 m1{};
+			Matrix4x4 m2{};
+			for (int i = 0; i < 16; i++)
+			{
+				m1.m[i / 4][i % 4] = RandomFloat(state, 10.0f);
+				m2.m[i / 4][i % 4] = RandomFloat(state, 10.0f);
+			}
+
+			CheckMatrixNear(Multiply(m1, m2), MultiplyReference(m1, m2), kTolerance);
+			CheckMatrixNear(Multiply(m1, identity), m1, 0.0f);
+			CheckMatrixNear(m1 * m2, Multiply(m1, m2), 0.0f);
+		}
+
+		// コンパイル時にも計算できる
+		constexpr Matrix4x4 constantMatrix = Multiply(MakeScaleMatrix({ 2.0f , 3.0f , 4.0f }), MakeTranslateMatrix({ 1.0f , 2.0f , 3.0f }));
+		static_assert(constantMatrix.m[0][0] == 2.0f && constantMatrix.m[3][2] == 3.0f);
+	}
+
+	/// <summary>
+	/// アフィン変換行列と座標変換
+	/// </summary>
+	void TestAffineAndTransform()
+	{
+		uint32_t state = 2;
+		for (int n = 0; n < 100; n++)
+		{
+			Transform3D transform = MakeRandomTransform(state);
+			Matrix4x4 reference = MakeAffineMatrixReference(transform);
+
+			Matrix4x4 affineMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+			CheckMatrixNear(affineMatrix, reference, kTolerance);
+			CHECK(IsAffineMatrix(affineMatrix));
+
+			// 座標変換は行ベクトル × 行列
+			Vector3 point = { RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) };
+			Vector3 transformed = Transform(point, affineMatrix);
+			Vector3 expected = Transform(Transform(Transform(point, MakeScaleMatrix(transform.scale)),
+				MultiplyReference(MultiplyReference(MakeRotateXMatrix(transform.rotate.x), MakeRotateYMatrix(transform.rotate.y)), MakeRotateZMatrix(transform.rotate.z))),
+				MakeTranslateMatrix(transform.translate));
+			CHECK_NEAR(transformed.x, expected.x, 1e-3f);
+			CHECK_NEAR(transformed.y, expected.y, 1e-3f);
+			CHECK_NEAR(transformed.z, expected.z, 1e-3f);
+		}
+
+		// 射影行列ではwで割る
+		Matrix4x4 projection = MakeIdenityMatrix();
+		projection.m[3][3] = 2.0f;
+		Vector3 projected = Transform({ 2.0f , 4.0f , 6.0f }, projection);
+		CHECK_NEAR(projected.x, 1.0f, 0.0f);
+		CHECK_NEAR(projected.y, 2.0f, 0.0f);
+		CHECK_NEAR(projected.z, 3.0f, 0.0f);
+		CHECK(!IsAffineMatrix(projection));
+	}
+
+	/// <summary>
+	/// 逆行列
+	/// </summary>
+	void TestInverse()
+	{
+		uint32_t state = 3;
+		for (int n = 0; n < 100; n++)
+		{
+			Transform3D transform = MakeRandomTransform(state);
+			Matrix4x4 m = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+
+			// 射影の成分もある一般の行列にする
+			m.m[0][3] = RandomFloat(state, 0.2f);
+			m.m[2][3] = RandomFloat(state, 0.2f);
+
+			CheckMatrixNear(MultiplyReference(m, MakeInverseMatrix(m)), MakeIdenityMatrix(), 1e-3f);
+		}
+	}
+
+	/// <summary>
+	/// SIMD版の積と逆行列が、コンパイル時に計算するスカラー版と同じ結果になる
+	/// </summary>
+	void TestSimdMatchesScalar()
+	{
+		constexpr Matrix4x4 m1 = { { { 1.0f , 2.0f , 3.0f , 4.0f } , { 5.0f , 6.0f , 7.0f , 8.0f } , { 9.0f , 10.0f , 11.0f , 12.0f } , { 13.0f , 14.0f , 15.0f , 16.0f } } };
+		constexpr Matrix4x4 m2 = { { { 0.5f , -1.0f , 2.0f , 0.0f } , { 1.5f , 0.25f , -3.0f , 1.0f } , { -2.0f , 4.0f , 0.5f , -1.0f } , { 3.0f , 0.0f , 1.0f , 2.0f } } };
+
+		// 整数と2のべき乗の分数だけなので、足す順番が違っても誤差は出ない
+		constexpr Matrix4x4 constantProduct = Multiply(m1, m2);
+		Matrix4x4 runtimeM1 = m1;
+		CheckMatrixNear(Multiply(runtimeM1, m2), constantProduct, 0.0f);
+
+		// 答えが分かる逆行列（対角と移動）
+		Matrix4x4 m = MakeScaleMatrix({ 2.0f , 4.0f , 0.5f }) * MakeTranslateMatrix({ 1.0f , -2.0f , 3.0f });
+		Matrix4x4 inverse = MakeInverseMatrix(m);
+		CHECK_NEAR(inverse.m[0][0], 0.5f, 1e-6f);
+		CHECK_NEAR(inverse.m[1][1], 0.25f, 1e-6f);
+		CHECK_NEAR(inverse.m[2][2], 2.0f, 1e-6f);
+		CHECK_NEAR(inverse.m[3][0], -0.5f, 1e-6f);
+		CHECK_NEAR(inverse.m[3][1], 0.5f, 1e-6f);
+		CHECK_NEAR(inverse.m[3][2], -6.0f, 1e-5f);
+		CHECK_NEAR(inverse.m[3][3], 1.0f, 1e-6f);
+
+		// 透視投影行列（4列目を使う行列）も戻せる
+		Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f);
+		CheckMatrixNear(MultiplyReference(projection, MakeInverseMatrix(projection)), MakeIdenityMatrix(), 1e-4f);
+		CheckMatrixNear(MultiplyReference(MakeInverseMatrix(projection), projection), MakeIdenityMatrix(), 1e-4f);
+
+		// 逆行列の逆行列は元に戻る
+		uint32_t state = 5;
+		for (int n = 0; n < 50; n++)
+		{
+			Transform3D transform = MakeRandomTransform(state);
+			Matrix4x4 affineMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+			CheckMatrixNear(MakeInverseMatrix(MakeInverseMatrix(affineMatrix)), affineMatrix, 1e-3f);
+		}
+	}
+
+	/// <summary>
+	/// アフィン変換行列、回転と移動だけの行列、ビュー行列の逆行列が、一般の逆行列と一致する
+	/// </summary>
+	void TestAffineInverse()
+	{
+		uint32_t state = 6;
+		for (int n = 0; n < 100; n++)
+		{
+			Transform3D transform = MakeRandomTransform(state);
+
+			Matrix4x4 affineMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+			Matrix4x4 inverseAffine = MakeInverseAffineMatrix(affineMatrix);
+			CheckMatrixNear(inverseAffine, MakeInverseMatrix(affineMatrix), 1e-3f);
+			CheckMatrixNear(MultiplyReference(affineMatrix, inverseAffine), MakeIdenityMatrix(), 1e-3f);
+			CHECK(IsAffineMatrix(inverseAffine));
+
+			Matrix4x4 rigidMatrix = MakeAffineMatrix({ 1.0f , 1.0f , 1.0f }, transform.rotate, transform.translate);
+			CheckMatrixNear(MakeInverseRigidMatrix(rigidMatrix), MakeInverseMatrix(rigidMatrix), 1e-3f);
+
+			// ビュー行列はカメラのワールド行列の逆行列
+			CheckMatrixNear(MakeViewMatrix(transform), MakeInverseMatrix(affineMatrix), 1e-3f);
+		}
+
+		// コンパイル時にも計算できる
+		constexpr Matrix4x4 constantInverse = MakeInverseAffineMatrix(MakeScaleMatrix({ 2.0f , 4.0f , 8.0f }) * MakeTranslateMatrix({ 2.0f , 4.0f , 8.0f }));
+		static_assert(constantInverse.m[0][0] == 0.5f && constantInverse.m[3][2] == -1.0f);
+		constexpr Matrix4x4 constantRigidInverse = MakeInverseRigidMatrix(MakeTranslateMatrix({ 1.0f , 2.0f , 3.0f }));
+		static_assert(constantRigidInverse.m[3][0] == -1.0f && constantRigidInverse.m[3][2] == -3.0f);
+	}
+
+	/// <summary>
+	/// 注視点を向くビュー行列
+	/// </summary>
+	void TestLookAt()
+	{
+		Vector3 eye = { 3.0f , 4.0f , -10.0f };
+		Vector3 target = { -1.0f , 2.0f , 5.0f };
+		Matrix4x4 viewMatrix = MakeLookAtMatrix(eye, target, { 0.0f , 1.0f , 0.0f });
+
+		// カメラは原点に、注視点は+Z上に来る
+		Vector3 viewEye = Transform(eye, viewMatrix);
+		CHECK_NEAR(Length(viewEye), 0.0f, 1e-4f);
+
+		Vector3 viewTarget = Transform(target, viewMatrix);
+		CHECK_NEAR(viewTarget.x, 0.0f, 1e-4f);
+		CHECK_NEAR(viewTarget.y, 0.0f, 1e-4f);
+		CHECK_NEAR(viewTarget.z, Length(Subtract(target, eye)), 1e-4f);
+
+		// 回転と移動だけなので、逆行列は転置で求まる
+		CHECK(IsAffineMatrix(viewMatrix));
+		CheckMatrixNear(MultiplyReference(viewMatrix, MakeInverseRigidMatrix(viewMatrix)), MakeIdenityMatrix(), 1e-4f);
+
+		// 上方向は、ビュー空間でも上を向く
+		Vector3 above = Transform(Add(eye, { 0.0f , 1.0f , 0.0f }), viewMatrix);
+		CHECK(above.y > 0.0f);
+	}
+
+	/// <summary>
+	/// 長さと正規化
+	/// </summary>
+	void TestLengthAndNormalize()
+	{
+		CHECK_NEAR(Length({ 3.0f , 4.0f , 12.0f }), 13.0f, 0.0f);
+		static_assert(LengthSquared({ 1.0f , 2.0f , 2.0f }) == 9.0f);
+
+		Vector3 normalized = Normalize({ 0.0f , 3.0f , 4.0f });
+		CHECK_NEAR(normalized.x, 0.0f, 0.0f);
+		CHECK_NEAR(normalized.y, 0.6f, 1e-6f);
+		CHECK_NEAR(normalized.z, 0.8f, 1e-6f);
+
+		// 長さ0は0ベクトルのまま
+		Vector3 zero = Normalize({ 0.0f , 0.0f , 0.0f });
+		CHECK(zero.x == 0.0f && zero.y == 0.0f && zero.z == 0.0f);
+
+		static_assert(Dot(Vector3{ 1.0f , 2.0f , 3.0f }, Vector3{ 4.0f , 5.0f , 6.0f }) == 32.0f);
+		static_assert(Cross(Vector3{ 1.0f , 0.0f , 0.0f }, Vector3{ 0.0f , 1.0f , 0.0f }).z == 1.0f);
+	}
+
+	/// <summary>
+	/// 波括弧で渡す呼び出しが、Vector3の関数に決まる（Vector2, Vector4は演算子だけにしている）
+	/// </summary>
+	void TestBraceInitializedCalls()
+	{
+		static_assert(Add({ 1.0f , 2.0f , 3.0f }, { 1.0f , 1.0f , 1.0f }).z == 4.0f);
+		static_assert(Subtract({ 1.0f , 2.0f , 3.0f }, { 1.0f , 1.0f , 1.0f }).z == 2.0f);
+		static_assert(Multiply(2.0f, { 1.0f , 2.0f , 3.0f }).z == 6.0f);
+		static_assert(Dot({ 1.0f , 2.0f , 3.0f }, { 1.0f , 1.0f , 1.0f }) == 6.0f);
+		CHECK_NEAR(Length({ 0.0f , 3.0f , 4.0f }), 5.0f, 0.0f);
+
+		constexpr Vector4 v4 = Vector4{ 1.0f , 2.0f , 3.0f , 4.0f } * 2.0f - Vector4{ 1.0f , 1.0f , 1.0f , 1.0f };
+		static_assert(v4.x == 1.0f && v4.w == 7.0f);
+
+		constexpr Vector2 v2 = -(Vector2{ 1.0f , 2.0f } + Vector2{ 1.0f , 1.0f }) / 2.0f;
+		static_assert(v2.x == -1.0f && v2.y == -1.5f);
+	}
+}
+
+int main()
+{
+	TestMultiply();
+	TestAffineAndTransform();
+	TestInverse();
+	TestSimdMatchesScalar();
+	TestAffineInverse();
+	TestLookAt();
+	TestLengthAndNormalize();
+	TestBraceInitializedCalls();
+
+	return FinishTest("MathTest");
+}
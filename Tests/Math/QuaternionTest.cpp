@@ -0,0 +1,137 @@
+#include <cstdint>
+#include "Func/Matrix/Matrix.h"
+#include "Func/Quaternion/Quaternion.h"
+#include "Func/Vector/Vector.h"
+#include "TestCheck.h"
+
+/*
+	クォータニオンのテスト
+	オイラー角の行列と同じ回転になるか、行列の関数の呼び出しを曖昧にしていないかを確かめる
+*/
+
+namespace
+{
+	// 許す誤差
+	const float kTolerance = 1e-4f;
+
+	/// <summary>
+	/// 再現できる乱数（-range 〜 range）
+	/// </summary>
+	float RandomFloat(uint32_t& state, float range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f) * range;
+	}
+
+	/// <summary>
+	/// 全ての要素が近いか確かめる
+	/// </summary>
+	void CheckMatrixNear(const Matrix4x4& actual, const Matrix4x4& expected, float tolerance)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				CHECK_NEAR(actual.m[row][column], expected.m[row][column], tolerance);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 同じ回転か確かめる（q と -q は同じ回転）
+	/// </summary>
+	void CheckSameRotation(const Quaternion& actual, const Quaternion& expected, float tolerance)
+	{
+		CHECK_NEAR(std::fabs(DotQuaternion(actual, expected)), 1.0f, tolerance);
+	}
+
+	/// <summary>
+	/// 波括弧で渡すVector3の呼び出しが、クォータニオンの関数と曖昧にならない
+	/// </summary>
+	void TestBraceInitializedCalls()
+	{
+		CheckMatrixNear(MakeAffineMatrix({ 1.0f , 1.0f , 1.0f }, { 0.0f , 0.0f , 0.0f }, { 0.0f , 0.0f , 0.0f }), MakeIdenityMatrix(), 0.0f);
+		CheckMatrixNear(MakeRotateMatrix({ 0.0f , 0.0f , 0.0f }), MakeIdenityMatrix(), 0.0f);
+
+		Vector3 normalized = Normalize({ 0.0f , 0.0f , 2.0f });
+		CHECK_NEAR(normalized.z, 1.0f, 0.0f);
+
+		Quaternion identity = MakeRotateQuaternion({ 0.0f , 0.0f , 0.0f });
+		CheckSameRotation(identity, MakeIdentityQuaternion(), 0.0f);
+	}
+
+	/// <summary>
+	/// オイラー角の行列と同じ回転になる
+	/// </summary>
+	void TestMatchesEulerMatrix()
+	{
+		uint32_t state = 6;
+		for (int n = 0; n < 100; n++)
+		{
+			Vector3 scale = { 0.5f + std::fabs(RandomFloat(state, 2.0f)) , 0.5f + std::fabs(RandomFloat(state, 2.0f)) , 0.5f + std::fabs(RandomFloat(state, 2.0f)) };
+			Vector3 rotate = { RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) , RandomFloat(state, 3.14f) };
+			Vector3 translate = { RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) , RandomFloat(state, 10.0f) };
+
+			Quaternion q = MakeRotateQuaternion(rotate);
+			CHECK_NEAR(Norm(q), 1.0f, kTolerance);
+
+			CheckMatrixNear(MakeRotateMatrixFromQuaternion(q), MakeRotateMatrix(rotate), kTolerance);
+			CheckMatrixNear(MakeAffineMatrixQuaternion(scale, q, translate), MakeAffineMatrix(scale, rotate, translate), 1e-3f);
+
+			// 行列から戻しても同じ回転
+			CheckSameRotation(MakeRotateQuaternionFromMatrix(MakeRotateMatrix(rotate)), q, kTolerance);
+
+			// ベクトルの回転は、回転行列での変換と同じ
+			Vector3 v = { RandomFloat(state, 5.0f) , RandomFloat(state, 5.0f) , RandomFloat(state, 5.0f) };
+			Vector3 rotated = RotateVector(v, q);
+			Vector3 expected = Transform(v, MakeRotateMatrix(rotate));
+			CHECK_NEAR(rotated.x, expected.x, 1e-3f);
+			CHECK_NEAR(rotated.y, expected.y, 1e-3f);
+			CHECK_NEAR(rotated.z, expected.z, 1e-3f);
+		}
+	}
+
+	/// <summary>
+	/// 合成の順番（MakeRotateMatrixFromQuaternion(q1) * MakeRotateMatrixFromQuaternion(q2) は Multiply(q2, q1)）
+	/// </summary>
+	void TestComposition()
+	{
+		Quaternion q1 = MakeRotateAxisAngleQuaternion({ 1.0f , 0.0f , 0.0f }, 0.7f);
+		Quaternion q2 = MakeRotateAxisAngleQuaternion({ 0.0f , 1.0f , 0.0f }, -1.2f);
+
+		CheckMatrixNear(MakeRotateMatrixFromQuaternion(q1) * MakeRotateMatrixFromQuaternion(q2), MakeRotateMatrixFromQuaternion(Multiply(q2, q1)), kTolerance);
+
+		// 逆クォータニオンで戻る
+		CheckSameRotation(Multiply(q1, Inverse(q1)), MakeIdentityQuaternion(), kTolerance);
+	}
+
+	/// <summary>
+	/// 補間
+	/// </summary>
+	void TestInterpolation()
+	{
+		Quaternion q0 = MakeIdentityQuaternion();
+		Quaternion q1 = MakeRotateAxisAngleQuaternion({ 0.0f , 0.0f , 1.0f }, 2.0f);
+
+		CheckSameRotation(Slerp(q0, q1, 0.0f), q0, kTolerance);
+		CheckSameRotation(Slerp(q0, q1, 1.0f), q1, kTolerance);
+		CheckSameRotation(Nlerp(q0, q1, 1.0f), q1, kTolerance);
+
+		// Slerpは角度を等分する
+		CheckSameRotation(Slerp(q0, q1, 0.25f), MakeRotateAxisAngleQuaternion({ 0.0f , 0.0f , 1.0f }, 0.5f), kTolerance);
+
+		// -q1 を渡しても最短経路を通る
+		Quaternion negated = { -q1.x , -q1.y , -q1.z , -q1.w };
+		CheckSameRotation(Slerp(q0, negated, 0.5f), MakeRotateAxisAngleQuaternion({ 0.0f , 0.0f , 1.0f }, 1.0f), kTolerance);
+	}
+}
+
+int main()
+{
+	TestBraceInitializedCalls();
+	TestMatchesEulerMatrix();
+	TestComposition();
+	TestInterpolation();
+
+	return FinishTest("QuaternionTest");
+}
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "Func/MeshUpload/MeshUpload.h"
+#include "TestCheck.h"
+
+/*
+	MeshUploadSchedulerのテスト
+	コピーキューの代わりに、ステージングバッファからメッシュごとのバッファへmemcpyして、届いた中身を確かめる
+*/
+
+namespace
+{
+	// 頂点1つの大きさ（float4）
+	const uint32_t kVertexStride = 16;
+
+	// GPU側のバッファ（コピー先）
+	typedef struct GpuMesh
+	{
+		std::vector<uint8_t> vertexBuffer;
+		std::vector<uint8_t> indexBuffer;
+	}GpuMesh;
+
+	/// <summary>
+	/// 番号から決まる中身の頂点データを作る
+	/// </summary>
+	std::vector<uint8_t> MakeVertexData(uint32_t seed, uint32_t vertexCount)
+	{
+		std::vector<uint8_t> data(vertexCount * kVertexStride);
+		for (size_t i = 0; i < data.size(); i++)
+		{
+			data[i] = static_cast<uint8_t>(seed * 13 + i);
+		}
+		return data;
+	}
+
+	/// <summary>
+	/// 番号から決まる中身のインデックスを作る
+	/// </summary>
+	std::vector<uint32_t> MakeIndexData(uint32_t seed, uint32_t indexCount)
+	{
+		std::vector<uint32_t> data(indexCount);
+		for (uint32_t i = 0; i < indexCount; i++)
+		{
+			data[i] = seed * 1000 + i;
+		}
+		return data;
+	}
+
+	/// <summary>
+	/// コピーを実行する（コピーキューの代わり）
+	/// </summary>
+	void ExecuteCopies(const MeshUploadBatch& batch, const std::vector<uint8_t>& stagingMemory, std::vector<GpuMesh>& gpuMeshes)
+	{
+		for (const MeshCopyCommand& copy : batch.copies)
+		{
+			if (gpuMeshes.size() <= copy.meshIndex)
+			{
+				gpuMeshes.resize(copy.meshIndex + 1);
+			}
+
+			std::vector<uint8_t>& destination = copy.bufferType == MeshBufferType::Vertex ? gpuMeshes[copy.meshIndex].vertexBuffer : gpuMeshes[copy.meshIndex].indexBuffer;
+			destination.assign(stagingMemory.begin() + copy.stagingOffset, stagingMemory.begin() + copy.stagingOffset + copy.size);
+		}
+	}
+
+	/// <summary>
+	/// 転送の流れ（書き込み待ち → 転送中 → 使える）と、届いた中身
+	/// </summary>
+	void TestUpload()
+	{
+		std::vector<uint8_t> stagingMemory(64 * 1024);
+		UploadRingBuffer staging = MakeUploadRingBuffer(stagingMemory.data(), 0, stagingMemory.size());
+		MeshUploadScheduler scheduler{};
+
+		std::vector<uint8_t> vertices0 = MakeVertexData(0, 24);
+		std::vector<uint32_t> indices0 = MakeIndexData(0, 36);
+		std::vector<uint8_t> vertices1 = MakeVertexData(1, 3);
+
+		MeshHandle mesh0 = RegisterMesh(scheduler, vertices0, kVertexStride, indices0);
+		MeshHandle mesh1 = RegisterMesh(scheduler, vertices1, kVertexStride, {});
+
+		CHECK(GetMeshRecord(scheduler, mesh0)->state == MeshUploadState::Pending);
+		CHECK(GetMeshRecord(scheduler, mesh0)->vertexBufferSize == vertices0.size());
+		CHECK(GetMeshRecord(scheduler, mesh0)->indexCount == 36);
+		CHECK(GetMeshRecord(scheduler, mesh1)->indexCount == 0);
+
+		// 頂点とインデックス、インデックスなしは頂点だけ
+		MeshUploadBatch batch = BuildMeshUploadBatch(scheduler, staging);
+		CHECK(batch.copies.size() == 3);
+		CHECK(batch.meshIndices == std::vector<uint32_t>({ mesh0.index , mesh1.index }));
+		for (const MeshCopyCommand& copy : batch.copies)
+		{
+			CHECK(copy.stagingOffset % 16 == 0);
+		}
+
+		// 書き込んだら手元のデータは捨てる
+		CHECK(GetMeshRecord(scheduler, mesh0)->state == MeshUploadState::Uploading);
+		CHECK(GetMeshRecord(scheduler, mesh0)->vertexData.empty());
+
+		std::vector<GpuMesh> gpuMeshes;
+		ExecuteCopies(batch, stagingMemory, gpuMeshes);
+		SubmitMeshUploadBatch(scheduler, batch, staging, 1);
+		CHECK(GetMeshRecord(scheduler, mesh1)->fenceValue == 1);
+
+		// 送るものがなければ空
+		CHECK(BuildMeshUploadBatch(scheduler, staging).copies.empty());
+
+		// Fenceが進むまでは使えない
+		UpdateMeshUploads(scheduler, staging, 0);
+		CHECK(GetMeshRecord(scheduler, mesh0)->state == MeshUploadState::Uploading);
+		CHECK(GetUploadRingBufferUsedSize(staging) > 0);
+
+		UpdateMeshUploads(scheduler, staging, 1);
+		CHECK(GetMeshRecord(scheduler, mesh0)->state == MeshUploadState::Ready);
+		CHECK(GetMeshRecord(scheduler, mesh1)->state == MeshUploadState::Ready);
+		CHECK(GetUploadRingBufferUsedSize(staging) == 0);
+
+		CHECK(gpuMeshes[mesh0.index].vertexBuffer == vertices0);
+		CHECK(gpuMeshes[mesh0.index].indexBuffer.size() == indices0.size() * sizeof(uint32_t));
+		CHECK(std::memcmp(gpuMeshes[mesh0.index].indexBuffer.data(), indices0.data(), indices0.size() * sizeof(uint32_t)) == 0);
+		CHECK(gpuMeshes[mesh1.index].vertexBuffer == vertices1);
+		CHECK(gpuMeshes[mesh1.index].indexBuffer.empty());
+	}
+
+	/// <summary>
+	/// ステージングバッファに入らない分は、登録順を守って次のバッチに回す
+	/// </summary>
+	void TestSplitAcrossBatches()
+	{
+		std::vector<uint8_t> stagingMemory(4096);
+		UploadRingBuffer staging = MakeUploadRingBuffer(stagingMemory.data(), 0, stagingMemory.size());
+		MeshUploadScheduler scheduler{};
+
+		// 1つ 1024 + 256 バイト
+		std::vector<MeshHandle> handles;
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			handles.push_back(RegisterMesh(scheduler, MakeVertexData(i, 64), kVertexStride, MakeIndexData(i, 64)));
+		}
+
+		std::vector<GpuMesh> gpuMeshes;
+		std::vector<uint32_t> uploadedOrder;
+		uint64_t fenceValue = 0;
+		uint64_t completedValue = 0;
+
+		// GPUは1フレームに1バッチずつ終わる
+		for (int frame = 0; frame < 20 && uploadedOrder.size() < handles.size(); frame++)
+		{
+			completedValue = (std::min)(completedValue + 1, fenceValue);
+			UpdateMeshUploads(scheduler, staging, completedValue);
+
+			MeshUploadBatch batch = BuildMeshUploadBatch(scheduler, staging);
+			if (batch.copies.empty())
+			{
+				continue;
+			}
+
+			// 1回で全ては入らない
+			CHECK(batch.meshIndices.size() <= 3);
+
+			ExecuteCopies(batch, stagingMemory, gpuMeshes);
+			uploadedOrder.insert(uploadedOrder.end(), batch.meshIndices.begin(), batch.meshIndices.end());
+			SubmitMeshUploadBatch(scheduler, batch, staging, ++fenceValue);
+		}
+		UpdateMeshUploads(scheduler, staging, fenceValue);
+
+		CHECK(fenceValue > 3);
+		CHECK(uploadedOrder.size() == handles.size());
+		for (uint32_t i = 0; i < handles.size() && i < uploadedOrder.size(); i++)
+		{
+			CHECK(uploadedOrder[i] == handles[i].index);
+			CHECK(GetMeshRecord(scheduler, handles[i])->state == MeshUploadState::Ready);
+			CHECK(gpuMeshes[handles[i].index].vertexBuffer == MakeVertexData(i, 64));
+		}
+	}
+
+	/// <summary>
+	/// 解除すると、古い番号は使えなくなり、番号は使い回される
+	/// </summary>
+	void TestUnregister()
+	{
+		std::vector<uint8_t> stagingMemory(4096);
+		UploadRingBuffer staging = MakeUploadRingBuffer(stagingMemory.data(), 0, stagingMemory.size());
+		MeshUploadScheduler scheduler{};
+
+		MeshHandle a = RegisterMesh(scheduler, MakeVertexData(1, 4), kVertexStride, {});
+		MeshHandle b = RegisterMesh(scheduler, MakeVertexData(2, 4), kVertexStride, {});
+
+		// 書き込み待ちのものを解除すると、転送もしない
+		UnregisterMesh(scheduler, a);
+		CHECK(GetMeshRecord(scheduler, a) == nullptr);
+
+		MeshUploadBatch batch = BuildMeshUploadBatch(scheduler, staging);
+		CHECK(batch.meshIndices == std::vector<uint32_t>({ b.index }));
+
+		// 同じ番号を使い回しても、古いハンドルでは引けない
+		MeshHandle c = RegisterMesh(scheduler, MakeVertexData(3, 4), kVertexStride, {});
+		CHECK(c.index == a.index && c.generation != a.generation);
+		CHECK(GetMeshRecord(scheduler, a) == nullptr);
+		CHECK(GetMeshRecord(scheduler, c) != nullptr);
+
+		// 範囲外
+		CHECK(GetMeshRecord(scheduler, MeshHandle{ 100 , 0 }) == nullptr);
+
+		// 使えるようになったものは解除できる
+		SubmitMeshUploadBatch(scheduler, batch, staging, 1);
+		UpdateMeshUploads(scheduler, staging, 1);
+		UnregisterMesh(scheduler, b);
+		CHECK(GetMeshRecord(scheduler, b) == nullptr);
+	}
+}
+
+int main()
+{
+	TestUpload();
+	TestSplitAcrossBatches();
+	TestUnregister();
+
+	return FinishTest("MeshUploadTest");
+}
@@ -0,0 +1,426 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <utility>
+#include "Func/Hash/Hash.h"
+#include "Func/PipelineDescription/PipelineDescription.h"
+#include "TestCheck.h"
+
+/*
+	HashとPipelineDescriptionのテスト
+	結果に影響する値が変わればハッシュが変わり、影響しない値だけが変わっても同じになるかを確かめる
+	（D3D12の列挙値は、数値のまま使う）
+*/
+
+namespace
+{
+	// D3D12_CULL_MODE_NONE / D3D12_CULL_MODE_BACK
+	const uint32_t kCullModeNone = 1;
+	const uint32_t kCullModeBack = 3;
+
+	// D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA
+	const uint32_t kInputClassificationPerInstanceData = 1;
+
+	/// <summary>
+	/// 既知の値と比べて、FNV-1aになっているかを確かめる
+	/// </summary>
+	void TestHash()
+	{
+		CHECK(HashBytes("", 0) == 0xcbf29ce484222325ull);
+		CHECK(HashBytes("a", 1) == 0xaf63dc4c8601ec8cull);
+		CHECK(HashBytes("foobar", 6) == 0x85944171f73967e8ull);
+
+		// 続けて求めると、連結したものと同じ
+		CHECK(HashBytes("bar", 3, HashBytes("foo", 3)) == HashBytes("foobar", 6));
+
+		// 文字列は長さも混ぜるので、区切りが違えば別のハッシュになる
+		CHECK(HashString(HashString(kHashSeed, "ab"), "c") != HashString(HashString(kHashSeed, "a"), "bc"));
+		CHECK(HashString(kHashSeed, "") != kHashSeed);
+
+		// 混ぜる順番で結果が変わる
+		CHECK(HashCombine(HashCombine(kHashSeed, 1), 2) != HashCombine(HashCombine(kHashSeed, 2), 1));
+		CHECK(HashValue(kHashSeed, uint32_t(5)) == HashBytes("\x05\x00\x00\x00", 4));
+	}
+
+	/// <summary>
+	/// よくある設定（不透明、RenderTarget1枚、深度あり）
+	/// </summary>
+	PipelineDescription MakeBaseDescription()
+	{
+		PipelineDescription description{};
+		description.rootSignatureHash = 0x1111;
+		description.vertexShaderHash = 0x2222;
+		description.pixelShaderHash = 0x3333;
+
+		for (PipelineBlendDescription& blend : description.blend)
+		{
+			blend.renderTargetWriteMask = 0xF;
+		}
+		description.sampleMask = 0xFFFFFFFF;
+
+		description.rasterizer.fillMode = 3;
+		description.rasterizer.cullMode = kCullModeBack;
+		description.rasterizer.depthClipEnable = true;
+
+		description.depthEnable = true;
+		description.depthWriteMask = 1;
+		description.depthFunc = 4;
+
+		description.inputLayout =
+		{
+			{ "POSITION" , 0 , 2 , 0 , 0 , 0 , 0 },
+			{ "TEXCOORD" , 0 , 16 , 0 , 16 , 0 , 0 },
+			{ "NORMAL" , 0 , 6 , 0 , 24 , 0 , 0 },
+		};
+		description.primitiveTopologyType = 3;
+
+		description.numRenderTargets = 1;
+		description.rtvFormats[0] = 29;
+		description.dsvFormat = 45;
+		description.sampleCount = 1;
+
+		return description;
+	}
+
+	/// <summary>
+	/// 結果に影響する値は、どれを変えてもハッシュが変わる
+	/// </summary>
+	void TestHashChanges()
+	{
+		const PipelineDescription kBase = MakeBaseDescription();
+		const uint64_t kBaseHash = HashPipelineDescription(kBase);
+
+		// 同じ設定なら同じハッシュ（別々に作っても）
+		CHECK(HashPipelineDescription(MakeBaseDescription()) == kBaseHash);
+
+		PipelineDescription changed = kBase;
+		auto checkChanged = [&](const char* name)
+			{
+				if (HashPipelineDescription(changed) == kBaseHash)
+				{
+					std::printf("  not hashed: %s\n", name);
+					CHECK(false);
+				}
+				changed = kBase;
+			};
+
+		changed.rootSignatureHash++; checkChanged("rootSignatureHash");
+		changed.vertexShaderHash++; checkChanged("vertexShaderHash");
+		changed.pixelShaderHash++; checkChanged("pixelShaderHash");
+		changed.geometryShaderHash = 0x4444; checkChanged("geometryShaderHash");
+		changed.hullShaderHash = 0x5555; checkChanged("hullShaderHash");
+		changed.domainShaderHash = 0x6666; checkChanged("domainShaderHash");
+		changed.streamOutput.push_back(PipelineStreamOutputElementDescription{ 0 , "SV_POSITION" , 0 , 0 , 4 , 0 }); checkChanged("streamOutput");
+		changed.blend[0].logicOpEnable = true; checkChanged("logicOpEnable");
+		changed.alphaToCoverageEnable = true; checkChanged("alphaToCoverageEnable");
+		changed.blend[0].blendEnable = true; checkChanged("blendEnable");
+		changed.blend[0].renderTargetWriteMask = 0x7; checkChanged("renderTargetWriteMask");
+		changed.sampleMask = 0xF; checkChanged("sampleMask");
+		changed.rasterizer.fillMode = 2; checkChanged("fillMode");
+		changed.rasterizer.cullMode = kCullModeNone; checkChanged("cullMode");
+		changed.rasterizer.frontCounterClockwise = true; checkChanged("frontCounterClockwise");
+		changed.rasterizer.depthBias = 1; checkChanged("depthBias");
+		changed.rasterizer.depthBiasClamp = 0.5f; checkChanged("depthBiasClamp");
+		changed.rasterizer.slopeScaledDepthBias = 1.0f; checkChanged("slopeScaledDepthBias");
+		changed.rasterizer.depthClipEnable = false; checkChanged("depthClipEnable");
+		changed.rasterizer.multisampleEnable = true; checkChanged("multisampleEnable");
+		changed.rasterizer.antialiasedLineEnable = true; checkChanged("antialiasedLineEnable");
+		changed.rasterizer.forcedSampleCount = 4; checkChanged("forcedSampleCount");
+		changed.rasterizer.conservativeRaster = 1; checkChanged("conservativeRaster");
+		changed.depthEnable = false; checkChanged("depthEnable");
+		changed.depthWriteMask = 0; checkChanged("depthWriteMask");
+		changed.depthFunc = 2; checkChanged("depthFunc");
+		changed.stencilEnable = true; checkChanged("stencilEnable");
+		changed.inputLayout[1].semanticName = "COLOR"; checkChanged("semanticName");
+		changed.inputLayout[1].semanticIndex = 1; checkChanged("semanticIndex");
+		changed.inputLayout[1].format = 6; checkChanged("format");
+		changed.inputLayout[1].inputSlot = 1; checkChanged("inputSlot");
+		changed.inputLayout[1].alignedByteOffset = 20; checkChanged("alignedByteOffset");
+		changed.inputLayout[1].inputSlotClass = kInputClassificationPerInstanceData; checkChanged("inputSlotClass");
+		changed.inputLayout.pop_back(); checkChanged("inputLayout size");
+		std::swap(changed.inputLayout[0], changed.inputLayout[2]); checkChanged("inputLayout order");
+		changed.ibStripCutValue = 1; checkChanged("ibStripCutValue");
+		changed.primitiveTopologyType = 2; checkChanged("primitiveTopologyType");
+		changed.numRenderTargets = 2; checkChanged("numRenderTargets");
+		changed.rtvFormats[0] = 28; checkChanged("rtvFormats");
+		changed.dsvFormat = 40; checkChanged("dsvFormat");
+		changed.sampleCount = 4; checkChanged("sampleCount");
+		changed.sampleQuality = 1; checkChanged("sampleQuality");
+		changed.nodeMask = 2; checkChanged("nodeMask");
+		changed.flags = 1; checkChanged("flags");
+
+		// ブレンドするなら係数も結果に影響する
+		PipelineDescription blended = kBase;
+		blended.blend[0].blendEnable = true;
+		blended.blend[0].srcBlend = 5;
+		blended.blend[0].destBlend = 6;
+		PipelineDescription otherFactor = blended;
+		otherFactor.blend[0].destBlend = 2;
+		CHECK(HashPipelineDescription(blended) != HashPipelineDescription(otherFactor));
+
+		// 論理演算するなら演算の種類も結果に影響する
+		PipelineDescription logicOp = kBase;
+		logicOp.blend[0].logicOpEnable = true;
+		logicOp.blend[0].logicOp = 4;
+		PipelineDescription otherLogicOp = logicOp;
+		otherLogicOp.blend[0].logicOp = 5;
+		CHECK(HashPipelineDescription(logicOp) != HashPipelineDescription(otherLogicOp));
+
+		// ステンシルを使うなら、マスクと面ごとの設定も結果に影響する
+		PipelineDescription stencil = kBase;
+		stencil.stencilEnable = true;
+		stencil.stencilReadMask = 0xFF;
+		stencil.stencilWriteMask = 0xFF;
+		stencil.frontFace = PipelineStencilOpDescription{ 1 , 1 , 1 , 8 };
+		stencil.backFace = PipelineStencilOpDescription{ 1 , 1 , 1 , 8 };
+		const uint64_t kStencilHash = HashPipelineDescription(stencil);
+
+		PipelineDescription changedStencil = stencil;
+		auto checkStencilChanged = [&](const char* name)
+			{
+				if (HashPipelineDescription(changedStencil) == kStencilHash)
+				{
+					std::printf("  not hashed: %s\n", name);
+					CHECK(false);
+				}
+				changedStencil = stencil;
+			};
+
+		changedStencil.stencilReadMask = 0x0F; checkStencilChanged("stencilReadMask");
+		changedStencil.stencilWriteMask = 0x0F; checkStencilChanged("stencilWriteMask");
+		changedStencil.frontFace.stencilFailOp = 2; checkStencilChanged("frontFace.stencilFailOp");
+		changedStencil.frontFace.stencilDepthFailOp = 2; checkStencilChanged("frontFace.stencilDepthFailOp");
+		changedStencil.frontFace.stencilPassOp = 3; checkStencilChanged("frontFace.stencilPassOp");
+		changedStencil.frontFace.stencilFunc = 3; checkStencilChanged("frontFace.stencilFunc");
+		changedStencil.backFace.stencilFailOp = 2; checkStencilChanged("backFace.stencilFailOp");
+		changedStencil.backFace.stencilDepthFailOp = 2; checkStencilChanged("backFace.stencilDepthFailOp");
+		changedStencil.backFace.stencilPassOp = 3; checkStencilChanged("backFace.stencilPassOp");
+		changedStencil.backFace.stencilFunc = 3; checkStencilChanged("backFace.stencilFunc");
+
+		// インスタンスごとのデータなら、進め方も結果に影響する
+		PipelineDescription instanced = kBase;
+		instanced.inputLayout[1].inputSlotClass = kInputClassificationPerInstanceData;
+		instanced.inputLayout[1].instanceDataStepRate = 1;
+		PipelineDescription otherStepRate = instanced;
+		otherStepRate.inputLayout[1].instanceDataStepRate = 2;
+		CHECK(HashPipelineDescription(instanced) != HashPipelineDescription(otherStepRate));
+
+		// ストリーム出力があるなら、要素、バッファの間隔、ラスタライズするストリームが結果に影響する
+		PipelineDescription streamOutput = kBase;
+		streamOutput.geometryShaderHash = 0x4444;
+		streamOutput.streamOutput = { PipelineStreamOutputElementDescription{ 0 , "SV_POSITION" , 0 , 0 , 4 , 0 } };
+		streamOutput.streamOutputStrides = { 16 };
+		const uint64_t kStreamOutputHash = HashPipelineDescription(streamOutput);
+
+		PipelineDescription changedStreamOutput = streamOutput;
+		auto checkStreamOutputChanged = [&](const char* name)
+			{
+				if (HashPipelineDescription(changedStreamOutput) == kStreamOutputHash)
+				{
+					std::printf("  not hashed: %s\n", name);
+					CHECK(false);
+				}
+				changedStreamOutput = streamOutput;
+			};
+
+		changedStreamOutput.streamOutput[0].stream = 1; checkStreamOutputChanged("streamOutput.stream");
+		changedStreamOutput.streamOutput[0].semanticName = "COLOR"; checkStreamOutputChanged("streamOutput.semanticName");
+		changedStreamOutput.streamOutput[0].semanticIndex = 1; checkStreamOutputChanged("streamOutput.semanticIndex");
+		changedStreamOutput.streamOutput[0].startComponent = 1; checkStreamOutputChanged("streamOutput.startComponent");
+		changedStreamOutput.streamOutput[0].componentCount = 3; checkStreamOutputChanged("streamOutput.componentCount");
+		changedStreamOutput.streamOutput[0].outputSlot = 1; checkStreamOutputChanged("streamOutput.outputSlot");
+		changedStreamOutput.streamOutputStrides[0] = 32; checkStreamOutputChanged("streamOutputStrides");
+		changedStreamOutput.streamOutputStrides.push_back(16); checkStreamOutputChanged("streamOutputStrides size");
+		changedStreamOutput.rasterizedStream = 0xFFFFFFFF; checkStreamOutputChanged("rasterizedStream");
+
+		// 別々のブレンドを使うなら、2枚目の設定も結果に影響する
+		PipelineDescription independent = kBase;
+		independent.numRenderTargets = 2;
+		independent.rtvFormats[1] = 10;
+		independent.independentBlendEnable = true;
+		PipelineDescription otherSecond = independent;
+		otherSecond.blend[1].renderTargetWriteMask = 0x1;
+		CHECK(HashPipelineDescription(independent) != HashPipelineDescription(otherSecond));
+	}
+
+	/// <summary>
+	/// 結果に影響しない値だけが違うなら、同じハッシュになる
+	/// </summary>
+	void TestHashIgnores()
+	{
+		const PipelineDescription kBase = MakeBaseDescription();
+		const uint64_t kBaseHash = HashPipelineDescription(kBase);
+
+		// ブレンドしないときの係数
+		PipelineDescription description = kBase;
+		description.blend[0].srcBlend = 5;
+		description.blend[0].blendOpAlpha = 2;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// 別々のブレンドを使わないときの、2枚目以降の設定
+		description = kBase;
+		description.blend[3].blendEnable = true;
+		description.blend[3].renderTargetWriteMask = 0;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// 論理演算しないときの演算の種類
+		description = kBase;
+		description.blend[0].logicOp = 4;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// ステンシルを使わないときのマスクと面ごとの設定
+		description = kBase;
+		description.stencilReadMask = 0xFF;
+		description.stencilWriteMask = 0x0F;
+		description.frontFace = PipelineStencilOpDescription{ 1 , 2 , 3 , 4 };
+		description.backFace = PipelineStencilOpDescription{ 4 , 3 , 2 , 1 };
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// 頂点ごとのデータの、インスタンスの進め方
+		description = kBase;
+		description.inputLayout[0].instanceDataStepRate = 3;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// ストリーム出力がないときの、バッファの間隔とラスタライズするストリーム
+		description = kBase;
+		description.streamOutputStrides = { 16 };
+		description.rasterizedStream = 2;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// 使わないRenderTargetの形式
+		description = kBase;
+		description.rtvFormats[5] = 10;
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// セマンティクス名の大文字小文字
+		description = kBase;
+		description.inputLayout[0].semanticName = "Position";
+		CHECK(HashPipelineDescription(description) == kBaseHash);
+
+		// 深度を使わないときの書き込みと比較
+		PipelineDescription noDepth = kBase;
+		noDepth.depthEnable = false;
+		description = noDepth;
+		description.depthWriteMask = 0;
+		description.depthFunc = 8;
+		CHECK(HashPipelineDescription(description) == HashPipelineDescription(noDepth));
+
+		// カリングしないときの表裏の向き
+		PipelineDescription noCull = kBase;
+		noCull.rasterizer.cullMode = kCullModeNone;
+		description = noCull;
+		description.rasterizer.frontCounterClockwise = true;
+		CHECK(HashPipelineDescription(description) == HashPipelineDescription(noCull));
+
+		// 揃えても、元の設定は変わらない
+		PipelineDescription normalized = NormalizePipelineDescription(description);
+		CHECK(normalized.rasterizer.frontCounterClockwise == false);
+		CHECK(description.rasterizer.frontCounterClockwise == true);
+		CHECK(normalized.inputLayout[0].semanticName == "POSITION");
+
+		// 揃えたものをもう一度揃えても変わらない
+		CHECK(HashPipelineDescription(normalized) == HashPipelineDescription(description));
+	}
+
+	/// <summary>
+	/// 同じハッシュなら作り直さずに、同じ番号を返す
+	/// </summary>
+	void TestCacheTable()
+	{
+		PipelineCacheTable table{};
+		int createCount = 0;
+		int pipelines[3] = {};
+
+		uint32_t a = FindOrCreatePipeline(table, 100, [&]() -> void* { createCount++; return &pipelines[0]; }, false);
+		uint32_t b = FindOrCreatePipeline(table, 200, [&]() -> void* { createCount++; return &pipelines[1]; }, false);
+		uint32_t c = FindOrCreatePipeline(table, 100, [&]() -> void* { createCount++; return &pipelines[2]; }, false);
+
+		CHECK(a == c && a != b);
+		CHECK(createCount == 2);
+		CHECK(table.hitCount == 1 && table.missCount == 2);
+		CHECK(GetPipeline(table, a, false) == &pipelines[0]);
+		CHECK(GetPipeline(table, b, true) == &pipelines[1]);
+	}
+
+	/// <summary>
+	/// 別のスレッドで作るときは、作り終わるまで待たなければnullptrを返す
+	/// </summary>
+	void TestCacheTableAsync()
+	{
+		PipelineCacheTable table{};
+		int pipeline = 0;
+
+		std::promise<void> release;
+		std::shared_future<void> released = release.get_future().share();
+		std::atomic<int> createCount = 0;
+
+		uint32_t slot = FindOrCreatePipeline(table, 300, [&, released]() -> void*
+			{
+				createCount++;
+				released.wait();
+				return &pipeline;
+			}, true);
+
+		// 作っている最中でも、同じハッシュなら作り直さない
+		CHECK(FindOrCreatePipeline(table, 300, [&]() -> void* { createCount++; return nullptr; }, true) == slot);
+		CHECK(GetPipeline(table, slot, false) == nullptr);
+		CHECK(GetPipelineStatus(table, slot) == PipelineCreateStatus::Pending);
+
+		release.set_value();
+		CHECK(GetPipeline(table, slot, true) == &pipeline);
+		CHECK(GetPipeline(table, slot, false) == &pipeline);
+		CHECK(GetPipelineStatus(table, slot) == PipelineCreateStatus::Ready);
+		CHECK(createCount == 1);
+	}
+
+	/// <summary>
+	/// 作れなかったパイプラインは、表から外せば次に求められたときに作り直す
+	/// </summary>
+	void TestCacheTableFailure()
+	{
+		PipelineCacheTable table{};
+		int pipeline = 0;
+		int createCount = 0;
+
+		for (bool isAsync : { false , true })
+		{
+			uint64_t hash = isAsync ? 500 : 400;
+
+			// 作れなかった
+			uint32_t failed = FindOrCreatePipeline(table, hash, [&]() -> void* { createCount++; return nullptr; }, isAsync);
+			CHECK(GetPipeline(table, failed, true) == nullptr);
+			CHECK(GetPipelineStatus(table, failed) == PipelineCreateStatus::Failed);
+
+			// 外す前は、同じハッシュなら作れなかったものを返す
+			CHECK(FindOrCreatePipeline(table, hash, [&]() -> void* { createCount++; return &pipeline; }, isAsync) == failed);
+
+			// 外すと作り直し、新しい番号になる
+			ErasePipeline(table, failed);
+			uint32_t created = FindOrCreatePipeline(table, hash, [&]() -> void* { createCount++; return &pipeline; }, isAsync);
+			CHECK(created != failed);
+			CHECK(GetPipeline(table, created, true) == &pipeline);
+			CHECK(GetPipelineStatus(table, created) == PipelineCreateStatus::Ready);
+
+			// 古い番号をもう一度外しても、作り直したものは残る
+			ErasePipeline(table, failed);
+			CHECK(FindOrCreatePipeline(table, hash, [&]() -> void* { createCount++; return nullptr; }, isAsync) == created);
+		}
+
+		CHECK(createCount == 4);
+		CHECK(table.missCount == 4 && table.hitCount == 4);
+	}
+}
+
+int main()
+{
+	TestHash();
+	TestHashChanges();
+	TestHashIgnores();
+	TestCacheTable();
+	TestCacheTableAsync();
+	TestCacheTableFailure();
+
+	return FinishTest("PipelineDescriptionTest");
+}
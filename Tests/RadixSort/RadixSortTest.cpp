@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Func/RadixSort/RadixSort.h"
+#include "TestCheck.h"
+
+/*
+	RadixSortのテスト
+	std::stable_sortで並べた結果と、キーと元の番号が全て一致するかを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 再現できる64bitの乱数
+	/// </summary>
+	uint64_t RandomUint64(uint64_t& state)
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return state ^ (state >> 29);
+	}
+
+	/// <summary>
+	/// std::stable_sortと同じ並びになる
+	/// </summary>
+	void CheckSorted(const std::vector<uint64_t>& keys, std::vector<RadixSortEntry>& buffer)
+	{
+		std::vector<RadixSortEntry> entries(keys.size());
+		for (uint32_t i = 0; i < keys.size(); i++)
+		{
+			entries[i] = RadixSortEntry{ keys[i] , i };
+		}
+
+		std::vector<RadixSortEntry> expected = entries;
+		std::stable_sort(expected.begin(), expected.end(), [](const RadixSortEntry& a, const RadixSortEntry& b) { return a.key < b.key; });
+
+		RadixSort(entries, buffer);
+
+		CHECK(entries.size() == expected.size());
+		for (size_t i = 0; i < entries.size() && i < expected.size(); i++)
+		{
+			CHECK(entries[i].key == expected[i].key && entries[i].index == expected[i].index);
+		}
+	}
+
+	/// <summary>
+	/// 要素が0個、1個のとき
+	/// </summary>
+	void TestTiny()
+	{
+		std::vector<RadixSortEntry> buffer;
+		CheckSorted({}, buffer);
+		CheckSorted({ 42 }, buffer);
+		CheckSorted({ UINT64_MAX , 0 }, buffer);
+	}
+
+	/// <summary>
+	/// 特定のバイトだけが違うキー（飛ばすバイトと、並べ替えるバイトが混ざる）
+	/// </summary>
+	void TestSingleByteKeys()
+	{
+		std::vector<RadixSortEntry> buffer;
+		uint64_t state = 1;
+
+		for (uint32_t byte = 0; byte < 8; byte++)
+		{
+			std::vector<uint64_t> keys(500);
+			for (uint64_t& key : keys)
+			{
+				key = (RandomUint64(state) & 0xFF) << (byte * 8);
+			}
+			CheckSorted(keys, buffer);
+		}
+
+		// 全て同じキーなら元の並びのまま
+		CheckSorted(std::vector<uint64_t>(300, 0x0123456789ABCDEFull), buffer);
+	}
+
+	/// <summary>
+	/// 重複の多いキーと、全てのビットを使うキー
+	/// </summary>
+	void TestRandom()
+	{
+		std::vector<RadixSortEntry> buffer;
+		uint64_t state = 2;
+
+		for (size_t count : { 2u , 17u , 1000u , 100000u })
+		{
+			std::vector<uint64_t> keys(count);
+			for (uint64_t& key : keys)
+			{
+				key = RandomUint64(state);
+			}
+			CheckSorted(keys, buffer);
+
+			// 重複が多い（安定であることが結果に出る）
+			for (uint64_t& key : keys)
+			{
+				key = (RandomUint64(state) % 16) << 40 | (RandomUint64(state) % 4);
+			}
+			CheckSorted(keys, buffer);
+
+			// 既に並んでいる、逆に並んでいる
+			std::sort(keys.begin(), keys.end());
+			CheckSorted(keys, buffer);
+			std::reverse(keys.begin(), keys.end());
+			CheckSorted(keys, buffer);
+		}
+	}
+}
+
+int main()
+{
+	TestTiny();
+	TestSingleByteKeys();
+	TestRandom();
+
+	return FinishTest("RadixSortTest");
+}
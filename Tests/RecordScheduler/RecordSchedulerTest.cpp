@@ -0,0 +1,251 @@
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "Func/RecordScheduler/RecordScheduler.h"
+#include "TestCheck.h"
+
+/*
+	RecordSchedulerのテスト
+	範囲の分け方、記録先の使い回し、範囲ごとの記録を確かめる
+	commandListの代わりに、記録先ごとにコマンドの番号を積む配列を使う
+*/
+
+namespace
+{
+	/// <summary>
+	/// 範囲が隙間なく順に並び、大きさの差が1以下で、最低限の数を守る
+	/// </summary>
+	void TestPartitionRecordRanges()
+	{
+		CHECK(PartitionRecordRanges(0, 8, 1).empty());
+
+		for (uint32_t itemCount : { 1u , 5u , 63u , 64u , 1000u , 4097u })
+		{
+			for (uint32_t workerCount : { 1u , 3u , 8u })
+			{
+				for (uint32_t minItems : { 1u , 16u , 256u })
+				{
+					std::vector<RecordRange> ranges = PartitionRecordRanges(itemCount, workerCount, minItems);
+
+					CHECK(!ranges.empty());
+					CHECK(ranges.size() <= workerCount);
+
+					uint32_t begin = 0;
+					uint32_t minCount = UINT32_MAX;
+					uint32_t maxCount = 0;
+					for (const RecordRange& range : ranges)
+					{
+						CHECK(range.begin == begin);
+						begin += range.count;
+						minCount = (std::min)(minCount, range.count);
+						maxCount = (std::max)(maxCount, range.count);
+					}
+					CHECK(begin == itemCount);
+					CHECK(maxCount - minCount <= 1);
+
+					// 2つ以上に分けるのは、どの範囲も最低限の数を満たせるときだけ
+					if (ranges.size() > 1)
+					{
+						CHECK(minCount >= minItems);
+					}
+
+					// 同じ引数なら同じ分け方
+					std::vector<RecordRange> again = PartitionRecordRanges(itemCount, workerCount, minItems);
+					CHECK(again.size() == ranges.size());
+					for (size_t i = 0; i < again.size() && i < ranges.size(); i++)
+					{
+						CHECK(again[i].begin == ranges[i].begin && again[i].count == ranges[i].count);
+					}
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// GPUが使い終わった記録先だけを使い回す
+	/// </summary>
+	void TestRecordContextPool()
+	{
+		RecordContextPool pool{};
+
+		// 1フレーム目は新しく作る
+		CHECK(AcquireRecordContext(pool, 0) == 0);
+		CHECK(AcquireRecordContext(pool, 0) == 1);
+		CHECK(pool.contextCount == 2);
+		CHECK(pool.frameContexts.size() == 2);
+		FinishRecordContextFrame(pool, 1);
+		CHECK(pool.frameContexts.empty());
+
+		// GPUがまだ1に届いていなければ、新しく作る
+		CHECK(AcquireRecordContext(pool, 0) == 2);
+		FinishRecordContextFrame(pool, 2);
+		CHECK(pool.contextCount == 3);
+
+		// 1に届いたら、1フレーム目の記録先を使い回す
+		uint32_t first = AcquireRecordContext(pool, 1);
+		uint32_t second = AcquireRecordContext(pool, 1);
+		CHECK(first <= 1 && second <= 1 && first != second);
+		CHECK(pool.contextCount == 3);
+
+		// 3つ目は2フレーム目のものがまだ使えないので、新しく作る
+		CHECK(AcquireRecordContext(pool, 1) == 3);
+		FinishRecordContextFrame(pool, 3);
+
+		// 全て使い終われば、作らずに済む
+		for (int i = 0; i < 4; i++)
+		{
+			CHECK(AcquireRecordContext(pool, 3) < 4);
+		}
+		CHECK(pool.contextCount == 4);
+	}
+
+	/// <summary>
+	/// 全ての範囲が1回ずつ、正しい番号で記録される
+	/// </summary>
+	void TestRecordRangesParallel()
+	{
+		RecordRangesParallel({}, [](uint32_t, const RecordRange&) { CHECK(false); });
+
+		std::vector<RecordRange> ranges = PartitionRecordRanges(1000, 6, 10);
+		std::vector<std::atomic<uint32_t>> recorded(1000);
+		std::vector<std::atomic<uint32_t>> rangeCalls(ranges.size());
+
+		for (int frame = 0; frame < 50; frame++)
+		{
+			RecordRangesParallel(ranges, [&](uint32_t rangeIndex, const RecordRange& range)
+				{
+					CHECK(range.begin == ranges[rangeIndex].begin);
+					rangeCalls[rangeIndex].fetch_add(1);
+
+					for (uint32_t i = range.begin; i < range.begin + range.count; i++)
+					{
+						recorded[i].fetch_add(1);
+					}
+				});
+		}
+
+		for (size_t i = 0; i < ranges.size(); i++)
+		{
+			CHECK(rangeCalls[i].load() == 50);
+		}
+		for (size_t i = 0; i < recorded.size(); i++)
+		{
+			CHECK(recorded[i].load() == 50);
+		}
+	}
+
+	/// <summary>
+	/// 描画1つ分のコマンドを積む（フレームと描画の番号で中身が決まる）
+	/// </summary>
+	void RecordItemCommands(std::vector<uint64_t>& commandLog, uint32_t frame, uint32_t item)
+	{
+		uint64_t frameBits = static_cast<uint64_t>(frame) << 32;
+
+		// マテリアルの切り替え（3つに1つ）と描画
+		if (item % 3 == 0)
+		{
+			commandLog.push_back(frameBits | 0x80000000ull | ((item * 2654435761u) % 17));
+		}
+		commandLog.push_back(frameBits | item);
+	}
+
+	/// <summary>
+	/// 範囲ごとの記録先に積んだコマンドを実行の順につなげると、1つの記録先に順に積んだものと同じになる
+	/// GPUが2フレーム遅れる状態で記録先を使い回し、まだ実行されていない記録先が書き換えられないことも確かめる
+	/// </summary>
+	void TestRecordRangesMatchSerial()
+	{
+		const uint64_t kFramesInFlight = 2;
+
+		// 提出したフレーム（実行されるまで、記録先の中身が変わってはならない）
+		typedef struct SubmittedFrame
+		{
+			uint64_t fenceValue;
+			std::vector<uint32_t> contextIndices;
+			std::vector<uint64_t> commands;
+		}SubmittedFrame;
+
+		RecordContextPool pool{};
+		std::vector<std::vector<uint64_t>> contextLogs;
+		std::deque<SubmittedFrame> submittedFrames;
+		uint64_t fenceValue = 0;
+
+		uint32_t state = 11;
+		for (uint32_t frame = 0; frame < 60; frame++)
+		{
+			// GPUはkFramesInFlightフレーム前まで実行し終えている
+			uint64_t completedFenceValue = (fenceValue > kFramesInFlight) ? fenceValue - kFramesInFlight : 0;
+			while (!submittedFrames.empty() && submittedFrames.front().fenceValue <= completedFenceValue)
+			{
+				// 実行した時点の中身が、提出したときと同じ
+				std::vector<uint64_t> executed;
+				for (uint32_t contextIndex : submittedFrames.front().contextIndices)
+				{
+					executed.insert(executed.end(), contextLogs[contextIndex].begin(), contextLogs[contextIndex].end());
+				}
+				CHECK(executed == submittedFrames.front().commands);
+				submittedFrames.pop_front();
+			}
+
+			// 描画とスレッドの数はフレームごとに変わる
+			state = state * 1664525u + 1013904223u;
+			uint32_t itemCount = (state >> 8) % 3000;
+			uint32_t workerCount = 1 + (state >> 20) % 8;
+			std::vector<RecordRange> ranges = PartitionRecordRanges(itemCount, workerCount, 32);
+
+			// 記録先は範囲の順に取得し、中身を捨ててから使う
+			std::vector<uint32_t> rangeContexts(ranges.size());
+			for (size_t i = 0; i < ranges.size(); i++)
+			{
+				rangeContexts[i] = AcquireRecordContext(pool, completedFenceValue);
+				if (rangeContexts[i] == contextLogs.size())
+				{
+					contextLogs.emplace_back();
+				}
+				contextLogs[rangeContexts[i]].clear();
+			}
+			CHECK(pool.frameContexts == rangeContexts);
+
+			RecordRangesParallel(ranges, [&](uint32_t rangeIndex, const RecordRange& range)
+				{
+					std::vector<uint64_t>& commandLog = contextLogs[rangeContexts[rangeIndex]];
+					for (uint32_t item = range.begin; item < range.begin + range.count; item++)
+					{
+						RecordItemCommands(commandLog, frame, item);
+					}
+				});
+
+			// 1つの記録先に順に積んだもの
+			std::vector<uint64_t> serial;
+			for (uint32_t item = 0; item < itemCount; item++)
+			{
+				RecordItemCommands(serial, frame, item);
+			}
+
+			// 実行の順（取得した順）につなげる
+			std::vector<uint64_t> concatenated;
+			for (uint32_t contextIndex : pool.frameContexts)
+			{
+				concatenated.insert(concatenated.end(), contextLogs[contextIndex].begin(), contextLogs[contextIndex].end());
+			}
+			CHECK(concatenated == serial);
+
+			submittedFrames.push_back(SubmittedFrame{ ++fenceValue , pool.frameContexts , serial });
+			FinishRecordContextFrame(pool, fenceValue);
+		}
+
+		// 記録先は同時に使う分までしか増えない（3フレーム分 x 最大8範囲）
+		CHECK(pool.contextCount <= (kFramesInFlight + 1) * 8);
+	}
+}
+
+int main()
+{
+	TestPartitionRecordRanges();
+	TestRecordContextPool();
+	TestRecordRangesParallel();
+	TestRecordRangesMatchSerial();
+
+	return FinishTest("RecordSchedulerTest");
+}
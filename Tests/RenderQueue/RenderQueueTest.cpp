@@ -0,0 +1,203 @@
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Func/RenderQueue/RenderQueue.h"
+#include "TestCheck.h"
+
+/*
+	RenderQueueのテスト
+	ソートキーの優先順と、並べ替えた後に省く状態の切り替えを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	/// <summary>
+	/// 各項目が決められたビットに入り、上位の項目ほど優先される
+	/// </summary>
+	void TestSortKey()
+	{
+		const uint32_t kPassMax = (1u << kRenderSortKeyPassBits) - 1;
+		const uint32_t kPipelineMax = (1u << kRenderSortKeyPipelineBits) - 1;
+		const uint32_t kMaterialMax = (1u << kRenderSortKeyMaterialBits) - 1;
+
+		CHECK(kRenderSortKeyPassBits + kRenderSortKeyPipelineBits + kRenderSortKeyMaterialBits + kRenderSortKeyDepthBits == 64);
+		CHECK(MakeRenderSortKey(0, 0, 0, 0.0f) == 0);
+		CHECK(MakeRenderSortKey(kPassMax, kPipelineMax, kMaterialMax, 1.0f) == UINT64_MAX);
+
+		// 項目ごとのビットの位置
+		const uint32_t kMaterialShift = kRenderSortKeyDepthBits;
+		const uint32_t kPipelineShift = kMaterialShift + kRenderSortKeyMaterialBits;
+		const uint32_t kPassShift = kPipelineShift + kRenderSortKeyPipelineBits;
+		CHECK(MakeRenderSortKey(1, 0, 0, 0.0f) == 1ull << kPassShift);
+		CHECK(MakeRenderSortKey(0, 1, 0, 0.0f) == 1ull << kPipelineShift);
+		CHECK(MakeRenderSortKey(0, 0, 1, 0.0f) == 1ull << kMaterialShift);
+
+		// 下位の項目が最大でも、上位の項目が1つ大きい方が後
+		CHECK(MakeRenderSortKey(0, kPipelineMax, kMaterialMax, 1.0f) < MakeRenderSortKey(1, 0, 0, 0.0f));
+		CHECK(MakeRenderSortKey(0, 0, kMaterialMax, 1.0f) < MakeRenderSortKey(0, 1, 0, 0.0f));
+		CHECK(MakeRenderSortKey(0, 0, 0, 1.0f) < MakeRenderSortKey(0, 0, 1, 0.0f));
+	}
+
+	/// <summary>
+	/// 深度は手前から順に並び、範囲外とNaNは端に丸める
+	/// </summary>
+	void TestSortKeyDepth()
+	{
+		const uint64_t kDepthMask = (1ull << kRenderSortKeyDepthBits) - 1;
+
+		uint64_t previous = MakeRenderSortKey(0, 3, 5, 0.0f);
+		for (int i = 1; i <= 1000; i++)
+		{
+			uint64_t key = MakeRenderSortKey(0, 3, 5, i / 1000.0f);
+			CHECK(key >= previous);
+			CHECK((key >> kRenderSortKeyDepthBits) == (MakeRenderSortKey(0, 3, 5, 0.0f) >> kRenderSortKeyDepthBits));
+			previous = key;
+		}
+
+		// 十分離れた深度は区別できる
+		CHECK(MakeRenderSortKey(0, 0, 0, 0.5f) < MakeRenderSortKey(0, 0, 0, 0.5f + 1e-6f));
+
+		CHECK((MakeRenderSortKey(0, 0, 0, -3.0f) & kDepthMask) == 0);
+		CHECK((MakeRenderSortKey(0, 0, 0, 7.0f) & kDepthMask) == kDepthMask);
+		CHECK((MakeRenderSortKey(0, 0, 0, std::numeric_limits<float>::infinity()) & kDepthMask) == kDepthMask);
+		CHECK((MakeRenderSortKey(0, 0, 0, std::numeric_limits<float>::quiet_NaN()) & kDepthMask) == kDepthMask);
+
+		// 深度は上位の項目に溢れない
+		CHECK((MakeRenderSortKey(0, 0, 0, 7.0f) >> kRenderSortKeyDepthBits) == 0);
+	}
+
+	/// <summary>
+	/// 小さな例で、並びと切り替えを直接確かめる
+	/// </summary>
+	void TestSmall()
+	{
+		RenderQueue queue{};
+		ClearRenderQueue(queue);
+
+		// pipeline, material, mesh
+		PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(0, 1, 0, 0.2f) , 1 , 0 , 7 , 0 });
+		PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(0, 0, 2, 0.5f) , 0 , 2 , 7 , 1 });
+		PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(0, 0, 2, 0.1f) , 0 , 2 , 8 , 2 });
+		PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(1, 0, 0, 0.0f) , 0 , 0 , 8 , 3 });
+		PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(0, 1, 0, 0.2f) , 1 , 0 , 7 , 4 });
+		SortRenderQueue(queue);
+
+		CHECK(queue.commands.size() == 5);
+		if (queue.commands.size() == 5)
+		{
+			// 同じキーは積まれた順
+			const uint32_t kExpectedOrder[] = { 2 , 1 , 0 , 4 , 3 };
+			const uint32_t kExpectedChanges[] =
+			{
+				kRenderStateChangeAll,
+				kRenderStateChangeMesh,
+				kRenderStateChangePipeline | kRenderStateChangeMaterial,
+				kRenderStateChangeNone,
+				kRenderStateChangePipeline | kRenderStateChangeMesh,
+			};
+
+			for (size_t i = 0; i < 5; i++)
+			{
+				CHECK(queue.commands[i].packetIndex == kExpectedOrder[i]);
+				CHECK(queue.commands[i].stateChanges == kExpectedChanges[i]);
+			}
+		}
+
+		CHECK(queue.stats.drawCount == 5);
+		CHECK(queue.stats.pipelineChanges == 3 && queue.stats.materialChanges == 2 && queue.stats.meshChanges == 3);
+		CHECK(queue.stats.removedStateChanges == 15 - 8);
+
+		// 次のフレームは空から始まる
+		ClearRenderQueue(queue);
+		SortRenderQueue(queue);
+		CHECK(queue.commands.empty() && queue.stats.drawCount == 0 && queue.stats.removedStateChanges == 0);
+	}
+
+	/// <summary>
+	/// ばらばらに積んでも、キーの順に並び、切り替えは直前の描画との違いと一致する
+	/// </summary>
+	void TestRandom()
+	{
+		RenderQueue queue{};
+		uint32_t state = 6;
+
+		for (int frame = 0; frame < 3; frame++)
+		{
+			ClearRenderQueue(queue);
+
+			const uint32_t kPacketCount = 5000;
+			for (uint32_t i = 0; i < kPacketCount; i++)
+			{
+				uint32_t pass = RandomUint(state, 2);
+				uint32_t pipelineIndex = RandomUint(state, 4);
+				uint32_t materialIndex = RandomUint(state, 16);
+				uint32_t meshIndex = RandomUint(state, 8);
+				float depth = RandomUint(state, 1000) / 1000.0f;
+
+				PushRenderPacket(queue, RenderPacket{ MakeRenderSortKey(pass, pipelineIndex, materialIndex, depth) , pipelineIndex , materialIndex , meshIndex , i });
+			}
+			SortRenderQueue(queue);
+
+			CHECK(queue.commands.size() == kPacketCount);
+
+			// 全てのパケットが1回ずつ出てくる
+			std::vector<bool> isSeen(kPacketCount, false);
+			uint32_t changeCount = 0;
+
+			for (size_t i = 0; i < queue.commands.size(); i++)
+			{
+				const RenderCommand& command = queue.commands[i];
+				CHECK(command.packetIndex < kPacketCount && !isSeen[command.packetIndex]);
+				isSeen[command.packetIndex] = true;
+
+				const RenderPacket& packet = queue.packets[command.packetIndex];
+				if (i == 0)
+				{
+					CHECK(command.stateChanges == kRenderStateChangeAll);
+				}
+				else
+				{
+					const RenderPacket& previous = queue.packets[queue.commands[i - 1].packetIndex];
+					CHECK(previous.sortKey <= packet.sortKey);
+
+					// 同じキーは積まれた順
+					if (previous.sortKey == packet.sortKey)
+					{
+						CHECK(previous.drawIndex < packet.drawIndex);
+					}
+
+					CHECK(((command.stateChanges & kRenderStateChangePipeline) != 0) == (previous.pipelineIndex != packet.pipelineIndex));
+					CHECK(((command.stateChanges & kRenderStateChangeMaterial) != 0) == (previous.materialIndex != packet.materialIndex));
+					CHECK(((command.stateChanges & kRenderStateChangeMesh) != 0) == (previous.meshIndex != packet.meshIndex));
+				}
+
+				changeCount += (command.stateChanges & kRenderStateChangePipeline) ? 1 : 0;
+				changeCount += (command.stateChanges & kRenderStateChangeMaterial) ? 1 : 0;
+				changeCount += (command.stateChanges & kRenderStateChangeMesh) ? 1 : 0;
+			}
+
+			// パス、パイプラインの切り替えは組み合わせの数まで減る
+			CHECK(queue.stats.pipelineChanges <= 2 * 4 + 1);
+			CHECK(queue.stats.removedStateChanges == kPacketCount * 3 - changeCount);
+		}
+	}
+}
+
+int main()
+{
+	TestSortKey();
+	TestSortKeyDepth();
+	TestSmall();
+	TestRandom();
+
+	return FinishTest("RenderQueueTest");
+}
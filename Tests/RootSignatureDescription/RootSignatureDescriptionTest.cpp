@@ -0,0 +1,215 @@
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+#include "Func/RootSignatureDescription/RootSignatureDescription.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	RootSignatureDescriptionのテスト
+	シリアライズは、設定のハッシュをバイト列にするだけの偽物を使い、
+	ハッシュの区別と、バイナリのメモリとファイルへの保存を確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// 描画で使う形に近い設定（CBV、定数、Table、StaticSampler）
+	/// </summary>
+	RootSignatureDescription MakeBaseDescription()
+	{
+		RootSignatureDescription description{};
+		description.flags = kRootSignatureFlagAllowInputLayout;
+
+		AddRootDescriptor(description, kRootParameterTypeCBV, kRootShaderVisibilityVertex, 0);
+		AddRootConstants(description, kRootShaderVisibilityPixel, 1, 4);
+		AddRootDescriptorTable(description, kRootShaderVisibilityPixel,
+			{ RootDescriptorRangeDescription{ kRootDescriptorRangeTypeSRV , 1 , 0 , 0 , kRootDescriptorRangeOffsetAppend } });
+
+		RootStaticSamplerDescription sampler{};
+		sampler.filter = 0x15;
+		sampler.addressU = 1;
+		sampler.addressV = 1;
+		sampler.addressW = 1;
+		sampler.maxLOD = 3.402823466e+38f;
+		sampler.shaderVisibility = kRootShaderVisibilityPixel;
+		AddRootStaticSampler(description, sampler);
+
+		return description;
+	}
+
+	/// <summary>
+	/// 偽物のシリアライズ（ハッシュのバイト列を返す）
+	/// </summary>
+	std::vector<uint8_t> FakeSerialize(const RootSignatureDescription& description)
+	{
+		uint64_t hash = HashRootSignatureDescription(description);
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&hash);
+		return std::vector<uint8_t>(bytes, bytes + sizeof(hash));
+	}
+
+	/// <summary>
+	/// パラメータの番号と、rootSignatureの大きさ
+	/// </summary>
+	void TestBuild()
+	{
+		RootSignatureDescription description{};
+		CHECK(GetRootSignatureSize(description) == 0);
+
+		CHECK(AddRootDescriptor(description, kRootParameterTypeSRV, kRootShaderVisibilityAll, 0) == 0);
+		CHECK(GetRootSignatureSize(description) == 2);
+
+		CHECK(AddRootConstants(description, kRootShaderVisibilityAll, 0, 16) == 1);
+		CHECK(GetRootSignatureSize(description) == 18);
+
+		CHECK(AddRootDescriptorTable(description, kRootShaderVisibilityAll,
+			{ RootDescriptorRangeDescription{ kRootDescriptorRangeTypeSRV , kRootDescriptorRangeUnbounded , 0 , 1 , 0 } }) == 2);
+		CHECK(GetRootSignatureSize(description) == 19);
+
+		// StaticSamplerは大きさに含まれない
+		AddRootStaticSampler(description, RootStaticSamplerDescription{});
+		CHECK(GetRootSignatureSize(description) == 19);
+
+		// 上限までは積める
+		AddRootConstants(description, kRootShaderVisibilityAll, 1, kRootSignatureMaxSize - 19);
+		CHECK(GetRootSignatureSize(description) == kRootSignatureMaxSize);
+	}
+
+	/// <summary>
+	/// 結果に影響する値が違えば別のハッシュ、使わない項目だけが違えば同じハッシュ
+	/// </summary>
+	void TestHash()
+	{
+		const RootSignatureDescription kBase = MakeBaseDescription();
+		const uint64_t kBaseHash = HashRootSignatureDescription(kBase);
+		CHECK(HashRootSignatureDescription(MakeBaseDescription()) == kBaseHash);
+
+		RootSignatureDescription changed = kBase;
+		auto checkChanged = [&]()
+			{
+				CHECK(HashRootSignatureDescription(changed) != kBaseHash);
+				changed = kBase;
+			};
+
+		changed.flags = 0; checkChanged();
+		changed.parameters[0].parameterType = kRootParameterTypeSRV; checkChanged();
+		changed.parameters[0].shaderVisibility = kRootShaderVisibilityAll; checkChanged();
+		changed.parameters[0].shaderRegister = 1; checkChanged();
+		changed.parameters[0].registerSpace = 1; checkChanged();
+		changed.parameters[1].num32BitValues = 3; checkChanged();
+		changed.parameters[2].ranges[0].rangeType = kRootDescriptorRangeTypeUAV; checkChanged();
+		changed.parameters[2].ranges[0].numDescriptors = 2; checkChanged();
+		changed.parameters[2].ranges[0].baseShaderRegister = 1; checkChanged();
+		changed.parameters[2].ranges[0].registerSpace = 1; checkChanged();
+		changed.parameters[2].ranges[0].offsetInDescriptorsFromTableStart = 0; checkChanged();
+		changed.parameters[2].ranges.push_back(changed.parameters[2].ranges[0]); checkChanged();
+		std::swap(changed.parameters[0], changed.parameters[1]); checkChanged();
+		changed.parameters.pop_back(); checkChanged();
+		changed.staticSamplers[0].filter = 0; checkChanged();
+		changed.staticSamplers[0].addressW = 3; checkChanged();
+		changed.staticSamplers[0].mipLODBias = 1.0f; checkChanged();
+		changed.staticSamplers[0].maxLOD = 0.0f; checkChanged();
+		changed.staticSamplers[0].shaderRegister = 1; checkChanged();
+		changed.staticSamplers.clear(); checkChanged();
+
+		// 種類ごとに使わない項目は見ない
+		RootSignatureDescription ignored = kBase;
+		ignored.parameters[0].num32BitValues = 7;
+		ignored.parameters[2].shaderRegister = 5;
+		ignored.parameters[2].registerSpace = 2;
+		CHECK(HashRootSignatureDescription(ignored) == kBaseHash);
+	}
+
+	/// <summary>
+	/// 同じ設定は1回だけシリアライズし、次の起動ではファイルから読む
+	/// </summary>
+	void TestBlobCache()
+	{
+		std::filesystem::path directory = MakeTestDirectory("RootSignatureDescription") / "blobs";
+		const RootSignatureDescription kBase = MakeBaseDescription();
+		const uint64_t kBaseHash = HashRootSignatureDescription(kBase);
+
+		uint32_t serializeCalls = 0;
+		auto serialize = [&](const RootSignatureDescription& description)
+			{
+				serializeCalls++;
+				return FakeSerialize(description);
+			};
+
+		// 初回はシリアライズして、フォルダを作って保存する
+		RootSignatureBlobCache cache{};
+		cache.directory = directory;
+		const std::vector<uint8_t>& blob = FindOrSerializeRootSignature(cache, kBase, serialize);
+		CHECK(blob == FakeSerialize(kBase));
+		CHECK(cache.serializeCount == 1 && serializeCalls == 1);
+		CHECK(CountTestFiles(directory, ".bin") == 1);
+		CHECK(CountTestFiles(directory, ".tmp") == 0);
+
+		// 2回目はメモリから（同じバイナリを返す）
+		CHECK(&FindOrSerializeRootSignature(cache, kBase, serialize) == &blob);
+		CHECK(cache.hitCount == 1 && serializeCalls == 1);
+
+		// 次の起動ではファイルから読む
+		RootSignatureBlobCache nextCache{};
+		nextCache.directory = directory;
+		CHECK(FindOrSerializeRootSignature(nextCache, kBase, serialize) == FakeSerialize(kBase));
+		CHECK(nextCache.loadCount == 1 && nextCache.serializeCount == 0 && serializeCalls == 1);
+
+		// 使えなかったバイナリを消すと、次はシリアライズし直す
+		EraseRootSignatureBlob(nextCache, kBaseHash);
+		CHECK(CountTestFiles(directory, ".bin") == 0);
+		FindOrSerializeRootSignature(nextCache, kBase, serialize);
+		CHECK(nextCache.serializeCount == 1 && serializeCalls == 2);
+
+		// 設定が違えば別のファイル
+		RootSignatureDescription other = kBase;
+		other.flags = 0;
+		FindOrSerializeRootSignature(nextCache, other, serialize);
+		CHECK(CountTestFiles(directory, ".bin") == 2);
+	}
+
+	/// <summary>
+	/// シリアライズに失敗したものと、保存できなかったものは残さない
+	/// </summary>
+	void TestBlobCacheFailures()
+	{
+		std::filesystem::path directory = MakeTestDirectory("RootSignatureDescriptionFailure");
+		const RootSignatureDescription kBase = MakeBaseDescription();
+
+		// シリアライズに失敗したら空を返し、覚えない
+		RootSignatureBlobCache cache{};
+		cache.directory = directory;
+		CHECK(FindOrSerializeRootSignature(cache, kBase, [](const RootSignatureDescription&) { return std::vector<uint8_t>{}; }).empty());
+		CHECK(cache.blobs.empty() && cache.serializeCount == 0);
+		CHECK(CountTestFiles(directory, ".bin") == 0);
+
+		// 保存先がファイルで書けなくても、メモリには残して使える
+		std::filesystem::path notDirectory = directory / "NotADirectory";
+		WriteTestFile(notDirectory, "file");
+
+		RootSignatureBlobCache brokenCache{};
+		brokenCache.directory = notDirectory;
+		CHECK(FindOrSerializeRootSignature(brokenCache, kBase, FakeSerialize) == FakeSerialize(kBase));
+		CHECK(brokenCache.serializeCount == 1);
+		CHECK(std::filesystem::is_regular_file(notDirectory));
+
+		// 保存先がなければ、ファイルを使わない
+		RootSignatureBlobCache memoryCache{};
+		CHECK(FindOrSerializeRootSignature(memoryCache, kBase, FakeSerialize) == FakeSerialize(kBase));
+		CHECK(FindOrSerializeRootSignature(memoryCache, kBase, FakeSerialize) == FakeSerialize(kBase));
+		CHECK(memoryCache.serializeCount == 1 && memoryCache.hitCount == 1);
+		EraseRootSignatureBlob(memoryCache, HashRootSignatureDescription(kBase));
+		CHECK(memoryCache.blobs.empty());
+	}
+}
+
+int main()
+{
+	TestBuild();
+	TestHash();
+	TestBlobCache();
+	TestBlobCacheFailures();
+
+	return FinishTest("RootSignatureDescriptionTest");
+}
@@ -0,0 +1,232 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Func/ShaderCache/ShaderCache.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	ShaderCacheのテスト
+	DXCの代わりに、ソースとマクロを並べたものをバイトコードとして返すコンパイラを使う
+*/
+
+namespace
+{
+	// 偽のコンパイラを呼んだ回数
+	uint32_t gCompileCount = 0;
+
+	/// <summary>
+	/// 偽のコンパイラ（ソースに "error" があれば失敗する）
+	/// </summary>
+	bool CompileFake(const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+	{
+		gCompileCount++;
+
+		std::ifstream file(request.sourcePath, std::ios::binary);
+		std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		if (source.find("error") != std::string::npos)
+		{
+			errors = request.sourcePath.string() + ": error";
+			return false;
+		}
+
+		std::string output = request.entryPoint + "|" + request.profile + "|" + source;
+		for (const std::string& define : request.defines)
+		{
+			output += "|" + define;
+		}
+
+		bytecode.assign(output.begin(), output.end());
+		return true;
+	}
+
+	/// <summary>
+	/// 1回コンパイルして、コンパイラを呼んだかを返す
+	/// </summary>
+	bool CompileAndCheckMiss(ShaderCache& cache, const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode)
+	{
+		uint32_t compileCount = gCompileCount;
+		std::string errors;
+
+		CHECK(CompileShaderCached(cache, request, CompileFake, bytecode, errors));
+		CHECK(errors.empty());
+
+		return gCompileCount != compileCount;
+	}
+
+	/// <summary>
+	/// ShaderCompileRequestを作る
+	/// </summary>
+	ShaderCompileRequest MakeRequest(const std::filesystem::path& sourcePath)
+	{
+		ShaderCompileRequest request{};
+		request.sourcePath = sourcePath;
+		request.entryPoint = "main";
+		request.profile = "vs_6_0";
+		return request;
+	}
+
+	/// <summary>
+	/// includeをたどる（コメントの中は見ない、見つからないものも含む）
+	/// </summary>
+	void TestCollectDependencies(const std::filesystem::path& root)
+	{
+		WriteTestFile(root / "Src/Main.hlsl",
+			"#include \"Common.hlsli\"\n"
+			"  #  include <Lighting.hlsli>\n"
+			"// #include \"Commented.hlsli\"\n"
+			"/* #include \"Block.hlsli\" */\n"
+			"#include \"Missing.hlsli\"\n");
+		WriteTestFile(root / "Src/Common.hlsli", "#include \"Main.hlsl\"\nfloat4 Common;\n");
+		WriteTestFile(root / "Include/Lighting.hlsli", "float4 Light;\n");
+
+		ShaderCache cache = MakeShaderCache(root / "Cache", true, "test");
+		cache.includeDirectories = { root / "Include" };
+
+		std::vector<std::filesystem::path> dependencies = CollectShaderDependencies(cache, root / "Src/Main.hlsl");
+
+		// 自身、書かれた順のinclude（循環は一度だけ）、見つからないもの
+		CHECK(dependencies.size() == 4);
+		if (dependencies.size() == 4)
+		{
+			CHECK(dependencies[0].filename() == "Main.hlsl");
+			CHECK(dependencies[1].filename() == "Common.hlsli");
+			CHECK(dependencies[2] == (root / "Include/Lighting.hlsli").lexically_normal());
+			CHECK(dependencies[3].filename() == "Missing.hlsli");
+		}
+	}
+
+	/// <summary>
+	/// 同じ内容なら読み、ハッシュに入るものが変われば、コンパイルし直す
+	/// </summary>
+	void TestHitAndInvalidation(const std::filesystem::path& root)
+	{
+		WriteTestFile(root / "Src/Object.hlsl", "#include \"Object.hlsli\"\nfloat4 main() : SV_POSITION { return 0; }\n");
+		WriteTestFile(root / "Src/Object.hlsli", "float4 Color;\n");
+
+		ShaderCache cache = MakeShaderCache(root / "Cache", true, "dxc 1.7");
+		ShaderCompileRequest request = MakeRequest(root / "Src/Object.hlsl");
+
+		std::vector<uint8_t> compiled;
+		std::vector<uint8_t> loaded;
+
+		CHECK(CompileAndCheckMiss(cache, request, compiled));
+		CHECK(!CompileAndCheckMiss(cache, request, loaded));
+		CHECK(loaded == compiled);
+		CHECK(cache.hitCount == 1 && cache.missCount == 1);
+		CHECK(CountTestFiles(cache.directory, ".cso") == 1);
+		CHECK(CountTestFiles(cache.directory, ".tmp") == 0);
+
+		// 別のShaderCacheからも読める（保存したファイルを使う）
+		ShaderCache other = MakeShaderCache(root / "Cache", true, "dxc 1.7");
+		CHECK(!CompileAndCheckMiss(other, request, loaded));
+		CHECK(loaded == compiled);
+
+		// includeの中身
+		WriteTestFile(root / "Src/Object.hlsli", "float4 Color2;\n");
+		CHECK(CompileAndCheckMiss(cache, request, compiled));
+		CHECK(!CompileAndCheckMiss(cache, request, loaded));
+
+		// マクロ、オプション、エントリーポイント
+		ShaderCompileRequest defined = request;
+		defined.defines = { "USE_FOG=1" };
+		CHECK(CompileAndCheckMiss(cache, defined, compiled));
+
+		ShaderCompileRequest optimized = request;
+		optimized.arguments = { "-O3" };
+		CHECK(CompileAndCheckMiss(cache, optimized, compiled));
+
+		ShaderCompileRequest entry = request;
+		entry.entryPoint = "mainInstanced";
+		CHECK(CompileAndCheckMiss(cache, entry, compiled));
+
+		// コンパイラの版
+		uint64_t hash = HashShaderCompileRequest(cache, request);
+		ShaderCache updated = MakeShaderCache(root / "Cache", true, "dxc 1.8");
+		CHECK(HashShaderCompileRequest(updated, request) != hash);
+		CHECK(CompileAndCheckMiss(updated, request, compiled));
+		CHECK(!CompileAndCheckMiss(cache, request, loaded));
+	}
+
+	/// <summary>
+	/// 失敗したものは保存しない
+	/// </summary>
+	void TestFailedCompileIsNotCached(const std::filesystem::path& root)
+	{
+		WriteTestFile(root / "Src/Broken.hlsl", "error\n");
+
+		ShaderCache cache = MakeShaderCache(root / "FailCache", true, "test");
+		ShaderCompileRequest request = MakeRequest(root / "Src/Broken.hlsl");
+
+		for (int i = 0; i < 2; i++)
+		{
+			std::vector<uint8_t> bytecode;
+			std::string errors;
+			CHECK(!CompileShaderCached(cache, request, CompileFake, bytecode, errors));
+			CHECK(errors.find("error") != std::string::npos);
+		}
+
+		CHECK(cache.missCount == 2 && cache.hitCount == 0);
+		CHECK(CountTestFiles(cache.directory, ".cso") == 0);
+	}
+
+	/// <summary>
+	/// 保存に失敗しても、コンパイルした結果は返し、書きかけのファイルを残さない
+	/// </summary>
+	void TestWriteFailure(const std::filesystem::path& root)
+	{
+		WriteTestFile(root / "Src/Write.hlsl", "float4 main() : SV_TARGET { return 1; }\n");
+
+		// 保存先の親がファイルなので、フォルダもファイルも作れない
+		WriteTestFile(root / "NotADirectory", "file");
+		ShaderCache cache = MakeShaderCache(root / "NotADirectory/Cache", true, "test");
+		ShaderCompileRequest request = MakeRequest(root / "Src/Write.hlsl");
+
+		std::vector<uint8_t> bytecode;
+		CHECK(CompileAndCheckMiss(cache, request, bytecode));
+		CHECK(!bytecode.empty());
+
+		// 保存できていないので、次もコンパイルする
+		CHECK(CompileAndCheckMiss(cache, request, bytecode));
+		CHECK(CountTestFiles(root, ".tmp") == 0);
+
+		// 空のファイル（壊れたもの）は使わない
+		ShaderCache emptyCache = MakeShaderCache(root / "EmptyCache", true, "test");
+		char name[32]{};
+		std::snprintf(name, sizeof(name), "%016llx.cso", static_cast<unsigned long long>(HashShaderCompileRequest(emptyCache, request)));
+		WriteTestFile(emptyCache.directory / name, "");
+		CHECK(CompileAndCheckMiss(emptyCache, request, bytecode));
+		CHECK(!CompileAndCheckMiss(emptyCache, request, bytecode));
+	}
+
+	/// <summary>
+	/// 使わない設定なら、毎回コンパイルする
+	/// </summary>
+	void TestDisabled(const std::filesystem::path& root)
+	{
+		ShaderCache cache = MakeShaderCache(root / "DisabledCache", false, "test");
+		ShaderCompileRequest request = MakeRequest(root / "Src/Write.hlsl");
+
+		std::vector<uint8_t> bytecode;
+		CHECK(CompileAndCheckMiss(cache, request, bytecode));
+		CHECK(CompileAndCheckMiss(cache, request, bytecode));
+		CHECK(!std::filesystem::exists(cache.directory));
+	}
+}
+
+int main()
+{
+	std::filesystem::path root = MakeTestDirectory("ShaderCache");
+
+	TestCollectDependencies(root);
+	TestHitAndInvalidation(root);
+	TestFailedCompileIsNotCached(root);
+	TestWriteFailure(root);
+	TestDisabled(root);
+
+	std::error_code error;
+	std::filesystem::remove_all(root, error);
+
+	return FinishTest("ShaderCacheTest");
+}
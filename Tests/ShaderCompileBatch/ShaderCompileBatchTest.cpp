@@ -0,0 +1,179 @@
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+#include "Func/ShaderCompileBatch/ShaderCompileBatch.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	ShaderCompileBatchのテスト
+	DXCの代わりに、作られた回数を数える偽のコンパイラを使う
+*/
+
+namespace
+{
+	// 偽のコンパイラを作った回数と、呼んだ回数
+	std::atomic<uint32_t> gCreateCount = 0;
+	std::atomic<uint32_t> gCompileCount = 0;
+
+	/// <summary>
+	/// 偽のコンパイラを作る（エントリーポイントとマクロを並べたものをバイトコードにする。"fail"なら失敗する）
+	/// </summary>
+	ShaderCompileFunction CreateFakeCompiler()
+	{
+		gCreateCount.fetch_add(1);
+
+		return [](const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+			{
+				gCompileCount.fetch_add(1);
+
+				if (request.entryPoint == "fail")
+				{
+					errors = "fail";
+					return false;
+				}
+
+				std::string output = request.entryPoint;
+				for (const std::string& define : request.defines)
+				{
+					output += "|" + define;
+				}
+
+				bytecode.assign(output.begin(), output.end());
+				return true;
+			};
+	}
+
+	/// <summary>
+	/// n個のジョブを作る
+	/// </summary>
+	std::vector<ShaderCompileRequest> MakeJobs(const std::filesystem::path& sourcePath, uint32_t count)
+	{
+		std::vector<ShaderCompileRequest> jobs(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			jobs[i].sourcePath = sourcePath;
+			jobs[i].entryPoint = "main" + std::to_string(i);
+			jobs[i].profile = "ps_6_0";
+		}
+		return jobs;
+	}
+
+	/// <summary>
+	/// 結果はジョブの順に受け取れ、コンパイラはスレッドごとに1回しか作らない
+	/// </summary>
+	void TestPoolReusesCompilers()
+	{
+		const uint32_t kWorkerCount = 3;
+		gCreateCount = 0;
+		gCompileCount = 0;
+
+		ShaderCompilePool* pool = CreateShaderCompilePool(kWorkerCount, CreateFakeCompiler);
+
+		for (int batchIndex = 0; batchIndex < 5; batchIndex++)
+		{
+			std::vector<ShaderCompileRequest> jobs = MakeJobs("Fake.hlsl", 16);
+			jobs[3].entryPoint = "fail";
+
+			ShaderCompileBatch batch = StartShaderCompileBatch(pool, jobs, nullptr);
+
+			std::set<uint32_t> workerIndices;
+			for (uint32_t i = 0; i < static_cast<uint32_t>(jobs.size()); i++)
+			{
+				const ShaderCompileResult& result = WaitShaderCompileResult(batch, i);
+
+				CHECK(result.isSucceeded == (i != 3));
+				CHECK(!result.isCacheHit);
+				CHECK(result.workerIndex < kWorkerCount);
+				if (result.isSucceeded)
+				{
+					CHECK(std::string(result.bytecode.begin(), result.bytecode.end()) == jobs[i].entryPoint);
+				}
+				workerIndices.insert(result.workerIndex);
+			}
+
+			ShaderCompileBatchStats stats = FinishShaderCompileBatch(batch, nullptr);
+			CHECK(stats.workerCount == kWorkerCount);
+			CHECK(stats.failedCount == 1);
+			CHECK(stats.missCount == 16 && stats.hitCount == 0);
+			CHECK(stats.wallMilliseconds >= 0.0);
+
+			// 終わった後も結果を取得できる
+			CHECK(WaitShaderCompileResult(batch, 0).isSucceeded);
+		}
+
+		// ジョブより少ないスレッドの数を返す
+		ShaderCompileBatch small = StartShaderCompileBatch(pool, MakeJobs("Fake.hlsl", 2), nullptr);
+		CHECK(FinishShaderCompileBatch(small, nullptr).workerCount == 2);
+
+		ReleaseShaderCompilePool(pool);
+
+		CHECK(gCreateCount == kWorkerCount);
+		CHECK(gCompileCount == 5 * 16 + 2);
+	}
+
+	/// <summary>
+	/// 解放するときは、入っている仕事を終わらせる
+	/// </summary>
+	void TestReleaseFinishesQueuedTasks()
+	{
+		gCompileCount = 0;
+
+		ShaderCompilePool* pool = CreateShaderCompilePool(1, CreateFakeCompiler);
+		ShaderCompileBatch batch = StartShaderCompileBatch(pool, MakeJobs("Fake.hlsl", 64), nullptr);
+		ReleaseShaderCompilePool(pool);
+
+		CHECK(gCompileCount == 64);
+		CHECK(FinishShaderCompileBatch(batch, nullptr).missCount == 64);
+	}
+
+	/// <summary>
+	/// ShaderCacheを使うと、2回目のバッチは保存したものを読む
+	/// </summary>
+	void TestBatchWithCache()
+	{
+		std::filesystem::path root = MakeTestDirectory("ShaderCompileBatch");
+		WriteTestFile(root / "Object.hlsl", "float4 main() : SV_TARGET { return 1; }\n");
+
+		ShaderCache cache = MakeShaderCache(root / "Cache", true, "test");
+		ShaderCompilePool* pool = CreateShaderCompilePool(2, CreateFakeCompiler);
+
+		std::vector<ShaderCompileRequest> jobs = MakeJobs(root / "Object.hlsl", 6);
+		jobs[5].defines = { "USE_FOG=1" };
+
+		for (int batchIndex = 0; batchIndex < 2; batchIndex++)
+		{
+			ShaderCompileBatch batch = StartShaderCompileBatch(pool, jobs, &cache);
+
+			for (uint32_t i = 0; i < static_cast<uint32_t>(jobs.size()); i++)
+			{
+				const ShaderCompileResult& result = WaitShaderCompileResult(batch, i);
+				CHECK(result.isSucceeded);
+				CHECK(result.isCacheHit == (batchIndex == 1));
+			}
+
+			std::string last(WaitShaderCompileResult(batch, 5).bytecode.begin(), WaitShaderCompileResult(batch, 5).bytecode.end());
+			CHECK(last == "main5|USE_FOG=1");
+
+			FinishShaderCompileBatch(batch, &cache);
+		}
+
+		CHECK(cache.missCount == 6 && cache.hitCount == 6);
+
+		ReleaseShaderCompilePool(pool);
+
+		std::error_code error;
+		std::filesystem::remove_all(root, error);
+	}
+}
+
+int main()
+{
+	TestPoolReusesCompilers();
+	TestReleaseFinishesQueuedTasks();
+	TestBatchWithCache();
+
+	return FinishTest("ShaderCompileBatchTest");
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Func/ShaderCompileSettings/ShaderCompileSettings.h"
+#include "TestCheck.h"
+
+/*
+	ShaderCompileSettingsのテスト
+	モードごとに、DXCに渡すオプションが揃っているかを確かめる
+*/
+
+namespace
+{
+	/// <summary>
+	/// オプションが含まれているか
+	/// </summary>
+	bool HasArgument(const std::vector<std::string>& arguments, const std::string& argument)
+	{
+		return std::find(arguments.begin(), arguments.end(), argument) != arguments.end();
+	}
+
+	/// <summary>
+	/// Debugは最適化せず、デバッグ情報を埋め込み、リフレクションを残す
+	/// </summary>
+	void TestDebug()
+	{
+		ShaderCompileSettings settings = MakeShaderCompileSettings(ShaderCompileMode::Debug, "Pdb");
+		std::vector<std::string> arguments = MakeShaderCompileArguments(settings);
+
+		CHECK(HasArgument(arguments, "-Od"));
+		CHECK(HasArgument(arguments, "-Zi"));
+		CHECK(HasArgument(arguments, "-Qembed_debug"));
+		CHECK(!HasArgument(arguments, "-Qstrip_debug"));
+		CHECK(!HasArgument(arguments, "-Qstrip_reflect"));
+		CHECK(HasArgument(arguments, "-Zpr"));
+		CHECK(std::string(GetShaderCompileModeName(settings.mode)) == "Debug");
+	}
+
+	/// <summary>
+	/// Releaseは最適化し、デバッグ情報をPDBに書き出し、リフレクションを外す
+	/// </summary>
+	void TestRelease()
+	{
+		ShaderCompileSettings settings = MakeShaderCompileSettings(ShaderCompileMode::Release, "Build/Pdb");
+		std::vector<std::string> arguments = MakeShaderCompileArguments(settings);
+
+		CHECK(HasArgument(arguments, "-O3"));
+		CHECK(!HasArgument(arguments, "-Od"));
+		CHECK(HasArgument(arguments, "-Zi"));
+		CHECK(!HasArgument(arguments, "-Qembed_debug"));
+		CHECK(HasArgument(arguments, "-Qstrip_debug"));
+		CHECK(HasArgument(arguments, "-Zsb"));
+		CHECK(HasArgument(arguments, "-Qstrip_reflect"));
+		CHECK(HasArgument(arguments, "-Zpr"));
+
+		// -Fdの次はフォルダ（末尾の区切りでフォルダと分かり、名前はDXCが付ける）
+		auto fd = std::find(arguments.begin(), arguments.end(), "-Fd");
+		CHECK(fd != arguments.end() && fd + 1 != arguments.end());
+		if (fd != arguments.end() && fd + 1 != arguments.end())
+		{
+			CHECK(*(fd + 1) == "Build/Pdb/");
+		}
+
+		CHECK(std::string(GetShaderCompileModeName(settings.mode)) == "Release");
+	}
+
+	/// <summary>
+	/// Profileは最適化し、デバッグ情報を埋め込む
+	/// </summary>
+	void TestProfile()
+	{
+		ShaderCompileSettings settings = MakeShaderCompileSettings(ShaderCompileMode::Profile, "Pdb");
+		std::vector<std::string> arguments = MakeShaderCompileArguments(settings);
+
+		CHECK(HasArgument(arguments, "-O3"));
+		CHECK(HasArgument(arguments, "-Zi"));
+		CHECK(HasArgument(arguments, "-Qembed_debug"));
+		CHECK(!HasArgument(arguments, "-Fd"));
+		CHECK(!HasArgument(arguments, "-Qstrip_reflect"));
+		CHECK(std::string(GetShaderCompileModeName(settings.mode)) == "Profile");
+	}
+
+	/// <summary>
+	/// 書き換えた項目がオプションに出る
+	/// </summary>
+	void TestOverrides()
+	{
+		ShaderCompileSettings settings = MakeShaderCompileSettings(ShaderCompileMode::Release, "Pdb");
+
+		// 最適化のレベルは3まで
+		settings.optimizationLevel = 1;
+		CHECK(HasArgument(MakeShaderCompileArguments(settings), "-O1"));
+		settings.optimizationLevel = 9;
+		CHECK(HasArgument(MakeShaderCompileArguments(settings), "-O3"));
+
+		// デバッグ情報を作らないなら、関係するオプションは全て出さない
+		settings.isDebugInfo = false;
+		std::vector<std::string> arguments = MakeShaderCompileArguments(settings);
+		CHECK(!HasArgument(arguments, "-Zi"));
+		CHECK(!HasArgument(arguments, "-Qstrip_debug"));
+		CHECK(!HasArgument(arguments, "-Fd"));
+		CHECK(HasArgument(arguments, "-Qstrip_reflect"));
+	}
+}
+
+int main()
+{
+	TestDebug();
+	TestRelease();
+	TestProfile();
+	TestOverrides();
+
+	return FinishTest("ShaderCompileSettingsTest");
+}
@@ -0,0 +1,141 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Func/ShaderHotReload/ShaderHotReload.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	ShaderHotReloadのテスト
+	DXCの代わりに、ソースの中身をそのままバイトコードとして返すコンパイラを使う
+*/
+
+namespace
+{
+	// 偽のコンパイラを作った回数
+	std::atomic<uint32_t> gCreateCount = 0;
+
+	/// <summary>
+	/// 偽のコンパイラを作る（ソースに "error" があれば失敗する）
+	/// </summary>
+	ShaderCompileFunction CreateFakeCompiler()
+	{
+		gCreateCount.fetch_add(1);
+
+		return [](const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+			{
+				std::ifstream file(request.sourcePath, std::ios::binary);
+				std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+				if (source.find("error") != std::string::npos)
+				{
+					errors = "error";
+					return false;
+				}
+
+				bytecode.assign(source.begin(), source.end());
+				return true;
+			};
+	}
+
+	/// <summary>
+	/// コンパイルし直したものが出るまで更新する（出なければ空を返す）
+	/// </summary>
+	std::vector<uint32_t> UpdateUntilReloaded(ShaderHotReload& reload, uint32_t failedCount)
+	{
+		for (int i = 0; i < 2000; i++)
+		{
+			std::vector<uint32_t> reloaded = UpdateShaderHotReload(reload);
+			if (!reloaded.empty() || reload.failedCount != failedCount)
+			{
+				return reloaded;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return {};
+	}
+
+	/// <summary>
+	/// 読むファイルの表
+	/// </summary>
+	void TestDependencyGraph()
+	{
+		ShaderDependencyGraph graph{};
+		SetShaderDependencies(graph, 0, { "Shaders/A.hlsl" , "Shaders/Common.hlsli" });
+		SetShaderDependencies(graph, 2, { "Shaders/B.hlsl" , "Shaders/./Common.hlsli" , "Shaders/Light.hlsli" });
+
+		CHECK(FindAffectedShaders(graph, { "Shaders/Common.hlsli" }) == std::vector<uint32_t>({ 0 , 2 }));
+		CHECK(FindAffectedShaders(graph, { "Shaders/Light.hlsli" , "Shaders/A.hlsl" }) == std::vector<uint32_t>({ 0 , 2 }));
+		CHECK(FindAffectedShaders(graph, { "Shaders/Other.hlsli" }).empty());
+
+		// 登録し直すと、前に読んでいたファイルは外れる
+		SetShaderDependencies(graph, 2, { "Shaders/B.hlsl" });
+		CHECK(FindAffectedShaders(graph, { "Shaders/Common.hlsli" }) == std::vector<uint32_t>({ 0 }));
+		CHECK(graph.dependents.count("Shaders/Light.hlsli") == 0);
+	}
+
+	/// <summary>
+	/// includeを書き換えると、それを読むシェーダーだけをコンパイルし直す
+	/// </summary>
+	void TestReload(const std::filesystem::path& root)
+	{
+		WriteTestFile(root / "A.hlsl", "#include \"Common.hlsli\"\nA1\n");
+		WriteTestFile(root / "B.hlsl", "B1\n");
+		WriteTestFile(root / "Common.hlsli", "C1\n");
+
+		std::vector<ShaderCompileRequest> shaders(2);
+		shaders[0].sourcePath = root / "A.hlsl";
+		shaders[1].sourcePath = root / "B.hlsl";
+
+		gCreateCount = 0;
+		ShaderCompilePool* pool = CreateShaderCompilePool(2, CreateFakeCompiler);
+		ShaderHotReload reload = CreateShaderHotReload(shaders, MakeShaderCache(root / "Cache", false, "test"), pool, 0.0);
+
+		// include
+		WriteTestFile(root / "Common.hlsli", "C2\n");
+		CHECK(UpdateUntilReloaded(reload, 0) == std::vector<uint32_t>({ 0 }));
+		CHECK(reload.reloadCount == 1);
+
+		// シェーダー自身
+		WriteTestFile(root / "B.hlsl", "B2\n");
+		CHECK(UpdateUntilReloaded(reload, 0) == std::vector<uint32_t>({ 1 }));
+		const std::vector<uint8_t>& bytecode = GetReloadedShaderBytecode(reload, 1);
+		CHECK(std::string(bytecode.begin(), bytecode.end()) == "B2\n");
+
+		// 失敗したら、前のバイトコードを使い続ける
+		WriteTestFile(root / "B.hlsl", "error\n");
+		CHECK(UpdateUntilReloaded(reload, 0).empty());
+		CHECK(reload.failedCount == 1 && reload.lastErrors == "error");
+		CHECK(std::string(GetReloadedShaderBytecode(reload, 1).begin(), GetReloadedShaderBytecode(reload, 1).end()) == "B2\n");
+
+		// 直すときに増やしたincludeも見張る
+		WriteTestFile(root / "Light.hlsli", "L1\n");
+		WriteTestFile(root / "B.hlsl", "#include \"Light.hlsli\"\nB3\n");
+		CHECK(UpdateUntilReloaded(reload, 1) == std::vector<uint32_t>({ 1 }));
+		WriteTestFile(root / "Light.hlsli", "L2\n");
+		CHECK(UpdateUntilReloaded(reload, 1) == std::vector<uint32_t>({ 1 }));
+		CHECK(reload.reloadCount == 4);
+
+		ReleaseShaderHotReload(reload);
+		ReleaseShaderCompilePool(pool);
+
+		// 何度コンパイルし直しても、コンパイラはスレッドごとに1回しか作らない
+		CHECK(gCreateCount == 2);
+	}
+}
+
+int main()
+{
+	std::filesystem::path root = MakeTestDirectory("ShaderHotReload");
+
+	TestDependencyGraph();
+	TestReload(root);
+
+	std::error_code error;
+	std::filesystem::remove_all(root, error);
+
+	return FinishTest("ShaderHotReloadTest");
+}
@@ -0,0 +1,207 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Func/ShaderPermutation/ShaderPermutation.h"
+#include "TestCheck.h"
+#include "TestFile.h"
+
+/*
+	ShaderPermutationのテスト
+	DXCの代わりに、"UNUSED_" で始まるマクロを読まない偽のコンパイラを使い、
+	同じバイトコードになる組み合わせがまとまるかを確かめる
+*/
+
+namespace
+{
+	// 偽のコンパイラを呼んだ回数
+	std::atomic<uint32_t> gCompileCount = 0;
+
+	/// <summary>
+	/// 偽のコンパイラを作る（使うマクロだけを並べたものをバイトコードにする。QUALITY=HIGHとUSE_A=1が揃うと失敗する）
+	/// </summary>
+	ShaderCompileFunction CreateFakeCompiler()
+	{
+		return [](const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode, std::string& errors)
+			{
+				gCompileCount.fetch_add(1);
+
+				bool isHigh = false;
+				bool isA = false;
+				std::string output = request.entryPoint;
+
+				for (const std::string& define : request.defines)
+				{
+					isHigh |= define == "QUALITY=HIGH";
+					isA |= define == "USE_A=1";
+
+					if (define.rfind("UNUSED_", 0) != 0)
+					{
+						output += "|" + define;
+					}
+				}
+
+				if (isHigh && isA)
+				{
+					errors = "HIGH with A";
+					return false;
+				}
+
+				bytecode.assign(output.begin(), output.end());
+				return true;
+			};
+	}
+
+	/// <summary>
+	/// 機能（2 x 2 x 3 = 12通り）
+	/// </summary>
+	std::vector<ShaderFeature> MakeFeatures()
+	{
+		return { MakeShaderToggle("USE_A") , MakeShaderToggle("UNUSED_B") , ShaderFeature{ "QUALITY" , { "LOW" , "MID" , "HIGH" } } };
+	}
+
+	/// <summary>
+	/// 組み合わせの数え方と、番号の付け方
+	/// </summary>
+	void TestExpand()
+	{
+		CHECK(CountShaderPermutations({}) == 1);
+		CHECK(ExpandShaderPermutations({}).size() == 1);
+		CHECK(ExpandShaderPermutations({}).front().defines.empty());
+
+		std::vector<ShaderFeature> features = MakeFeatures();
+		CHECK(CountShaderPermutations(features) == 12);
+
+		std::vector<ShaderPermutation> permutations = ExpandShaderPermutations(features);
+		CHECK(permutations.size() == 12);
+
+		// 先頭の機能が一番細かく変わり、番号は並びと一致する
+		for (uint32_t i = 0; i < permutations.size(); i++)
+		{
+			const ShaderPermutation& permutation = permutations[i];
+			CHECK(GetShaderPermutationIndex(features, permutation.valueIndices) == i);
+			CHECK(permutation.valueIndices[0] == i % 2);
+			CHECK(permutation.valueIndices[1] == (i / 2) % 2);
+			CHECK(permutation.valueIndices[2] == i / 4);
+
+			CHECK(permutation.defines.size() == 3);
+			CHECK(permutation.defines[0] == "USE_A=" + features[0].values[permutation.valueIndices[0]]);
+			CHECK(permutation.defines[2] == "QUALITY=" + features[2].values[permutation.valueIndices[2]]);
+		}
+		CHECK((permutations[11].defines == std::vector<std::string>{ "USE_A=1" , "UNUSED_B=1" , "QUALITY=HIGH" }));
+	}
+
+	/// <summary>
+	/// 同じ中身のバイトコードは1つにまとめる
+	/// </summary>
+	void TestAddVariant()
+	{
+		ShaderPermutationSet set{};
+		CHECK(AddShaderPermutationVariant(set, 2, { 1 , 2 , 3 }) == 0);
+		CHECK(AddShaderPermutationVariant(set, 0, { 4 , 5 }) == 1);
+		CHECK(AddShaderPermutationVariant(set, 5, { 1 , 2 , 3 }) == 0);
+		CHECK(AddShaderPermutationVariant(set, 1, {}) == 2);
+		CHECK(AddShaderPermutationVariant(set, 3, {}) == 2);
+
+		CHECK(set.variants.size() == 3);
+		CHECK(set.variantIndices.size() == 6);
+		CHECK((set.variantIndices == std::vector<uint32_t>{ 1 , 2 , 0 , 2 , UINT32_MAX , 0 }));
+	}
+
+	/// <summary>
+	/// 全ての組み合わせをコンパイルし、使わないマクロだけが違う組み合わせは同じバイトコードを指す
+	/// </summary>
+	void TestCompile()
+	{
+		ShaderCompilePool* pool = CreateShaderCompilePool(3, CreateFakeCompiler);
+		std::vector<ShaderFeature> features = MakeFeatures();
+
+		ShaderCompileRequest request{};
+		request.sourcePath = "Fake.hlsl";
+		request.entryPoint = "main";
+		request.profile = "ps_6_0";
+		request.defines = { "COMMON=1" };
+
+		gCompileCount = 0;
+		ShaderPermutationSet set = CompileShaderPermutations(request, features, pool, nullptr);
+		CHECK(gCompileCount == 12);
+
+		// USE_A x QUALITY の6通りのうち、HIGHとAの組み合わせは失敗する
+		CHECK(set.variants.size() == 5);
+		CHECK(set.failedCount == 2);
+		CHECK(set.lastErrors == "HIGH with A");
+
+		for (uint32_t a = 0; a < 2; a++)
+		{
+			for (uint32_t quality = 0; quality < 3; quality++)
+			{
+				const std::vector<uint8_t>* off = FindShaderPermutation(set, { a , 0 , quality });
+				const std::vector<uint8_t>* on = FindShaderPermutation(set, { a , 1 , quality });
+
+				if (a == 1 && quality == 2)
+				{
+					CHECK(off == nullptr && on == nullptr);
+					continue;
+				}
+
+				// 使わないマクロだけが違えば、同じバイトコード
+				CHECK(off != nullptr && off == on);
+				if (off == nullptr)
+				{
+					continue;
+				}
+
+				// 全ての組み合わせに付けるマクロと、選んだマクロが渡っている
+				std::string expected = "main|COMMON=1|USE_A=" + features[0].values[a] + "|QUALITY=" + features[2].values[quality];
+				CHECK(std::string(off->begin(), off->end()) == expected);
+			}
+		}
+
+		ReleaseShaderCompilePool(pool);
+	}
+
+	/// <summary>
+	/// ShaderCacheを渡すと、2回目はコンパイラを呼ばずに同じ結果になる
+	/// </summary>
+	void TestCompileCached()
+	{
+		std::filesystem::path root = MakeTestDirectory("ShaderPermutation");
+		WriteTestFile(root / "Permutation.hlsl", "float4 main() : SV_TARGET { return QUALITY; }\n");
+
+		ShaderCompilePool* pool = CreateShaderCompilePool(2, CreateFakeCompiler);
+		ShaderCache cache = MakeShaderCache(root / "Cache", true, "test");
+		std::vector<ShaderFeature> features = MakeFeatures();
+
+		ShaderCompileRequest request{};
+		request.sourcePath = root / "Permutation.hlsl";
+		request.entryPoint = "main";
+		request.profile = "ps_6_0";
+
+		gCompileCount = 0;
+		ShaderPermutationSet first = CompileShaderPermutations(request, features, pool, &cache);
+		CHECK(gCompileCount == 12);
+		CHECK(cache.missCount == 12 && cache.hitCount == 0);
+
+		// 失敗した組み合わせは保存されないので、もう一度コンパイルする
+		gCompileCount = 0;
+		ShaderPermutationSet second = CompileShaderPermutations(request, features, pool, &cache);
+		CHECK(gCompileCount == 2);
+		CHECK(cache.hitCount == 10);
+
+		CHECK(second.variants == first.variants);
+		CHECK(second.variantIndices == first.variantIndices);
+		CHECK(second.failedCount == first.failedCount);
+
+		ReleaseShaderCompilePool(pool);
+	}
+}
+
+int main()
+{
+	TestExpand();
+	TestAddVariant();
+	TestCompile();
+	TestCompileCached();
+
+	return FinishTest("ShaderPermutationTest");
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+
+/*
+	テスト用の小さな確認マクロ
+	失敗しても止めずに数えて、最後にFinishTestで終了コードにする
+*/
+
+/// <summary>
+/// 失敗した数
+/// </summary>
+inline int& GetTestFailureCount()
+{
+	static int count = 0;
+	return count;
+}
+
+// 条件が成り立つか確かめる
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::fprintf(stderr, "%s(%d): CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+			GetTestFailureCount()++; \
+		} \
+	} while (false)
+
+// 2つの値の差がtolerance以下か確かめる
+#define CHECK_NEAR(actual, expected, tolerance) \
+	do \
+	{ \
+		double checkActual = static_cast<double>(actual); \
+		double checkExpected = static_cast<double>(expected); \
+		if (!(std::fabs(checkActual - checkExpected) <= (tolerance))) \
+		{ \
+			std::fprintf(stderr, "%s(%d): CHECK_NEAR failed: %s = %.9g, %s = %.9g\n", __FILE__, __LINE__, #actual, checkActual, #expected, checkExpected); \
+			GetTestFailureCount()++; \
+		} \
+	} while (false)
+
+/// <summary>
+/// 結果を出して、終了コードを返す
+/// </summary>
+/// <param name="name">テストの名前</param>
+/// <returns>全て成功なら0</returns>
+inline int FinishTest(const char* name)
+{
+	if (GetTestFailureCount() != 0)
+	{
+		std::fprintf(stderr, "%s: %d checks failed\n", name, GetTestFailureCount());
+		return 1;
+	}
+
+	std::printf("%s: passed\n", name);
+	return 0;
+}
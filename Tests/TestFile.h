@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/*
+	テストで使うファイルの用意
+*/
+
+/// <summary>
+/// 空のフォルダを作る（前回の残りがあれば消す）
+/// </summary>
+/// <param name="name">フォルダの名前（一時フォルダの下に作る）</param>
+/// <returns>フォルダのパス</returns>
+inline std::filesystem::path MakeTestDirectory(const std::string& name)
+{
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / ("DirectXTest_" + name);
+
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+	std::filesystem::create_directories(directory);
+
+	return directory;
+}
+
+/// <summary>
+/// ファイルを書く（フォルダがなければ作る）
+/// </summary>
+/// <param name="path">パス</param>
+/// <param name="contents">中身</param>
+inline void WriteTestFile(const std::filesystem::path& path, const std::string& contents)
+{
+	std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file << contents;
+}
+
+/// <summary>
+/// フォルダの中の、指定した拡張子のファイルの数を数える
+/// </summary>
+/// <param name="directory">フォルダ</param>
+/// <param name="extension">拡張子（".tmp" など）</param>
+/// <returns>ファイルの数（フォルダがなければ0）</returns>
+inline size_t CountTestFiles(const std::filesystem::path& directory, const std::string& extension)
+{
+	size_t count = 0;
+
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+	{
+		if (it->path().extension() == extension)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,162 @@
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "Func/UploadRingBuffer/UploadRingBuffer.h"
+#include "TestCheck.h"
+
+/*
+	UploadRingBufferのテスト
+	GPUの代わりに普通のメモリとFenceの値を使い、数フレーム遅れて読み終わる流れを再現する
+*/
+
+namespace
+{
+	// GPUアドレスの先頭（CPUアドレスと区別できる値）
+	const uint64_t kGpuBase = 0x10000000;
+
+	/// <summary>
+	/// 再現できる乱数（0 〜 range - 1）
+	/// </summary>
+	uint32_t RandomUint(uint32_t& state, uint32_t range)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) % range;
+	}
+
+	// GPUがまだ読んでいない領域と、書いた値
+	typedef struct PendingUpload
+	{
+		uint64_t fenceValue;
+		UploadAllocation allocation;
+		uint8_t value;
+	}PendingUpload;
+
+	/// <summary>
+	/// 切り出し、アラインメント、折り返し
+	/// </summary>
+	void TestAllocateAndWrap()
+	{
+		std::vector<uint8_t> memory(1024);
+		UploadRingBuffer ring = MakeUploadRingBuffer(memory.data(), kGpuBase, memory.size());
+
+		UploadAllocation a = AllocateUploadRingBuffer(ring, 100);
+		CHECK(a.cpuAddress == memory.data() && a.gpuAddress == kGpuBase && a.offset == 0 && a.size == 100);
+
+		// 次は256の倍数から
+		UploadAllocation b = AllocateUploadRingBuffer(ring, 300);
+		CHECK(b.offset == 256 && b.gpuAddress == kGpuBase + 256);
+
+		// 小さいアラインメント
+		UploadAllocation c = AllocateUploadRingBuffer(ring, 4, 4);
+		CHECK(c.offset == 556);
+		CHECK(GetUploadRingBufferUsedSize(ring) == 560);
+
+		// 0と、全体より大きいものは切り出さない
+		CHECK(AllocateUploadRingBuffer(ring, 0).cpuAddress == nullptr);
+		CHECK(AllocateUploadRingBuffer(ring, 2048).cpuAddress == nullptr);
+
+		// 末尾に入らないので先頭に戻りたいが、GPUが読んでいるので切り出せない
+		CHECK(AllocateUploadRingBuffer(ring, 300).cpuAddress == nullptr);
+		CHECK(GetUploadRingBufferUsedSize(ring) == 560);
+
+		// 読み終わる前は回収しない
+		FinishUploadRingBufferFrame(ring, 1);
+		ReclaimUploadRingBuffer(ring, 0);
+		CHECK(GetUploadRingBufferUsedSize(ring) == 560);
+
+		// 読み終われば、先頭に戻って切り出せる（末尾の余りの768〜1024は捨てる）
+		ReclaimUploadRingBuffer(ring, 1);
+		CHECK(GetUploadRingBufferUsedSize(ring) == 0);
+		UploadAllocation d = AllocateUploadRingBuffer(ring, 300);
+		CHECK(d.offset == 0 && d.cpuAddress == memory.data());
+		CHECK(GetUploadRingBufferUsedSize(ring) == 1024 - 560 + 300);
+
+		// 捨てた余りは回収されるまで使わないので、空いているのは読み終わった0〜560だけ
+		UploadAllocation e = AllocateUploadRingBuffer(ring, 200, 4);
+		CHECK(e.offset == 300);
+		CHECK(AllocateUploadRingBuffer(ring, 64, 4).cpuAddress == nullptr);
+		CHECK(AllocateUploadRingBuffer(ring, 60, 4).offset == 500);
+	}
+
+	/// <summary>
+	/// GPUが読んでいる領域は、回収するまで上書きしない
+	/// </summary>
+	void TestFramesInFlight()
+	{
+		const uint64_t kFrameLatency = 2;
+
+		std::vector<uint8_t> memory(8192);
+		UploadRingBuffer ring = MakeUploadRingBuffer(memory.data(), kGpuBase, memory.size());
+
+		std::deque<PendingUpload> pending;
+		uint32_t state = 1;
+		uint64_t completedFenceValue = 0;
+		uint32_t failedCount = 0;
+
+		for (uint64_t frame = 1; frame <= 500; frame++)
+		{
+			// GPUはkFrameLatencyフレーム遅れて読み終わる（読み終わるまで、書いた値が残っていること）
+			uint64_t nextCompleted = frame > kFrameLatency ? frame - kFrameLatency : 0;
+			while (!pending.empty() && pending.front().fenceValue <= nextCompleted)
+			{
+				const PendingUpload& upload = pending.front();
+				const uint8_t* bytes = static_cast<const uint8_t*>(upload.allocation.cpuAddress);
+				for (size_t i = 0; i < upload.allocation.size; i++)
+				{
+					if (bytes[i] != upload.value)
+					{
+						CHECK(bytes[i] == upload.value);
+						break;
+					}
+				}
+				pending.pop_front();
+			}
+			completedFenceValue = nextCompleted;
+			ReclaimUploadRingBuffer(ring, completedFenceValue);
+
+			// このフレームの書き込み（入らなければ諦める）
+			uint32_t uploadCount = 1 + RandomUint(state, 12);
+			for (uint32_t i = 0; i < uploadCount; i++)
+			{
+				size_t size = 16 + RandomUint(state, 600);
+				size_t alignment = RandomUint(state, 2) ? kUploadConstantBufferAlignment : 16;
+
+				UploadAllocation allocation = AllocateUploadRingBuffer(ring, size, alignment);
+				if (allocation.cpuAddress == nullptr)
+				{
+					failedCount++;
+					continue;
+				}
+
+				CHECK(allocation.offset % alignment == 0);
+				CHECK(allocation.offset + size <= memory.size());
+				CHECK(allocation.gpuAddress == kGpuBase + allocation.offset);
+				CHECK(GetUploadRingBufferUsedSize(ring) <= memory.size());
+
+				uint8_t value = static_cast<uint8_t>(frame * 31 + i);
+				std::memset(allocation.cpuAddress, value, size);
+				pending.push_back(PendingUpload{ frame , allocation , value });
+			}
+
+			FinishUploadRingBufferFrame(ring, frame);
+		}
+
+		// 足りなくなることもあるが、ほとんどは入る
+		CHECK(failedCount > 0);
+		CHECK(failedCount < 500);
+
+		// 全て読み終われば空になる
+		ReclaimUploadRingBuffer(ring, UINT64_MAX);
+		CHECK(GetUploadRingBufferUsedSize(ring) == 0);
+		CHECK(ring.frames.empty());
+	}
+}
+
+int main()
+{
+	TestAllocateAndWrap();
+	TestFramesInFlight();
+
+	return FinishTest("UploadRingBufferTest");
+}
@@ -4,6 +4,8 @@
 #include <fstream>
 #include <chrono>
 #include <cassert>
+#include <thread>
+#include <vector>
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <dxcapi.h>
@@ -14,7 +16,21 @@
 #include "./Func/Create/Create.h"
 #include "./Func/Barrier/Barrier.h"
 #include "./Func/Shader/Shader.h"
+#include "./Func/ShaderCompileBatch/ShaderCompileBatch.h"
+#include "./Func/ShaderHotReload/ShaderHotReload.h"
+#include "./Func/AsyncLogger/AsyncLogger.h"
 #include "./Func/Matrix/Matrix.h"
+#include "./Func/Culling/Culling.h"
+#include "./Func/UploadRingBuffer/UploadRingBuffer.h"
+#include "./Func/FramePacer/FramePacer.h"
+#include "./Func/GeometryManager/GeometryManager.h"
+#include "./Func/DescriptorHeapAllocator/DescriptorHeapAllocator.h"
+#include "./Func/ParallelCommandRecorder/ParallelCommandRecorder.h"
+#include "./Func/InstanceBatch/InstanceBatch.h"
+#include "./Func/RenderQueue/RenderQueue.h"
+#include "./Func/PipelineStateCache/PipelineStateCache.h"
+#include "./Func/RootSignatureCache/RootSignatureCache.h"
+#include "./Func/BindlessBuffer/BindlessBuffer.h"
 #include "./externals/imgui/imgui.h"
 #include "./externals/imgui/imgui_impl_dx12.h"
 #include "./externals/imgui/imgui_impl_win32.h"
@@ -54,6 +70,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	// ファイルを作って書き込み準備
 	std::ofstream logStream(logFilePath);
 
+	// ログはリングに入れるだけにして、別のスレッドがまとめてファイルに書く
+	AsyncLogger* logger = CreateAsyncLogger(logStream, MakeAsyncLoggerSettings());
+	AttachAsyncLogger(logStream, logger);
+
 
 	/*----------------------------
 	    ウィンドウクラスを登録する
@@ -168,11 +188,26 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	// commandQueueを生成する
 	ID3D12CommandQueue* commandQueue = CreateCommandQueue(device);
 
-	// commandAllocatorを生成する
-	ID3D12CommandAllocator* commandAllocator = CreateCommandAllocator(device);
+	// 同時に処理中にできるフレーム数（1にすると毎フレームGPUを待つ）
+	const uint32_t kFrameLatency = 2;
+	static_assert(kFrameLatency >= 1 && kFrameLatency <= kMaxFrameLatency);
+
+	// commandAllocatorを生成する（GPUが使っている間はResetできないので、フレームごとに持つ）
+	ID3D12CommandAllocator* commandAllocators[kFrameLatency] = {};
+	for (uint32_t i = 0; i < kFrameLatency; i++)
+	{
+		commandAllocators[i] = CreateCommandAllocator(device);
+	}
 
 	// commandListを生成する
-	ID3D12GraphicsCommandList* commandList = CreateCommandList(device, commandAllocator);
+	ID3D12GraphicsCommandList* commandList = CreateCommandList(device, commandAllocators[0]);
+
+	// 描画はスレッドごとのcommandListに分けて記録する（記録先は使い回す）
+	ParallelCommandRecorder commandRecorder{};
+
+	// 記録に使うスレッドの数と、1つのcommandListに最低限入れる描画の数
+	const uint32_t kRecordWorkerCount = (std::max)(1u, std::thread::hardware_concurrency());
+	const uint32_t kMinDrawsPerCommandList = 64;
 
 
 	/*-----------------------------
@@ -182,8 +217,11 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	// RTV用のDescriptor
 	ID3D12DescriptorHeap* rtvDescriptorHeap = CreateDescriptorHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 2, false);
 
-	// SRV用のDescriptor
-	ID3D12DescriptorHeap* srvDescriptorHeap = CreateDescriptorHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 128, true);
+	// SRV用のDescriptor（前半はテクスチャなど使い続けるもの、後半はフレームごとのDescriptorTable用）
+	const uint32_t kSrvPersistentDescriptorCount = 96;
+	const uint32_t kSrvFrameDescriptorCount = 32;
+	DescriptorHeapAllocator srvDescriptorHeap = CreateDescriptorHeapAllocator
+	(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, kSrvPersistentDescriptorCount, kSrvFrameDescriptorCount, true);
 
 
 	/*---------------
@@ -272,22 +310,47 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	HANDLE fenceEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
 	assert(fenceEvent != nullptr);
 
+	// 何フレーム先までGPUを追い越してよいかを管理する
+	FramePacer framePacer = MakeFramePacer(kFrameLatency, fenceValue);
 
-	/*--------------------
-	    DXCを初期化する
-	--------------------*/
 
-	IDxcUtils* dxcUtils = nullptr;
-	IDxcCompiler3* dxcCompiler = nullptr;
-	hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxcUtils));
-	hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler));
-	assert(SUCCEEDED(hr));
+	/*------------------------------
+	    Shaderのコンパイルを始める
+	------------------------------*/
 
-	// 現時点でincludeはしないが、includeに対応するための設定を行っておく
-	IDxcIncludeHandler* includeHandler = nullptr;
-	
-	hr = dxcUtils->CreateDefaultIncludeHandler(&includeHandler);
-	assert(SUCCEEDED(hr));
+	// 同じソース、include、オプションならコンパイルせずに、保存したバイナリを使う
+	const bool kUseShaderCache = true;
+	ShaderCache shaderCache = MakeShaderCache("Cache/Shader", kUseShaderCache, GetDxcCompilerVersion());
+
+	// Debugビルドは最適化なしでデバッグ情報を埋め込み、Releaseビルドは最適化してデバッグ情報を別のPDBに書き出す
+#ifdef _DEBUG
+	const ShaderCompileMode kShaderCompileMode = ShaderCompileMode::Debug;
+#else
+	const ShaderCompileMode kShaderCompileMode = ShaderCompileMode::Release;
+#endif
+	ShaderCompileSettings shaderSettings = MakeShaderCompileSettings(kShaderCompileMode, "Cache/ShaderPdb");
+
+	// コンパイルするShader（番号は下のジョブの順）
+	const uint32_t kObjectVertexShader = 0;
+	const uint32_t kInstancedVertexShader = 1;
+	const uint32_t kObjectPixelShader = 2;
+	const uint32_t kBindlessVertexShader = 3;
+	const uint32_t kBindlessPixelShader = 4;
+
+	std::vector<ShaderCompileRequest> shaderJobs =
+	{
+		MakeShaderCompileRequest(L"Object3d.VS.hlsl", "vs_6_0", shaderSettings),
+		MakeShaderCompileRequest(L"Object3dInstanced.VS.hlsl", "vs_6_0", shaderSettings),
+		MakeShaderCompileRequest(L"Object3d.PS.hlsl", "ps_6_0", shaderSettings),
+		MakeShaderCompileRequest(L"Object3dBindless.VS.hlsl", "vs_6_0", shaderSettings),
+		MakeShaderCompileRequest(L"Object3dBindless.PS.hlsl", "ps_6_0", shaderSettings)
+	};
+
+	// スレッドごとにDXCを1回だけ作り、ホットリロードでも同じスレッドを使う
+	ShaderCompilePool* shaderCompilePool = CreateShaderCompilePool((std::max)(1u, std::thread::hardware_concurrency()), CreateDxcShaderCompiler);
+
+	// 同時にコンパイルし、その間にRootSignatureなどを作る
+	ShaderCompileBatch shaderBatch = StartShaderCompileBatch(shaderCompilePool, shaderJobs, &shaderCache);
 
 
 
@@ -295,40 +358,35 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	    rootSignatureを生成する
 	----------------------------*/
 
-	D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
-	descriptionRootSignature.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
-
+	// 同じ設定のrootSignatureは使い回し、シリアライズしたバイナリはファイルに保存する
+	RootSignatureCache rootSignatureCache = CreateRootSignatureCache("Cache/RootSignature");
 
-	D3D12_ROOT_PARAMETER rootParameter[2] = {};
+	RootSignatureDescription rootSignatureDescription{};
+	rootSignatureDescription.flags = kRootSignatureFlagAllowInputLayout;
 
 	// CBV PixelShader b0 
-	rootParameter[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-	rootParameter[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-	rootParameter[0].Descriptor.ShaderRegister = 0;
+	AddRootDescriptor(rootSignatureDescription, kRootParameterTypeCBV, kRootShaderVisibilityPixel, 0);
 
 	// CBV VertexShader b0
-	rootParameter[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-	rootParameter[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-	rootParameter[1].Descriptor.ShaderRegister = 0;
+	AddRootDescriptor(rootSignatureDescription, kRootParameterTypeCBV, kRootShaderVisibilityVertex, 0);
 
-	descriptionRootSignature.pParameters = rootParameter;
-	descriptionRootSignature.NumParameters = _countof(rootParameter);
+	// SRV VertexShader t0（インスタンス描画の座標変換の並び）
+	AddRootDescriptor(rootSignatureDescription, kRootParameterTypeSRV, kRootShaderVisibilityVertex, 0);
 
+	// 定数 b1（バインドレス描画の、描画ごとの番号とバッファのDescriptorの番号）
+	AddRootConstants(rootSignatureDescription, kRootShaderVisibilityAll, 1, 5);
 
-	// シリアライズにしてバイナリにする
-	ID3DBlob* signatureBlob = nullptr;
-	ID3DBlob* errorBlob = nullptr;
-	hr = D3D12SerializeRootSignature(&descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
-	if (FAILED(hr))
-	{
-		Log(logStream, reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
-		assert(false);
-	}
+	// DescriptorTable（バインドレス描画用。DescriptorHeap全体を、型ごとに別のspaceで見る）
+	AddRootDescriptorTable(rootSignatureDescription, kRootShaderVisibilityAll,
+		{
+			{ kRootDescriptorRangeTypeSRV , kRootDescriptorRangeUnbounded , 0 , 1 , 0 },
+			{ kRootDescriptorRangeTypeSRV , kRootDescriptorRangeUnbounded , 0 , 2 , 0 },
+			{ kRootDescriptorRangeTypeSRV , kRootDescriptorRangeUnbounded , 0 , 3 , 0 },
+		});
 
-	// バイナリを元に生成する
-	ID3D12RootSignature* rootSignature = nullptr;
-	hr = device->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
-	assert(SUCCEEDED(hr));
+	// 生成する
+	ID3D12RootSignature* rootSignature = GetRootSignature(rootSignatureCache, device, rootSignatureDescription, logStream);
+	assert(rootSignature != nullptr);
 
 
 	/*----------------------------
@@ -372,17 +430,36 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
 
 
-	/*---------------------------
-	    Shaderをコンパイルする
-	---------------------------*/
+	/*------------------------------
+	    Shaderのコンパイルを待つ
+	------------------------------*/
+
+	// 失敗したShaderがあれば、理由をログに出して止める
+	for (uint32_t i = 0; i < static_cast<uint32_t>(shaderJobs.size()); i++)
+	{
+		const ShaderCompileResult& result = WaitShaderCompileResult(shaderBatch, i);
+		if (!result.isSucceeded)
+		{
+			LogError(logStream, result.errors);
+		}
+		assert(result.isSucceeded);
+
+		Log(logStream, std::format("{}, path : {} , profile : {} , thread : {} , {:.2f} ms \n", result.isCacheHit ? "Cache Hit" : "Compile Succeeded",
+			shaderJobs[i].sourcePath.string(), shaderJobs[i].profile, result.workerIndex, result.compileMilliseconds));
+	}
 
-	// VertexShader
-	IDxcBlob* vertexShaderBlob = CompileShader(L"Object3d.VS.hlsl", L"vs_6_0", dxcUtils, dxcCompiler, includeHandler, logStream);
-	assert(vertexShaderBlob != nullptr);
+	// 起動時間を比べられるように、1つずつコンパイルした場合の時間と並べてログに出す
+	ShaderCompileBatchStats shaderStats = FinishShaderCompileBatch(shaderBatch, &shaderCache);
+	Log(logStream, std::format("Shader compile time : {:.2f} ms (serial {:.2f} ms) , mode : {} , threads : {} , cache : {} , hit : {} , miss : {} \n",
+		shaderStats.wallMilliseconds, shaderStats.serialMilliseconds, GetShaderCompileModeName(kShaderCompileMode), shaderStats.workerCount,
+		kUseShaderCache ? "on" : "off", shaderCache.hitCount, shaderCache.missCount));
 
-	// PixelShader
-	IDxcBlob* pixelShaderBlob = CompileShader(L"Object3d.PS.hlsl", L"ps_6_0", dxcUtils, dxcCompiler, includeHandler, logStream);
-	assert(pixelShaderBlob != nullptr);
+	// バイトコード（別のスレッドで作るPSOも読むので、shaderBatchは最後まで残す）
+	const std::vector<uint8_t>& vertexShaderBytecode = WaitShaderCompileResult(shaderBatch, kObjectVertexShader).bytecode;
+	const std::vector<uint8_t>& instancedVertexShaderBytecode = WaitShaderCompileResult(shaderBatch, kInstancedVertexShader).bytecode;
+	const std::vector<uint8_t>& pixelShaderBytecode = WaitShaderCompileResult(shaderBatch, kObjectPixelShader).bytecode;
+	const std::vector<uint8_t>& bindlessVertexShaderBytecode = WaitShaderCompileResult(shaderBatch, kBindlessVertexShader).bytecode;
+	const std::vector<uint8_t>& bindlessPixelShaderBytecode = WaitShaderCompileResult(shaderBatch, kBindlessPixelShader).bytecode;
 
 
 
@@ -393,8 +470,8 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipelineStateDesc{};
 	graphicsPipelineStateDesc.pRootSignature = rootSignature;
 	graphicsPipelineStateDesc.InputLayout = inputLayoutDesc;
-	graphicsPipelineStateDesc.VS = { vertexShaderBlob->GetBufferPointer() , vertexShaderBlob->GetBufferSize() };
-	graphicsPipelineStateDesc.PS = { pixelShaderBlob->GetBufferPointer() , pixelShaderBlob->GetBufferSize() };
+	graphicsPipelineStateDesc.VS = { vertexShaderBytecode.data() , vertexShaderBytecode.size() };
+	graphicsPipelineStateDesc.PS = { pixelShaderBytecode.data() , pixelShaderBytecode.size() };
 	graphicsPipelineStateDesc.BlendState = blendDesc;
 	graphicsPipelineStateDesc.RasterizerState = rasterizerDesc;
 
@@ -409,10 +486,34 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	graphicsPipelineStateDesc.SampleDesc.Count = 1;
 	graphicsPipelineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 
-	// 実際に生成
-	ID3D12PipelineState* graphicsPipelineState = nullptr;
-	hr = device->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&graphicsPipelineState));
-	assert(SUCCEEDED(hr));
+	// PSOは設定のハッシュで使い回し、ファイルに保存して次の起動では読むだけにする
+	PipelineStateCache pipelineStateCache = CreatePipelineStateCache(device, "Cache/PipelineLibrary.bin");
+	uint64_t rootSignatureHash = HashRootSignatureDescription(rootSignatureDescription);
+
+	// 実際に生成（最初のフレームから使うので、できるまで待つ）
+	ID3D12PipelineState* graphicsPipelineState = GetGraphicsPipelineState(pipelineStateCache, graphicsPipelineStateDesc, rootSignatureHash, false);
+	assert(graphicsPipelineState != nullptr);
+
+	// インスタンス描画用（VertexShaderだけが違う。別のスレッドで作り、できるまでは1つずつ描画する）
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC instancedPipelineStateDesc = graphicsPipelineStateDesc;
+	instancedPipelineStateDesc.VS = { instancedVertexShaderBytecode.data() , instancedVertexShaderBytecode.size() };
+
+	ID3D12PipelineState* instancedPipelineState = GetGraphicsPipelineState(pipelineStateCache, instancedPipelineStateDesc, rootSignatureHash, true);
+
+	// バインドレス描画用（VertexShaderとPixelShaderが違う。こちらも別のスレッドで作る）
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC bindlessPipelineStateDesc = graphicsPipelineStateDesc;
+	bindlessPipelineStateDesc.VS = { bindlessVertexShaderBytecode.data() , bindlessVertexShaderBytecode.size() };
+	bindlessPipelineStateDesc.PS = { bindlessPixelShaderBytecode.data() , bindlessPixelShaderBytecode.size() };
+
+	ID3D12PipelineState* bindlessPipelineState = GetGraphicsPipelineState(pipelineStateCache, bindlessPipelineStateDesc, rootSignatureHash, true);
+
+	// Shaderとincludeを見張り、書き換えられたら再起動せずにコンパイルし直す
+	const bool kUseShaderHotReload = true;
+	ShaderHotReload shaderHotReload{};
+	if (kUseShaderHotReload)
+	{
+		shaderHotReload = CreateShaderHotReload(shaderJobs, shaderCache, shaderCompilePool, 100.0);
+	}
 
 
 	/*------------------------
@@ -444,9 +545,53 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	ImGui::CreateContext();
 	ImGui::StyleColorsDark();
 	ImGui_ImplWin32_Init(hwnd);
+	// ImGuiのフォント用のDescriptorも割り当てから取る
+	DescriptorRange imguiDescriptor = AllocatePersistentDescriptors(srvDescriptorHeap.allocator, 1);
+	assert(imguiDescriptor.count == 1);
+
 	ImGui_ImplDX12_Init
-	(device, swapChainDesc.BufferCount, rtvDesc.Format,
-		srvDescriptorHeap, srvDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), srvDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+	(device, kFrameLatency, rtvDesc.Format, srvDescriptorHeap.heap,
+		GetDescriptorCPUHandle(srvDescriptorHeap, imguiDescriptor.start), GetDescriptorGPUHandle(srvDescriptorHeap, imguiDescriptor.start));
+
+
+
+	/*-------------------------------------
+	    アップロード用のリングバッファを作る
+	-------------------------------------*/
+
+	// 毎フレームの頂点や定数はここから切り出す（作り直さず、マップしたままにする）
+	const size_t kUploadRingBufferSize = 1024 * 1024;
+	ID3D12Resource* uploadRingResource = CreateBufferResource(device, kUploadRingBufferSize);
+
+	void* uploadRingData = nullptr;
+	hr = uploadRingResource->Map(0, nullptr, &uploadRingData);
+	assert(SUCCEEDED(hr));
+
+	UploadRingBuffer uploadRing = MakeUploadRingBuffer(uploadRingData, uploadRingResource->GetGPUVirtualAddress(), kUploadRingBufferSize);
+
+
+
+	/*--------------------------------
+	    変わらない形状をGPUに送る
+	--------------------------------*/
+
+	// 頂点とインデックスはdefaultHeapに一度だけ送り、毎フレームは書き込まない
+	const size_t kGeometryStagingSize = 1024 * 1024;
+	GeometryManager geometryManager = CreateGeometryManager(device, kGeometryStagingSize);
+
+	// 三角形
+	const Vector4 triangleVertices[] =
+	{
+		{ -0.5f , -0.5f , 0.0f , 1.0f },
+		{ 0.0f , 0.5f , 0.0f , 1.0f },
+		{ 0.5f , -0.5f , 0.0f , 1.0f },
+	};
+	const uint32_t triangleIndices[] = { 0 , 1 , 2 };
+
+	MeshHandle triangleMesh = CreateMesh(geometryManager, device, std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(triangleVertices), sizeof(triangleVertices)), sizeof(Vector4), triangleIndices);
+
+	// コピーキューに送る（完了は待たず、届いたフレームから描画する）
+	FlushGeometryUploads(geometryManager);
 
 
 
@@ -454,18 +599,94 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	    変数を作る
 	----------------*/
 
-	// Transform
+	// 描画するメッシュ（オブジェクトはこの番号でメッシュを指す）
+	const MeshHandle sceneMeshes[] = { triangleMesh };
+
+	// パイプライン（0 : 1つずつ描画、1 : インスタンス描画、2 : バインドレス描画）
+	ID3D12PipelineState* scenePipelines[] = { graphicsPipelineState , instancedPipelineState , bindlessPipelineState };
+
+	// パイプラインごとの設定と、使うShader（VertexShader , PixelShader）
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC* scenePipelineDescs[] = { &graphicsPipelineStateDesc , &instancedPipelineStateDesc , &bindlessPipelineStateDesc };
+	const uint32_t scenePipelineShaders[][2] =
+	{
+		{ kObjectVertexShader , kObjectPixelShader },
+		{ kInstancedVertexShader , kObjectPixelShader },
+		{ kBindlessVertexShader , kBindlessPixelShader }
+	};
+
+	// 別のスレッドで作っているパイプライン（できたフレームから差し替える）
+	bool isScenePipelinePending[] = { false , true , true };
+	uint32_t shaderReloadFailedCount = 0;
+
+	// マテリアルの色（オブジェクトはこの番号でマテリアルを指す）
+	const Vector4 materialColors[] = { { 1.0f , 0.0f , 0.0f , 1.0f } };
+
+	// オブジェクトのTransformと、使うメッシュ、マテリアル
 	Transform3D transform;
 	transform.scale = { 1.0f , 1.0f , 1.0f };
 	transform.rotate = { 0.0f , 0.0f , 0.0f };
 	transform.translate = { 0.0f , 0.0f , 0.0f };
 
+	std::vector<Transform3D> transforms = { transform };
+	std::vector<uint32_t> objectMeshes = { 0 };
+	std::vector<uint32_t> objectMaterials = { 0 };
+
+	// 同じメッシュとマテリアルのオブジェクトを1回の描画にまとめるか
+	bool useInstancing = true;
+
+	// マテリアルと座標変換を大きなバッファに置き、描画ごとには番号だけを渡すか
+	bool useBindless = false;
+
+	// バインドレス描画で使う、マテリアルと座標変換の表（書き換えた範囲だけをGPUに送る）
+	const uint32_t kBindlessTransformCapacity = 4096;
+	const uint32_t kBindlessMaterialCapacity = 256;
+	BindlessBuffer transformBuffer = CreateBindlessBuffer(device, srvDescriptorHeap, sizeof(Matrix4x4), kBindlessTransformCapacity);
+	BindlessBuffer materialBuffer = CreateBindlessBuffer(device, srvDescriptorHeap, sizeof(Vector4), kBindlessMaterialCapacity);
+
+	// マテリアルは変わらないので、最初に一度だけ書き込む
+	uint32_t materialSlots[_countof(materialColors)]{};
+	for (uint32_t i = 0; i < _countof(materialColors); i++)
+	{
+		materialSlots[i] = AllocateBindlessSlot(materialBuffer.table);
+		assert(materialSlots[i] != kBindlessInvalidSlot);
+
+		WriteBindlessSlot(materialBuffer.table, materialSlots[i], &materialColors[i]);
+	}
+
+	// 前のフレームでGPUに送った表の大きさ
+	size_t bindlessUploadedSize = 0;
+
+	// オブジェクトごとの座標変換のスロット
+	std::vector<uint32_t> objectTransformSlots(transforms.size());
+	for (uint32_t& slot : objectTransformSlots)
+	{
+		slot = AllocateBindlessSlot(transformBuffer.table);
+		assert(slot != kBindlessInvalidSlot);
+	}
+
+	// 毎フレーム使う作業用の配列（確保し直さないように使い回す）
+	std::vector<Matrix4x4> worldViewProjectionMatrices;
+	std::vector<Sphere> boundingSpheres;
+	std::vector<uint32_t> visibleIndices;
+	std::vector<InstanceDrawItem> drawItems;
+	std::vector<uint32_t> instanceObjectIndices;
+	std::vector<InstanceBatch> instanceBatches;
+
+	// 描画の並べ替えと、同じ状態の設定の省略
+	RenderQueue renderQueue{};
+
+	// 三角形の頂点を全て囲む境界球の半径（拡縮1のとき）
+	const float kTriangleBoundingRadius = 0.7072f;
+
 	// カメラ用のTransform
 	Transform3D cameraTransform;
 	cameraTransform.scale = { 1.0f , 1.0f , 1.0f };
 	cameraTransform.rotate = { 0.0f , 0.0f , 0.0f };
 	cameraTransform.translate = { 0.0f , 0.0f , -5.0f };
 
+	// 透視投影行列（画面サイズが変わらない限り毎フレーム作り直す必要はない）
+	const Matrix4x4 projectionMatrix = MakePerspectiveFovMatrix(0.45f, static_cast<float>(kClientWidth) / static_cast<float>(kClientHeight), 0.1f, 100.0f);
+
 
 
 	/*-----------------
@@ -509,152 +730,417 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 			commandList->ClearRenderTargetView(rtvHandles[backBufferIndex], clearColor, 0, nullptr);
 
 			// 描画用のDescriptorの設定
-			ID3D12DescriptorHeap* descriptorHeap[] = { srvDescriptorHeap };
-			commandList->SetDescriptorHeaps(1, descriptorHeap);
+			ID3D12DescriptorHeap* descriptorHeap[] = { srvDescriptorHeap.heap };
 
 			///
 			/// ↓ 更新処理ここから
 			/// 
 
 			// Y軸に回転させる
-			transform.rotate.y += 0.03f;
-
-			// 一周したら角度を初期化する
-			if (transform.rotate.y >= float(M_PI) * 2)
+			for (Transform3D& objectTransform : transforms)
 			{
-				transform.rotate.y = 0.0f;
+				objectTransform.rotate.y += 0.03f;
+
+				// 一周したら角度を初期化する
+				if (objectTransform.rotate.y >= float(M_PI) * 2)
+				{
+					objectTransform.rotate.y = 0.0f;
+				}
 			}
 
 			// 座標変換を行う
-			Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
-			Matrix4x4 viewMatrix = MakeInverseMatrix(MakeAffineMatrix(cameraTransform.scale, cameraTransform.rotate, cameraTransform.translate));
-			Matrix4x4 projectionMatrix = MakePerspectiveFovMatrix(0.45f, static_cast<float>(kClientWidth) / static_cast<float>(kClientHeight), 0.1f, 100.0f);
-			Matrix4x4 worldViewProjectionMatrix = Multiply(Multiply(worldMatrix, viewMatrix), projectionMatrix);
+			Matrix4x4 viewMatrix = MakeViewMatrix(cameraTransform);
+			Matrix4x4 viewProjectionMatrix = Multiply(viewMatrix, projectionMatrix);
 
+			// ワールドビュープロジェクション行列はオブジェクト分まとめて作る
+			worldViewProjectionMatrices.resize(transforms.size());
+			MakeWorldViewProjectionMatrices(transforms, viewProjectionMatrix, worldViewProjectionMatrices);
 
+			// 視錐台カリング（見えないオブジェクトは描画しない）
+			Frustum frustum = MakeFrustum(viewProjectionMatrix);
 
-			///
-			/// ↑ 更新処理ここまで
-			/// 
-			
-			ImGui::Render();
+			boundingSpheres.resize(transforms.size());
+			for (size_t i = 0; i < transforms.size(); i++)
+			{
+				const Transform3D& objectTransform = transforms[i];
+				boundingSpheres[i] = { objectTransform.translate , kTriangleBoundingRadius * (std::max)({ objectTransform.scale.x , objectTransform.scale.y , objectTransform.scale.z }) };
+			}
 
-			///
-			/// ↓ 描画処理ここから
-			/// 
+			visibleIndices.resize(transforms.size());
+			size_t visibleCount = CullSpheres(frustum, boundingSpheres, visibleIndices);
 
+			// 転送が終わったメッシュを使えるようにする
+			UpdateGeometryManager(geometryManager);
 
-			// viewportを設定
-			commandList->RSSetViewports(1,&viewport);
+			D3D12_VERTEX_BUFFER_VIEW vertexBufferViews[_countof(sceneMeshes)]{};
+			D3D12_INDEX_BUFFER_VIEW indexBufferViews[_countof(sceneMeshes)]{};
+			uint32_t indexCounts[_countof(sceneMeshes)]{};
+			bool isMeshReady[_countof(sceneMeshes)]{};
 
-			// scissorを設定
-			commandList->RSSetScissorRects(1, &scissorRect);
-			
-			// rootSignature
-			commandList->SetGraphicsRootSignature(rootSignature);
+			for (uint32_t i = 0; i < _countof(sceneMeshes); i++)
+			{
+				isMeshReady[i] = GetMeshViews(geometryManager, sceneMeshes[i], vertexBufferViews[i], indexBufferViews[i]);
+				indexCounts[i] = isMeshReady[i] ? GetMeshRecord(geometryManager.scheduler, sceneMeshes[i])->indexCount : 0;
+			}
 
-			// PSO
-			commandList->SetPipelineState(graphicsPipelineState);
+			// 見えていて、メッシュの転送が終わっているオブジェクトを描画する
+			drawItems.clear();
+			for (size_t i = 0; i < visibleCount; i++)
+			{
+				uint32_t objectIndex = visibleIndices[i];
 
+				if (isMeshReady[objectMeshes[objectIndex]])
+				{
+					drawItems.push_back(InstanceDrawItem{ objectMeshes[objectIndex] , objectMaterials[objectIndex] , objectIndex });
+				}
+			}
 
-			// 頂点
-			ID3D12Resource* vertexResource = CreateBufferResource(device, sizeof(Vector4) * 3);
+			// コンパイルし直せたShaderを使うパイプラインは、設定を差し替えて作り直す
+			if (kUseShaderHotReload)
+			{
+				for (uint32_t shaderIndex : UpdateShaderHotReload(shaderHotReload))
+				{
+					const std::vector<uint8_t>& bytecode = GetReloadedShaderBytecode(shaderHotReload, shaderIndex);
+					Log(logStream, std::format("Shader reloaded, path : {} \n", shaderJobs[shaderIndex].sourcePath.string()));
+
+					for (uint32_t i = 0; i < _countof(scenePipelines); i++)
+					{
+						if (scenePipelineShaders[i][0] == shaderIndex)
+						{
+							scenePipelineDescs[i]->VS = { bytecode.data() , bytecode.size() };
+							isScenePipelinePending[i] = true;
+						}
+
+						if (scenePipelineShaders[i][1] == shaderIndex)
+						{
+							scenePipelineDescs[i]->PS = { bytecode.data() , bytecode.size() };
+							isScenePipelinePending[i] = true;
+						}
+					}
+				}
+
+				// 失敗したら今のPSOを使い続ける
+				if (shaderHotReload.failedCount != shaderReloadFailedCount)
+				{
+					shaderReloadFailedCount = shaderHotReload.failedCount;
+					LogError(logStream, shaderHotReload.lastErrors);
+				}
+			}
 
-			D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
-			vertexBufferView.BufferLocation = vertexResource->GetGPUVirtualAddress();
-			vertexBufferView.SizeInBytes = sizeof(Vector4) * 3;
-			vertexBufferView.StrideInBytes = sizeof(Vector4);
+			// PSOは別のスレッドで作り、できたらこのフレームから差し替える（描画中のフレームの古いPSOはキャッシュが持っている）
+			// インスタンス描画用、バインドレス描画用のPSOが最初にできるまでは、1つずつ描画する
+			for (uint32_t i = 0; i < _countof(scenePipelines); i++)
+			{
+				if (isScenePipelinePending[i])
+				{
+					PipelineCreateStatus pipelineStatus = PipelineCreateStatus::Pending;
+					ID3D12PipelineState* pipelineState = GetGraphicsPipelineState(pipelineStateCache, *scenePipelineDescs[i], rootSignatureHash, true, &pipelineStatus);
+					if (pipelineState)
+					{
+						scenePipelines[i] = pipelineState;
+						isScenePipelinePending[i] = false;
+					}
+
+					// 作れなければ今のPSOを使い続け、次にShaderが書き換えられるまで作り直さない
+					if (pipelineStatus == PipelineCreateStatus::Failed)
+					{
+						isScenePipelinePending[i] = false;
+						LogError(logStream, std::format("Pipeline state creation failed, pipeline : {} , VS : {} , PS : {} \n", i,
+							shaderJobs[scenePipelineShaders[i][0]].sourcePath.string(), shaderJobs[scenePipelineShaders[i][1]].sourcePath.string()));
+					}
+				}
+			}
 
-			Vector4* vertexData = nullptr;
-			vertexResource->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-			vertexData[0] = { -0.5f , -0.5f , 0.0f , 1.0f };
-			vertexData[1] = { 0.0f , 0.5f , 0.0f , 1.0f };
-			vertexData[2] = { 0.5f , -0.5f , 0.0f , 1.0f };
+			bool isBindless = useBindless && scenePipelines[2] != nullptr;
 
+			// バインドレス描画はインスタンス描画もできる
+			bool isInstancing = useInstancing && (isBindless || scenePipelines[1] != nullptr);
 
-			// マテリアル
-			ID3D12Resource* materialResource = CreateBufferResource(device, sizeof(Vector4));
+			// 同じメッシュとマテリアルのオブジェクトを1回の描画にまとめる（使わないときは1つずつ描画する）
+			BuildInstanceBatches(drawItems, isInstancing ? UINT32_MAX : 1, instanceObjectIndices, instanceBatches);
 
-			Vector4* materialData = nullptr;
-			materialResource->Map(0, nullptr, reinterpret_cast<void**>(&materialData));
-			*materialData = { 1.0f , 0.0f ,0.0 , 1.0f };
+			// バッチをパイプライン、マテリアル、手前からの順に並べ、続けて同じ状態なら設定を省く
+			ClearRenderQueue(renderQueue);
+			for (uint32_t i = 0; i < instanceBatches.size(); i++)
+			{
+				const InstanceBatch& batch = instanceBatches[i];
+				uint32_t pipelineIndex = isBindless ? 2 : (isInstancing ? 1 : 0);
+
+				// 先頭のインスタンスの原点の深度（クリップ空間の z / w）
+				const Matrix4x4& firstMatrix = worldViewProjectionMatrices[instanceObjectIndices[batch.firstInstance]];
+				float depth = (firstMatrix.m[3][3] != 0.0f) ? firstMatrix.m[3][2] / firstMatrix.m[3][3] : 1.0f;
+
+				PushRenderPacket(renderQueue,
+					RenderPacket{ MakeRenderSortKey(0, pipelineIndex, batch.materialIndex, depth) , pipelineIndex , batch.materialIndex , batch.meshIndex , i });
+			}
+			SortRenderQueue(renderQueue);
+
+			ImGui::Begin("Renderer");
+			ImGui::Checkbox("Instancing", &useInstancing);
+			ImGui::Checkbox("Bindless", &useBindless);
+			ImGui::Text("Bindless upload : %zu bytes  Transform slots : %u / %u", bindlessUploadedSize, transformBuffer.table.usedCount, kBindlessTransformCapacity);
+			ImGui::Text("Objects : %zu  Draw calls : %u", drawItems.size(), renderQueue.stats.drawCount);
+			ImGui::Text("State changes removed : %u", renderQueue.stats.removedStateChanges);
+			ImGui::Text("PSO cache hit : %u  miss : %u  loaded : %u", pipelineStateCache.table.hitCount, pipelineStateCache.table.missCount, pipelineStateCache.loadedCount);
+			ImGui::Text("Shader reload : %u  failed : %u", shaderHotReload.reloadCount, shaderHotReload.failedCount);
+			ImGui::Text("Log written : %llu  dropped : %llu", static_cast<unsigned long long>(logger->writtenCount.load()), static_cast<unsigned long long>(logger->droppedCount.load()));
+			ImGui::End();
+
+
+
+			///
+			/// ↑ 更新処理ここまで
+			/// 
+			
+			ImGui::Render();
 
+			///
+			/// ↓ 描画処理ここから
+			/// 
 
-			// 座標変換
-			ID3D12Resource* wvpResource = CreateBufferResource(device, sizeof(Matrix4x4));
 
-			Matrix4x4* wvpData = nullptr;
-			wvpResource->Map(0, nullptr, reinterpret_cast<void**>(&wvpData));
-			*wvpData = worldViewProjectionMatrix;
+			// GPUが読み終わったフレームの領域を回収する
+			ReclaimUploadRingBuffer(uploadRing, fence->GetCompletedValue());
+			ReclaimDescriptorFrames(srvDescriptorHeap.allocator, fence->GetCompletedValue());
 
 
-			// VBVを設定
-			commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+			// リングバッファは複数のスレッドから切り出せないので、記録を分ける前に書き込んでおく
 
-			// 形状
-			commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			// マテリアルのアドレス（マテリアルごとに1つ）
+			uint64_t materialAddresses[_countof(materialColors)]{};
 
-			// CBVのマテリアルを設定
-			commandList->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+			// 座標変換（バッチごとの先頭のアドレス）
+			std::vector<uint64_t> batchTransformAddresses(instanceBatches.size());
 
-			// CBVの座標変換を設定
-			commandList->SetGraphicsRootConstantBufferView(1, wvpResource->GetGPUVirtualAddress());
+			// バインドレス描画で読むバッファのDescriptorの番号（座標変換、マテリアル、インスタンスのスロットの並び）
+			uint32_t bindlessTableIndices[3] = { transformBuffer.descriptor.start , materialBuffer.descriptor.start , 0 };
 
-			// 描画
-			commandList->DrawInstanced(3, 1, 0, 0);
+			if (isBindless)
+			{
+				// 描画するオブジェクトの座標変換を表に書き込み、書き換えた範囲だけをGPUに送る（描画より前に実行されるcommandListに積む）
+				for (uint32_t objectIndex : instanceObjectIndices)
+				{
+					WriteBindlessSlot(transformBuffer.table, objectTransformSlots[objectIndex], &worldViewProjectionMatrices[objectIndex]);
+				}
+
+				bindlessUploadedSize = UploadBindlessBuffer(transformBuffer, uploadRing, uploadRingResource, commandList);
+				bindlessUploadedSize += UploadBindlessBuffer(materialBuffer, uploadRing, uploadRingResource, commandList);
+
+				// インスタンスの並びの順に座標変換のスロットを詰める（シェーダーは instanceBase + SV_InstanceID で読む）
+				if (!instanceObjectIndices.empty())
+				{
+					UploadAllocation slotAllocation = AllocateUploadRingBuffer(uploadRing, sizeof(uint32_t) * instanceObjectIndices.size());
+					assert(slotAllocation.cpuAddress != nullptr);
+
+					uint32_t* slotData = static_cast<uint32_t*>(slotAllocation.cpuAddress);
+					for (size_t i = 0; i < instanceObjectIndices.size(); i++)
+					{
+						slotData[i] = objectTransformSlots[instanceObjectIndices[i]];
+					}
+
+					// このフレームだけ使うので、フレームの領域にSRVを作る
+					DescriptorRange slotListDescriptor = AllocateFrameDescriptors(srvDescriptorHeap.allocator, 1);
+					assert(slotListDescriptor.count == 1);
+
+					D3D12_SHADER_RESOURCE_VIEW_DESC slotListSrvDesc{};
+					slotListSrvDesc.Format = DXGI_FORMAT_UNKNOWN;
+					slotListSrvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+					slotListSrvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+					slotListSrvDesc.Buffer.FirstElement = slotAllocation.offset / sizeof(uint32_t);
+					slotListSrvDesc.Buffer.NumElements = static_cast<UINT>(instanceObjectIndices.size());
+					slotListSrvDesc.Buffer.StructureByteStride = sizeof(uint32_t);
+
+					device->CreateShaderResourceView(uploadRingResource, &slotListSrvDesc, GetDescriptorCPUHandle(srvDescriptorHeap, slotListDescriptor.start));
+					bindlessTableIndices[2] = slotListDescriptor.start;
+				}
+			}
+			else
+			{
+				// マテリアル（マテリアルごとに1つ）
+				for (uint32_t i = 0; i < _countof(materialColors); i++)
+				{
+					UploadAllocation materialAllocation = AllocateUploadRingBuffer(uploadRing, sizeof(Vector4));
+					assert(materialAllocation.cpuAddress != nullptr);
+
+					*static_cast<Vector4*>(materialAllocation.cpuAddress) = materialColors[i];
+					materialAddresses[i] = materialAllocation.gpuAddress;
+				}
+
+
+				// 座標変換
+				if (isInstancing && !instanceObjectIndices.empty())
+				{
+					// インスタンスの並びの順に詰めて書き込み、バッチの先頭をSRVで指す
+					UploadAllocation instanceAllocation = AllocateUploadRingBuffer(uploadRing, sizeof(Matrix4x4) * instanceObjectIndices.size());
+					assert(instanceAllocation.cpuAddress != nullptr);
+
+					Matrix4x4* instanceData = static_cast<Matrix4x4*>(instanceAllocation.cpuAddress);
+					for (size_t i = 0; i < instanceObjectIndices.size(); i++)
+					{
+						instanceData[i] = worldViewProjectionMatrices[instanceObjectIndices[i]];
+					}
+
+					for (size_t i = 0; i < instanceBatches.size(); i++)
+					{
+						batchTransformAddresses[i] = instanceAllocation.gpuAddress + sizeof(Matrix4x4) * instanceBatches[i].firstInstance;
+					}
+				}
+				else
+				{
+					// 1つずつ描画するときは、オブジェクトごとのCBV
+					for (size_t i = 0; i < instanceBatches.size(); i++)
+					{
+						UploadAllocation wvpAllocation = AllocateUploadRingBuffer(uploadRing, sizeof(Matrix4x4));
+						assert(wvpAllocation.cpuAddress != nullptr);
+
+						*static_cast<Matrix4x4*>(wvpAllocation.cpuAddress) = worldViewProjectionMatrices[instanceObjectIndices[instanceBatches[i].firstInstance]];
+						batchTransformAddresses[i] = wvpAllocation.gpuAddress;
+					}
+				}
+			}
 
 
+			// 並べ替えた描画を範囲に分けて、スレッドごとのcommandListに記録する
+			std::vector<ID3D12CommandList*> sceneCommandLists = RecordCommandListsParallel
+			(commandRecorder, device, fence->GetCompletedValue(), static_cast<uint32_t>(renderQueue.commands.size()), kRecordWorkerCount, kMinDrawsPerCommandList,
+				[&](ID3D12GraphicsCommandList* sceneCommandList, const RecordRange& range)
+				{
+					// commandListごとに設定は引き継がれないので、それぞれで設定する
+					sceneCommandList->OMSetRenderTargets(1, &rtvHandles[backBufferIndex], false, nullptr);
+					sceneCommandList->SetDescriptorHeaps(1, descriptorHeap);
+
+					// viewportを設定
+					sceneCommandList->RSSetViewports(1, &viewport);
+
+					// scissorを設定
+					sceneCommandList->RSSetScissorRects(1, &scissorRect);
+
+					// rootSignature
+					sceneCommandList->SetGraphicsRootSignature(rootSignature);
+
+					// 形状
+					sceneCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+					// バインドレス描画では、読むバッファをcommandListごとに一度だけ設定する
+					if (isBindless)
+					{
+						sceneCommandList->SetGraphicsRootDescriptorTable(4, srvDescriptorHeap.gpuStart);
+						sceneCommandList->SetGraphicsRoot32BitConstants(3, _countof(bindlessTableIndices), bindlessTableIndices, 2);
+					}
+
+					for (uint32_t i = range.begin; i < range.begin + range.count; i++)
+					{
+						const RenderCommand& command = renderQueue.commands[i];
+						const RenderPacket& packet = renderQueue.packets[command.packetIndex];
+						const InstanceBatch& batch = instanceBatches[packet.drawIndex];
+
+						// 範囲の最初の描画は、前の状態がないので全て設定する
+						uint32_t stateChanges = (i == range.begin) ? kRenderStateChangeAll : command.stateChanges;
+
+						// PSO
+						if (stateChanges & kRenderStateChangePipeline)
+						{
+							sceneCommandList->SetPipelineState(scenePipelines[packet.pipelineIndex]);
+						}
+
+						// VBV、IBVを設定
+						if (stateChanges & kRenderStateChangeMesh)
+						{
+							sceneCommandList->IASetVertexBuffers(0, 1, &vertexBufferViews[packet.meshIndex]);
+							sceneCommandList->IASetIndexBuffer(&indexBufferViews[packet.meshIndex]);
+						}
+
+						// バインドレス描画では、先頭のインスタンスとマテリアルの番号だけを渡す
+						if (isBindless)
+						{
+							uint32_t drawConstants[] = { batch.firstInstance , materialSlots[packet.materialIndex] };
+							sceneCommandList->SetGraphicsRoot32BitConstants(3, _countof(drawConstants), drawConstants, 0);
+						}
+						else
+						{
+							// CBVのマテリアルを設定
+							if (stateChanges & kRenderStateChangeMaterial)
+							{
+								sceneCommandList->SetGraphicsRootConstantBufferView(0, materialAddresses[packet.materialIndex]);
+							}
+
+							// 座標変換を設定（インスタンス描画ならSRV、1つずつならCBV）
+							if (isInstancing)
+							{
+								sceneCommandList->SetGraphicsRootShaderResourceView(2, batchTransformAddresses[packet.drawIndex]);
+							}
+							else
+							{
+								sceneCommandList->SetGraphicsRootConstantBufferView(1, batchTransformAddresses[packet.drawIndex]);
+							}
+						}
+
+						// 描画
+						sceneCommandList->DrawIndexedInstanced(indexCounts[packet.meshIndex], batch.instanceCount, 0, 0, 0);
+					}
+				});
+
+
+			// ImGuiは全ての描画の後に積む
+			ID3D12GraphicsCommandList* uiCommandList = AcquireRecorderCommandList(commandRecorder, device, fence->GetCompletedValue());
+			uiCommandList->OMSetRenderTargets(1, &rtvHandles[backBufferIndex], false, nullptr);
+			uiCommandList->SetDescriptorHeaps(1, descriptorHeap);
 
 			// 実際のcommandListのImGui描画コマンドを積む
-			ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+			ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), uiCommandList);
 
 			///
 			/// ↑ 描画処理ここまで
 			/// 
 
 			// BackBufferを 描画 -> 表示 に変更する
-			TransitionBarrier(swapChainResources[backBufferIndex], commandList, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+			TransitionBarrier(swapChainResources[backBufferIndex], uiCommandList, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
 
 			// commandListの内容を確定させる　全てのコマンドを積んでからCloseする
 			hr = commandList->Close();
 			assert(SUCCEEDED(hr));
+			hr = uiCommandList->Close();
+			assert(SUCCEEDED(hr));
 
 
-			// GPUにcommandListの実行を行わせる
-			ID3D12CommandList* commandLists[] = { commandList };
-			commandQueue->ExecuteCommandLists(1, commandLists);
+			// GPUにcommandListの実行を行わせる（クリア -> 描画の範囲順 -> ImGui の順で、1回で送る）
+			std::vector<ID3D12CommandList*> commandLists;
+			commandLists.reserve(sceneCommandLists.size() + 2);
+			commandLists.push_back(commandList);
+			commandLists.insert(commandLists.end(), sceneCommandLists.begin(), sceneCommandLists.end());
+			commandLists.push_back(uiCommandList);
+			commandQueue->ExecuteCommandLists(static_cast<UINT>(commandLists.size()), commandLists.data());
 
 			// GPUとOSに画面の交換を行うよう通知する
 			swapChain->Present(1, 0);
 
-			// Fenceの値を更新
-			fenceValue++;
+			// Fenceの値を更新（このフレームのスロットに記録して、次のスロットに進む）
+			fenceValue = AdvanceFramePacer(framePacer);
 
 			// GPUがここまでたどり着いたときに、Fenceの値を指定した値に代入するようにSignalを送る
 			commandQueue->Signal(fence, fenceValue);
 
-			// Fenceの値が指定したSignal値にたどり着いているかを確認する
-			if (fence->GetCompletedValue() < fenceValue)
+			// このフレームで切り出した領域は、GPUがこの値に届いたら回収できる
+			FinishUploadRingBufferFrame(uploadRing, fenceValue);
+			FinishDescriptorFrame(srvDescriptorHeap.allocator, fenceValue);
+			FinishParallelCommandRecorderFrame(commandRecorder, fenceValue);
+
+			// 次のスロットを前回使ったフレームまで、GPUが進んでいるかを確認する（毎フレームは待たない）
+			uint64_t waitValue = GetFramePacerWaitValue(framePacer);
+			if (fence->GetCompletedValue() < waitValue)
 			{
 				// 指定したSignal値にたどり着いていないので、たどり着くまで待つようにEventを設定する
-				fence->SetEventOnCompletion(fenceValue, fenceEvent);
+				fence->SetEventOnCompletion(waitValue, fenceEvent);
 
 				// イベントを待つ
 				WaitForSingleObject(fenceEvent, INFINITE);
 			}
 
 			// 次のフレーム用のcommandListを準備
-			hr = commandAllocator->Reset();
+			hr = commandAllocators[framePacer.slotIndex]->Reset();
 			assert(SUCCEEDED(hr));
-			hr = commandList->Reset(commandAllocator, nullptr);
+			hr = commandList->Reset(commandAllocators[framePacer.slotIndex], nullptr);
 			assert(SUCCEEDED(hr));
-
-
-			
-			// 解放処理
-			wvpResource->Release();
-			materialResource->Release();
-			vertexResource->Release();
 		}
 	}
 
@@ -667,24 +1153,41 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	    解放処理
 	--------------*/
 
-	graphicsPipelineState->Release();
-	signatureBlob->Release();
-	if (errorBlob)
+	// 処理中のフレームが全て終わるまで待ってから解放する
+	if (fence->GetCompletedValue() < fenceValue)
+	{
+		fence->SetEventOnCompletion(fenceValue, fenceEvent);
+		WaitForSingleObject(fenceEvent, INFINITE);
+	}
+
+
+	ReleaseGeometryManager(geometryManager);
+	uploadRingResource->Unmap(0, nullptr);
+	uploadRingResource->Release();
+	SavePipelineStateCache(pipelineStateCache);
+	ReleasePipelineStateCache(pipelineStateCache);
+	if (kUseShaderHotReload)
 	{
-		errorBlob->Release();
+		ReleaseShaderHotReload(shaderHotReload);
 	}
-	rootSignature->Release();
-	pixelShaderBlob->Release();
-	vertexShaderBlob->Release();
+	ReleaseShaderCompilePool(shaderCompilePool);
+	ReleaseRootSignatureCache(rootSignatureCache);
 	CloseHandle(fenceEvent);
 	fence->Release();
 	swapChainResources[0]->Release();
 	swapChainResources[1]->Release();
-	srvDescriptorHeap->Release();
+	FreePersistentDescriptors(srvDescriptorHeap.allocator, imguiDescriptor);
+	ReleaseBindlessBuffer(materialBuffer, srvDescriptorHeap);
+	ReleaseBindlessBuffer(transformBuffer, srvDescriptorHeap);
+	ReleaseDescriptorHeapAllocator(srvDescriptorHeap);
 	rtvDescriptorHeap->Release();
 	swapChain->Release();
+	ReleaseParallelCommandRecorder(commandRecorder);
 	commandList->Release();
-	commandAllocator->Release();
+	for (uint32_t i = 0; i < kFrameLatency; i++)
+	{
+		commandAllocators[i]->Release();
+	}
 	commandQueue->Release();
 	device->Release();
 	useAdapter->Release();
@@ -696,5 +1199,8 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int)
 	// リソースリークチェッカー
 	ResourceLeakChecker();
 
+	// 残ったログを書き切る
+	ReleaseAsyncLogger(logger);
+
 	return 0;
 }